@@ -0,0 +1,447 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Attribute flash and RAM to the modules under src/modules/ and check budgets.
+
+Usage:
+    module_footprint.py build                                    # print table
+    module_footprint.py build --top 5                            # plus largest symbols
+    module_footprint.py build -b footprint_budget.json           # check budgets
+    module_footprint.py build -b footprint_budget.json --update  # re-baseline
+    module_footprint.py build -o footprint.json                  # results as JSON
+
+The build directory is the application build (or a sysbuild build, where the
+default image is used). Every input section in zephyr/zephyr.map is traced
+back to its source file through compile_commands.json and counted for the
+module directory it lives in: code, rodata, static buffers such as msg_buf
+or status_buf, thread stacks, and the webserver's gzip assets (arrays
+included from .gz.inc files, named *_gz by convention), which are also
+shown in their own column. Other application sources count as "app",
+everything else (kernel, drivers, libc) as "(rest)".
+
+Whether a section costs flash, RAM or both comes from the output section
+in zephyr.elf: loaded contents cost flash, writable sections cost RAM, so
+initialized data counts in both.
+
+LTO merges objects before the final link, so the map no longer names the
+source. With CONFIG_LTO the sizes are taken from the ELF symbols instead
+(nm -l, needs debug info); string literals and statics that nm cannot
+place then stay in "(rest)". Budget a build without CONFIG_LTO.
+
+Budget file:
+    {"nrf7002dk/nrf5340/cpuapp": {"wifi": {"flash": 24576, "ram": 4096}}}
+
+Keyed by CONFIG_BOARD_TARGET. A module over a budget, or one with no
+budget at all, fails the check. --update rewrites the budgets from this
+build plus --headroom percent, rounded up to --align bytes.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import shutil
+import struct
+import subprocess
+import sys
+
+REST = "(rest)"
+APP = "app"
+ASSET_RE = re.compile(r"_gz$")
+
+SHT_NOBITS = 8
+SHF_WRITE = 0x1
+SHF_ALLOC = 0x2
+
+OUT_RE = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+IN_RE = re.compile(r"^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+CONT_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(\S.*))?$")
+REGION_RE = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+MEMBER_RE = re.compile(r"^(.*)\((.*)\)$")
+TARGET_RE = re.compile(r"(?:^|/)CMakeFiles/([^/]+)\.dir/")
+NM_RE = re.compile(r"^([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+(\w)\s+(\S+)(?:\s+(\S+):\d+)?$")
+
+
+def find_build(build):
+    """Return the image build dir, following sysbuild's default domain."""
+    if os.path.isfile(os.path.join(build, "zephyr", "zephyr.map")):
+        return build
+    domains = os.path.join(build, "domains.yaml")
+    if os.path.isfile(domains):
+        with open(domains, encoding="utf-8") as f:
+            m = re.search(r"^default:\s*(\S+)", f.read(), re.M)
+        if m and os.path.isfile(os.path.join(build, m.group(1), "zephyr", "zephyr.map")):
+            return os.path.join(build, m.group(1))
+    sys.exit(f"No zephyr/zephyr.map under {build}")
+
+
+def read_kconfig(build, name):
+    try:
+        with open(os.path.join(build, "zephyr", ".config"), encoding="utf-8") as f:
+            m = re.search(rf'^{name}=(.*)$', f.read(), re.M)
+    except OSError:
+        return None
+    return m.group(1).strip('"') if m else None
+
+
+def elf_sections(path):
+    """Return {name: (flags, type)} for the section headers of an ELF file."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF":
+        sys.exit(f"{path}: not an ELF file")
+    is64 = data[4] == 2
+    end = "<" if data[5] == 1 else ">"
+    if is64:
+        shoff, = struct.unpack_from(end + "Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", data, 0x3A)
+        fmt = end + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(end + "I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", data, 0x2E)
+        fmt = end + "IIIIIIIIII"
+    headers = [struct.unpack_from(fmt, data, shoff + i * shentsize) for i in range(shnum)]
+    stroff = headers[shstrndx][4]
+    sections = {}
+    for name, sh_type, flags, *_ in headers:
+        raw = data[stroff + name:data.index(b"\0", stroff + name)]
+        sections[raw.decode()] = (flags, sh_type)
+    return sections
+
+
+def parse_map(path):
+    """Return (regions, output sections, input sections) from a GNU ld map.
+
+    regions: [(name, start, end)]
+    outputs: {name: (vma, size)}
+    inputs:  [(output, section, size, object)]
+    """
+    regions, outputs, inputs = [], {}, []
+    part = None
+    out = None
+    pending = None
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("Memory Configuration"):
+                part = "mem"
+                continue
+            if line.startswith("Linker script and memory map"):
+                part = "map"
+                continue
+            if part == "mem":
+                m = REGION_RE.match(line)
+                if m and m.group(1) not in ("Name", "*default*"):
+                    start = int(m.group(2), 16)
+                    regions.append((m.group(1), start, start + int(m.group(3), 16)))
+                continue
+            if part != "map":
+                continue
+
+            if pending:
+                kind, name = pending
+                pending = None
+                m = CONT_RE.match(line)
+                if m:
+                    if kind == "out":
+                        out = name
+                        outputs[name] = (int(m.group(1), 16), int(m.group(2), 16))
+                    elif m.group(3) and out:
+                        inputs.append((out, name, int(m.group(2), 16), m.group(3)))
+                    continue
+            if line and not line[0].isspace():
+                m = OUT_RE.match(line)
+                if m:
+                    out = m.group(1)
+                    outputs[out] = (int(m.group(2), 16), int(m.group(3), 16))
+                elif " " not in line:
+                    pending = ("out", line)
+                continue
+            m = IN_RE.match(line)
+            if m and out:
+                if m.group(1) != "*fill*":
+                    inputs.append((out, m.group(1), int(m.group(3), 16), m.group(4)))
+                continue
+            if re.match(r"^ \S+$", line) and not line.startswith(" *"):
+                pending = ("in", line.strip())
+    return regions, outputs, inputs
+
+
+def classify(outputs, sections, regions):
+    """Return {output section: (flash, ram)} for the allocated sections."""
+    ram_regions = [(s, e) for n, s, e in regions if re.search(r"RAM", n, re.I)]
+    costs = {}
+    for name, (vma, size) in outputs.items():
+        if name not in sections or not size:
+            continue
+        flags, sh_type = sections[name]
+        if not flags & SHF_ALLOC:
+            continue
+        flash = sh_type != SHT_NOBITS
+        ram = bool(flags & SHF_WRITE) or any(s <= vma < e for s, e in ram_regions)
+        costs[name] = (flash, ram)
+    return costs
+
+
+def object_sources(build):
+    """Return ({object path: source}, {(target, basename): [sources]})."""
+    by_path, by_member = {}, {}
+    try:
+        with open(os.path.join(build, "compile_commands.json"), encoding="utf-8") as f:
+            entries = json.load(f)
+    except OSError:
+        sys.exit(f"No compile_commands.json in {build} (CMAKE_EXPORT_COMPILE_COMMANDS)")
+    for entry in entries:
+        obj = entry.get("output")
+        if not obj:
+            args = entry.get("arguments") or shlex.split(entry.get("command", ""))
+            if "-o" not in args:
+                continue
+            obj = args[args.index("-o") + 1]
+        obj = os.path.relpath(os.path.join(entry["directory"], obj), build)
+        src = os.path.normpath(os.path.join(entry["directory"], entry["file"]))
+        by_path[obj] = src
+        m = TARGET_RE.search(obj)
+        if m:
+            by_member.setdefault((m.group(1), os.path.basename(obj)), []).append(src)
+    return by_path, by_member
+
+
+def owner(src, target, modules_dir):
+    m = re.search(rf"(?:^|/){re.escape(modules_dir)}/([^/]+)/", src or "")
+    if m:
+        return m.group(1)
+    return APP if target == "app" else REST
+
+
+class Resolver:
+    """Map an object name from the linker map to its owning module."""
+
+    def __init__(self, build, modules_dir):
+        self.build = build
+        self.modules_dir = modules_dir
+        self.by_path, self.by_member = object_sources(build)
+        self.app_sources = {src for (target, _), srcs in self.by_member.items()
+                            if target == "app" for src in srcs}
+        self.cache = {}
+        self.ambiguous = set()
+
+    def __call__(self, obj):
+        if obj not in self.cache:
+            self.cache[obj] = self.resolve(obj)
+        return self.cache[obj]
+
+    def resolve(self, obj):
+        m = MEMBER_RE.match(obj)
+        if not m:
+            path = os.path.relpath(os.path.join(self.build, obj), self.build)
+            t = TARGET_RE.search(path)
+            return owner(self.by_path.get(path), t.group(1) if t else None, self.modules_dir)
+        archive, member = m.groups()
+        lib = os.path.basename(archive)
+        target = lib[3:-2] if lib.startswith("lib") and lib.endswith(".a") else lib
+        srcs = self.by_member.get((target, member), [])
+        owners = {owner(src, target, self.modules_dir) for src in srcs}
+        if len(owners) > 1:
+            # Same file name in two modules of one library: ar keeps only
+            # the base name, so the map cannot tell them apart
+            self.ambiguous.add(f"{lib}({member})")
+            return REST
+        return owners.pop() if owners else REST
+
+
+def symbol_name(section):
+    """Symbol behind a -ffunction-sections/-fdata-sections input section."""
+    for prefix in (".text.", ".rodata.", ".data.", ".bss.", ".noinit."):
+        if section.startswith(prefix):
+            return section[len(prefix):]
+    return section
+
+
+def add(results, module, name, size, flash, ram, details):
+    row = results.setdefault(module, {"flash": 0, "ram": 0, "assets": 0})
+    if flash:
+        row["flash"] += size
+        if ASSET_RE.search(name):
+            row["assets"] += size
+    if ram:
+        row["ram"] += size
+    details.setdefault(module, {})
+    details[module][name] = details[module].get(name, 0) + size
+
+
+def from_map(inputs, costs, resolve):
+    results, details = {}, {}
+    for out, section, size, obj in inputs:
+        if out not in costs or not size:
+            continue
+        flash, ram = costs[out]
+        add(results, resolve(obj), symbol_name(section), size, flash, ram, details)
+    return results, details
+
+
+def find_nm(build, nm):
+    if nm:
+        return nm
+    try:
+        with open(os.path.join(build, "CMakeCache.txt"), encoding="utf-8") as f:
+            m = re.search(r"^CMAKE_NM:\w+=(.+)$", f.read(), re.M)
+        if m and os.path.exists(m.group(1)):
+            return m.group(1)
+    except OSError:
+        pass
+    for tool in ("arm-zephyr-eabi-nm", "arm-none-eabi-nm", "nm"):
+        if shutil.which(tool):
+            return tool
+    sys.exit("No nm found, pass --nm")
+
+
+def from_symbols(elf, outputs, costs, nm, resolve):
+    """LTO fallback: attribute ELF symbols by the source line nm reports."""
+    ranges = sorted((vma, vma + size, costs[name])
+                    for name, (vma, size) in outputs.items() if name in costs)
+    proc = subprocess.run([nm, "-S", "-l", elf], capture_output=True, text=True, check=True)
+    results, details = {}, {}
+    seen = set()
+    for line in proc.stdout.splitlines():
+        m = NM_RE.match(line.strip())
+        if not m:
+            continue
+        addr, size = int(m.group(1), 16), int(m.group(2), 16)
+        if not size or (addr, m.group(4)) in seen:
+            continue
+        seen.add((addr, m.group(4)))
+        cost = next((c for s, e, c in ranges if s <= addr < e), None)
+        if cost is None:
+            continue
+        src = os.path.normpath(m.group(5)) if m.group(5) else None
+        module = owner(src, APP if src in resolve.app_sources else None, resolve.modules_dir)
+        add(results, module, m.group(4), size, *cost, details)
+    return results, details
+
+
+def print_table(results, budgets, details, top):
+    """Print the footprint table, return the number of budget failures."""
+    failures = 0
+    rows = sorted(r for r in results if r not in (APP, REST))
+    print(f"{'module':<20} {'flash':>9} {'assets':>8} {'ram':>8} "
+          f"{'flash_max':>10} {'ram_max':>8}  status")
+    for module in rows + [APP, REST]:
+        if module not in results:
+            continue
+        row = results[module]
+        budget = budgets.get(module) if budgets is not None else None
+        status = ""
+        if budgets is not None and module != REST:
+            if budget is None:
+                status = "NEW (no budget)"
+                failures += 1
+            else:
+                over = [k for k in ("flash", "ram") if k in budget and row[k] > budget[k]]
+                status = "OVER " + ",".join(over) if over else "ok"
+                failures += bool(over)
+        fmax = budget.get("flash", "-") if budget else "-"
+        rmax = budget.get("ram", "-") if budget else "-"
+        print(f"{module:<20} {row['flash']:>9} {row['assets'] or '':>8} {row['ram']:>8} "
+              f"{fmax:>10} {rmax:>8}  {status}")
+        if top and module != REST:
+            biggest = sorted(details[module].items(), key=lambda kv: -kv[1])[:top]
+            for name, size in biggest:
+                print(f"    {size:>8}  {name}")
+    flash = sum(r["flash"] for r in results.values())
+    ram = sum(r["ram"] for r in results.values())
+    print(f"{'total':<20} {flash:>9} {'':>8} {ram:>8}")
+    for module in sorted(set(budgets or {}) - set(results)):
+        if not module.startswith("_"):
+            print(f"# {module}: budgeted but not in this build", file=sys.stderr)
+    return failures
+
+
+def update(results, budgets, headroom, align):
+    scale = 1 + headroom / 100
+    for module, row in results.items():
+        if module == REST:
+            continue
+        budgets[module] = {k: -(-int(row[k] * scale) // align) * align for k in ("flash", "ram")}
+    return budgets
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("build", nargs="?", default="build", help="build directory")
+    parser.add_argument("-b", "--budget", help="budget JSON to check against")
+    parser.add_argument("-o", "--output", help="write the results as JSON")
+    parser.add_argument("--update", action="store_true",
+                        help="rewrite this board's budgets from this build")
+    parser.add_argument("--headroom", type=float, default=10,
+                        help="percent added to sizes by --update (default 10)")
+    parser.add_argument("--align", type=int, default=256,
+                        help="round budgets up to this many bytes (default 256)")
+    parser.add_argument("--top", type=int, default=0,
+                        help="list the N largest symbols of each module")
+    parser.add_argument("--modules-dir", default="src/modules",
+                        help="directory holding one subdirectory per module")
+    parser.add_argument("--board", help="budget key (default CONFIG_BOARD_TARGET)")
+    parser.add_argument("--nm", help="nm of the toolchain, for LTO builds")
+    args = parser.parse_args()
+
+    build = find_build(args.build)
+    board = args.board or read_kconfig(build, "CONFIG_BOARD_TARGET") \
+        or read_kconfig(build, "CONFIG_BOARD")
+    elf = os.path.join(build, "zephyr", "zephyr.elf")
+    regions, outputs, inputs = parse_map(os.path.join(build, "zephyr", "zephyr.map"))
+    costs = classify(outputs, elf_sections(elf), regions)
+
+    resolve = Resolver(build, args.modules_dir)
+    if any(".ltrans" in obj for _, _, _, obj in inputs):
+        print(f"# LTO build: attributed by ELF symbols, partly counted in {REST}",
+              file=sys.stderr)
+        results, details = from_symbols(elf, outputs, costs, find_nm(build, args.nm), resolve)
+    else:
+        results, details = from_map(inputs, costs, resolve)
+        for obj in sorted(resolve.ambiguous):
+            print(f"# {obj}: file name used by several modules, counted in {REST}",
+                  file=sys.stderr)
+
+    if not any(m not in (APP, REST) for m in results):
+        print(f"# no sources under {args.modules_dir}/ in this build", file=sys.stderr)
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump({board: results}, f, indent=2, sort_keys=True)
+            f.write("\n")
+
+    if not args.budget:
+        print_table(results, None, details, args.top)
+        sys.exit(0)
+
+    all_budgets = {}
+    if os.path.exists(args.budget):
+        with open(args.budget, encoding="utf-8") as f:
+            all_budgets = json.load(f)
+    elif not args.update:
+        sys.exit(f"{args.budget}: not found (create it with --update)")
+
+    if args.update:
+        all_budgets[board] = update(results, all_budgets.get(board, {}), args.headroom,
+                                    args.align)
+        with open(args.budget, "w", encoding="utf-8") as f:
+            json.dump(all_budgets, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print(f"Budgets for {board} updated with {args.headroom:.0f}% headroom: {args.budget}")
+        sys.exit(0)
+
+    if board not in all_budgets:
+        sys.exit(f"{args.budget}: no budgets for {board}")
+    failures = print_table(results, all_budgets[board], details, args.top)
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
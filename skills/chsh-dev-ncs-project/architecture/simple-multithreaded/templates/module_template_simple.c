@@ -31,6 +31,10 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/atomic.h>
 
+#include "app_stats.h"
+
+#include "log_hot.h"
+
 LOG_MODULE_REGISTER(module_template_simple, CONFIG_MODULE_TEMPLATE_LOG_LEVEL);
 
 /*******************************************************************************
@@ -100,6 +104,11 @@ static struct module_context ctx = {
 /* Message queue for receiving commands */
 K_MSGQ_DEFINE(module_msgq, sizeof(struct module_message), 10, 4);
 
+/* Exported to the "stats" shell command (compile out without CONFIG_APP_STATS) */
+APP_STATS_COUNTER_DEFINE(module_simple, processed);
+APP_STATS_COUNTER_DEFINE(module_simple, errors);
+APP_STATS_MSGQ_DEFINE(module_simple, queue_depth, &module_msgq);
+
 /*******************************************************************************
  * Synchronization Primitives
  ******************************************************************************/
@@ -250,7 +259,8 @@ static int process_data(const void *data, size_t len)
 		return -EINVAL;
 	}
 
-	LOG_DBG("Processing %zu bytes", len);
+	/* Per-message path: at most one log per second, with a skipped count */
+	LOG_HOT_DBG(0, 1000, "Processing %zu bytes", len);
 
 	/* Process data here */
 	/* Example:
@@ -263,6 +273,8 @@ static int process_data(const void *data, size_t len)
 	ctx.run_count++;
 	k_mutex_unlock(&ctx.mutex);
 
+	APP_STATS_INC(module_simple, processed);
+
 	/* Signal data processing complete */
 	k_sem_give(&data_ready_sem);
 	
@@ -282,6 +294,8 @@ static void handle_error(int error_code)
 	ctx.error_count++;
 	k_mutex_unlock(&ctx.mutex);
 
+	APP_STATS_INC(module_simple, errors);
+
 	/* Handle error here */
 	/* Example:
 	 * - Attempt recovery
@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file app_stats.c
+ * @brief Registry of named module counters, gauges and histograms
+ *
+ * This module demonstrates:
+ * - Self-registering statistics collected in an iterable ROM section
+ * - Lock-free reads of values owned by other modules (atomics only)
+ * - Streaming a binary dump through the shell without a dump buffer
+ * - Fixed-size log2 histograms read as percentiles
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+
+#include "app_stats.h"
+
+/*******************************************************************************
+ * System Statistics
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_STATS_SYSTEM
+
+static uint32_t uptime_s(void)
+{
+	return k_uptime_seconds();
+}
+APP_STATS_FN_DEFINE(system, uptime_s, uptime_s);
+
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (K_HEAP_MEM_POOL_SIZE > 0)
+extern struct k_heap _system_heap;
+
+static uint32_t heap_used(void)
+{
+	struct sys_memory_stats s;
+
+	return sys_heap_runtime_stats_get(&_system_heap.heap, &s) ? 0 : s.allocated_bytes;
+}
+APP_STATS_FN_DEFINE(system, heap_used, heap_used);
+
+static uint32_t heap_max(void)
+{
+	struct sys_memory_stats s;
+
+	return sys_heap_runtime_stats_get(&_system_heap.heap, &s) ? 0 : s.max_allocated_bytes;
+}
+APP_STATS_FN_DEFINE(system, heap_max, heap_max);
+#endif
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+/* CPU busy share since the previous read, in percent */
+static uint32_t cpu_busy_pct(void)
+{
+	static uint64_t prev_all;
+	static uint64_t prev_busy;
+	k_thread_runtime_stats_t s;
+	uint64_t all;
+	uint64_t busy;
+
+	if (k_thread_runtime_stats_all_get(&s)) {
+		return 0;
+	}
+
+	/* execution_cycles includes idle, total_cycles does not */
+	all = s.execution_cycles - prev_all;
+	busy = s.total_cycles - prev_busy;
+	prev_all = s.execution_cycles;
+	prev_busy = s.total_cycles;
+
+	return all ? (uint32_t)((busy * 100U) / all) : 0;
+}
+APP_STATS_FN_DEFINE(system, cpu_busy_pct, cpu_busy_pct);
+#endif
+
+#endif /* CONFIG_APP_STATS_SYSTEM */
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Bucket 0 holds 0, bucket i holds [2^(i-1), 2^i), the last one the rest */
+static size_t hist_bucket(uint32_t value)
+{
+	size_t idx = value ? (32U - __builtin_clz(value)) : 0;
+
+	return MIN(idx, APP_STATS_HIST_BUCKETS - 1);
+}
+
+static void entry_read(const struct app_stats_entry *entry, uint32_t *value, uint32_t *max)
+{
+	switch (entry->type) {
+	case APP_STATS_TYPE_HIST:
+		*value = (uint32_t)atomic_get(&entry->hist->count);
+		*max = (uint32_t)atomic_get(&entry->hist->max);
+		break;
+	case APP_STATS_TYPE_GAUGE:
+		*value = (uint32_t)atomic_get(&entry->val->value);
+		*max = (uint32_t)atomic_get(&entry->val->max);
+		break;
+	case APP_STATS_TYPE_FN:
+		*value = entry->fn();
+		*max = 0;
+		break;
+	case APP_STATS_TYPE_COUNTER:
+	default:
+		*value = (uint32_t)atomic_get(&entry->val->value);
+		*max = 0;
+		break;
+	}
+}
+
+static void fill_dump_hdr(struct app_stats_dump_hdr *hdr, size_t entries)
+{
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->magic = APP_STATS_DUMP_MAGIC;
+	hdr->version = APP_STATS_DUMP_VERSION;
+	hdr->entry_count = entries;
+	hdr->uptime_ms = k_uptime_get_32();
+}
+
+static void fill_dump_entry(const struct app_stats_entry *entry, struct app_stats_dump_entry *out)
+{
+	memset(out, 0, sizeof(*out));
+	strncpy(out->group, entry->group, sizeof(out->group) - 1);
+	strncpy(out->name, entry->name, sizeof(out->name) - 1);
+	out->type = entry->type;
+	entry_read(entry, &out->value, &out->max);
+
+	if (entry->type == APP_STATS_TYPE_HIST) {
+		out->p50 = app_stats_percentile(entry, 50);
+		out->p90 = app_stats_percentile(entry, 90);
+		out->p99 = app_stats_percentile(entry, 99);
+	}
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+void z_app_stats_gauge_set(struct app_stats_value *val, uint32_t value)
+{
+	atomic_val_t max;
+
+	atomic_set(&val->value, (atomic_val_t)value);
+
+	do {
+		max = atomic_get(&val->max);
+		if (value <= (uint32_t)max) {
+			return;
+		}
+	} while (!atomic_cas(&val->max, max, (atomic_val_t)value));
+}
+
+void z_app_stats_hist_record(struct app_stats_hist *hist, uint32_t value)
+{
+	atomic_val_t max;
+
+	atomic_inc(&hist->buckets[hist_bucket(value)]);
+	atomic_inc(&hist->count);
+
+	do {
+		max = atomic_get(&hist->max);
+		if (value <= (uint32_t)max) {
+			return;
+		}
+	} while (!atomic_cas(&hist->max, max, (atomic_val_t)value));
+}
+
+int app_stats_get(size_t idx, const struct app_stats_entry **entry, uint32_t *value,
+		  uint32_t *max)
+{
+	size_t count;
+
+	STRUCT_SECTION_COUNT(app_stats_entry, &count);
+	if (idx >= count) {
+		return -ENOENT;
+	}
+
+	STRUCT_SECTION_GET(app_stats_entry, idx, entry);
+	entry_read(*entry, value, max);
+
+	return 0;
+}
+
+uint32_t app_stats_percentile(const struct app_stats_entry *entry, uint32_t pct)
+{
+	uint32_t counts[APP_STATS_HIST_BUCKETS];
+	uint64_t total = 0;
+	uint64_t target;
+	uint64_t seen = 0;
+	uint32_t max;
+
+	if (entry->type != APP_STATS_TYPE_HIST || pct == 0 || pct > 100) {
+		return 0;
+	}
+
+	/* Buckets are read one by one while writers run; sum the snapshot */
+	for (size_t i = 0; i < APP_STATS_HIST_BUCKETS; i++) {
+		counts[i] = (uint32_t)atomic_get(&entry->hist->buckets[i]);
+		total += counts[i];
+	}
+
+	if (total == 0) {
+		return 0;
+	}
+
+	max = (uint32_t)atomic_get(&entry->hist->max);
+	target = DIV_ROUND_UP(total * pct, 100U);
+
+	for (size_t i = 0; i < APP_STATS_HIST_BUCKETS - 1; i++) {
+		seen += counts[i];
+		if (seen >= target) {
+			return MIN(BIT64(i) - 1U, max);
+		}
+	}
+
+	return max;
+}
+
+int app_stats_dump(uint8_t *buf, size_t size)
+{
+	struct app_stats_dump_hdr hdr;
+	struct app_stats_dump_entry out;
+	size_t count;
+	size_t off;
+
+	STRUCT_SECTION_COUNT(app_stats_entry, &count);
+	if (size < sizeof(hdr) + count * sizeof(out)) {
+		return -ENOMEM;
+	}
+
+	fill_dump_hdr(&hdr, count);
+	memcpy(buf, &hdr, sizeof(hdr));
+	off = sizeof(hdr);
+
+	STRUCT_SECTION_FOREACH(app_stats_entry, entry) {
+		fill_dump_entry(entry, &out);
+		memcpy(buf + off, &out, sizeof(out));
+		off += sizeof(out);
+	}
+
+	return off;
+}
+
+void app_stats_reset(const char *group)
+{
+	STRUCT_SECTION_FOREACH(app_stats_entry, entry) {
+		if (group && strcmp(group, entry->group) != 0) {
+			continue;
+		}
+
+		switch (entry->type) {
+		case APP_STATS_TYPE_COUNTER:
+			atomic_clear(&entry->val->value);
+			break;
+		case APP_STATS_TYPE_GAUGE:
+			atomic_set(&entry->val->max, atomic_get(&entry->val->value));
+			break;
+		case APP_STATS_TYPE_HIST:
+			/* Not atomic as a whole: a sample racing the reset may survive */
+			for (size_t i = 0; i < APP_STATS_HIST_BUCKETS; i++) {
+				atomic_clear(&entry->hist->buckets[i]);
+			}
+			atomic_clear(&entry->hist->count);
+			atomic_clear(&entry->hist->max);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_STATS_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	const char *group = (argc > 1) ? argv[1] : NULL;
+	uint32_t value;
+	uint32_t max;
+
+	shell_print(sh, "%-16s %-16s %-7s %10s %10s", "group", "name", "type", "value", "max");
+
+	STRUCT_SECTION_FOREACH(app_stats_entry, entry) {
+		if (group && strcmp(group, entry->group) != 0) {
+			continue;
+		}
+
+		entry_read(entry, &value, &max);
+
+		if (entry->type == APP_STATS_TYPE_GAUGE) {
+			shell_print(sh, "%-16s %-16s %-7s %10u %10u",
+				    entry->group, entry->name, "gauge", value, max);
+		} else if (entry->type == APP_STATS_TYPE_HIST) {
+			/* value is the sample count */
+			shell_print(sh, "%-16s %-16s %-7s %10u %10u  p50 %u p90 %u p99 %u",
+				    entry->group, entry->name, "hist", value, max,
+				    app_stats_percentile(entry, 50),
+				    app_stats_percentile(entry, 90),
+				    app_stats_percentile(entry, 99));
+		} else {
+			shell_print(sh, "%-16s %-16s %-7s %10u %10s",
+				    entry->group, entry->name,
+				    entry->type == APP_STATS_TYPE_FN ? "fn" : "counter", value, "-");
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	struct app_stats_dump_hdr hdr;
+	struct app_stats_dump_entry out;
+	size_t count;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	/* Stream header + entries so no dump-sized buffer is needed */
+	STRUCT_SECTION_COUNT(app_stats_entry, &count);
+	fill_dump_hdr(&hdr, count);
+	shell_hexdump(sh, (const uint8_t *)&hdr, sizeof(hdr));
+
+	STRUCT_SECTION_FOREACH(app_stats_entry, entry) {
+		fill_dump_entry(entry, &out);
+		shell_hexdump(sh, (const uint8_t *)&out, sizeof(out));
+	}
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	const char *group = (argc > 1) ? argv[1] : NULL;
+
+	app_stats_reset(group);
+	shell_print(sh, "Statistics cleared%s%s", group ? ": " : "", group ? group : "");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_stats,
+	SHELL_CMD_ARG(show, NULL, "Show all statistics [group]", cmd_show, 1, 1),
+	SHELL_CMD(dump, NULL, "Hex dump for app_stats_decode.py", cmd_dump),
+	SHELL_CMD_ARG(reset, NULL, "Clear counters, histograms and high-water marks [group]",
+		      cmd_reset, 1, 1),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(stats, &sub_stats, "Module performance counters", NULL);
+
+#endif /* CONFIG_APP_STATS_SHELL */
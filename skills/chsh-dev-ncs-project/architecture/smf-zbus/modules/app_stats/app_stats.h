@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _APP_STATS_H_
+#define _APP_STATS_H_
+
+/**
+ * @file app_stats.h
+ * @brief Registry of named module counters, gauges and histograms
+ *
+ * Modules export performance counters with one line each and update them
+ * with a single atomic operation; the "stats" shell command and
+ * app_stats_dump() read every registered value without taking any module
+ * lock:
+ *
+ * @code
+ * APP_STATS_COUNTER_DEFINE(sensor, samples);
+ * APP_STATS_GAUGE_DEFINE(sensor, backlog);
+ * APP_STATS_HIST_DEFINE(module_template, run_us);
+ *
+ * APP_STATS_INC(sensor, samples);
+ * APP_STATS_SET(sensor, backlog, n);                   // also tracks the max
+ * APP_STATS_RECORD(module_template, run_us, elapsed_us);
+ * @endcode
+ *
+ * Histograms count samples in log2 buckets and are read as p50/p90/p99
+ * (upper bucket bound, capped at the largest sample) plus count and max.
+ * Queue depths are exported with APP_STATS_MSGQ_DEFINE(), other values
+ * derived on demand (heap usage) with APP_STATS_FN_DEFINE(); the function
+ * must not block.
+ *
+ * Without CONFIG_APP_STATS all macros compile to nothing, so modules use
+ * them unconditionally. (Prefixed APP_ to stay clear of Zephyr's own
+ * CONFIG_STATS / <zephyr/stats/stats.h>.)
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Binary dump magic ("STAT", little endian) */
+#define APP_STATS_DUMP_MAGIC 0x54415453U
+
+/** Binary dump format version */
+#define APP_STATS_DUMP_VERSION 2
+
+/** Name lengths stored per entry in the binary dump (NUL padded) */
+#define APP_STATS_GROUP_LEN 16
+#define APP_STATS_NAME_LEN 16
+
+enum app_stats_type {
+	APP_STATS_TYPE_COUNTER,	/* Monotonic, cleared by "stats reset" */
+	APP_STATS_TYPE_GAUGE,	/* Last value plus high-water mark */
+	APP_STATS_TYPE_FN,		/* Computed when read */
+	APP_STATS_TYPE_HIST,	/* Sample distribution, read as percentiles */
+};
+
+/** Histogram buckets: 0, then [2^(i-1), 2^i), the last one open-ended */
+#define APP_STATS_HIST_BUCKETS 24
+
+/** Storage of a counter or gauge (RAM) */
+struct app_stats_value {
+	atomic_t value;
+	atomic_t max;
+};
+
+/** Storage of a histogram (RAM) */
+struct app_stats_hist {
+	atomic_t count;
+	atomic_t max;
+	atomic_t buckets[APP_STATS_HIST_BUCKETS];
+};
+
+/**
+ * @brief Registered statistic (ROM)
+ */
+struct app_stats_entry {
+	const char *group;
+	const char *name;
+	enum app_stats_type type;
+	struct app_stats_value *val;	/* COUNTER, GAUGE */
+	uint32_t (*fn)(void);		/* FN */
+	struct app_stats_hist *hist;	/* HIST */
+};
+
+/**
+ * @brief Binary dump header
+ *
+ * Followed by entry_count struct app_stats_dump_entry records, in link order.
+ * All fields are little endian.
+ */
+struct app_stats_dump_hdr {
+	uint32_t magic;
+	uint8_t version;
+	uint8_t reserved;
+	uint16_t entry_count;
+	uint32_t uptime_ms;
+} __packed;
+
+/** Binary dump record, one per registered statistic */
+struct app_stats_dump_entry {
+	char group[APP_STATS_GROUP_LEN];
+	char name[APP_STATS_NAME_LEN];
+	uint8_t type;
+	uint8_t reserved[3];
+	uint32_t value;	/* Sample count for histograms */
+	uint32_t max;	/* Gauges and histograms, 0 otherwise */
+	uint32_t p50;	/* Histograms only, 0 otherwise */
+	uint32_t p90;
+	uint32_t p99;
+} __packed;
+
+#ifdef CONFIG_APP_STATS
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_APP_STATS_VAL(_group, _name) _CONCAT(app_stats_val_, _CONCAT(_group, _CONCAT(_, _name)))
+#define Z_APP_STATS_ENTRY(_group, _name) _CONCAT(app_stats_, _CONCAT(_group, _CONCAT(_, _name)))
+
+#define Z_APP_STATS_DEFINE(_group, _name, _type)					\
+	static struct app_stats_value Z_APP_STATS_VAL(_group, _name);			\
+	static const STRUCT_SECTION_ITERABLE(app_stats_entry,				\
+					     Z_APP_STATS_ENTRY(_group, _name)) = {	\
+		.group = STRINGIFY(_group),						\
+		.name = STRINGIFY(_name),						\
+		.type = _type,								\
+		.val = &Z_APP_STATS_VAL(_group, _name),					\
+	}
+
+#define Z_APP_STATS_HIST(_group, _name) _CONCAT(app_stats_hist_, _CONCAT(_group, _CONCAT(_, _name)))
+#define Z_APP_STATS_FN(_group, _name) _CONCAT(app_stats_fn_, _CONCAT(_group, _CONCAT(_, _name)))
+
+void z_app_stats_gauge_set(struct app_stats_value *val, uint32_t value);
+void z_app_stats_hist_record(struct app_stats_hist *hist, uint32_t value);
+/** @endcond */
+
+/**
+ * @brief Define a counter
+ *
+ * @param _group Module name (identifier), groups entries in the shell
+ * @param _name Counter name (identifier)
+ */
+#define APP_STATS_COUNTER_DEFINE(_group, _name)						\
+	Z_APP_STATS_DEFINE(_group, _name, APP_STATS_TYPE_COUNTER)
+
+/**
+ * @brief Define a gauge (current value and high-water mark)
+ */
+#define APP_STATS_GAUGE_DEFINE(_group, _name)						\
+	Z_APP_STATS_DEFINE(_group, _name, APP_STATS_TYPE_GAUGE)
+
+/**
+ * @brief Export a value computed by @p _fn when read
+ *
+ * @param _fn uint32_t (*)(void), called from the shell thread, must not block
+ */
+#define APP_STATS_FN_DEFINE(_group, _name, _fn)						\
+	static const STRUCT_SECTION_ITERABLE(app_stats_entry,				\
+					     Z_APP_STATS_ENTRY(_group, _name)) = {	\
+		.group = STRINGIFY(_group),						\
+		.name = STRINGIFY(_name),						\
+		.type = APP_STATS_TYPE_FN,						\
+		.fn = _fn,								\
+	}
+
+/**
+ * @brief Define a histogram (count, max, p50/p90/p99)
+ *
+ * Log2 buckets keep it at a fixed size; percentiles are accurate to a
+ * factor of two, which is enough to tell a tail from the median.
+ */
+#define APP_STATS_HIST_DEFINE(_group, _name)						\
+	static struct app_stats_hist Z_APP_STATS_HIST(_group, _name);			\
+	static const STRUCT_SECTION_ITERABLE(app_stats_entry,				\
+					     Z_APP_STATS_ENTRY(_group, _name)) = {	\
+		.group = STRINGIFY(_group),						\
+		.name = STRINGIFY(_name),						\
+		.type = APP_STATS_TYPE_HIST,						\
+		.hist = &Z_APP_STATS_HIST(_group, _name),				\
+	}
+
+/**
+ * @brief Export the number of messages queued in a k_msgq
+ *
+ * Also works for ZBUS_SUBSCRIBER_DEFINE() observers through obs.queue.
+ * Message subscribers queue in a k_fifo that has no count; put them on
+ * zbus_lanes, which tracks depth per lane, to see it.
+ *
+ * @param _msgq struct k_msgq pointer, a constant expression
+ */
+#define APP_STATS_MSGQ_DEFINE(_group, _name, _msgq)					\
+	static uint32_t Z_APP_STATS_FN(_group, _name)(void)				\
+	{										\
+		return k_msgq_num_used_get(_msgq);					\
+	}										\
+	APP_STATS_FN_DEFINE(_group, _name, Z_APP_STATS_FN(_group, _name))
+
+/** Add @p _n to a counter */
+#define APP_STATS_ADD(_group, _name, _n)						\
+	((void)atomic_add(&Z_APP_STATS_VAL(_group, _name).value, (atomic_val_t)(_n)))
+
+/** Increment a counter */
+#define APP_STATS_INC(_group, _name) APP_STATS_ADD(_group, _name, 1)
+
+/** Set a gauge and raise its high-water mark if needed */
+#define APP_STATS_SET(_group, _name, _v)						\
+	z_app_stats_gauge_set(&Z_APP_STATS_VAL(_group, _name), (uint32_t)(_v))
+
+/** Add one sample to a histogram */
+#define APP_STATS_RECORD(_group, _name, _v)						\
+	z_app_stats_hist_record(&Z_APP_STATS_HIST(_group, _name), (uint32_t)(_v))
+
+#else /* !CONFIG_APP_STATS */
+
+#define APP_STATS_COUNTER_DEFINE(_group, _name)
+#define APP_STATS_GAUGE_DEFINE(_group, _name)
+#define APP_STATS_HIST_DEFINE(_group, _name)
+#define APP_STATS_FN_DEFINE(_group, _name, _fn)
+#define APP_STATS_MSGQ_DEFINE(_group, _name, _msgq)
+#define APP_STATS_ADD(_group, _name, _n) ((void)sizeof(_n))
+#define APP_STATS_INC(_group, _name) ((void)0)
+#define APP_STATS_SET(_group, _name, _v) ((void)sizeof(_v))
+#define APP_STATS_RECORD(_group, _name, _v) ((void)sizeof(_v))
+
+#endif /* CONFIG_APP_STATS */
+
+/**
+ * @brief Read one registered statistic
+ *
+ * @param idx Entry index, starting at 0
+ * @param entry Output descriptor
+ * @param value Output current value (sample count for histograms)
+ * @param max Output high-water mark (gauges, histograms), 0 otherwise
+ * @return 0 on success, -ENOENT when idx is past the last entry
+ */
+int app_stats_get(size_t idx, const struct app_stats_entry **entry, uint32_t *value, uint32_t *max);
+
+/**
+ * @brief Percentile of a histogram
+ *
+ * @param entry Histogram descriptor (from app_stats_get())
+ * @param pct Percentile, 1 to 100
+ * @return Upper bound of the bucket holding that sample, capped at the
+ *         largest sample; 0 without samples or for other types
+ */
+uint32_t app_stats_percentile(const struct app_stats_entry *entry, uint32_t pct);
+
+/**
+ * @brief Export all statistics as a binary dump
+ *
+ * @param buf Output buffer
+ * @param size Size of buf
+ * @return Number of bytes written, or -ENOMEM if buf is too small
+ */
+int app_stats_dump(uint8_t *buf, size_t size);
+
+/**
+ * @brief Clear counters, histograms and gauge high-water marks
+ *
+ * @param group Only this group, or NULL for all
+ */
+void app_stats_reset(const char *group);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _APP_STATS_H_ */
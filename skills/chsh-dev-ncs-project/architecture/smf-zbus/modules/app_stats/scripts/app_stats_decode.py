@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Decode "stats dump" captures into a table, CSV or per-second rates.
+
+Usage:
+    app_stats_decode.py uart.log             # last dump in the capture
+    app_stats_decode.py uart.log --csv       # one CSV row per dump and statistic
+    app_stats_decode.py uart.log --rate      # counter rates between first and last dump
+
+The input is any text file that contains the shell hexdump lines printed by
+"stats dump" (other log lines are ignored). Binary layout is documented in
+app_stats.h.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+MAGIC = 0x54415453
+TYPES = {0: "counter", 1: "gauge", 2: "fn", 3: "hist"}
+
+VERSION = 2
+HDR = struct.Struct("<IBBHI")
+ENTRY = struct.Struct("<16s16sB3xIIIII")
+
+HEXDUMP_RE = re.compile(r"^\s*[0-9a-fA-F]{8}:\s+((?:[0-9a-fA-F]{2}\s+)+)")
+
+
+def read_bytes(path):
+    data = bytearray()
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            m = HEXDUMP_RE.match(line)
+            if m:
+                data.extend(bytes.fromhex(m.group(1).replace(" ", "")))
+    return bytes(data)
+
+
+def cstr(raw):
+    return raw.split(b"\0", 1)[0].decode("ascii", errors="replace")
+
+
+def parse(data):
+    """Yield (uptime_ms, [(group, name, type, value, max, pcts), ...]) per dump.
+
+    pcts is (p50, p90, p99) for histograms, where value is the sample count.
+    """
+    magic = struct.pack("<I", MAGIC)
+    start = data.find(magic)
+    while start >= 0:
+        _, version, _, count, uptime_ms = HDR.unpack_from(data, start)
+        if version != VERSION:
+            sys.exit(f"Unsupported dump version {version}")
+        off = start + HDR.size
+        if off + count * ENTRY.size > len(data):
+            break
+        entries = []
+        for _ in range(count):
+            group, name, typ, value, vmax, *pcts = ENTRY.unpack_from(data, off)
+            entries.append((cstr(group), cstr(name), TYPES.get(typ, str(typ)), value, vmax,
+                            tuple(pcts)))
+            off += ENTRY.size
+        yield uptime_ms, entries
+        start = data.find(magic, off)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", help="UART/RTT log containing one or more dumps")
+    parser.add_argument("--csv", action="store_true", help="CSV output, all dumps")
+    parser.add_argument("--rate", action="store_true",
+                        help="counter increase per second between first and last dump")
+    args = parser.parse_args()
+
+    dumps = list(parse(read_bytes(args.capture)))
+    if not dumps:
+        sys.exit("No stats dump found in input")
+
+    if args.csv:
+        print("uptime_ms,group,name,type,value,max,p50,p90,p99")
+        for uptime_ms, entries in dumps:
+            for group, name, typ, value, vmax, (p50, p90, p99) in entries:
+                print(f"{uptime_ms},{group},{name},{typ},{value},{vmax},{p50},{p90},{p99}")
+        return
+
+    if args.rate:
+        if len(dumps) < 2:
+            sys.exit("--rate needs at least two dumps in the capture")
+        (t0, first), (t1, last) = dumps[0], dumps[-1]
+        dt = (t1 - t0) / 1000
+        if dt <= 0:
+            sys.exit("Dumps are not in uptime order (device reset in between?)")
+        before = {(g, n): v for g, n, typ, v, *_ in first if typ in ("counter", "hist")}
+        print(f"# {dt:.1f} s between dumps")
+        for group, name, typ, value, *_ in last:
+            if (group, name) in before:
+                rate = (value - before[(group, name)]) / dt
+                print(f"{group:<16} {name:<16} {rate:12.2f} /s")
+        return
+
+    uptime_ms, entries = dumps[-1]
+    print(f"# uptime {uptime_ms / 1000:.1f} s")
+    for group, name, typ, value, vmax, (p50, p90, p99) in entries:
+        if typ == "gauge":
+            extra = f"  max {vmax}"
+        elif typ == "hist":
+            extra = f"  max {vmax}  p50 {p50} p90 {p90} p99 {p99}"
+        else:
+            extra = ""
+        print(f"{group:<16} {name:<16} {typ:<8} {value:>10}{extra}")
+
+
+if __name__ == "__main__":
+    main()
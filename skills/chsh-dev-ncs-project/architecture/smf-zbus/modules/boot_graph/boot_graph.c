@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file boot_graph.c
+ * @brief Boot timeline and dependency-declared module initialization
+ *
+ * This module demonstrates:
+ * - One k_event bit per module, so a thread waits on exactly the modules
+ *   it depends on with a single k_event_wait_all()
+ * - Dependency cycle detection at boot over an iterable section
+ * - Cycle-counter timestamps from SYS_INIT hooks and module threads
+ * - Finding the critical path of the boot from the recorded timeline
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "boot_graph.h"
+
+LOG_MODULE_REGISTER(boot_graph, CONFIG_APP_BOOT_GRAPH_LOG_LEVEL);
+
+/* One bit per registered module, set by boot_graph_done() */
+static K_EVENT_DEFINE(running_events);
+
+static struct k_spinlock lock;
+
+/* Set when the graph cannot be used (cycle, too many modules) */
+static bool disabled;
+
+static uint32_t kernel_cycles;
+static uint32_t drivers_cycles;
+static uint32_t all_running_cycles;
+static size_t running_count;
+
+static struct {
+	const char *name;
+	uint32_t cycles;
+} milestones[CONFIG_APP_BOOT_GRAPH_MILESTONES];
+static size_t milestone_count;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Never 0, which marks a step not reached */
+static uint32_t stamp(void)
+{
+	uint32_t cycles = k_cycle_get_32();
+
+	return cycles ? cycles : 1;
+}
+
+static size_t module_count(void)
+{
+	size_t count;
+
+	STRUCT_SECTION_COUNT(boot_graph_module, &count);
+
+	return count;
+}
+
+/* Depth-first search; visiting is the set of modules on the current path */
+static bool has_cycle(const struct boot_graph_module *mod, uint32_t *visiting, uint32_t *done)
+{
+	if (*done & mod->data->bit) {
+		return false;
+	}
+	if (*visiting & mod->data->bit) {
+		LOG_ERR("Dependency cycle through %s", mod->name);
+		return true;
+	}
+
+	*visiting |= mod->data->bit;
+	for (const struct boot_graph_module *const *dep = mod->deps; *dep; dep++) {
+		if (has_cycle(*dep, visiting, done)) {
+			return true;
+		}
+	}
+	*visiting &= ~mod->data->bit;
+	*done |= mod->data->bit;
+
+	return false;
+}
+
+/* "wifi <- webserver <- settings": follow the dependency that finished last */
+static void critical_path(const struct boot_graph_module *last, char *buf, size_t len)
+{
+	size_t used = 0;
+
+	buf[0] = '\0';
+	for (const struct boot_graph_module *mod = last; mod && used < len;
+	     mod = mod->data->gated_by) {
+		used += snprintf(buf + used, len - used, "%s%s", used ? " <- " : "", mod->name);
+	}
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int boot_graph_wait(const struct boot_graph_module *mod)
+{
+	struct boot_graph_data *data = mod->data;
+	k_spinlock_key_t key;
+	uint32_t mask = 0;
+	uint32_t got;
+	int ret = 0;
+
+	key = k_spin_lock(&lock);
+	data->cycles[BOOT_GRAPH_START] = stamp();
+	k_spin_unlock(&lock, key);
+
+	for (const struct boot_graph_module *const *dep = mod->deps; *dep; dep++) {
+		mask |= (*dep)->data->bit;
+	}
+
+	if (mask && !disabled) {
+		got = k_event_wait_all(&running_events, mask, false,
+				       CONFIG_APP_BOOT_GRAPH_WAIT_TIMEOUT_MS ?
+				       K_MSEC(CONFIG_APP_BOOT_GRAPH_WAIT_TIMEOUT_MS) :
+				       K_FOREVER);
+		if ((got & mask) != mask) {
+			for (const struct boot_graph_module *const *dep = mod->deps; *dep; dep++) {
+				if (!(got & (*dep)->data->bit)) {
+					LOG_WRN("%s: starting without %s", mod->name, (*dep)->name);
+				}
+			}
+			ret = -EAGAIN;
+		}
+	}
+
+	/* The dependency that finished last is the one this module waited for */
+	key = k_spin_lock(&lock);
+	for (const struct boot_graph_module *const *dep = mod->deps; *dep; dep++) {
+		uint32_t t = (*dep)->data->cycles[BOOT_GRAPH_RUNNING];
+
+		if (t && (!data->gated_by ||
+			  (int32_t)(t - data->gated_by->data->cycles[BOOT_GRAPH_RUNNING]) > 0)) {
+			data->gated_by = *dep;
+		}
+	}
+
+	data->cycles[BOOT_GRAPH_READY] = stamp();
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+void boot_graph_mark(const struct boot_graph_module *mod, enum boot_graph_step step)
+{
+	k_spinlock_key_t key;
+
+	if (step >= BOOT_GRAPH_STEP_COUNT) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	if (!mod->data->cycles[step]) {
+		mod->data->cycles[step] = stamp();
+	}
+	k_spin_unlock(&lock, key);
+}
+
+void boot_graph_done(const struct boot_graph_module *mod)
+{
+	struct boot_graph_data *data = mod->data;
+	k_spinlock_key_t key;
+	bool last;
+	char path[96];
+
+	key = k_spin_lock(&lock);
+	if (data->cycles[BOOT_GRAPH_RUNNING]) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+	data->cycles[BOOT_GRAPH_RUNNING] = stamp();
+	last = (++running_count == module_count());
+	if (last) {
+		all_running_cycles = data->cycles[BOOT_GRAPH_RUNNING];
+	}
+	k_spin_unlock(&lock, key);
+
+	k_event_post(&running_events, data->bit);
+
+	LOG_DBG("%s running at %u us", mod->name, boot_graph_us(data->cycles[BOOT_GRAPH_RUNNING]));
+
+	if (last) {
+		critical_path(mod, path, sizeof(path));
+		LOG_INF("All %zu modules running at %u us, critical path: %s", running_count,
+			boot_graph_us(all_running_cycles), path);
+	}
+}
+
+int boot_graph_milestone(const char *name)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int ret = 0;
+
+	for (size_t i = 0; i < milestone_count; i++) {
+		if (strcmp(milestones[i].name, name) == 0) {
+			goto out;
+		}
+	}
+
+	if (milestone_count == ARRAY_SIZE(milestones)) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	milestones[milestone_count].name = name;
+	milestones[milestone_count].cycles = stamp();
+	milestone_count++;
+
+out:
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+uint32_t boot_graph_us(uint32_t cycles)
+{
+	return cycles ? k_cyc_to_us_floor32(cycles) : 0;
+}
+
+void boot_graph_timeline_get(struct boot_graph_timeline *timeline)
+{
+	timeline->kernel_us = boot_graph_us(kernel_cycles);
+	timeline->drivers_us = boot_graph_us(drivers_cycles);
+	timeline->all_running_us = boot_graph_us(all_running_cycles);
+	timeline->modules = module_count();
+	timeline->running = running_count;
+}
+
+void boot_graph_data_get(const struct boot_graph_module *mod, struct boot_graph_data *data)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*data = *mod->data;
+
+	k_spin_unlock(&lock, key);
+}
+
+int boot_graph_milestone_get(size_t idx, const char **name, uint32_t *us)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int ret = -ENOENT;
+
+	if (idx < milestone_count) {
+		*name = milestones[idx].name;
+		*us = boot_graph_us(milestones[idx].cycles);
+		ret = 0;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+/* First POST_KERNEL hook: kernel objects usable, drivers not yet */
+static int boot_graph_init(void)
+{
+	uint32_t visiting = 0;
+	uint32_t done = 0;
+	size_t i = 0;
+
+	kernel_cycles = stamp();
+
+	if (module_count() > 32) {
+		LOG_ERR("%zu modules, at most 32 supported", module_count());
+		disabled = true;
+		return 0;
+	}
+
+	STRUCT_SECTION_FOREACH(boot_graph_module, mod) {
+		mod->data->bit = BIT(i++);
+	}
+
+	STRUCT_SECTION_FOREACH(boot_graph_module, mod) {
+		if (has_cycle(mod, &visiting, &done)) {
+			/* Waiting would deadlock: start everything unordered */
+			disabled = true;
+			break;
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(boot_graph_init, POST_KERNEL, 0);
+
+/* First APPLICATION hook: drivers are up, module threads start next */
+static int boot_graph_drivers_done(void)
+{
+	drivers_cycles = stamp();
+
+	return 0;
+}
+
+SYS_INIT(boot_graph_drivers_done, APPLICATION, 0);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_BOOT_GRAPH_SHELL
+
+/* Microseconds, or "-" for a step not reached */
+static const char *us_str(char *buf, size_t len, uint32_t cycles)
+{
+	if (!cycles) {
+		return "-";
+	}
+
+	snprintf(buf, len, "%u", boot_graph_us(cycles));
+
+	return buf;
+}
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	static const char *const labels[] = { "start", "ready", "init_in", "init_out", "running" };
+	struct boot_graph_timeline timeline;
+	struct boot_graph_data data;
+	char t[BOOT_GRAPH_STEP_COUNT][12];
+	const char *name;
+	uint32_t us;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	boot_graph_timeline_get(&timeline);
+
+	shell_print(sh, "Times in us since the system timer started");
+	shell_print(sh, "%-16s %9u", "kernel", timeline.kernel_us);
+	shell_print(sh, "%-16s %9u", "drivers", timeline.drivers_us);
+
+	shell_print(sh, "%-16s %9s %9s %9s %9s %9s  %s", "module", labels[0], labels[1],
+		    labels[2], labels[3], labels[4], "gated_by");
+
+	STRUCT_SECTION_FOREACH(boot_graph_module, mod) {
+		boot_graph_data_get(mod, &data);
+
+		shell_print(sh, "%-16s %9s %9s %9s %9s %9s  %s", mod->name,
+			    us_str(t[0], sizeof(t[0]), data.cycles[0]),
+			    us_str(t[1], sizeof(t[1]), data.cycles[1]),
+			    us_str(t[2], sizeof(t[2]), data.cycles[2]),
+			    us_str(t[3], sizeof(t[3]), data.cycles[3]),
+			    us_str(t[4], sizeof(t[4]), data.cycles[4]),
+			    data.gated_by ? data.gated_by->name : "-");
+	}
+
+	for (size_t i = 0; boot_graph_milestone_get(i, &name, &us) == 0; i++) {
+		shell_print(sh, "%-16s %9u", name, us);
+	}
+
+	if (timeline.all_running_us) {
+		shell_print(sh, "All %zu modules running at %u us", timeline.modules,
+			    timeline.all_running_us);
+	} else {
+		shell_print(sh, "%zu of %zu modules running", timeline.running, timeline.modules);
+	}
+
+	if (disabled) {
+		shell_print(sh, "Dependencies not enforced (see boot log)");
+	}
+
+	return 0;
+}
+
+static int cmd_deps(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	STRUCT_SECTION_FOREACH(boot_graph_module, mod) {
+		if (!mod->deps[0]) {
+			shell_print(sh, "%s", mod->name);
+			continue;
+		}
+		for (const struct boot_graph_module *const *dep = mod->deps; *dep; dep++) {
+			shell_print(sh, "%s -> %s", mod->name, (*dep)->name);
+		}
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_boot_graph,
+	SHELL_CMD(show, NULL, "Boot timeline per module and milestones", cmd_show),
+	SHELL_CMD(deps, NULL, "Declared dependencies, one edge per line", cmd_deps),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(boot_graph, &sub_boot_graph, "Boot timeline and init dependencies", NULL);
+
+#endif /* CONFIG_APP_BOOT_GRAPH_SHELL */
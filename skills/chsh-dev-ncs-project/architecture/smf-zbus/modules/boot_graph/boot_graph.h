@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _BOOT_GRAPH_H_
+#define _BOOT_GRAPH_H_
+
+/**
+ * @file boot_graph.h
+ * @brief Boot timeline and dependency-declared module initialization
+ *
+ * Every module thread is created at boot, but the order in which modules
+ * become usable is implicit: thread priorities, or init calls placed one
+ * after another in main(). Here each module names the modules it needs,
+ * and its thread waits for exactly those before running its INIT state:
+ *
+ * @code
+ * BOOT_GRAPH_MODULE_DEFINE(webserver);
+ * BOOT_GRAPH_MODULE_DEFINE(wifi, webserver);	// http_resources_init() first
+ *
+ * // Module thread, before smf_set_initial()
+ * boot_graph_wait(BOOT_GRAPH_MODULE(wifi));
+ *
+ * // INIT entry / INIT exit / RUNNING entry
+ * boot_graph_mark(BOOT_GRAPH_MODULE(wifi), BOOT_GRAPH_INIT_ENTRY);
+ * boot_graph_mark(BOOT_GRAPH_MODULE(wifi), BOOT_GRAPH_INIT_EXIT);
+ * boot_graph_done(BOOT_GRAPH_MODULE(wifi));
+ * @endcode
+ *
+ * Modules without a path between them in the graph initialize in
+ * parallel: while one blocks on hardware in its INIT state, the others
+ * run. A misspelled dependency fails at link time, a cycle is reported at
+ * boot and waiting is then skipped.
+ *
+ * Each step is timestamped with k_cycle_get_32() (cycles since the system
+ * timer started, which is close to reset), together with the end of
+ * kernel and driver init and any boot_graph_milestone() such as the first
+ * published sample. "boot_graph show" prints the timeline and, for every
+ * module, the dependency that held it back; the critical path is logged
+ * once the last module is running.
+ *
+ * With CONFIG_APP_SMF_EXECUTOR, module initial states run one after
+ * another on the dispatcher and boot_graph_wait() is not called; marks
+ * and milestones are still recorded.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Steps of one module's start-up, in order */
+enum boot_graph_step {
+	BOOT_GRAPH_START,	/* Thread called boot_graph_wait() */
+	BOOT_GRAPH_READY,	/* All dependencies running */
+	BOOT_GRAPH_INIT_ENTRY,
+	BOOT_GRAPH_INIT_EXIT,
+	BOOT_GRAPH_RUNNING,	/* boot_graph_done() */
+	BOOT_GRAPH_STEP_COUNT,
+};
+
+/** Runtime data of a registered module (RAM) */
+struct boot_graph_data {
+	uint32_t cycles[BOOT_GRAPH_STEP_COUNT];	/* 0 until the step is reached */
+	uint32_t bit;				/* Event bit, set at boot */
+	const struct boot_graph_module *gated_by;	/* Dependency that finished last */
+};
+
+/**
+ * @brief Registered module descriptor (ROM)
+ *
+ * Define one per module with BOOT_GRAPH_MODULE_DEFINE().
+ */
+struct boot_graph_module {
+	const char *name;
+	const struct boot_graph_module *const *deps;	/* NULL terminated */
+	struct boot_graph_data *data;
+};
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_BOOT_GRAPH_DEP_DECLARE(_dep)							\
+	extern const struct boot_graph_module _CONCAT(boot_graph_mod_, _dep)
+/** @endcond */
+
+/** Reference a descriptor defined with BOOT_GRAPH_MODULE_DEFINE() */
+#define BOOT_GRAPH_MODULE(_name) (&_CONCAT(boot_graph_mod_, _name))
+
+/**
+ * @brief Register a module and the modules it depends on
+ *
+ * Dependencies are module names (identifiers) of other
+ * BOOT_GRAPH_MODULE_DEFINE()s, possibly in other files. The descriptor
+ * has external linkage, so each name can be defined only once.
+ *
+ * @param _name Module name (identifier)
+ * @param ... Names of the modules that must be running first, if any
+ */
+#define BOOT_GRAPH_MODULE_DEFINE(_name, ...)						\
+	FOR_EACH_NONEMPTY_TERM(Z_BOOT_GRAPH_DEP_DECLARE, (;), __VA_ARGS__)		\
+	static const struct boot_graph_module *const					\
+		_CONCAT(boot_graph_deps_, _name)[] = {					\
+		FOR_EACH_NONEMPTY_TERM(BOOT_GRAPH_MODULE, (,), __VA_ARGS__)		\
+		NULL									\
+	};										\
+	static struct boot_graph_data _CONCAT(boot_graph_data_, _name);			\
+	const STRUCT_SECTION_ITERABLE(boot_graph_module,				\
+				      _CONCAT(boot_graph_mod_, _name)) = {		\
+		.name = STRINGIFY(_name),						\
+		.deps = _CONCAT(boot_graph_deps_, _name),				\
+		.data = &_CONCAT(boot_graph_data_, _name),				\
+	}
+
+/**
+ * @brief Boot timeline up to now
+ */
+struct boot_graph_timeline {
+	uint32_t kernel_us;	/* Kernel services up (end of PRE_KERNEL init) */
+	uint32_t drivers_us;	/* Drivers up (end of POST_KERNEL init) */
+	uint32_t all_running_us;	/* Last module running, 0 until then */
+	size_t modules;
+	size_t running;
+};
+
+/**
+ * @brief Wait until every dependency of a module is running
+ *
+ * Call from the module thread before smf_set_initial(). Gives up after
+ * CONFIG_APP_BOOT_GRAPH_WAIT_TIMEOUT_MS and logs the missing modules, so
+ * a module stuck in its INIT state cannot stall the whole boot.
+ *
+ * @param mod Module descriptor
+ * @return 0 when all dependencies are running, -EAGAIN on timeout
+ */
+int boot_graph_wait(const struct boot_graph_module *mod);
+
+/**
+ * @brief Timestamp a start-up step of a module
+ *
+ * Only the first time each step is reached counts, so the calls can stay
+ * in entry/exit actions that run again later.
+ *
+ * @param mod Module descriptor
+ * @param step BOOT_GRAPH_INIT_ENTRY or BOOT_GRAPH_INIT_EXIT
+ */
+void boot_graph_mark(const struct boot_graph_module *mod, enum boot_graph_step step);
+
+/**
+ * @brief Declare the module running, releasing the modules that wait on it
+ *
+ * Call from the entry of the module's RUNNING (or first operational)
+ * state. Later calls are ignored.
+ */
+void boot_graph_done(const struct boot_graph_module *mod);
+
+/**
+ * @brief Record an application milestone
+ *
+ * For points such as the first published sample, which is what a
+ * duty-cycled device pays for on every wake from reset. Only the first
+ * call per name counts; names must be string literals.
+ *
+ * @return 0 on success, -ENOMEM when CONFIG_APP_BOOT_GRAPH_MILESTONES
+ *         are already recorded
+ */
+int boot_graph_milestone(const char *name);
+
+/**
+ * @brief Convert a recorded cycle count to microseconds since reset
+ *
+ * @return Microseconds, 0 for a step not reached yet
+ */
+uint32_t boot_graph_us(uint32_t cycles);
+
+/**
+ * @brief Get the boot timeline
+ */
+void boot_graph_timeline_get(struct boot_graph_timeline *timeline);
+
+/**
+ * @brief Get a consistent copy of a module's timestamps and gating dependency
+ *
+ * @param mod Module descriptor
+ * @param data Output copy
+ */
+void boot_graph_data_get(const struct boot_graph_module *mod, struct boot_graph_data *data);
+
+/**
+ * @brief Get a recorded milestone
+ *
+ * @param idx Milestone index, in the order recorded
+ * @param name Output milestone name
+ * @param us Output microseconds since reset
+ * @return 0 on success, -ENOENT when idx is past the last milestone
+ */
+int boot_graph_milestone_get(size_t idx, const char **name, uint32_t *us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BOOT_GRAPH_H_ */
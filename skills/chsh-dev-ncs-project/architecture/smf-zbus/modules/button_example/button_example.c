@@ -9,7 +9,7 @@
  * @brief Button module using SMF + zbus pattern
  * 
  * This module demonstrates:
- * - Button event detection (short/long press)
+ * - Button event detection (short/long press) without blocking handlers
  * - SMF state machine for button handling
  * - zbus channel publishing
  * - Task watchdog integration
@@ -25,6 +25,33 @@
 #include <dk_buttons_and_leds.h>
 
 #include "button_example.h"
+#include "zbus_latest.h"
+
+#include "app_stats.h"
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+#include "zbus_trace.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_TRACE
+#include "smf_trace.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_EXECUTOR
+#include "smf_executor.h"
+#endif
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+#include "wdt_supervisor.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_IDLE
+#include "smf_idle.h"
+#endif
+
+#ifdef CONFIG_APP_BOOT_GRAPH
+#include "boot_graph.h"
+#endif
 
 LOG_MODULE_REGISTER(button_example, CONFIG_APP_BUTTON_LOG_LEVEL);
 
@@ -44,11 +71,36 @@ ZBUS_CHAN_DEFINE(BUTTON_CHAN,
 		 ZBUS_MSG_INIT(.type = BUTTON_IDLE)
 );
 
+#ifdef CONFIG_APP_ZBUS_TRACE
+ZBUS_TRACE_CHAN_DEFINE(BUTTON_CHAN, struct button_msg);
+#endif
+
+/* Button edges and long-press timer expiry, published from IRQ context */
+enum button_hw_event {
+	BUTTON_HW_PRESSED = 0x1,
+	BUTTON_HW_RELEASED,
+	BUTTON_HW_LONG_PRESS,
+};
+
+struct button_hw_msg {
+	enum button_hw_event event;
+};
+
+/* Private channel: turns interrupts into messages for the state machine */
+ZBUS_CHAN_DEFINE(BUTTON_HW_CHAN,
+		 struct button_hw_msg,
+		 NULL,
+		 NULL,
+		 ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0)
+);
+
 /* Register as zbus subscriber */
 ZBUS_MSG_SUBSCRIBER_DEFINE(button);
 
-/* Observe button channel for internal messages */
-ZBUS_CHAN_ADD_OBS(BUTTON_CHAN, button, 0);
+/* Observe button channel for internal messages; BUTTON_IDLE updates coalesce */
+ZBUS_LATEST_CHAN_ADD_OBS_IF(BUTTON_CHAN, button, 0, button_msg_is_idle);
+ZBUS_CHAN_ADD_OBS(BUTTON_HW_CHAN, button, 0);
 
 /*******************************************************************************
  * State Machine States
@@ -65,7 +117,7 @@ enum button_state {
 struct button_state_object {
 	struct smf_ctx ctx;
 	const struct zbus_channel *chan;
-	uint8_t msg_buf[sizeof(struct button_msg)];
+	uint8_t msg_buf[MAX(sizeof(struct button_msg), sizeof(struct button_hw_msg))];
 	uint32_t pressed_buttons;
 	int wdt_id;
 };
@@ -75,10 +127,13 @@ static void state_init_entry(void *obj);
 static enum smf_state_result state_init_run(void *obj);
 static void state_idle_entry(void *obj);
 static enum smf_state_result state_idle_run(void *obj);
+static void state_idle_exit(void *obj);
 static void state_pressed_entry(void *obj);
 static enum smf_state_result state_pressed_run(void *obj);
+static void state_pressed_exit(void *obj);
 static void state_long_press_pending_entry(void *obj);
 static enum smf_state_result state_long_press_pending_run(void *obj);
+static void button_handler(uint32_t button_states, uint32_t has_changed);
 
 /* State definitions */
 static const struct smf_state states[] = {
@@ -92,16 +147,16 @@ static const struct smf_state states[] = {
 	[STATE_IDLE] = SMF_CREATE_STATE(
 		state_idle_entry,
 		state_idle_run,
-		NULL,
+		state_idle_exit,
 		NULL,
 		NULL  /* No initial transition */
 	),
 	[STATE_PRESSED] = SMF_CREATE_STATE(
 		state_pressed_entry,
 		state_pressed_run,
+		state_pressed_exit,
 		NULL,
-		NULL,
-		&states[STATE_LONG_PRESS_PENDING]  /* Transition to long press check */
+		NULL  /* Long press timer moves on to LONG_PRESS_PENDING */
 	),
 	[STATE_LONG_PRESS_PENDING] = SMF_CREATE_STATE(
 		state_long_press_pending_entry,
@@ -112,8 +167,42 @@ static const struct smf_state states[] = {
 	),
 };
 
+#ifdef CONFIG_APP_SMF_TRACE
+SMF_TRACE_MODULE_DEFINE(button, states,
+			"INIT", "IDLE", "PRESSED", "LONG_PRESS_PENDING");
+#endif
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+/* Heartbeat on the shared supervisor instead of an own task_wdt channel */
+WDT_SUPERVISOR_MODULE_DEFINE(button, CONFIG_APP_BUTTON_WATCHDOG_TIMEOUT_SECONDS * 1000);
+#endif
+
+#ifdef CONFIG_APP_SMF_IDLE
+/*
+ * No timeout while IDLE, presses arrive as BUTTON_HW_CHAN messages. An own
+ * task_wdt channel still has to be fed, so without the supervisor wake up
+ * at half the watchdog timeout.
+ */
+SMF_IDLE_MODULE_DEFINE(button, IS_ENABLED(CONFIG_APP_WDT_SUPERVISOR) ? 0 :
+		       CONFIG_APP_BUTTON_WATCHDOG_TIMEOUT_SECONDS * 500);
+#endif
+
+#ifdef CONFIG_APP_BOOT_GRAPH
+/* No dependencies: starts as soon as its thread runs */
+BOOT_GRAPH_MODULE_DEFINE(button);
+#endif
+
 static struct button_state_object state_obj;
 
+static void long_press_expiry(struct k_timer *timer);
+
+/* Started on press; a release before expiry is a short press */
+static K_TIMER_DEFINE(long_press_timer, long_press_expiry, NULL);
+
+APP_STATS_COUNTER_DEFINE(button, short_presses);
+APP_STATS_COUNTER_DEFINE(button, long_presses);
+APP_STATS_COUNTER_DEFINE(button, errors);
+
 /*******************************************************************************
  * Helper Functions
  ******************************************************************************/
@@ -128,10 +217,46 @@ static void publish_button_msg(enum button_msg_type type, uint8_t button_number)
 
 	LOG_DBG("Publishing button event: type=%d, button=%d", type, button_number);
 
+#ifdef CONFIG_APP_ZBUS_TRACE
+	zbus_trace_stamp(&BUTTON_CHAN, &msg);
+#endif
+
 	err = zbus_chan_pub(&BUTTON_CHAN, &msg, K_SECONDS(1));
 	if (err) {
 		LOG_ERR("zbus_chan_pub failed: %d", err);
+		APP_STATS_INC(button, errors);
+		return;
 	}
+
+	if (type == BUTTON_PRESS_LONG) {
+		APP_STATS_INC(button, long_presses);
+	} else {
+		APP_STATS_INC(button, short_presses);
+	}
+}
+
+/* Called from IRQ context, must not block */
+static void publish_hw_event(enum button_hw_event event)
+{
+	struct button_hw_msg msg = {
+		.event = event,
+	};
+	int err;
+
+	err = zbus_chan_pub(&BUTTON_HW_CHAN, &msg, K_NO_WAIT);
+	if (err) {
+		APP_STATS_INC(button, errors);
+	}
+}
+
+/* Hardware event in the current message, 0 for anything else */
+static enum button_hw_event hw_event_get(const struct button_state_object *state)
+{
+	if (state->chan != &BUTTON_HW_CHAN) {
+		return 0;
+	}
+
+	return ((const struct button_hw_msg *)state->msg_buf)->event;
 }
 
 /*******************************************************************************
@@ -142,16 +267,22 @@ static void state_init_entry(void *obj)
 {
 	struct button_state_object *state = obj;
 
+#ifdef CONFIG_APP_BOOT_GRAPH
+	boot_graph_mark(BOOT_GRAPH_MODULE(button), BOOT_GRAPH_INIT_ENTRY);
+#endif
+
 	LOG_INF("Button module initializing");
 
-	/* Initialize button hardware */
-	int err = dk_buttons_init(NULL);  /* Button handler in module thread */
+	/* Initialize button hardware, the handler only publishes messages */
+	int err = dk_buttons_init(button_handler);
 	if (err) {
 		LOG_ERR("dk_buttons_init failed: %d", err);
 		return;
 	}
 
-#ifdef CONFIG_TASK_WDT
+/* With the executor, its workers own the task_wdt channels */
+#if defined(CONFIG_TASK_WDT) && !defined(CONFIG_APP_WDT_SUPERVISOR) &&	\
+	!defined(CONFIG_APP_SMF_EXECUTOR)
 	/* Register with watchdog */
 	state->wdt_id = task_wdt_add(
 		CONFIG_APP_BUTTON_WATCHDOG_TIMEOUT_SECONDS * 1000,
@@ -176,68 +307,89 @@ static void state_idle_entry(void *obj)
 {
 	LOG_DBG("Button idle");
 	publish_button_msg(BUTTON_IDLE, 0);
+
+#ifdef CONFIG_APP_BOOT_GRAPH
+	/* INIT hands over to IDLE directly; later IDLE entries are ignored */
+	boot_graph_mark(BOOT_GRAPH_MODULE(button), BOOT_GRAPH_INIT_EXIT);
+	boot_graph_done(BOOT_GRAPH_MODULE(button));
+#endif
+
+#ifdef CONFIG_APP_SMF_IDLE
+	/* Presses arrive as messages, which wake the module */
+	smf_idle_enter(SMF_IDLE_MODULE(button));
+#endif
 }
 
 static enum smf_state_result state_idle_run(void *obj)
 {
 	struct button_state_object *state = obj;
 
-	/* Feed watchdog */
-#ifdef CONFIG_TASK_WDT
-	if (state->wdt_id >= 0) {
-		task_wdt_feed(state->wdt_id);
+	if (hw_event_get(state) == BUTTON_HW_PRESSED) {
+		smf_set_state(SMF_CTX(state), &states[STATE_PRESSED]);
+		return SMF_STATE_TRANSITION();
 	}
-#endif
 
-	/* Wait for messages - handled by module thread */
 	return SMF_STATE_HANDLED();
 }
 
+static void state_idle_exit(void *obj)
+{
+	ARG_UNUSED(obj);
+
+#ifdef CONFIG_APP_SMF_IDLE
+	smf_idle_exit(SMF_IDLE_MODULE(button));
+#endif
+}
+
 static void state_pressed_entry(void *obj)
 {
 	LOG_DBG("Button pressed");
+
+	k_timer_start(&long_press_timer, K_MSEC(LONG_PRESS_TIMEOUT_MS), K_NO_WAIT);
 }
 
 static enum smf_state_result state_pressed_run(void *obj)
 {
 	struct button_state_object *state = obj;
 
-	/* Check if button still pressed after delay */
-	if (state->pressed_buttons == 0) {
-		/* Button released - short press */
+	switch (hw_event_get(state)) {
+	case BUTTON_HW_RELEASED:
+		/* Released before the long press timer - short press */
 		publish_button_msg(BUTTON_PRESS_SHORT, 1);
 		smf_set_state(SMF_CTX(state), &states[STATE_IDLE]);
 		return SMF_STATE_TRANSITION();
+	case BUTTON_HW_LONG_PRESS:
+		publish_button_msg(BUTTON_PRESS_LONG, 1);
+		smf_set_state(SMF_CTX(state), &states[STATE_LONG_PRESS_PENDING]);
+		return SMF_STATE_TRANSITION();
+	default:
+		return SMF_STATE_HANDLED();
 	}
+}
 
-	/* Still pressed - check for long press */
-	return SMF_STATE_HANDLED();
+static void state_pressed_exit(void *obj)
+{
+	ARG_UNUSED(obj);
+
+	k_timer_stop(&long_press_timer);
 }
 
 static void state_long_press_pending_entry(void *obj)
 {
-	LOG_DBG("Checking for long press");
+	LOG_DBG("Long press, waiting for release");
 }
 
 static enum smf_state_result state_long_press_pending_run(void *obj)
 {
 	struct button_state_object *state = obj;
 
-	/* Wait for long press timeout */
-	k_sleep(K_MSEC(LONG_PRESS_TIMEOUT_MS));
-
-	if (state->pressed_buttons != 0) {
-		/* Still pressed after timeout - long press */
-		publish_button_msg(BUTTON_PRESS_LONG, 1);
-	}
-
-	/* Wait for button release */
-	while (state->pressed_buttons != 0) {
-		k_sleep(K_MSEC(100));
+	/* The release interrupt publishes a message, no need to poll */
+	if (hw_event_get(state) == BUTTON_HW_RELEASED) {
+		smf_set_state(SMF_CTX(state), &states[STATE_IDLE]);
+		return SMF_STATE_TRANSITION();
 	}
 
-	smf_set_state(SMF_CTX(state), &states[STATE_IDLE]);
-	return SMF_STATE_TRANSITION();
+	return SMF_STATE_HANDLED();
 }
 
 /*******************************************************************************
@@ -250,22 +402,51 @@ static void button_handler(uint32_t button_states, uint32_t has_changed)
 		return;
 	}
 
+	/* Only publish: the state machine runs in the module's own context */
 	if (button_states & DK_BTN1_MSK) {
-		/* Button pressed */
 		state_obj.pressed_buttons = DK_BTN1_MSK;
-		
-		/* Trigger state machine transition */
-		smf_set_state(SMF_CTX(&state_obj), &states[STATE_PRESSED]);
+		publish_hw_event(BUTTON_HW_PRESSED);
 	} else {
-		/* Button released */
 		state_obj.pressed_buttons = 0;
+		publish_hw_event(BUTTON_HW_RELEASED);
 	}
 }
 
+static void long_press_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	publish_hw_event(BUTTON_HW_LONG_PRESS);
+}
+
 /*******************************************************************************
  * Module Thread
  ******************************************************************************/
 
+#ifdef CONFIG_APP_SMF_EXECUTOR
+
+/* No thread of its own: run on the shared executor */
+SMF_EXECUTOR_MODULE_DEFINE(button, button, state_obj, &states[STATE_INIT],
+			   CONFIG_APP_BUTTON_MSG_PROCESSING_TIMEOUT_SECONDS * 1000,
+			   NULL);
+
+#else
+
+/* Once per loop iteration, whatever state the module is in */
+static void feed_watchdog(struct button_state_object *state)
+{
+#if defined(CONFIG_APP_WDT_SUPERVISOR)
+	ARG_UNUSED(state);
+	wdt_supervisor_feed(WDT_SUPERVISOR_MODULE(button));
+#elif defined(CONFIG_TASK_WDT)
+	if (state->wdt_id >= 0) {
+		task_wdt_feed(state->wdt_id);
+	}
+#else
+	ARG_UNUSED(state);
+#endif
+}
+
 static void button_thread(void *p1, void *p2, void *p3)
 {
 	ARG_UNUSED(p1);
@@ -274,31 +455,66 @@ static void button_thread(void *p1, void *p2, void *p3)
 
 	LOG_INF("Button module thread started");
 
+#ifdef CONFIG_APP_BOOT_GRAPH
+	/* Start only once the modules we depend on are running */
+	boot_graph_wait(BOOT_GRAPH_MODULE(button));
+#endif
+
 	/* Initialize state machine */
 	smf_set_initial(SMF_CTX(&state_obj), &states[STATE_INIT]);
 
-	/* Set up button handler */
-	dk_buttons_init(button_handler);
+#ifdef CONFIG_APP_SMF_TRACE
+	smf_trace_record(SMF_TRACE_MODULE(button), NULL,
+			 SMF_CTX(&state_obj)->current, NULL);
+#endif
 
 	/* Run state machine */
 	while (1) {
+		feed_watchdog(&state_obj);
+
 		/* Wait for zbus messages */
+#ifdef CONFIG_APP_SMF_IDLE
+		/* Same as below, but without the timeout while IDLE */
+		int err = smf_idle_wait_msg(SMF_IDLE_MODULE(button), &button, &state_obj.chan,
+					    state_obj.msg_buf,
+					    CONFIG_APP_BUTTON_MSG_PROCESSING_TIMEOUT_SECONDS * 1000);
+#else
 		int err = zbus_sub_wait_msg(&button, &state_obj.chan,
 					    state_obj.msg_buf,
 					    K_MSEC(CONFIG_APP_BUTTON_MSG_PROCESSING_TIMEOUT_SECONDS * 1000));
+#endif
 
 		if (err == -EAGAIN || err == -ENOMSG) {
-			/* Timeout - run state machine anyway */
+			/* Timeout or kick: run without a message, not the last one again */
+			state_obj.chan = NULL;
 		} else if (err) {
 			LOG_ERR("zbus_sub_wait_msg failed: %d", err);
 			continue;
+		} else {
+			/* Latest value of a coalesced status channel */
+			zbus_latest_received(&button, state_obj.chan, state_obj.msg_buf);
+		}
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+		if (err == 0) {
+			zbus_trace_dispatch(&button, state_obj.chan, state_obj.msg_buf);
 		}
+#endif
+
+#ifdef CONFIG_APP_SMF_TRACE
+		const struct smf_state *prev = SMF_CTX(&state_obj)->current;
+#endif
 
 		/* Run state machine */
 		int32_t ret = smf_run_state(SMF_CTX(&state_obj));
 		if (ret) {
 			LOG_ERR("smf_run_state failed: %d", ret);
 		}
+
+#ifdef CONFIG_APP_SMF_TRACE
+		smf_trace_record(SMF_TRACE_MODULE(button), prev,
+				 SMF_CTX(&state_obj)->current, state_obj.chan);
+#endif
 	}
 }
 
@@ -308,3 +524,5 @@ K_THREAD_DEFINE(button_module,
 		NULL, NULL, NULL,
 		CONFIG_APP_BUTTON_PRIORITY,
 		0, 0);
+
+#endif /* CONFIG_APP_SMF_EXECUTOR */
@@ -39,6 +39,10 @@ enum button_msg_type {
 struct button_msg {
 	enum button_msg_type type;
 	uint8_t button_number;
+#ifdef CONFIG_APP_ZBUS_TRACE
+	/** Publish timestamp in cycles, set by zbus_trace_stamp() */
+	uint32_t trace_cycles;
+#endif
 };
 
 /**
@@ -46,6 +50,17 @@ struct button_msg {
  */
 #define MSG_TO_BUTTON_MSG(_msg) (*(const struct button_msg *)_msg)
 
+/**
+ * @brief Check for a status message, which only the latest value of matters
+ *
+ * Filter for ZBUS_LATEST_CHAN_ADD_OBS_IF(): BUTTON_IDLE updates coalesce,
+ * presses are all delivered.
+ */
+static inline bool button_msg_is_idle(const void *msg)
+{
+	return MSG_TO_BUTTON_MSG(msg).type == BUTTON_IDLE;
+}
+
 /**
  * @brief Button channel declaration
  * 
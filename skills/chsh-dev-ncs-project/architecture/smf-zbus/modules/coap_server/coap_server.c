@@ -0,0 +1,914 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file coap_server.c
+ * @brief CoAP server exposing zbus channels as observable resources
+ *
+ * This module demonstrates:
+ * - Building the CoAP resource table at boot from link-time bindings
+ * - Turning channel publishes into rate-limited, coalesced Observe
+ *   notifications without touching the publishing thread's stack
+ * - Serving large representations block-wise from one static buffer
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/zvfs/eventfd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coap_server.h"
+
+#ifdef CONFIG_APP_COAP_SERVER_DTLS
+#include <zephyr/net/tls_credentials.h>
+#endif
+
+LOG_MODULE_REGISTER(coap_server, CONFIG_APP_COAP_SERVER_LOG_LEVEL);
+
+#define MAX_RESOURCES CONFIG_APP_COAP_SERVER_RESOURCES
+#define MAX_OBSERVERS CONFIG_APP_COAP_SERVER_OBSERVERS
+#define BLOCK_BYTES CONFIG_APP_COAP_SERVER_BLOCK_SIZE
+#define BLOCK_SZX ((enum coap_block_size)(LOG2(BLOCK_BYTES) - 4))
+
+BUILD_ASSERT(IS_POWER_OF_TWO(BLOCK_BYTES) && BLOCK_BYTES >= 16 && BLOCK_BYTES <= 1024,
+	     "CoAP block size must be a power of two from 16 to 1024");
+
+/* Header, token and options in front of one block */
+#define PDU_SIZE (BLOCK_BYTES + 64)
+
+#define OBSERVE_SEQ_MASK 0xFFFFFF
+#define BLOCK2_MORE(v) (((v) & 0x08) != 0)
+
+/* Per resource; shared with the listener, so under the lock */
+struct res_state {
+	bool dirty;		/* Published since the last notification */
+	int64_t last_notify;
+	uint32_t seq;		/* Observe sequence number */
+	struct coap_server_resource_stats stats;
+};
+
+/* Per observer, next to the library's struct coap_observer */
+struct obs_ext {
+	struct coap_resource *res;	/* NULL: slot free */
+	uint16_t last_id;		/* Message ID of the last notification */
+	bool con_pending;		/* Confirmable notification not acknowledged yet */
+	uint32_t sent;
+};
+
+/* .well-known/core first, one per binding, then the terminator */
+static struct coap_resource resources[1 + MAX_RESOURCES + 1];
+static const char *paths[MAX_RESOURCES][2];
+static size_t res_count;
+
+static struct res_state states[MAX_RESOURCES];
+static struct k_spinlock lock;
+
+/* Server thread only */
+static struct coap_observer observers[MAX_OBSERVERS];
+static struct obs_ext obs_ext[MAX_OBSERVERS];
+static uint8_t payload[CONFIG_APP_COAP_SERVER_PAYLOAD_MAX];
+static size_t payload_len;
+static uint32_t payload_etag;
+static uint8_t pdu[PDU_SIZE];
+static int sock = -1;
+
+static int wake_fd = -1;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static void wake(void)
+{
+	if (wake_fd >= 0) {
+		(void)zvfs_eventfd_write(wake_fd, 1);
+	}
+}
+
+static size_t res_index(const struct coap_resource *res)
+{
+	return res - &resources[1];
+}
+
+static const struct coap_server_binding *binding_get(size_t idx)
+{
+	struct coap_server_binding *b;
+
+	STRUCT_SECTION_GET(coap_server_binding, idx, &b);
+
+	return b;
+}
+
+static bool addr_equal(const struct sockaddr *a, const struct sockaddr *b)
+{
+	const struct sockaddr_in *a4 = (const struct sockaddr_in *)a;
+	const struct sockaddr_in *b4 = (const struct sockaddr_in *)b;
+
+	return a4->sin_family == b4->sin_family && a4->sin_port == b4->sin_port &&
+	       a4->sin_addr.s_addr == b4->sin_addr.s_addr;
+}
+
+/* FNV-1a: cheap, and all an ETag needs is to change with the content */
+static uint32_t etag_of(const uint8_t *data, size_t len)
+{
+	uint32_t h = 2166136261u;
+
+	for (size_t i = 0; i < len; i++) {
+		h = (h ^ data[i]) * 16777619u;
+	}
+
+	return h;
+}
+
+/* Encode the channel's current message into the payload buffer */
+static int encode(size_t idx)
+{
+	const struct coap_server_binding *b = binding_get(idx);
+	int len;
+	int err;
+
+	err = zbus_chan_claim(b->chan, K_MSEC(100));
+	if (err) {
+		return err;
+	}
+	len = b->encode(zbus_chan_const_msg(b->chan), (char *)payload, sizeof(payload));
+	zbus_chan_finish(b->chan);
+
+	if (len < 0) {
+		return len;
+	}
+	if ((size_t)len >= sizeof(payload)) {
+		LOG_WRN("%s: %d bytes do not fit in PAYLOAD_MAX", b->path, len);
+		return -EMSGSIZE;
+	}
+
+	payload_len = len;
+	payload_etag = etag_of(payload, len);
+
+	K_SPINLOCK(&lock) {
+		states[idx].stats.size = len;
+	}
+
+	return 0;
+}
+
+static int send_pkt(const struct coap_packet *pkt, const struct sockaddr *addr)
+{
+	if (zsock_sendto(sock, pkt->data, pkt->offset, 0, addr, sizeof(struct sockaddr_in)) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+static int send_code(const struct sockaddr *addr, uint8_t type, uint16_t id,
+		     const uint8_t *token, uint8_t tkl, uint8_t code)
+{
+	struct coap_packet rsp;
+	int err;
+
+	err = coap_packet_init(&rsp, pdu, sizeof(pdu), COAP_VERSION_1, type, tkl, token, code, id);
+	if (err) {
+		return err;
+	}
+
+	return send_pkt(&rsp, addr);
+}
+
+/*
+ * The encoded representation, or one block of it: the block a GET asks
+ * for, or the first one in a notification (request NULL).
+ */
+static int send_content(size_t idx, const struct sockaddr *addr, uint8_t type, uint16_t id,
+			const uint8_t *token, uint8_t tkl, int observe,
+			const struct coap_packet *request)
+{
+	const struct coap_server_binding *b = binding_get(idx);
+	struct coap_block_context blk;
+	struct coap_packet rsp;
+	size_t off = 0;
+	size_t chunk = payload_len;
+	bool block;
+	int err;
+
+	block = payload_len > BLOCK_BYTES ||
+		(request && coap_get_option_int(request, COAP_OPTION_BLOCK2) >= 0);
+	if (block) {
+		coap_block_transfer_init(&blk, BLOCK_SZX, payload_len);
+		if (request) {
+			coap_update_from_block(request, &blk);
+			/* Never more than our PDU holds; the offset stays block aligned */
+			blk.block_size = MIN(blk.block_size, BLOCK_SZX);
+		}
+		off = blk.current;
+		if (off > 0 && off >= payload_len) {
+			return send_code(addr, type, id, token, tkl, COAP_RESPONSE_CODE_BAD_OPTION);
+		}
+		chunk = MIN(coap_block_size_to_bytes(blk.block_size), payload_len - off);
+
+		K_SPINLOCK(&lock) {
+			states[idx].stats.blocks++;
+		}
+	}
+
+	/* Options in ascending number: ETag, Observe, Content-Format, Block2, Size2 */
+	err = coap_packet_init(&rsp, pdu, sizeof(pdu), COAP_VERSION_1, type, tkl, token,
+			       COAP_RESPONSE_CODE_CONTENT, id);
+	if (!err) {
+		err = coap_packet_append_option(&rsp, COAP_OPTION_ETAG, (uint8_t *)&payload_etag,
+						sizeof(payload_etag));
+	}
+	if (!err && observe >= 0) {
+		err = coap_append_option_int(&rsp, COAP_OPTION_OBSERVE, observe);
+	}
+	if (!err) {
+		err = coap_append_option_int(&rsp, COAP_OPTION_CONTENT_FORMAT, b->format);
+	}
+	if (!err && block) {
+		err = coap_append_block2_option(&rsp, &blk);
+		if (!err) {
+			err = coap_append_option_int(&rsp, COAP_OPTION_SIZE2, payload_len);
+		}
+	}
+	if (!err && chunk) {
+		err = coap_packet_append_payload_marker(&rsp);
+		if (!err) {
+			err = coap_packet_append_payload(&rsp, &payload[off], chunk);
+		}
+	}
+	if (err) {
+		LOG_ERR("%s: building response failed: %d", b->path, err);
+		return err;
+	}
+
+	return send_pkt(&rsp, addr);
+}
+
+static void observer_remove(size_t i)
+{
+	size_t idx = res_index(obs_ext[i].res);
+
+	coap_remove_observer(obs_ext[i].res, &observers[i]);
+
+	K_SPINLOCK(&lock) {
+		states[idx].stats.observers--;
+	}
+
+	LOG_DBG("%s: observer %zu removed", binding_get(idx)->path, i);
+
+	memset(&observers[i], 0, sizeof(observers[i]));
+	memset(&obs_ext[i], 0, sizeof(obs_ext[i]));
+}
+
+static int observer_find(const struct coap_resource *res, const struct sockaddr *addr)
+{
+	for (size_t i = 0; i < MAX_OBSERVERS; i++) {
+		if (obs_ext[i].res == res && addr_equal(&observers[i].addr, addr)) {
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+static int observer_add(struct coap_resource *res, const struct coap_packet *request,
+			const struct sockaddr *addr)
+{
+	int i = observer_find(res, addr);
+
+	/* A client registering again replaces its earlier registration */
+	if (i >= 0) {
+		observer_remove(i);
+	}
+
+	for (i = 0; i < MAX_OBSERVERS; i++) {
+		if (!obs_ext[i].res) {
+			break;
+		}
+	}
+	if (i == MAX_OBSERVERS) {
+		return -ENOMEM;
+	}
+
+	coap_observer_init(&observers[i], request, addr);
+	coap_register_observer(res, &observers[i]);
+	obs_ext[i].res = res;
+
+	K_SPINLOCK(&lock) {
+		states[res_index(res)].stats.observers++;
+	}
+
+	return 0;
+}
+
+static int resource_get(struct coap_resource *resource, struct coap_packet *request,
+			struct sockaddr *addr, socklen_t addr_len)
+{
+	size_t idx = res_index(resource);
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t tkl = coap_header_get_token(request, token);
+	uint16_t id = coap_header_get_id(request);
+	uint8_t type = coap_header_get_type(request);
+	int observe = coap_get_option_int(request, COAP_OPTION_OBSERVE);
+	int block2 = coap_get_option_int(request, COAP_OPTION_BLOCK2);
+	int seq = -1;
+	int i;
+
+	ARG_UNUSED(addr_len);
+
+	/* Piggybacked on the ACK of a confirmable request */
+	if (type == COAP_TYPE_CON) {
+		type = COAP_TYPE_ACK;
+	} else {
+		type = COAP_TYPE_NON_CON;
+		id = coap_next_id();
+	}
+
+	K_SPINLOCK(&lock) {
+		states[idx].stats.gets++;
+	}
+
+	/* Block2 continuations of a notification carry no registration */
+	if (observe == 0 && block2 <= 0) {
+		if (observer_add(resource, request, addr) == 0) {
+			K_SPINLOCK(&lock) {
+				seq = states[idx].seq;
+			}
+		} else {
+			LOG_WRN("%s: no room for another observer", binding_get(idx)->path);
+		}
+	} else if (observe == 1) {
+		i = observer_find(resource, addr);
+		if (i >= 0) {
+			observer_remove(i);
+		}
+	}
+
+	if (encode(idx)) {
+		return send_code(addr, type, id, token, tkl, COAP_RESPONSE_CODE_INTERNAL_ERROR);
+	}
+
+	return send_content(idx, addr, type, id, token, tkl, seq, request);
+}
+
+static int well_known_get(struct coap_resource *resource, struct coap_packet *request,
+			  struct sockaddr *addr, socklen_t addr_len)
+{
+	struct coap_packet rsp;
+	int err;
+
+	ARG_UNUSED(addr_len);
+
+	err = coap_well_known_core_get(resource, request, &rsp, pdu, sizeof(pdu));
+	if (err) {
+		return err;
+	}
+
+	return send_pkt(&rsp, addr);
+}
+
+static void resources_init(void)
+{
+	size_t n;
+
+	STRUCT_SECTION_COUNT(coap_server_binding, &n);
+	if (n > MAX_RESOURCES) {
+		LOG_ERR("%zu bound channels, only the first %d are served", n, MAX_RESOURCES);
+		n = MAX_RESOURCES;
+	}
+
+	resources[0] = (struct coap_resource){
+		.get = well_known_get,
+		.path = COAP_WELL_KNOWN_CORE_PATH,
+	};
+
+	for (size_t i = 0; i < n; i++) {
+		paths[i][0] = binding_get(i)->path;
+		paths[i][1] = NULL;
+		resources[1 + i] = (struct coap_resource){
+			.get = resource_get,
+			.path = paths[i],
+		};
+		states[i].stats.path = paths[i][0];
+	}
+
+	res_count = n;
+}
+
+/* Empty ACK or RST from a client: match it to a notification we sent */
+static void handle_reply(uint8_t type, uint16_t id, const struct sockaddr *addr)
+{
+	for (size_t i = 0; i < MAX_OBSERVERS; i++) {
+		if (!obs_ext[i].res || obs_ext[i].last_id != id ||
+		    !addr_equal(&observers[i].addr, addr)) {
+			continue;
+		}
+		if (type == COAP_TYPE_RESET) {
+			/* The client forgot the observation */
+			observer_remove(i);
+		} else {
+			obs_ext[i].con_pending = false;
+		}
+		return;
+	}
+}
+
+static void handle_packet(uint8_t *buf, size_t len, struct sockaddr *addr)
+{
+	struct coap_option options[16];
+	struct coap_packet req;
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t tkl;
+	uint8_t type;
+	uint8_t code;
+	int err;
+
+	err = coap_packet_parse(&req, buf, len, options, ARRAY_SIZE(options));
+	if (err) {
+		LOG_DBG("Malformed packet: %d", err);
+		return;
+	}
+
+	type = coap_header_get_type(&req);
+	code = coap_header_get_code(&req);
+
+	if (code == COAP_CODE_EMPTY) {
+		if (type == COAP_TYPE_ACK || type == COAP_TYPE_RESET) {
+			handle_reply(type, coap_header_get_id(&req), addr);
+		}
+		return;
+	}
+
+	err = coap_handle_request(&req, resources, options, ARRAY_SIZE(options), addr,
+				  sizeof(struct sockaddr_in));
+	if (err >= 0) {
+		return;
+	}
+
+	tkl = coap_header_get_token(&req, token);
+	send_code(addr, type == COAP_TYPE_CON ? COAP_TYPE_ACK : COAP_TYPE_NON_CON,
+		  type == COAP_TYPE_CON ? coap_header_get_id(&req) : coap_next_id(), token, tkl,
+		  err == -ENOENT ? COAP_RESPONSE_CODE_NOT_FOUND : COAP_RESPONSE_CODE_NOT_ALLOWED);
+}
+
+static void notify(size_t idx, uint32_t seq)
+{
+	struct coap_resource *res = &resources[1 + idx];
+	uint8_t type;
+	uint32_t sent = 0;
+
+	if (encode(idx) || payload_len == 0) {
+		return;
+	}
+
+	for (size_t i = 0; i < MAX_OBSERVERS; i++) {
+		if (obs_ext[i].res != res) {
+			continue;
+		}
+
+		type = COAP_TYPE_NON_CON;
+		if (++obs_ext[i].sent % CONFIG_APP_COAP_SERVER_CON_EVERY == 0) {
+			if (obs_ext[i].con_pending) {
+				LOG_INF("%s: observer %zu stopped acknowledging",
+					binding_get(idx)->path, i);
+				observer_remove(i);
+				continue;
+			}
+			type = COAP_TYPE_CON;
+		}
+
+		obs_ext[i].last_id = coap_next_id();
+		obs_ext[i].con_pending = (type == COAP_TYPE_CON);
+
+		if (send_content(idx, &observers[i].addr, type, obs_ext[i].last_id,
+				 observers[i].token, observers[i].tkl, seq, NULL) == 0) {
+			sent++;
+		}
+	}
+
+	K_SPINLOCK(&lock) {
+		states[idx].stats.notifications += sent;
+	}
+}
+
+/* Notify every resource whose interval has passed; returns the poll timeout */
+static int notify_due(void)
+{
+	int64_t now = k_uptime_get();
+	int64_t next = INT64_MAX;
+	uint32_t seq = 0;
+	bool due;
+
+	for (size_t idx = 0; idx < res_count; idx++) {
+		due = false;
+
+		K_SPINLOCK(&lock) {
+			struct res_state *st = &states[idx];
+			int64_t at = st->last_notify + CONFIG_APP_COAP_SERVER_NOTIFY_MIN_MS;
+
+			if (!st->dirty) {
+				/* Nothing to send */
+			} else if (now >= at) {
+				st->dirty = false;
+				st->last_notify = now;
+				st->seq = (st->seq + 1) & OBSERVE_SEQ_MASK;
+				seq = st->seq;
+				due = true;
+			} else {
+				next = MIN(next, at);
+			}
+		}
+
+		if (due) {
+			notify(idx, seq);
+		}
+	}
+
+	return (next == INT64_MAX) ? -1 : (int)(next - now);
+}
+
+static void listener_cb(const struct zbus_channel *chan)
+{
+	size_t idx = 0;
+
+	STRUCT_SECTION_FOREACH(coap_server_binding, b) {
+		if (idx >= res_count) {
+			return;
+		}
+		if (b->chan != chan) {
+			idx++;
+			continue;
+		}
+
+		K_SPINLOCK(&lock) {
+			struct res_state *st = &states[idx];
+
+			st->stats.updates++;
+			if (st->stats.observers) {
+				st->stats.coalesced += st->dirty ? 1 : 0;
+				st->dirty = true;
+			}
+		}
+		wake();
+		return;
+	}
+}
+
+ZBUS_LISTENER_DEFINE(coap_server_lis, listener_cb);
+
+static int socket_open(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONFIG_APP_COAP_SERVER_PORT),
+		.sin_addr.s_addr = htonl(INADDR_ANY),
+	};
+	int fd;
+	int err;
+
+#ifdef CONFIG_APP_COAP_SERVER_DTLS
+	static const sec_tag_t sec_tags[] = { CONFIG_APP_COAP_SERVER_SEC_TAG };
+	int role = TLS_DTLS_ROLE_SERVER;
+
+	fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_DTLS_1_2);
+	if (fd >= 0 &&
+	    (zsock_setsockopt(fd, SOL_TLS, TLS_SEC_TAG_LIST, sec_tags, sizeof(sec_tags)) ||
+	     zsock_setsockopt(fd, SOL_TLS, TLS_DTLS_ROLE, &role, sizeof(role)))) {
+		err = -errno;
+		LOG_ERR("DTLS setup failed: %d", err);
+		zsock_close(fd);
+		return err;
+	}
+#else
+	fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#endif
+	if (fd < 0) {
+		return -errno;
+	}
+
+	if (zsock_bind(fd, (struct sockaddr *)&addr, sizeof(addr))) {
+		err = -errno;
+		LOG_ERR("bind to port %d failed: %d", CONFIG_APP_COAP_SERVER_PORT, err);
+		zsock_close(fd);
+		return err;
+	}
+
+	return fd;
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int coap_server_resource_get(size_t idx, struct coap_server_resource_stats *out)
+{
+	if (idx >= res_count) {
+		return -ENOENT;
+	}
+
+	K_SPINLOCK(&lock) {
+		*out = states[idx].stats;
+	}
+
+	return 0;
+}
+
+/*******************************************************************************
+ * Module Thread
+ ******************************************************************************/
+
+static void coap_server_thread(void *p1, void *p2, void *p3)
+{
+	static uint8_t rx_buf[PDU_SIZE];
+	struct zsock_pollfd fds[2];
+	struct sockaddr_in from;
+	socklen_t from_len;
+	zvfs_eventfd_t val;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	resources_init();
+
+	wake_fd = zvfs_eventfd(0, ZVFS_EFD_NONBLOCK);
+	if (wake_fd < 0) {
+		LOG_ERR("eventfd failed: %d", errno);
+		return;
+	}
+
+	sock = socket_open();
+	if (sock < 0) {
+		return;
+	}
+
+	LOG_INF("CoAP server on port %d, %zu resources", CONFIG_APP_COAP_SERVER_PORT, res_count);
+
+	while (1) {
+		fds[0] = (struct zsock_pollfd){ .fd = wake_fd, .events = ZSOCK_POLLIN };
+		fds[1] = (struct zsock_pollfd){ .fd = sock, .events = ZSOCK_POLLIN };
+
+		ret = zsock_poll(fds, ARRAY_SIZE(fds), notify_due());
+		if (ret < 0) {
+			LOG_ERR("poll failed: %d", errno);
+			k_sleep(K_SECONDS(1));
+			continue;
+		}
+
+		if (fds[0].revents & ZSOCK_POLLIN) {
+			(void)zvfs_eventfd_read(wake_fd, &val);
+		}
+
+		if (fds[1].revents & ZSOCK_POLLIN) {
+			from_len = sizeof(from);
+			ret = zsock_recvfrom(sock, rx_buf, sizeof(rx_buf), 0,
+					     (struct sockaddr *)&from, &from_len);
+			if (ret > 0) {
+				handle_packet(rx_buf, ret, (struct sockaddr *)&from);
+			}
+		}
+	}
+}
+
+K_THREAD_DEFINE(coap_server_module,
+		CONFIG_APP_COAP_SERVER_STACK_SIZE,
+		coap_server_thread,
+		NULL, NULL, NULL,
+		CONFIG_APP_COAP_SERVER_PRIORITY,
+		0, 0);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_COAP_SERVER_SHELL
+
+/*
+ * A minimal client for the shell, talking to the server over loopback: on
+ * native_sim with CONFIG_NET_LOOPBACK the whole path is testable without
+ * a network or a host-side CoAP tool.
+ */
+static uint8_t cli_buf[PDU_SIZE];
+
+static int cli_open(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONFIG_APP_COAP_SERVER_PORT),
+		.sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+	};
+	int fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+	if (fd < 0) {
+		return -errno;
+	}
+	if (zsock_connect(fd, (struct sockaddr *)&addr, sizeof(addr))) {
+		zsock_close(fd);
+		return -errno;
+	}
+
+	return fd;
+}
+
+static int cli_request(int fd, const char *path, int observe, int block2)
+{
+	static const uint8_t token[] = { 's', 'h' };
+	struct coap_packet req;
+	int err;
+
+	err = coap_packet_init(&req, cli_buf, sizeof(cli_buf), COAP_VERSION_1, COAP_TYPE_CON,
+			       sizeof(token), token, COAP_METHOD_GET, coap_next_id());
+	if (!err && observe >= 0) {
+		err = coap_append_option_int(&req, COAP_OPTION_OBSERVE, observe);
+	}
+	if (!err) {
+		err = coap_packet_append_option(&req, COAP_OPTION_URI_PATH, (const uint8_t *)path,
+						strlen(path));
+	}
+	if (!err && block2 >= 0) {
+		err = coap_append_option_int(&req, COAP_OPTION_BLOCK2, block2);
+	}
+	if (err) {
+		return err;
+	}
+
+	return (zsock_send(fd, req.data, req.offset, 0) < 0) ? -errno : 0;
+}
+
+/* Wait for a packet; returns its payload length or negative errno */
+static int cli_receive(int fd, struct coap_packet *rsp, struct coap_option *opts, size_t n,
+		       int timeout_ms)
+{
+	struct zsock_pollfd pfd = { .fd = fd, .events = ZSOCK_POLLIN };
+	uint16_t plen = 0;
+	int ret;
+
+	ret = zsock_poll(&pfd, 1, timeout_ms);
+	if (ret <= 0) {
+		return ret ? -errno : -ETIMEDOUT;
+	}
+
+	ret = zsock_recv(fd, cli_buf, sizeof(cli_buf), 0);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	ret = coap_packet_parse(rsp, cli_buf, ret, opts, n);
+	if (ret) {
+		return ret;
+	}
+
+	(void)coap_packet_get_payload(rsp, &plen);
+
+	return plen;
+}
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct coap_server_resource_stats s;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "Port %d, block %d B, notify at most every %d ms",
+		    CONFIG_APP_COAP_SERVER_PORT, BLOCK_BYTES, CONFIG_APP_COAP_SERVER_NOTIFY_MIN_MS);
+	shell_print(sh, "%-16s %6s %6s %7s %6s %7s %5s %6s", "path", "gets", "blocks",
+		    "updates", "notif", "coalesc", "obs", "size");
+
+	for (size_t i = 0; coap_server_resource_get(i, &s) == 0; i++) {
+		shell_print(sh, "%-16s %6u %6u %7u %6u %7u %5u %6u", s.path, s.gets, s.blocks,
+			    s.updates, s.notifications, s.coalesced, s.observers, s.size);
+	}
+
+	return 0;
+}
+
+static int cmd_get(const struct shell *sh, size_t argc, char **argv)
+{
+	struct coap_option opts[8];
+	struct coap_packet rsp;
+	int64_t start = k_uptime_get();
+	uint32_t num = 0;
+	size_t total = 0;
+	int block2 = -1;
+	int fd;
+	int ret;
+
+	ARG_UNUSED(argc);
+
+	fd = cli_open();
+	if (fd < 0) {
+		shell_error(sh, "socket failed: %d", fd);
+		return fd;
+	}
+
+	do {
+		ret = cli_request(fd, argv[1], -1, num ? (int)((num << 4) | BLOCK_SZX) : -1);
+		if (!ret) {
+			ret = cli_receive(fd, &rsp, opts, ARRAY_SIZE(opts), 2000);
+		}
+		if (ret < 0) {
+			shell_error(sh, "Block %u failed: %d", num, ret);
+			break;
+		}
+		if (coap_header_get_code(&rsp) != COAP_RESPONSE_CODE_CONTENT) {
+			shell_error(sh, "Response code %u.%02u", coap_header_get_code(&rsp) >> 5,
+				    coap_header_get_code(&rsp) & 0x1F);
+			ret = -EIO;
+			break;
+		}
+		total += ret;
+		num++;
+		block2 = coap_get_option_int(&rsp, COAP_OPTION_BLOCK2);
+	} while (block2 >= 0 && BLOCK2_MORE(block2));
+
+	zsock_close(fd);
+
+	if (ret >= 0) {
+		shell_print(sh, "%s: %zu bytes in %u block(s), %lld ms", argv[1], total, num,
+			    k_uptime_get() - start);
+	}
+
+	return (ret < 0) ? ret : 0;
+}
+
+static int cmd_observe(const struct shell *sh, size_t argc, char **argv)
+{
+	struct coap_option opts[8];
+	struct coap_packet rsp;
+	struct coap_packet ack;
+	uint8_t ack_buf[8];
+	int64_t end = k_uptime_get() + strtoul(argv[2], NULL, 10) * MSEC_PER_SEC;
+	uint32_t count = 0;
+	int fd;
+	int ret;
+
+	ARG_UNUSED(argc);
+
+	fd = cli_open();
+	if (fd < 0) {
+		shell_error(sh, "socket failed: %d", fd);
+		return fd;
+	}
+
+	ret = cli_request(fd, argv[1], 0, -1);
+	while (ret == 0 && k_uptime_get() < end) {
+		ret = cli_receive(fd, &rsp, opts, ARRAY_SIZE(opts), (int)(end - k_uptime_get()));
+		if (ret == -ETIMEDOUT) {
+			ret = 0;
+			break;
+		}
+		if (ret < 0) {
+			break;
+		}
+
+		shell_print(sh, "  %lld ms: seq %d, %d bytes%s", k_uptime_get(),
+			    coap_get_option_int(&rsp, COAP_OPTION_OBSERVE), ret,
+			    coap_header_get_type(&rsp) == COAP_TYPE_CON ? " (CON)" : "");
+		count++;
+
+		if (coap_header_get_type(&rsp) == COAP_TYPE_CON &&
+		    !coap_packet_init(&ack, ack_buf, sizeof(ack_buf), COAP_VERSION_1,
+				      COAP_TYPE_ACK, 0, NULL, COAP_CODE_EMPTY,
+				      coap_header_get_id(&rsp))) {
+			(void)zsock_send(fd, ack.data, ack.offset, 0);
+		}
+		ret = 0;
+	}
+
+	/* Deregister */
+	(void)cli_request(fd, argv[1], 1, -1);
+	(void)cli_receive(fd, &rsp, opts, ARRAY_SIZE(opts), 1000);
+	zsock_close(fd);
+
+	if (ret < 0) {
+		shell_error(sh, "Observe failed: %d", ret);
+		return ret;
+	}
+
+	shell_print(sh, "%u responses and notifications", count);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_coap_server,
+	SHELL_CMD(show, NULL, "Requests, notifications and observers per resource", cmd_show),
+	SHELL_CMD_ARG(get, NULL, "GET over loopback, block by block: get <path>", cmd_get, 2, 0),
+	SHELL_CMD_ARG(observe, NULL, "Observe over loopback: observe <path> <seconds>",
+		      cmd_observe, 3, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(coap_server, &sub_coap_server, "CoAP server", NULL);
+
+#endif /* CONFIG_APP_COAP_SERVER_SHELL */
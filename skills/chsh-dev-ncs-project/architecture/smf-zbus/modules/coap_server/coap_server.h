@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _COAP_SERVER_H_
+#define _COAP_SERVER_H_
+
+/**
+ * @file coap_server.h
+ * @brief CoAP server exposing zbus channels as observable resources
+ *
+ * A module makes the latest message of its channel readable over CoAP:
+ *
+ * @code
+ * static int location_encode(const void *msg, char *buf, size_t len)
+ * {
+ *     const struct location_msg *m = msg;
+ *
+ *     return snprintk(buf, len, "{\"lat_e6\":%d,\"lon_e6\":%d}",
+ *                     (int)(m->latitude * 1e6), (int)(m->longitude * 1e6));
+ * }
+ *
+ * COAP_SERVER_CHAN_DEFINE(LOCATION_CHAN, "location", COAP_CONTENT_FORMAT_APP_JSON,
+ *                         location_encode);
+ * @endcode
+ *
+ * GET coap://device/location returns the channel's current message,
+ * encoded on request. Clients that register with Observe get a
+ * notification when the channel is published, at most once per
+ * CONFIG_APP_COAP_SERVER_NOTIFY_MIN_MS per resource: publishes in between
+ * are coalesced and the notification carries the latest message.
+ *
+ * Representations larger than CONFIG_APP_COAP_SERVER_BLOCK_SIZE are sent
+ * block-wise (Block2, RFC 7959) with an ETag, so a client can tell when
+ * the representation changed between blocks. A notification carries the
+ * first block; the client fetches the rest with GET.
+ *
+ * Notifications are non-confirmable except every
+ * CONFIG_APP_COAP_SERVER_CON_EVERY-th; an observer that does not
+ * acknowledge one by the next, or answers with RST, is removed.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Listener behind every COAP_SERVER_CHAN_DEFINE() */
+ZBUS_OBS_DECLARE(coap_server_lis);
+
+/**
+ * @brief Encode one channel message as a resource representation
+ *
+ * Runs in the server thread with the channel claimed; keep it short.
+ *
+ * @param msg Channel message
+ * @param buf Where to write the representation
+ * @param len Room in @p buf, CONFIG_APP_COAP_SERVER_PAYLOAD_MAX
+ * @return Length, 0 when the message is not worth a notification (GET
+ *         then returns empty content), a value >= @p len when it does not
+ *         fit (snprintk() semantics), or negative errno
+ */
+typedef int (*coap_server_encode_t)(const void *msg, char *buf, size_t len);
+
+/** Channel bound to a resource (ROM) */
+struct coap_server_binding {
+	const struct zbus_channel *chan;
+	const char *path;
+	uint16_t format;
+	coap_server_encode_t encode;
+};
+
+/**
+ * @brief Expose a channel as an observable resource
+ *
+ * @param _chan zbus channel
+ * @param _path Resource path, one segment without slashes
+ * @param _format CoAP content format, e.g. COAP_CONTENT_FORMAT_APP_JSON
+ * @param _encode Encoder, see coap_server_encode_t
+ */
+#define COAP_SERVER_CHAN_DEFINE(_chan, _path, _format, _encode)				\
+	ZBUS_CHAN_ADD_OBS(_chan, coap_server_lis, 0);					\
+	static const STRUCT_SECTION_ITERABLE(coap_server_binding,			\
+					     _CONCAT(coap_server_bind_, _chan)) = {	\
+		.chan = &_chan,								\
+		.path = _path,								\
+		.format = _format,							\
+		.encode = _encode,							\
+	}
+
+/** Statistics of one resource since boot */
+struct coap_server_resource_stats {
+	const char *path;
+	uint32_t gets;		/* Requests, including Block2 continuations */
+	uint32_t blocks;	/* Responses that were one block of several */
+	uint32_t updates;	/* Channel publishes */
+	uint32_t notifications;	/* Sent, one per observer */
+	uint32_t coalesced;	/* Publishes folded into a later notification */
+	uint32_t observers;	/* Now */
+	uint32_t size;		/* Last representation, bytes */
+};
+
+/**
+ * @brief Get the statistics of a resource
+ *
+ * @param idx Resource index, in link order
+ * @return 0 on success, -ENOENT when idx is past the last resource
+ */
+int coap_server_resource_get(size_t idx, struct coap_server_resource_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _COAP_SERVER_H_ */
@@ -0,0 +1,688 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file dns_cache.c
+ * @brief Application DNS cache with TTL, prefetch and stale-on-error
+ *
+ * This module demonstrates:
+ * - A minimal DNS A query over a UDP socket, to learn the record TTL
+ * - Refreshing names in use from a low-priority work queue before they
+ *   expire, so callers only ever wait on the first lookup
+ * - Serving the last known address while DNS is unreachable
+ *
+ * Zephyr's own CONFIG_DNS_RESOLVER_CACHE is not used: it keeps
+ * zsock_getaddrinfo() answers for their TTL, but drops them on expiry, so
+ * the next connect waits for a query and fails while DNS is down, and it
+ * has no prefetch. Leave it off with this module; it would only add a
+ * second copy of each name.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/dns_resolve.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include <ctype.h>
+#include <errno.h>
+#include <string.h>
+
+#include "dns_cache.h"
+
+LOG_MODULE_REGISTER(dns_cache, CONFIG_APP_DNS_CACHE_LOG_LEVEL);
+
+#define DNS_PORT 53
+#define DNS_HDR_SIZE 12
+#define DNS_MSG_MAX 512
+#define DNS_TYPE_A 1
+#define DNS_TYPE_CNAME 5
+#define DNS_CLASS_IN 1
+#define DNS_FLAG_QR BIT(15)
+#define DNS_FLAG_RD BIT(8)
+#define DNS_RCODE_MASK 0x000F
+#define DNS_RCODE_NXDOMAIN 3
+
+/* Name, then QTYPE and QCLASS */
+#define QUERY_MAX (DNS_HDR_SIZE + CONFIG_APP_DNS_CACHE_HOST_LEN + 1 + 4)
+
+/* Never prefetch closer than this to expiry, whatever the TTL */
+#define PREFETCH_MIN_MS 2000
+
+struct entry {
+	char host[CONFIG_APP_DNS_CACHE_HOST_LEN];
+	struct in_addr addr;
+	int64_t fetched;
+	int64_t expires;
+	int64_t retry_at;	/* Earliest refresh after a failed one */
+	bool used;		/* Looked up since the last refresh */
+	bool refreshing;
+	int64_t last_used;
+};
+
+static struct entry entries[CONFIG_APP_DNS_CACHE_ENTRIES];
+
+static K_MUTEX_DEFINE(lock);
+
+static struct dns_cache_stats stats;
+static uint64_t query_ms_total;
+
+/* Refreshes block on the network; keep them off the system work queue */
+static K_THREAD_STACK_DEFINE(refresh_stack, CONFIG_APP_DNS_CACHE_STACK_SIZE);
+static struct k_work_q refresh_q;
+
+static void refresh_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(refresh_work, refresh_handler);
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static int server_get(struct sockaddr_in *server)
+{
+	struct dns_resolve_context *ctx;
+	int err = -ENOENT;
+
+	memset(server, 0, sizeof(*server));
+	server->sin_family = AF_INET;
+	server->sin_port = htons(DNS_PORT);
+
+	if (sizeof(CONFIG_APP_DNS_CACHE_SERVER) > 1) {
+		return zsock_inet_pton(AF_INET, CONFIG_APP_DNS_CACHE_SERVER,
+				       &server->sin_addr) == 1 ? 0 : -EINVAL;
+	}
+
+	/* First unicast IPv4 server of the resolver (static or from DHCP) */
+	ctx = dns_resolve_get_default();
+	if (!ctx) {
+		return -ENOENT;
+	}
+
+	/* DHCP replaces the server list through dns_resolve_reconfigure(), under this lock */
+	k_mutex_lock(&ctx->lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(ctx->servers); i++) {
+		const struct sockaddr_in *sin = net_sin(&ctx->servers[i].dns_server);
+
+		if (sin->sin_family == AF_INET && sin->sin_addr.s_addr != 0 &&
+		    !net_ipv4_is_addr_mcast(&sin->sin_addr)) {
+			server->sin_addr = sin->sin_addr;
+			if (sin->sin_port) {
+				server->sin_port = sin->sin_port;
+			}
+			err = 0;
+			break;
+		}
+	}
+	k_mutex_unlock(&ctx->lock);
+
+	return err;
+}
+
+static int query_build(uint8_t *buf, const char *host, uint16_t id)
+{
+	size_t pos = DNS_HDR_SIZE;
+	const char *label = host;
+	const char *dot;
+	size_t len;
+
+	memset(buf, 0, DNS_HDR_SIZE);
+	sys_put_be16(id, &buf[0]);
+	sys_put_be16(DNS_FLAG_RD, &buf[2]);
+	sys_put_be16(1, &buf[4]);
+
+	while (*label) {
+		dot = strchr(label, '.');
+		len = dot ? (size_t)(dot - label) : strlen(label);
+		if (len == 0 || len > 63 || pos + 1 + len + 5 > QUERY_MAX) {
+			return -EINVAL;
+		}
+		buf[pos++] = (uint8_t)len;
+		memcpy(&buf[pos], label, len);
+		pos += len;
+		label += len + (dot ? 1 : 0);
+	}
+
+	buf[pos++] = 0;
+	sys_put_be16(DNS_TYPE_A, &buf[pos]);
+	sys_put_be16(DNS_CLASS_IN, &buf[pos + 2]);
+
+	return pos + 4;
+}
+
+/* Offset past a (possibly compressed) name, or -EBADMSG */
+static int name_skip(const uint8_t *msg, size_t len, size_t pos)
+{
+	while (pos < len) {
+		uint8_t l = msg[pos];
+
+		if ((l & 0xC0) == 0xC0) {
+			return (pos + 2 <= len) ? (int)(pos + 2) : -EBADMSG;
+		}
+		if (l & 0xC0) {
+			return -EBADMSG;
+		}
+		pos += 1 + l;
+		if (l == 0) {
+			return (int)pos;
+		}
+	}
+
+	return -EBADMSG;
+}
+
+/* The reply repeats our question: same name (any case), QTYPE and QCLASS */
+static bool question_match(const uint8_t *msg, size_t len, const uint8_t *query, size_t qlen)
+{
+	if (len < qlen || sys_get_be16(&msg[4]) != 1) {
+		return false;
+	}
+
+	/* Label lengths are below 64, so tolower() leaves them alone */
+	for (size_t i = DNS_HDR_SIZE; i < qlen; i++) {
+		if (tolower(msg[i]) != tolower(query[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* First A record, and the lowest TTL along the CNAME chain */
+static int answer_parse(const uint8_t *msg, size_t len, const uint8_t *query, size_t qlen,
+			struct in_addr *addr, uint32_t *ttl)
+{
+	uint16_t flags, ancount, type, class, rdlen;
+	uint32_t min_ttl = UINT32_MAX;
+	bool found = false;
+	int pos = qlen;
+
+	/* Query id first: it is random, the question is not */
+	if (len < DNS_HDR_SIZE || sys_get_be16(&msg[0]) != sys_get_be16(&query[0]) ||
+	    !question_match(msg, len, query, qlen)) {
+		return -EBADMSG;
+	}
+
+	flags = sys_get_be16(&msg[2]);
+	if (!(flags & DNS_FLAG_QR)) {
+		return -EBADMSG;
+	}
+	if ((flags & DNS_RCODE_MASK) == DNS_RCODE_NXDOMAIN) {
+		return -ENOENT;
+	}
+	if (flags & DNS_RCODE_MASK) {
+		return -EIO;
+	}
+
+	ancount = sys_get_be16(&msg[6]);
+
+	for (uint16_t i = 0; i < ancount; i++) {
+		pos = name_skip(msg, len, pos);
+		if (pos < 0 || (size_t)pos + 10 > len) {
+			return -EBADMSG;
+		}
+		type = sys_get_be16(&msg[pos]);
+		class = sys_get_be16(&msg[pos + 2]);
+		rdlen = sys_get_be16(&msg[pos + 8]);
+		if ((size_t)pos + 10 + rdlen > len) {
+			return -EBADMSG;
+		}
+
+		if (type == DNS_TYPE_A || type == DNS_TYPE_CNAME) {
+			min_ttl = MIN(min_ttl, sys_get_be32(&msg[pos + 4]));
+		}
+		if (!found && type == DNS_TYPE_A && class == DNS_CLASS_IN && rdlen == 4) {
+			memcpy(addr, &msg[pos + 10], 4);
+			found = true;
+		}
+
+		pos += 10 + rdlen;
+	}
+
+	if (!found) {
+		return -ENOENT;
+	}
+
+	*ttl = min_ttl;
+
+	return 0;
+}
+
+/* No DNS server known: let the resolver do it, without a TTL */
+static int fallback_query(const char *host, struct in_addr *addr, uint32_t *ttl)
+{
+	struct zsock_addrinfo hints = {
+		.ai_family = AF_INET,
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct zsock_addrinfo *res;
+	int err;
+
+	err = zsock_getaddrinfo(host, NULL, &hints, &res);
+	if (err) {
+		return (err == DNS_EAI_NONAME) ? -ENOENT : -EAGAIN;
+	}
+
+	*addr = net_sin(res->ai_addr)->sin_addr;
+	*ttl = CONFIG_APP_DNS_CACHE_DEFAULT_TTL;
+	zsock_freeaddrinfo(res);
+
+	return 0;
+}
+
+/* Send the query, retransmit once, wait for the answer to our question */
+static int udp_query(const struct sockaddr_in *server, const char *host, struct in_addr *addr,
+		     uint32_t *ttl)
+{
+	uint8_t query[QUERY_MAX];
+	uint8_t reply[DNS_MSG_MAX];
+	uint16_t id = sys_rand16_get();
+	struct zsock_pollfd pfd;
+	int64_t deadline;
+	int qlen;
+	int sock;
+	int ret;
+	int err = -ETIMEDOUT;
+
+	qlen = query_build(query, host, id);
+	if (qlen < 0) {
+		return qlen;
+	}
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	/* Connected: the stack drops datagrams from any other address or port */
+	if (zsock_connect(sock, (const struct sockaddr *)server, sizeof(*server)) < 0) {
+		err = -errno;
+		zsock_close(sock);
+		return err;
+	}
+
+	for (int attempt = 0; attempt < 2 && err == -ETIMEDOUT; attempt++) {
+		if (zsock_send(sock, query, qlen, 0) < 0) {
+			err = -errno;
+			break;
+		}
+
+		deadline = k_uptime_get() + CONFIG_APP_DNS_CACHE_TIMEOUT_MS / 2;
+		while (err == -ETIMEDOUT) {
+			pfd = (struct zsock_pollfd){ .fd = sock, .events = ZSOCK_POLLIN };
+			ret = zsock_poll(&pfd, 1, (int)MAX(deadline - k_uptime_get(), 0));
+			if (ret <= 0) {
+				break;
+			}
+
+			ret = zsock_recv(sock, reply, sizeof(reply), 0);
+			if (ret < 0) {
+				err = -errno;
+				break;
+			}
+
+			err = answer_parse(reply, ret, query, qlen, addr, ttl);
+			if (err == -EBADMSG) {
+				/* Not an answer to this query, or garbage: keep waiting */
+				err = -ETIMEDOUT;
+			}
+		}
+	}
+
+	zsock_close(sock);
+
+	return err;
+}
+
+static int dns_query(const char *host, struct in_addr *addr, uint32_t *ttl)
+{
+	struct sockaddr_in server;
+	int64_t start = k_uptime_get();
+	uint32_t ms;
+	int err;
+
+	if (server_get(&server)) {
+		err = fallback_query(host, addr, ttl);
+	} else {
+		err = udp_query(&server, host, addr, ttl);
+	}
+
+	ms = (uint32_t)(k_uptime_get() - start);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	stats.queries++;
+	query_ms_total += ms;
+	stats.query_ms_max = MAX(stats.query_ms_max, ms);
+	k_mutex_unlock(&lock);
+
+	LOG_DBG("%s: %d in %u ms", host, err, ms);
+
+	return err;
+}
+
+/* Lock held */
+static struct entry *entry_find(const char *host)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (entries[i].host[0] && strcmp(entries[i].host, host) == 0) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Lock held */
+static int64_t prefetch_at(const struct entry *e)
+{
+	int64_t margin = MAX((e->expires - e->fetched) * CONFIG_APP_DNS_CACHE_PREFETCH_PCT / 100,
+			     PREFETCH_MIN_MS);
+
+	return MAX(e->expires - margin, e->retry_at);
+}
+
+/* Lock held. Wake the refresher for the next name in use that is due */
+static void refresh_schedule(void)
+{
+	int64_t next = INT64_MAX;
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (entries[i].host[0] && entries[i].used && !entries[i].refreshing) {
+			next = MIN(next, prefetch_at(&entries[i]));
+		}
+	}
+
+	if (next != INT64_MAX) {
+		k_work_reschedule_for_queue(&refresh_q, &refresh_work,
+					    K_MSEC(MAX(next - k_uptime_get(), 0)));
+	}
+}
+
+/* Lock held. Reuses the entry of the name, else an empty or the least recently used one */
+static struct entry *entry_store(const char *host, struct in_addr addr, uint32_t ttl)
+{
+	struct entry *e = entry_find(host);
+	int64_t now = k_uptime_get();
+
+	if (!e) {
+		e = &entries[0];
+		for (size_t i = 0; i < ARRAY_SIZE(entries) && e->host[0]; i++) {
+			if (!entries[i].host[0] || entries[i].last_used < e->last_used) {
+				e = &entries[i];
+			}
+		}
+		if (e->host[0]) {
+			LOG_DBG("Evicting %s", e->host);
+		}
+		memset(e, 0, sizeof(*e));
+		strcpy(e->host, host);
+		e->last_used = now;
+	}
+
+	ttl = CLAMP(ttl, CONFIG_APP_DNS_CACHE_MIN_TTL, CONFIG_APP_DNS_CACHE_MAX_TTL);
+
+	e->addr = addr;
+	e->fetched = now;
+	e->expires = now + (int64_t)ttl * MSEC_PER_SEC;
+	e->retry_at = 0;
+	e->refreshing = false;
+
+	return e;
+}
+
+static void refresh_handler(struct k_work *work)
+{
+	char host[CONFIG_APP_DNS_CACHE_HOST_LEN];
+	struct in_addr addr;
+	struct entry *e;
+	uint32_t ttl;
+	int64_t now;
+	int err;
+
+	ARG_UNUSED(work);
+
+	for (;;) {
+		k_mutex_lock(&lock, K_FOREVER);
+
+		now = k_uptime_get();
+		e = NULL;
+		for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+			struct entry *c = &entries[i];
+
+			if (!c->host[0] || !c->used || c->refreshing || now < prefetch_at(c)) {
+				continue;
+			}
+			if (now >= c->expires + CONFIG_APP_DNS_CACHE_STALE_SECONDS * MSEC_PER_SEC) {
+				/* Too old to serve; the next lookup queries anyway */
+				c->used = false;
+				continue;
+			}
+			e = c;
+			break;
+		}
+
+		if (!e) {
+			refresh_schedule();
+			k_mutex_unlock(&lock);
+			return;
+		}
+
+		strcpy(host, e->host);
+		e->refreshing = true;
+		k_mutex_unlock(&lock);
+
+		err = dns_query(host, &addr, &ttl);
+
+		k_mutex_lock(&lock, K_FOREVER);
+		e = entry_find(host);
+		if (e && !err) {
+			entry_store(host, addr, ttl);
+			/* Refreshed once; again only if looked up before the next expiry */
+			e->used = false;
+			stats.prefetches++;
+		} else if (e) {
+			e->refreshing = false;
+			e->retry_at = k_uptime_get() +
+				      CONFIG_APP_DNS_CACHE_RETRY_SECONDS * MSEC_PER_SEC;
+			LOG_DBG("Refreshing %s failed: %d", host, err);
+		}
+		k_mutex_unlock(&lock);
+	}
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int dns_cache_resolve(const char *host, uint16_t port, struct sockaddr_in *out)
+{
+	struct in_addr addr;
+	struct entry *e;
+	uint32_t ttl;
+	int64_t now = k_uptime_get();
+	int err;
+
+	memset(out, 0, sizeof(*out));
+	out->sin_family = AF_INET;
+	out->sin_port = htons(port);
+
+	if (zsock_inet_pton(AF_INET, host, &out->sin_addr) == 1) {
+		return 0;
+	}
+	if (strlen(host) >= CONFIG_APP_DNS_CACHE_HOST_LEN) {
+		return -ENAMETOOLONG;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	stats.lookups++;
+	e = entry_find(host);
+	if (e && now < e->expires) {
+		stats.hits++;
+		e->used = true;
+		e->last_used = now;
+		out->sin_addr = e->addr;
+		refresh_schedule();
+		k_mutex_unlock(&lock);
+		return 0;
+	}
+
+	stats.misses++;
+	k_mutex_unlock(&lock);
+
+	err = dns_query(host, &addr, &ttl);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	now = k_uptime_get();
+	if (!err) {
+		e = entry_store(host, addr, ttl);
+		out->sin_addr = addr;
+	} else if (err != -ENOENT && (e = entry_find(host)) != NULL &&
+		   now < e->expires + CONFIG_APP_DNS_CACHE_STALE_SECONDS * MSEC_PER_SEC) {
+		/* Connecting to the last address beats failing the upload */
+		LOG_WRN("%s: query failed (%d), using address expired %lld s ago", host, err,
+			(now - e->expires) / MSEC_PER_SEC);
+		stats.stale++;
+		e->retry_at = now + CONFIG_APP_DNS_CACHE_RETRY_SECONDS * MSEC_PER_SEC;
+		out->sin_addr = e->addr;
+		err = 0;
+	} else {
+		stats.failures++;
+	}
+
+	if (e && !err) {
+		/* In use: keep it fresh from now on */
+		e->used = true;
+		e->last_used = now;
+		refresh_schedule();
+	}
+
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+void dns_cache_flush(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	memset(entries, 0, sizeof(entries));
+	k_mutex_unlock(&lock);
+}
+
+void dns_cache_stats_get(struct dns_cache_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	*out = stats;
+	out->query_ms_avg = stats.queries ? (uint32_t)(query_ms_total / stats.queries) : 0;
+	out->entries = 0;
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		out->entries += entries[i].host[0] ? 1 : 0;
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+static int dns_cache_init(void)
+{
+	/* Below application modules: a refresh is never urgent */
+	k_work_queue_start(&refresh_q, refresh_stack, K_THREAD_STACK_SIZEOF(refresh_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, NULL);
+	k_thread_name_set(&refresh_q.thread, "dns_cache");
+
+	return 0;
+}
+
+SYS_INIT(dns_cache_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_DNS_CACHE_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dns_cache_stats s;
+	char addr[NET_IPV4_ADDR_LEN];
+	int64_t now = k_uptime_get();
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	dns_cache_stats_get(&s);
+
+	shell_print(sh, "lookups %u: hits %u, stale %u, misses %u, failed %u (hit rate %u%%)",
+		    s.lookups, s.hits, s.stale, s.misses, s.failures,
+		    s.lookups ? (s.hits + s.stale) * 100 / s.lookups : 0);
+	shell_print(sh, "queries %u (prefetch %u), avg %u ms, max %u ms", s.queries,
+		    s.prefetches, s.query_ms_avg, s.query_ms_max);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		const struct entry *e = &entries[i];
+
+		if (!e->host[0]) {
+			continue;
+		}
+		zsock_inet_ntop(AF_INET, &e->addr, addr, sizeof(addr));
+		shell_print(sh, "%-32s %-15s %6lld s %s%s", e->host, addr,
+			    (e->expires - now) / MSEC_PER_SEC, now < e->expires ? "fresh" : "stale",
+			    e->used ? ", in use" : "");
+	}
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+static int cmd_resolve(const struct shell *sh, size_t argc, char **argv)
+{
+	struct sockaddr_in sin;
+	char addr[NET_IPV4_ADDR_LEN];
+	int64_t start = k_uptime_get();
+	int err;
+
+	ARG_UNUSED(argc);
+
+	err = dns_cache_resolve(argv[1], 0, &sin);
+	if (err) {
+		shell_error(sh, "%s: %d", argv[1], err);
+		return err;
+	}
+
+	zsock_inet_ntop(AF_INET, &sin.sin_addr, addr, sizeof(addr));
+	shell_print(sh, "%s -> %s (%lld ms)", argv[1], addr, k_uptime_get() - start);
+
+	return 0;
+}
+
+static int cmd_flush(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	dns_cache_flush();
+	shell_print(sh, "DNS cache flushed");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_dns_cache,
+	SHELL_CMD(show, NULL, "Hit rate, query times and cached names", cmd_show),
+	SHELL_CMD_ARG(resolve, NULL, "Look up a name: resolve <host>", cmd_resolve, 2, 0),
+	SHELL_CMD(flush, NULL, "Forget every cached name", cmd_flush),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(dns_cache, &sub_dns_cache, "Application DNS cache", NULL);
+
+#endif /* CONFIG_APP_DNS_CACHE_SHELL */
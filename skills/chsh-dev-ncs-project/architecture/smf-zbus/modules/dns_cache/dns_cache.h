@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _DNS_CACHE_H_
+#define _DNS_CACHE_H_
+
+/**
+ * @file dns_cache.h
+ * @brief Application DNS cache with TTL, prefetch and stale-on-error
+ *
+ * A drop-in for the zsock_getaddrinfo() call in front of every connect:
+ *
+ * @code
+ * struct sockaddr_in addr;
+ *
+ * err = dns_cache_resolve("api.example.com", 443, &addr);
+ * fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+ * err = zsock_connect(fd, (struct sockaddr *)&addr, sizeof(addr));
+ * @endcode
+ *
+ * Names are resolved with a direct A query to the resolver's first IPv4
+ * server, because the Zephyr resolver API does not return record TTLs.
+ * An answer is kept for its TTL, clamped to CONFIG_APP_DNS_CACHE_MIN_TTL
+ * and CONFIG_APP_DNS_CACHE_MAX_TTL. A name used since its last refresh is
+ * queried again in the background shortly before it expires, so hot names
+ * never miss. When a query fails (right after a Wi-Fi reconnect, say), an
+ * expired address is served for up to CONFIG_APP_DNS_CACHE_STALE_SECONDS
+ * and refreshed later.
+ *
+ * IPv4 only. Without a known DNS server the cache falls back to
+ * zsock_getaddrinfo() and CONFIG_APP_DNS_CACHE_DEFAULT_TTL.
+ *
+ * CONFIG_DNS_RESOLVER_CACHE also honours TTLs, but forgets a name when it
+ * expires: no prefetch, and no address while DNS is down. Use one or the
+ * other.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief DNS cache statistics since boot
+ */
+struct dns_cache_stats {
+	uint32_t lookups;	/* dns_cache_resolve() calls */
+	uint32_t hits;		/* Answered from a fresh entry */
+	uint32_t stale;		/* Answered from an expired entry after a failed query */
+	uint32_t misses;	/* Needed a query */
+	uint32_t failures;	/* Returned an error */
+	uint32_t prefetches;	/* Background refreshes before expiry */
+	uint32_t queries;	/* DNS queries sent */
+	uint32_t query_ms_avg;
+	uint32_t query_ms_max;
+	uint32_t entries;	/* Now */
+};
+
+/**
+ * @brief Resolve a host name to an IPv4 address
+ *
+ * Returns at once on a hit; blocks for one query (at most
+ * CONFIG_APP_DNS_CACHE_TIMEOUT_MS) on a miss.
+ *
+ * @param host Host name or dotted IPv4 address
+ * @param port Port to store in @p addr, host byte order
+ * @param addr Output address
+ * @return 0 on success, -ENOENT when the name does not exist, -ETIMEDOUT
+ *         or another negative errno when it could not be resolved
+ */
+int dns_cache_resolve(const char *host, uint16_t port, struct sockaddr_in *addr);
+
+/**
+ * @brief Forget every cached name
+ */
+void dns_cache_flush(void);
+
+/**
+ * @brief Get the statistics
+ */
+void dns_cache_stats_get(struct dns_cache_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DNS_CACHE_H_ */
@@ -0,0 +1,693 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file http_pool.c
+ * @brief Keep-alive HTTP(S) connection pool
+ *
+ * This module demonstrates:
+ * - Running Zephyr's HTTP client over sockets that outlive one request
+ * - Detecting connections the server closed while they sat idle
+ * - Sharing a few connections between threads with a condition variable
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/client.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "http_pool.h"
+
+#ifdef CONFIG_APP_HTTP_POOL_TLS
+#include <zephyr/net/tls_credentials.h>
+#endif
+
+#ifdef CONFIG_APP_DNS_CACHE
+#include "dns_cache.h"
+#endif
+
+#if defined(CONFIG_APP_TLS_SESSION) && defined(CONFIG_APP_HTTP_POOL_TLS)
+#include "tls_session.h"
+#define USE_TLS_SESSION 1
+#endif
+
+LOG_MODULE_REGISTER(http_pool, CONFIG_APP_HTTP_POOL_LOG_LEVEL);
+
+#define IDLE_MS (CONFIG_APP_HTTP_POOL_IDLE_SECONDS * MSEC_PER_SEC)
+
+struct conn {
+	char host[CONFIG_APP_HTTP_POOL_HOST_LEN];	/* Empty: slot free */
+	uint16_t port;
+	int sock;		/* -1 while connecting */
+	bool busy;
+	bool doomed;		/* Close when the request in progress ends */
+	int64_t last_used;
+	uint32_t requests;
+	uint8_t rx_buf[CONFIG_APP_HTTP_POOL_RX_BUF];
+};
+
+static struct conn conns[CONFIG_APP_HTTP_POOL_CONNS];
+
+static K_MUTEX_DEFINE(lock);
+
+/* Signalled whenever a connection is released or a slot freed */
+static K_CONDVAR_DEFINE(released);
+
+static struct http_pool_stats stats;
+static uint32_t new_count;
+static uint64_t new_ms_total;
+static uint64_t reused_ms_total;
+
+#ifdef CONFIG_APP_HTTP_POOL_TLS
+static const sec_tag_t sec_tags[] = { CONFIG_APP_HTTP_POOL_SEC_TAG };
+#endif
+
+struct rsp_ctx {
+	const struct http_pool_request *req;
+	struct http_pool_response *rsp;
+	bool got_data;
+	bool complete;
+};
+
+static void idle_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(idle_work, idle_handler);
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Lock held; released around the close, which may send a TLS close_notify */
+static void conn_drop(struct conn *c)
+{
+	int sock = c->sock;
+
+	LOG_DBG("Closing %s:%u after %u requests", c->host, c->port, c->requests);
+
+	c->host[0] = '\0';
+	c->sock = -1;
+	c->busy = false;
+	c->doomed = false;
+	c->requests = 0;
+
+	if (sock >= 0) {
+		k_mutex_unlock(&lock);
+		zsock_close(sock);
+		k_mutex_lock(&lock, K_FOREVER);
+	}
+
+	k_condvar_broadcast(&released);
+}
+
+/*
+ * An idle keep-alive connection has nothing to read. Readable means the
+ * server closed it (FIN, or a 408 before the FIN), so it must not be reused.
+ */
+static bool conn_dead(const struct conn *c)
+{
+	struct zsock_pollfd pfd = { .fd = c->sock, .events = ZSOCK_POLLIN };
+
+	return zsock_poll(&pfd, 1, 0) != 0;
+}
+
+static int host_resolve(const char *host, uint16_t port, struct sockaddr_in *addr)
+{
+#ifdef CONFIG_APP_DNS_CACHE
+	return dns_cache_resolve(host, port, addr);
+#else
+	struct zsock_addrinfo hints = {
+		.ai_family = AF_INET,
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct zsock_addrinfo *res;
+	int err;
+
+	err = zsock_getaddrinfo(host, NULL, &hints, &res);
+	if (err) {
+		return -EHOSTUNREACH;
+	}
+
+	memcpy(addr, res->ai_addr, sizeof(*addr));
+	addr->sin_port = htons(port);
+	zsock_freeaddrinfo(res);
+
+	return 0;
+#endif
+}
+
+static int conn_open(const char *host, uint16_t port)
+{
+#ifdef USE_TLS_SESSION
+	struct tls_session_probe probe;
+#endif
+	struct sockaddr_in addr;
+	int sock;
+	int err;
+
+	err = host_resolve(host, port, &addr);
+	if (err) {
+		LOG_WRN("Resolving %s failed: %d", host, err);
+		return err;
+	}
+
+#ifdef CONFIG_APP_HTTP_POOL_TLS
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+#else
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#endif
+	if (sock < 0) {
+		return -errno;
+	}
+
+#ifdef CONFIG_APP_HTTP_POOL_TLS
+	if (zsock_setsockopt(sock, SOL_TLS, TLS_SEC_TAG_LIST, sec_tags, sizeof(sec_tags)) ||
+	    zsock_setsockopt(sock, SOL_TLS, TLS_HOSTNAME, host, strlen(host) + 1)) {
+		err = -errno;
+		zsock_close(sock);
+		return err;
+	}
+#endif
+
+#ifdef USE_TLS_SESSION
+	tls_session_sock_setup(sock);
+	tls_session_handshake_begin(&probe, host);
+	(void)tls_session_sock_probe(&probe, sock);
+#endif
+	err = zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)) ? -errno : 0;
+#ifdef USE_TLS_SESSION
+	tls_session_handshake_end(&probe, err);
+#endif
+	if (err) {
+		LOG_WRN("Connecting to %s:%u failed: %d", host, port, err);
+		zsock_close(sock);
+		return err;
+	}
+
+	return sock;
+}
+
+/* Lock held. Idle connections of other hosts go first when the pool is full */
+static struct conn *slot_victim(void)
+{
+	struct conn *victim = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		struct conn *c = &conns[i];
+
+		if (c->host[0] && !c->busy && (!victim || c->last_used < victim->last_used)) {
+			victim = c;
+		}
+	}
+
+	return victim;
+}
+
+/*
+ * Take an idle connection to the host, or open one while under the per-host
+ * limit, or wait for one to be released. Returns with the connection busy.
+ */
+static int conn_acquire(const char *host, uint16_t port, bool fresh, int64_t deadline,
+			struct conn **out, bool *reused)
+{
+	struct conn *idle, *free_slot, *c;
+	size_t same_host;
+	int64_t remaining;
+	int sock;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (;;) {
+		idle = NULL;
+		free_slot = NULL;
+		same_host = 0;
+
+		for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+			c = &conns[i];
+			if (!c->host[0]) {
+				free_slot = free_slot ? free_slot : c;
+			} else if (c->port == port && strcmp(c->host, host) == 0) {
+				same_host++;
+				if (c->busy || c->doomed) {
+					continue;
+				}
+				/* Most recently used: least likely to have timed out */
+				if (!idle || c->last_used > idle->last_used) {
+					idle = c;
+				}
+			}
+		}
+
+		if (idle && !fresh) {
+			if (conn_dead(idle)) {
+				stats.closed_server++;
+				conn_drop(idle);
+				continue;
+			}
+			idle->busy = true;
+			*out = idle;
+			*reused = true;
+			k_mutex_unlock(&lock);
+			return 0;
+		}
+
+		if (idle && fresh) {
+			/* Replace it rather than exceed the per-host limit */
+			conn_drop(idle);
+			fresh = false;
+			continue;
+		}
+
+		if (same_host < CONFIG_APP_HTTP_POOL_PER_HOST) {
+			if (!free_slot && (c = slot_victim()) != NULL) {
+				stats.closed_idle++;
+				conn_drop(c);
+				continue;
+			}
+			if (free_slot) {
+				break;
+			}
+		}
+
+		remaining = deadline - k_uptime_get();
+		if (remaining <= 0) {
+			k_mutex_unlock(&lock);
+			return -EAGAIN;
+		}
+		k_condvar_wait(&released, &lock, K_MSEC(remaining));
+	}
+
+	/* Reserve the slot, connect without holding the lock */
+	c = free_slot;
+	strcpy(c->host, host);
+	c->port = port;
+	c->busy = true;
+	c->sock = -1;
+	k_mutex_unlock(&lock);
+
+	sock = conn_open(host, port);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (sock < 0) {
+		conn_drop(c);
+		k_mutex_unlock(&lock);
+		return sock;
+	}
+	c->sock = sock;
+	stats.opened++;
+	k_mutex_unlock(&lock);
+
+	*out = c;
+	*reused = false;
+
+	return 0;
+}
+
+static void conn_release(struct conn *c, bool keep)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	c->busy = false;
+	c->last_used = k_uptime_get();
+	c->requests++;
+
+	if (!keep || c->doomed) {
+		conn_drop(c);
+	} else {
+		k_condvar_broadcast(&released);
+		if (!k_work_delayable_is_pending(&idle_work)) {
+			k_work_schedule(&idle_work, K_MSEC(IDLE_MS));
+		}
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+static void idle_handler(struct k_work *work)
+{
+	int64_t next = INT64_MAX;
+	int64_t now;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	now = k_uptime_get();
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		struct conn *c = &conns[i];
+
+		if (!c->host[0] || c->busy) {
+			continue;
+		}
+		if (now - c->last_used >= IDLE_MS) {
+			stats.closed_idle++;
+			conn_drop(c);
+		} else {
+			next = MIN(next, c->last_used + IDLE_MS);
+		}
+	}
+
+	if (next != INT64_MAX) {
+		k_work_schedule(&idle_work, K_MSEC(next - now));
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+static int response_cb(struct http_response *hr, enum http_final_call final_data,
+		       void *user_data)
+{
+	struct rsp_ctx *ctx = user_data;
+	struct http_pool_response *rsp = ctx->rsp;
+	size_t room;
+
+	ctx->got_data = true;
+
+	if (hr->body_frag_start && hr->body_frag_len) {
+		if (ctx->req->body && rsp->body_len < ctx->req->body_size) {
+			room = ctx->req->body_size - rsp->body_len;
+			memcpy(&ctx->req->body[rsp->body_len], hr->body_frag_start,
+			       MIN(room, hr->body_frag_len));
+		}
+		rsp->body_len += hr->body_frag_len;
+	}
+
+	if (final_data == HTTP_DATA_FINAL) {
+		rsp->status = hr->http_status_code;
+		ctx->complete = true;
+	}
+
+	return 0;
+}
+
+/*
+ * A response that ends cleanly leaves the connection reusable. The client
+ * keeps the Connection header to its private parser; a server that asked
+ * to close closes right after the response, which conn_dead() sees before
+ * the next request.
+ */
+static int conn_send(struct conn *c, struct rsp_ctx *ctx, int32_t timeout_ms)
+{
+	const struct http_pool_request *req = ctx->req;
+	struct http_request hr = {
+		.method = req->method,
+		.url = req->url,
+		.host = req->host,
+		.protocol = "HTTP/1.1",
+		.payload = (const char *)req->payload,
+		.payload_len = req->payload_len,
+		.content_type_value = req->content_type,
+		.response = response_cb,
+		.recv_buf = c->rx_buf,
+		.recv_buf_len = sizeof(c->rx_buf),
+	};
+	int ret;
+
+	ret = http_client_req(c->sock, &hr, timeout_ms, ctx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return ctx->complete ? 0 : -ECONNRESET;
+}
+
+/* Safe to send twice: the first copy may have reached the server */
+static bool retry_allowed(const struct http_pool_request *req)
+{
+	return req->retry || req->method == HTTP_GET || req->method == HTTP_HEAD;
+}
+
+static void stats_record(bool reused, uint32_t ms)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	if (reused) {
+		stats.reused++;
+		reused_ms_total += ms;
+		stats.reused_ms_max = MAX(stats.reused_ms_max, ms);
+	} else {
+		new_count++;
+		new_ms_total += ms;
+		stats.new_ms_max = MAX(stats.new_ms_max, ms);
+	}
+	k_mutex_unlock(&lock);
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int http_pool_request(const struct http_pool_request *req, struct http_pool_response *rsp,
+		      int32_t timeout_ms)
+{
+	uint16_t port = req->port ? req->port : CONFIG_APP_HTTP_POOL_PORT;
+	int64_t start = k_uptime_get();
+	int64_t deadline = start + timeout_ms;
+	struct rsp_ctx ctx;
+	struct conn *c;
+	bool reused;
+	int err;
+
+	if (strlen(req->host) >= CONFIG_APP_HTTP_POOL_HOST_LEN) {
+		return -ENAMETOOLONG;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	stats.requests++;
+	k_mutex_unlock(&lock);
+
+	for (bool fresh = false;; fresh = true) {
+		err = conn_acquire(req->host, port, fresh, deadline, &c, &reused);
+		if (err) {
+			break;
+		}
+
+		memset(rsp, 0, sizeof(*rsp));
+		ctx = (struct rsp_ctx){ .req = req, .rsp = rsp };
+
+		err = conn_send(c, &ctx, (int32_t)MAX(deadline - k_uptime_get(), 1));
+		conn_release(c, err == 0);
+
+		/* The server may close an idle connection just as we send on it */
+		if (err && reused && !ctx.got_data && !fresh && retry_allowed(req)) {
+			LOG_DBG("%s: reused connection failed (%d), retrying", req->host, err);
+			k_mutex_lock(&lock, K_FOREVER);
+			stats.retried++;
+			k_mutex_unlock(&lock);
+			continue;
+		}
+		break;
+	}
+
+	if (err) {
+		k_mutex_lock(&lock, K_FOREVER);
+		stats.failures++;
+		k_mutex_unlock(&lock);
+		LOG_WRN("%s%s failed: %d", req->host, req->url, err);
+		return err;
+	}
+
+	rsp->reused = reused;
+	rsp->ms = (uint32_t)(k_uptime_get() - start);
+	stats_record(reused, rsp->ms);
+
+	LOG_DBG("%s%s: %u in %u ms (%s)", req->host, req->url, rsp->status, rsp->ms,
+		reused ? "reused" : "new");
+
+	return 0;
+}
+
+void http_pool_close_all(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		struct conn *c = &conns[i];
+
+		if (c->busy) {
+			c->doomed = true;
+		} else if (c->host[0]) {
+			conn_drop(c);
+		}
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+void http_pool_stats_get(struct http_pool_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	*out = stats;
+	out->new_ms_avg = new_count ? (uint32_t)(new_ms_total / new_count) : 0;
+	out->reused_ms_avg = stats.reused ? (uint32_t)(reused_ms_total / stats.reused) : 0;
+	out->open = 0;
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		out->open += (conns[i].sock >= 0) ? 1 : 0;
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+static int http_pool_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		conns[i].sock = -1;
+	}
+
+	return 0;
+}
+
+SYS_INIT(http_pool_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_HTTP_POOL_SHELL
+
+static uint8_t shell_payload[CONFIG_APP_HTTP_POOL_RX_BUF];
+
+/* "host" or "host:port"; the port is cut off in place */
+static uint16_t host_port_split(char *arg)
+{
+	char *colon = strchr(arg, ':');
+
+	if (!colon) {
+		return 0;
+	}
+	*colon = '\0';
+
+	return (uint16_t)strtoul(colon + 1, NULL, 10);
+}
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct http_pool_stats s;
+	int64_t now = k_uptime_get();
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	http_pool_stats_get(&s);
+
+	shell_print(sh, "requests %u: reused %u (%u%%), failed %u, retried %u", s.requests,
+		    s.reused, s.requests ? s.reused * 100 / s.requests : 0, s.failures, s.retried);
+	shell_print(sh, "connections: opened %u, open %u, closed idle %u, by server %u",
+		    s.opened, s.open, s.closed_idle, s.closed_server);
+	shell_print(sh, "latency: new avg %u max %u ms, reused avg %u max %u ms", s.new_ms_avg,
+		    s.new_ms_max, s.reused_ms_avg, s.reused_ms_max);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(conns); i++) {
+		const struct conn *c = &conns[i];
+
+		if (!c->host[0]) {
+			continue;
+		}
+		shell_print(sh, "  %s:%u %s, %u requests, idle %lld s", c->host, c->port,
+			    c->busy ? "busy" : "idle", c->requests,
+			    c->busy ? 0 : (now - c->last_used) / MSEC_PER_SEC);
+	}
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+static int cmd_get(const struct shell *sh, size_t argc, char **argv)
+{
+	struct http_pool_request req = {
+		.method = HTTP_GET,
+		.port = host_port_split(argv[1]),
+		.host = argv[1],
+		.url = argv[2],
+	};
+	struct http_pool_response rsp;
+	int err;
+
+	ARG_UNUSED(argc);
+
+	err = http_pool_request(&req, &rsp, CONFIG_APP_HTTP_POOL_SHELL_TIMEOUT_MS);
+	if (err) {
+		shell_error(sh, "Request failed: %d", err);
+		return err;
+	}
+
+	shell_print(sh, "%u, %zu bytes, %u ms (%s connection)", rsp.status, rsp.body_len,
+		    rsp.ms, rsp.reused ? "reused" : "new");
+
+	return 0;
+}
+
+static int cmd_upload(const struct shell *sh, size_t argc, char **argv)
+{
+	struct http_pool_request req = {
+		.method = HTTP_POST,
+		.port = host_port_split(argv[1]),
+		.host = argv[1],
+		.url = argv[2],
+		.content_type = "application/octet-stream",
+		.payload = shell_payload,
+		.retry = true,		/* Filler, the stub can take it twice */
+	};
+	struct http_pool_response rsp;
+	uint32_t count = strtoul(argv[3], NULL, 10);
+	uint32_t reused = 0;
+	int64_t start = k_uptime_get();
+	int err;
+
+	ARG_UNUSED(argc);
+
+	req.payload_len = MIN(strtoul(argv[4], NULL, 10), sizeof(shell_payload));
+	memset(shell_payload, 'x', req.payload_len);
+
+	for (uint32_t i = 0; i < count; i++) {
+		err = http_pool_request(&req, &rsp, CONFIG_APP_HTTP_POOL_SHELL_TIMEOUT_MS);
+		if (err) {
+			shell_error(sh, "Upload %u failed: %d", i, err);
+			return err;
+		}
+		reused += rsp.reused ? 1 : 0;
+		shell_print(sh, "  %u: %u in %u ms%s", i, rsp.status, rsp.ms,
+			    rsp.reused ? "" : " (connect)");
+	}
+
+	shell_print(sh, "%u uploads of %zu bytes in %lld ms, %u on a reused connection", count,
+		    req.payload_len, k_uptime_get() - start, reused);
+
+	return 0;
+}
+
+static int cmd_close(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	http_pool_close_all();
+	shell_print(sh, "Idle connections closed");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_http_pool,
+	SHELL_CMD(show, NULL, "Reuse ratio, latency and open connections", cmd_show),
+	SHELL_CMD_ARG(get, NULL, "GET a URL: get <host[:port]> <url>", cmd_get, 3, 0),
+	SHELL_CMD_ARG(upload, NULL,
+		      "POST back to back: upload <host[:port]> <url> <count> <bytes>",
+		      cmd_upload, 5, 0),
+	SHELL_CMD(close, NULL, "Close idle connections", cmd_close),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(http_pool, &sub_http_pool, "HTTP connection pool", NULL);
+
+#endif /* CONFIG_APP_HTTP_POOL_SHELL */
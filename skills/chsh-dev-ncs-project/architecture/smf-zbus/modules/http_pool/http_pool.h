@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _HTTP_POOL_H_
+#define _HTTP_POOL_H_
+
+/**
+ * @file http_pool.h
+ * @brief Keep-alive HTTP(S) connection pool
+ *
+ * Instead of socket, handshake, one request, close:
+ *
+ * @code
+ * struct http_pool_request req = {
+ *         .method = HTTP_POST,
+ *         .host = "api.example.com",
+ *         .url = "/v1/telemetry",
+ *         .content_type = "application/json",
+ *         .payload = buf,
+ *         .payload_len = len,
+ * };
+ * struct http_pool_response rsp;
+ *
+ * err = http_pool_request(&req, &rsp, 5000);
+ * @endcode
+ *
+ * Up to CONFIG_APP_HTTP_POOL_PER_HOST connections per host stay open
+ * between requests, so back-to-back uploads pay the TCP and TLS handshake
+ * once. A request takes an idle connection to its host, opens a new one
+ * while under the limit, or waits for one to be released. Connections
+ * idle for CONFIG_APP_HTTP_POOL_IDLE_SECONDS, or that the server closed,
+ * are dropped. A GET or HEAD that fails on a reused connection before any
+ * response arrives is sent once more on a new connection. Other methods
+ * are only resent with .retry set: the server may have acted on the first
+ * copy before the connection died.
+ *
+ * Requests on one connection are sequential: HTTP/1.1 pipelining is not
+ * used, since Zephyr's HTTP client waits for each response.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/method.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** One request */
+struct http_pool_request {
+	enum http_method method;
+	const char *host;		/* Pool key and Host header */
+	uint16_t port;			/* 0: CONFIG_APP_HTTP_POOL_PORT */
+	const char *url;
+	const char *content_type;	/* NULL without payload */
+	const uint8_t *payload;
+	size_t payload_len;
+	uint8_t *body;			/* Response body out, optional */
+	size_t body_size;
+	bool retry;			/* Resend like GET: the request is idempotent */
+};
+
+/** Result of a request that got a response */
+struct http_pool_response {
+	uint16_t status;		/* HTTP status code */
+	size_t body_len;		/* Bytes received, may exceed body_size */
+	bool reused;			/* Sent on a connection opened earlier */
+	uint32_t ms;			/* Including the connect, when there was one */
+};
+
+/** Pool statistics since boot */
+struct http_pool_stats {
+	uint32_t requests;
+	uint32_t reused;		/* Requests on an open connection */
+	uint32_t opened;		/* Connections established */
+	uint32_t retried;		/* Reused connection was dead, sent again */
+	uint32_t failures;		/* Requests without a response */
+	uint32_t closed_idle;
+	uint32_t closed_server;		/* Server closed it before reuse */
+	uint32_t new_ms_avg;		/* Request time including connect */
+	uint32_t new_ms_max;
+	uint32_t reused_ms_avg;
+	uint32_t reused_ms_max;
+	uint32_t open;			/* Connections open now */
+};
+
+/**
+ * @brief Send a request and wait for its response
+ *
+ * @param req Request; strings must stay valid until return
+ * @param rsp Response status and body length
+ * @param timeout_ms Time for the whole request, including waiting for a
+ *                   free connection and connecting
+ * @return 0 when a response was received (any status), -EAGAIN when no
+ *         connection became free in time, other negative errno on
+ *         resolve, connect or transfer failure
+ */
+int http_pool_request(const struct http_pool_request *req, struct http_pool_response *rsp,
+		      int32_t timeout_ms);
+
+/**
+ * @brief Close every idle connection, e.g. before a Wi-Fi disconnect
+ *
+ * Connections in use are closed when their request finishes.
+ */
+void http_pool_close_all(void);
+
+/**
+ * @brief Get the statistics
+ */
+void http_pool_stats_get(struct http_pool_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HTTP_POOL_H_ */
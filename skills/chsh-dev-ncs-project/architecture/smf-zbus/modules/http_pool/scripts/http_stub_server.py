@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Keep-alive HTTP/1.1 server stand-in for testing http_pool on native_sim.
+
+Usage:
+    http_stub_server.py                          # port 8080, plain HTTP
+    http_stub_server.py --rtt-ms 150             # delay each response by 150 ms
+    http_stub_server.py --handshake-ms 800       # delay the first response per connection
+    http_stub_server.py --keepalive 5            # close connections idle for 5 s
+    http_stub_server.py --max-requests 10        # Connection: close on every 10th request
+    http_stub_server.py --tls --cert c.pem --key k.pem --port 8443
+
+Answers every request with 200 and a short JSON body, keeping the connection
+open unless told otherwise. --handshake-ms stands in for the TLS handshake
+on plain HTTP, so the cost of new connections is visible without
+certificates. Once per second it prints connections accepted, requests,
+and requests per connection, which is the reuse the device achieved.
+"""
+
+import argparse
+import asyncio
+import ssl
+import sys
+import time
+
+
+class Stats:
+    def __init__(self):
+        self.connections = 0
+        self.open = 0
+        self.requests = 0
+        self.bytes = 0
+        self.closed_idle = 0
+        self.closed_max = 0
+
+    def line(self, elapsed):
+        per_conn = self.requests / self.connections if self.connections else 0
+        return (f"{elapsed:7.1f}s connections={self.connections} open={self.open} "
+                f"requests={self.requests} per_conn={per_conn:.1f} bytes={self.bytes} "
+                f"closed_idle={self.closed_idle} closed_max={self.closed_max}")
+
+
+async def read_request(reader, keepalive):
+    """Return (request line, headers, body), "idle" after --keepalive, None on close."""
+    try:
+        head = await asyncio.wait_for(reader.readuntil(b"\r\n\r\n"),
+                                      keepalive if keepalive else None)
+    except asyncio.TimeoutError:
+        return "idle"
+    except (asyncio.IncompleteReadError, ConnectionError):
+        return None
+
+    lines = head.decode(errors="replace").split("\r\n")
+    headers = {}
+    for line in lines[1:]:
+        if ":" in line:
+            name, value = line.split(":", 1)
+            headers[name.strip().lower()] = value.strip()
+
+    body = b""
+    length = int(headers.get("content-length", "0"))
+    if length:
+        body = await reader.readexactly(length)
+    return lines[0], headers, body
+
+
+async def session(reader, writer, args, stats):
+    peer = writer.get_extra_info("peername")
+    stats.connections += 1
+    stats.open += 1
+    served = 0
+    print(f"Connection from {peer[0]}:{peer[1]}")
+    try:
+        while True:
+            req = await read_request(reader, args.keepalive)
+            if req == "idle":
+                stats.closed_idle += 1
+                print(f"Closing idle {peer[0]}:{peer[1]} after {served} requests")
+                break
+            if req is None:
+                break
+            line, headers, body = req
+            stats.requests += 1
+            stats.bytes += len(body)
+            served += 1
+            if args.print:
+                print(f"  {line} ({len(body)} bytes)")
+
+            delay = args.rtt_ms + (args.handshake_ms if served == 1 else 0)
+            await asyncio.sleep(delay / 1000)
+
+            close = (headers.get("connection", "").lower() == "close" or
+                     (args.max_requests and served >= args.max_requests))
+            payload = f'{{"ok":true,"n":{stats.requests}}}'.encode()
+            writer.write(b"HTTP/1.1 200 OK\r\n"
+                         b"Content-Type: application/json\r\n" +
+                         f"Content-Length: {len(payload)}\r\n".encode() +
+                         (b"Connection: close\r\n" if close else b"") +
+                         b"\r\n" + payload)
+            await writer.drain()
+            if close:
+                if args.max_requests and served >= args.max_requests:
+                    stats.closed_max += 1
+                break
+    except ConnectionError:
+        pass
+    finally:
+        stats.open -= 1
+        writer.close()
+
+
+async def report(stats, start):
+    while True:
+        await asyncio.sleep(1)
+        print(stats.line(time.monotonic() - start))
+
+
+async def main_async(args):
+    stats = Stats()
+    start = time.monotonic()
+    ctx = None
+    if args.tls:
+        ctx = ssl.create_default_context(ssl.Purpose.CLIENT_AUTH)
+        ctx.load_cert_chain(args.cert, args.key)
+    server = await asyncio.start_server(
+        lambda r, w: session(r, w, args, stats), args.host, args.port, ssl=ctx)
+    print(f"Listening on {args.host}:{args.port} ({'HTTPS' if ctx else 'HTTP'}), "
+          f"keep-alive {args.keepalive or 'unlimited'} s")
+    reporter = asyncio.create_task(report(stats, start)) if not args.quiet else None
+    try:
+        async with server:
+            await server.serve_forever()
+    finally:
+        if reporter:
+            reporter.cancel()
+        print(stats.line(time.monotonic() - start))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--rtt-ms", type=int, default=0,
+                        help="delay before each response (default: 0)")
+    parser.add_argument("--handshake-ms", type=int, default=0,
+                        help="extra delay before the first response on a connection")
+    parser.add_argument("--keepalive", type=float, default=0,
+                        help="close connections idle this many seconds (default: never)")
+    parser.add_argument("--max-requests", type=int, default=0,
+                        help="send Connection: close on this request of each connection")
+    parser.add_argument("--tls", action="store_true", help="serve HTTPS")
+    parser.add_argument("--cert", help="server certificate (PEM), with --tls")
+    parser.add_argument("--key", help="server private key (PEM), with --tls")
+    parser.add_argument("--print", action="store_true", help="print every request")
+    parser.add_argument("--quiet", action="store_true", help="no per-second statistics")
+    args = parser.parse_args()
+
+    if args.tls and not (args.cert and args.key):
+        sys.exit("--tls needs --cert and --key")
+
+    try:
+        asyncio.run(main_async(args))
+    except KeyboardInterrupt:
+        pass
+    except OSError as e:
+        sys.exit(f"Cannot listen on {args.host}:{args.port}: {e}")
+
+
+if __name__ == "__main__":
+    main()
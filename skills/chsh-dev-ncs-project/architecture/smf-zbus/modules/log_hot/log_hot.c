@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file log_hot.c
+ * @brief Sampled, rate-limited logging for module hot paths
+ *
+ * This module demonstrates:
+ * - Per-call-site state collected in an iterable RAM section
+ * - Lock-free 1-in-N sampling and rate limiting with atomics
+ * - Suppressed-message accounting reported inline and via the shell
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+
+#include "log_hot.h"
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static bool rate_limited(struct log_hot_site *site)
+{
+	uint32_t now = k_uptime_get_32();
+	atomic_val_t last = atomic_get(&site->last_ms);
+
+	/* First log of a site is never rate limited */
+	if (atomic_get(&site->logged) != 0 && (now - (uint32_t)last) < site->period_ms) {
+		return true;
+	}
+
+	/* Another thread logged in between: let that one count */
+	return !atomic_cas(&site->last_ms, last, (atomic_val_t)now);
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+bool log_hot_check(struct log_hot_site *site, uint32_t *suppressed)
+{
+	atomic_val_t hit = atomic_inc(&site->hits);
+
+	if ((site->every_n > 1 && (hit % site->every_n) != 0) ||
+	    (site->period_ms && rate_limited(site))) {
+		atomic_inc(&site->pending);
+		atomic_inc(&site->suppressed);
+		return false;
+	}
+
+	*suppressed = (uint32_t)atomic_clear(&site->pending);
+	atomic_inc(&site->logged);
+
+	return true;
+}
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_LOG_HOT_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-28s %5s %6s %10s %10s %10s  %s",
+		    "site", "1/N", "ms", "hits", "logged", "suppressed", "format");
+
+	STRUCT_SECTION_FOREACH(log_hot_site, site) {
+		const char *file = strrchr(site->file, '/');
+		char where[29];
+
+		snprintk(where, sizeof(where), "%s:%u", file ? file + 1 : site->file,
+			 site->line);
+		shell_print(sh, "%-28s %5u %6u %10u %10u %10u  %s",
+			    where, site->every_n, site->period_ms,
+			    (uint32_t)atomic_get(&site->hits),
+			    (uint32_t)atomic_get(&site->logged),
+			    (uint32_t)atomic_get(&site->suppressed),
+			    site->fmt);
+	}
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	STRUCT_SECTION_FOREACH(log_hot_site, site) {
+		atomic_clear(&site->hits);
+		atomic_clear(&site->logged);
+		atomic_clear(&site->suppressed);
+		atomic_clear(&site->pending);
+	}
+
+	shell_print(sh, "Hot-path log counters cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_hot,
+	SHELL_CMD(show, NULL, "Per call site hits, logged and suppressed", cmd_show),
+	SHELL_CMD(reset, NULL, "Clear counters", cmd_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(log_hot, &sub_log_hot, "Hot-path log sampling", NULL);
+
+#endif /* CONFIG_APP_LOG_HOT_SHELL */
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _LOG_HOT_H_
+#define _LOG_HOT_H_
+
+/**
+ * @file log_hot.h
+ * @brief Sampled, rate-limited logging for module hot paths
+ *
+ * Drop-in replacements for LOG_DBG()/LOG_INF() on paths that run once per
+ * message. Each call site decides on its own whether to log:
+ *
+ * @code
+ * // At most every 16th message, and at most once per second
+ * LOG_HOT_DBG(16, 1000, "Message received on channel: %s", zbus_chan_name(chan));
+ * @endcode
+ *
+ * Calls that are skipped are counted per call site, and the next message
+ * that does get logged carries the count: "... (+37 suppressed)".
+ *
+ * Without CONFIG_APP_LOG_HOT every LOG_HOT_*() compiles to nothing (the
+ * arguments are still type-checked, never evaluated), so the same source
+ * serves verbose and production builds. With it, a call whose level is
+ * filtered out at compile time costs no run time either.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief State of one LOG_HOT_*() call site (RAM, one per call)
+ */
+struct log_hot_site {
+	const char *file;	/* file:line and fmt identify the site */
+	const char *fmt;
+	uint16_t line;
+	uint16_t every_n;	/* Log 1 in N calls, 0/1 = every call */
+	uint32_t period_ms;	/* Minimum time between two logs, 0 = none */
+	atomic_t hits;		/* Calls that passed the level check */
+	atomic_t logged;
+	atomic_t suppressed;	/* Total skipped calls */
+	atomic_t pending;	/* Skipped since the last logged call */
+	atomic_t last_ms;
+};
+
+/**
+ * @brief Decide whether a call site logs this time
+ *
+ * @param site Call site
+ * @param suppressed Output number of calls skipped since the last log
+ * @return true to log, false when sampled out or rate limited
+ */
+bool log_hot_check(struct log_hot_site *site, uint32_t *suppressed);
+
+/** @cond INTERNAL_HIDDEN */
+static inline __printf_like(1, 2) void z_log_hot_arg_check(const char *fmt, ...)
+{
+	ARG_UNUSED(fmt);
+}
+
+#ifdef CONFIG_APP_LOG_HOT
+#define Z_LOG_HOT(_log, _level, _every_n, _period_ms, _fmt, ...)			\
+	do {										\
+		uint32_t _suppressed;							\
+		static STRUCT_SECTION_ITERABLE(log_hot_site, _site) = {			\
+			.file = __FILE__,						\
+			.fmt = _fmt,							\
+			.line = __LINE__,						\
+			.every_n = _every_n,						\
+			.period_ms = _period_ms,					\
+		};									\
+											\
+		if (!Z_LOG_CONST_LEVEL_CHECK(_level) ||					\
+		    !log_hot_check(&_site, &_suppressed)) {				\
+			break;								\
+		}									\
+		if (_suppressed) {							\
+			_log(_fmt " (+%u suppressed)", ##__VA_ARGS__, _suppressed);	\
+		} else {								\
+			_log(_fmt, ##__VA_ARGS__);					\
+		}									\
+	} while (0)
+#else
+#define Z_LOG_HOT(_log, _level, _every_n, _period_ms, _fmt, ...)			\
+	do {										\
+		if (0) {								\
+			z_log_hot_arg_check(_fmt, ##__VA_ARGS__);			\
+		}									\
+	} while (0)
+#endif
+/** @endcond */
+
+/**
+ * @brief Hot-path LOG_DBG()
+ *
+ * @param _every_n Log at most 1 in @p _every_n calls (0 or 1: every call)
+ * @param _period_ms At most one log per @p _period_ms (0: no limit)
+ * @param _fmt Format string, then its arguments
+ */
+#define LOG_HOT_DBG(_every_n, _period_ms, _fmt, ...)					\
+	Z_LOG_HOT(LOG_DBG, LOG_LEVEL_DBG, _every_n, _period_ms, _fmt, ##__VA_ARGS__)
+
+/** @brief Hot-path LOG_INF(), see LOG_HOT_DBG() */
+#define LOG_HOT_INF(_every_n, _period_ms, _fmt, ...)					\
+	Z_LOG_HOT(LOG_INF, LOG_LEVEL_INF, _every_n, _period_ms, _fmt, ##__VA_ARGS__)
+
+/** @brief Hot-path LOG_WRN(), see LOG_HOT_DBG() */
+#define LOG_HOT_WRN(_every_n, _period_ms, _fmt, ...)					\
+	Z_LOG_HOT(LOG_WRN, LOG_LEVEL_WRN, _every_n, _period_ms, _fmt, ##__VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LOG_HOT_H_ */
@@ -0,0 +1,885 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file mqtt_publisher.c
+ * @brief Batched MQTT publisher with a QoS 1 in-flight window
+ *
+ * This module demonstrates:
+ * - A zbus listener that encodes messages straight into a batch buffer
+ * - Pipelined QoS 1 publishes, matched to their PUBACKs by message id
+ * - Static batch buffers that double as the retransmit copy
+ * - One thread polling the broker socket and an eventfd, so it sleeps
+ *   until there is traffic, a batch to send or a keep-alive due
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/net/mqtt.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/tls_credentials.h>
+#include <zephyr/zvfs/eventfd.h>
+#include <errno.h>
+#include <string.h>
+
+#include "mqtt_publisher.h"
+
+#ifdef CONFIG_APP_OUTBOX
+#include "outbox.h"
+#endif
+
+#ifdef CONFIG_APP_DNS_CACHE
+#include "dns_cache.h"
+#endif
+
+#ifdef CONFIG_APP_NET_READY
+#include "net_ready.h"
+#endif
+
+#if defined(CONFIG_APP_TLS_SESSION) && defined(CONFIG_APP_MQTT_PUBLISHER_TLS)
+#include "tls_session.h"
+#define USE_TLS_SESSION 1
+#endif
+
+LOG_MODULE_REGISTER(mqtt_publisher, CONFIG_APP_MQTT_PUBLISHER_LOG_LEVEL);
+
+#define WINDOW CONFIG_APP_MQTT_PUBLISHER_WINDOW
+#define BATCH_SIZE CONFIG_APP_MQTT_PUBLISHER_BATCH_SIZE
+#define TOPIC CONFIG_APP_MQTT_PUBLISHER_TOPIC
+#define CONNACK_TIMEOUT_MS 10000
+
+/* A buffer per in-flight batch, plus the one being filled */
+#define SLOT_COUNT (WINDOW + 1)
+
+#ifdef CONFIG_APP_OUTBOX
+BUILD_ASSERT(BATCH_SIZE + sizeof(struct outbox_entry_hdr) + sizeof(uint16_t) <=
+	     CONFIG_APP_OUTBOX_BATCH_SIZE, "A batch must fit one outbox record");
+#endif
+
+ZBUS_CHAN_DEFINE(MQTT_PUBLISHER_CHAN,
+		 struct mqtt_publisher_msg,
+		 NULL,
+		 NULL,
+		 ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(.type = MQTT_PUBLISHER_DISCONNECTED)
+);
+
+enum slot_state {
+	SLOT_FREE,
+	SLOT_FILLING,	/* Taking records */
+	SLOT_READY,	/* Sealed, waiting for room in the window */
+	SLOT_INFLIGHT,	/* Published, waiting for its PUBACK */
+};
+
+struct slot {
+	enum slot_state state;
+	uint16_t msg_id;
+	uint16_t records;
+	uint32_t order;		/* Fill order, READY slots are sent oldest first */
+	uint32_t outbox_seq;	/* Outbox record it carries, 0 for new records */
+	int64_t sent_at;
+	size_t len;
+	uint8_t buf[BATCH_SIZE];
+};
+
+enum conn_state {
+	CONN_DOWN,
+	CONN_CONNECTING,	/* CONNECT sent, waiting for CONNACK */
+	CONN_UP,
+};
+
+/* Protects the slots and stats; the listener runs in publisher threads */
+static struct k_spinlock lock;
+
+static struct slot slots[SLOT_COUNT];
+static struct slot *filling;
+static int64_t filling_since;
+static uint32_t next_order;
+static bool flush_requested;
+
+static struct mqtt_publisher_stats stats;
+static uint64_t rtt_total_ms;
+
+/* Owned by the module thread */
+static struct mqtt_client client;
+static struct sockaddr_storage broker;
+static uint8_t rx_buf[CONFIG_APP_MQTT_PUBLISHER_RX_BUF_SIZE];
+static uint8_t tx_buf[CONFIG_APP_MQTT_PUBLISHER_TX_BUF_SIZE];
+static enum conn_state conn;
+static int64_t connect_started;
+static uint16_t next_msg_id;
+static int wake_fd = -1;
+
+#ifdef CONFIG_APP_NET_READY
+static atomic_t net_came_up;
+#endif
+
+#ifdef CONFIG_APP_MQTT_PUBLISHER_TLS
+static const sec_tag_t sec_tags[] = { CONFIG_APP_MQTT_PUBLISHER_SEC_TAG };
+#endif
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static void wake(void)
+{
+	if (wake_fd >= 0) {
+		(void)zvfs_eventfd_write(wake_fd, 1);
+	}
+}
+
+static bool network_usable(void)
+{
+#ifdef CONFIG_APP_NET_READY
+	return net_ready_is_ready();
+#else
+	return true;
+#endif
+}
+
+#ifdef CONFIG_APP_NET_READY
+/* Connect as soon as the network is usable, not when the retry timer says */
+static void network_cb(const struct zbus_channel *chan)
+{
+	const struct network_msg *msg = zbus_chan_const_msg(chan);
+
+	if (msg->type == NETWORK_CONNECTED) {
+		atomic_set(&net_came_up, 1);
+		wake();
+	}
+}
+
+ZBUS_LISTENER_DEFINE(mqtt_publisher_net_lis, network_cb);
+ZBUS_CHAN_ADD_OBS(NETWORK_CHAN, mqtt_publisher_net_lis, 0);
+#endif
+
+/* Lock held */
+static struct slot *slot_take(enum slot_state state)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].state == SLOT_FREE) {
+			slots[i].state = state;
+			slots[i].len = 0;
+			slots[i].records = 0;
+			slots[i].order = next_order++;
+			slots[i].outbox_seq = 0;
+			return &slots[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Lock held */
+static struct slot *oldest(enum slot_state state)
+{
+	struct slot *found = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].state == state &&
+		    (!found || (int32_t)(slots[i].order - found->order) < 0)) {
+			found = &slots[i];
+		}
+	}
+
+	return found;
+}
+
+/* Lock held. 0 when added, -ENOSPC when it does not fit */
+static int put_record(struct slot *s, const void *data, size_t len)
+{
+	size_t sep = s->len ? 1 : 0;
+	size_t room = BATCH_SIZE - s->len - sep;
+
+	if (len >= room) {
+		return -ENOSPC;
+	}
+
+	if (sep) {
+		s->buf[s->len] = '\n';
+	}
+	memcpy(&s->buf[s->len + sep], data, len);
+	s->len += sep + len;
+	s->records++;
+
+	return 0;
+}
+
+static int add_record(const struct mqtt_publisher_binding *bind, const void *msg, size_t len)
+{
+	char rec[CONFIG_APP_MQTT_PUBLISHER_RECORD_SIZE];
+	const void *data = msg;
+	k_spinlock_key_t key;
+	bool kick = false;
+	int ret = -ENOBUFS;
+
+	/* Encode before taking the lock, only the copy runs under it */
+	if (bind) {
+		ret = bind->encode(msg, rec, sizeof(rec));
+		if (ret <= 0) {
+			return ret;
+		}
+		if ((size_t)ret >= sizeof(rec)) {
+			return -EMSGSIZE;
+		}
+		data = rec;
+		len = ret;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* Second pass only after sealing a full batch */
+	for (int pass = 0; pass < 2; pass++) {
+		if (!filling) {
+			filling = slot_take(SLOT_FILLING);
+			if (!filling) {
+				ret = -ENOBUFS;
+				break;
+			}
+			filling_since = k_uptime_get();
+			kick = true;
+		}
+
+		ret = put_record(filling, data, len);
+		if (ret != -ENOSPC) {
+			break;
+		}
+		if (!filling->records) {
+			ret = -EMSGSIZE;
+			break;
+		}
+
+		filling->state = SLOT_READY;
+		filling = NULL;
+	}
+
+	if (ret == 0) {
+		stats.records++;
+	} else if (ret == -ENOBUFS) {
+		stats.dropped++;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (kick) {
+		wake();
+	}
+
+	return ret;
+}
+
+static void listener_cb(const struct zbus_channel *chan)
+{
+	STRUCT_SECTION_FOREACH(mqtt_publisher_binding, bind) {
+		if (bind->chan == chan) {
+			(void)add_record(bind, zbus_chan_const_msg(chan), 0);
+			return;
+		}
+	}
+}
+
+ZBUS_LISTENER_DEFINE(mqtt_publisher_lis, listener_cb);
+
+/* Seal the filling batch once it has lingered long enough */
+static void seal_due(int64_t now)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (filling && filling->records &&
+	    (flush_requested || now - filling_since >= CONFIG_APP_MQTT_PUBLISHER_LINGER_MS)) {
+		filling->state = SLOT_READY;
+		filling = NULL;
+	}
+	flush_requested = false;
+
+	k_spin_unlock(&lock, key);
+}
+
+static int broker_sock(void)
+{
+#ifdef CONFIG_APP_MQTT_PUBLISHER_TLS
+	return client.transport.tls.sock;
+#else
+	return client.transport.tcp.sock;
+#endif
+}
+
+static void conn_publish(enum mqtt_publisher_msg_type type)
+{
+	struct mqtt_publisher_msg msg = { .type = type };
+
+	(void)zbus_chan_pub(&MQTT_PUBLISHER_CHAN, &msg, K_MSEC(100));
+}
+
+/* Unacknowledged batches go back in front of the queue */
+static void on_disconnected(void)
+{
+	k_spinlock_key_t key;
+	uint32_t requeued = 0;
+
+	if (conn == CONN_DOWN) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	for (size_t i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].state == SLOT_INFLIGHT) {
+			slots[i].state = SLOT_READY;
+			requeued++;
+		}
+	}
+	stats.resent += requeued;
+	stats.inflight = 0;
+	stats.connected = false;
+	k_spin_unlock(&lock, key);
+
+	if (conn == CONN_UP) {
+		conn_publish(MQTT_PUBLISHER_DISCONNECTED);
+	}
+	conn = CONN_DOWN;
+
+	LOG_WRN("Disconnected from broker, %u batches to resend", requeued);
+}
+
+static void drop_connection(void)
+{
+	(void)mqtt_abort(&client);
+	on_disconnected();
+}
+
+static void on_puback(uint16_t msg_id)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t outbox_seq = 0;
+	uint32_t rtt;
+
+	for (size_t i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].state == SLOT_INFLIGHT && slots[i].msg_id == msg_id) {
+			rtt = (uint32_t)(k_uptime_get() - slots[i].sent_at);
+			rtt_total_ms += rtt;
+			stats.rtt_max_ms = MAX(stats.rtt_max_ms, rtt);
+			stats.acked++;
+			stats.inflight--;
+			outbox_seq = slots[i].outbox_seq;
+			slots[i].state = SLOT_FREE;
+			break;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+#ifdef CONFIG_APP_OUTBOX
+	/* Only now is the record delivered; a reset before this sends it again */
+	if (outbox_seq) {
+		(void)outbox_ack(outbox_seq);
+	}
+#else
+	ARG_UNUSED(outbox_seq);
+#endif
+}
+
+static void mqtt_evt_handler(struct mqtt_client *const c, const struct mqtt_evt *evt)
+{
+	switch (evt->type) {
+	case MQTT_EVT_CONNACK:
+		if (evt->result != 0) {
+			LOG_ERR("Broker refused connection: %d", evt->result);
+			break;
+		}
+		conn = CONN_UP;
+		K_SPINLOCK(&lock) {
+			stats.connects++;
+			stats.connected = true;
+		}
+		LOG_INF("Connected to %s", CONFIG_APP_MQTT_PUBLISHER_BROKER_HOST);
+		conn_publish(MQTT_PUBLISHER_CONNECTED);
+		break;
+
+	case MQTT_EVT_PUBACK:
+		if (evt->result != 0) {
+			LOG_WRN("PUBACK %u error: %d", evt->param.puback.message_id, evt->result);
+		}
+		on_puback(evt->param.puback.message_id);
+		break;
+
+	case MQTT_EVT_DISCONNECT:
+		on_disconnected();
+		break;
+
+	default:
+		break;
+	}
+}
+
+#ifdef CONFIG_APP_DNS_CACHE
+static int broker_resolve(void)
+{
+	/* Cached across reconnects; an expired address still works if DNS is slow to return */
+	struct sockaddr_in *sin = (struct sockaddr_in *)&broker;
+
+	return dns_cache_resolve(CONFIG_APP_MQTT_PUBLISHER_BROKER_HOST,
+				 CONFIG_APP_MQTT_PUBLISHER_BROKER_PORT, sin);
+}
+#else
+static int broker_resolve(void)
+{
+	struct zsock_addrinfo hints = {
+		.ai_family = AF_INET,
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct zsock_addrinfo *res;
+	char port[6];
+	int err;
+
+	snprintk(port, sizeof(port), "%d", CONFIG_APP_MQTT_PUBLISHER_BROKER_PORT);
+
+	err = zsock_getaddrinfo(CONFIG_APP_MQTT_PUBLISHER_BROKER_HOST, port, &hints, &res);
+	if (err) {
+		return err;
+	}
+	memcpy(&broker, res->ai_addr, MIN(res->ai_addrlen, sizeof(broker)));
+	zsock_freeaddrinfo(res);
+
+	return 0;
+}
+#endif
+
+static int broker_connect(void)
+{
+#ifdef USE_TLS_SESSION
+	struct tls_session_probe probe;
+#endif
+	int err;
+
+	err = broker_resolve();
+	if (err) {
+		LOG_WRN("Resolving %s failed: %d", CONFIG_APP_MQTT_PUBLISHER_BROKER_HOST, err);
+		return -EHOSTUNREACH;
+	}
+
+	mqtt_client_init(&client);
+	client.broker = &broker;
+	client.evt_cb = mqtt_evt_handler;
+	client.client_id.utf8 = (const uint8_t *)CONFIG_APP_MQTT_PUBLISHER_CLIENT_ID;
+	client.client_id.size = strlen(CONFIG_APP_MQTT_PUBLISHER_CLIENT_ID);
+	client.protocol_version = MQTT_VERSION_3_1_1;
+	client.rx_buf = rx_buf;
+	client.rx_buf_size = sizeof(rx_buf);
+	client.tx_buf = tx_buf;
+	client.tx_buf_size = sizeof(tx_buf);
+
+#ifdef CONFIG_APP_MQTT_PUBLISHER_TLS
+	client.transport.type = MQTT_TRANSPORT_SECURE;
+	client.transport.tls.config.peer_verify = TLS_PEER_VERIFY_REQUIRED;
+	client.transport.tls.config.sec_tag_list = sec_tags;
+	client.transport.tls.config.sec_tag_count = ARRAY_SIZE(sec_tags);
+	client.transport.tls.config.hostname = CONFIG_APP_MQTT_PUBLISHER_BROKER_HOST;
+#ifdef USE_TLS_SESSION
+	/* Reconnects after a Wi-Fi drop offer the last session */
+	client.transport.tls.config.session_cache = tls_session_cache_enabled() ?
+		TLS_SESSION_CACHE_ENABLED : TLS_SESSION_CACHE_DISABLED;
+#endif
+#else
+	client.transport.type = MQTT_TRANSPORT_NON_SECURE;
+#endif
+
+#ifdef USE_TLS_SESSION
+	tls_session_handshake_begin(&probe, CONFIG_APP_MQTT_PUBLISHER_BROKER_HOST);
+	err = mqtt_connect(&client);
+	tls_session_handshake_end(&probe, err);
+#else
+	err = mqtt_connect(&client);
+#endif
+	if (err) {
+		LOG_WRN("mqtt_connect failed: %d", err);
+		return err;
+	}
+
+	conn = CONN_CONNECTING;
+	connect_started = k_uptime_get();
+
+	return 0;
+}
+
+/*
+ * The payload goes out from the slot buffer; tx_buf only holds the fixed
+ * header and topic.
+ */
+static int publish_slot(struct slot *s)
+{
+	struct mqtt_publish_param param = {
+		.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+		.message.topic.topic.utf8 = (const uint8_t *)TOPIC,
+		.message.topic.topic.size = sizeof(TOPIC) - 1,
+		.message.payload.data = s->buf,
+		.message.payload.len = s->len,
+	};
+	int err;
+
+	if (++next_msg_id == 0) {
+		next_msg_id = 1;
+	}
+	s->msg_id = next_msg_id;
+	param.message_id = s->msg_id;
+
+	err = mqtt_publish(&client, &param);
+	if (err) {
+		LOG_WRN("mqtt_publish failed: %d", err);
+		return err;
+	}
+
+	K_SPINLOCK(&lock) {
+		s->sent_at = k_uptime_get();
+		s->state = SLOT_INFLIGHT;
+		stats.publishes++;
+		stats.inflight++;
+		stats.inflight_max = MAX(stats.inflight_max, stats.inflight);
+	}
+
+	return 0;
+}
+
+static uint32_t window_room(void)
+{
+	uint32_t room = 0;
+
+	K_SPINLOCK(&lock) {
+		room = WINDOW - MIN(stats.inflight, WINDOW);
+	}
+
+	return room;
+}
+
+#ifdef CONFIG_APP_OUTBOX
+/*
+ * Copy one outbox record into a free slot and publish it. The outbox keeps
+ * it until on_puback() confirms delivery with outbox_ack().
+ */
+static int outbox_send(const void *data, size_t len, uint32_t seq, void *user_data)
+{
+	struct slot *s = NULL;
+	int err;
+
+	ARG_UNUSED(user_data);
+
+	if (len > BATCH_SIZE) {
+		return -EMSGSIZE;
+	}
+
+	K_SPINLOCK(&lock) {
+		s = slot_take(SLOT_READY);
+	}
+	if (!s) {
+		return -ENOBUFS;
+	}
+
+	memcpy(s->buf, data, len);
+	s->len = len;
+	s->outbox_seq = seq;
+
+	err = publish_slot(s);
+	if (err) {
+		/* The record stays in the outbox */
+		K_SPINLOCK(&lock) {
+			s->state = SLOT_FREE;
+		}
+		return err;
+	}
+
+	return -EINPROGRESS;
+}
+
+/* Lock held. Oldest READY slot that is not an outbox record already */
+static struct slot *oldest_new(void)
+{
+	struct slot *found = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(slots); i++) {
+		if (slots[i].state == SLOT_READY && !slots[i].outbox_seq &&
+		    (!found || (int32_t)(slots[i].order - found->order) < 0)) {
+			found = &slots[i];
+		}
+	}
+
+	return found;
+}
+
+/*
+ * Offline: sealed batches move to flash instead of filling every buffer.
+ * Outbox records waiting for a resend stay in RAM, the outbox still has
+ * them as not delivered.
+ */
+static void spill_to_outbox(void)
+{
+	struct slot *s = NULL;
+
+	for (;;) {
+		K_SPINLOCK(&lock) {
+			s = oldest_new();
+		}
+		if (!s || outbox_put(s->buf, s->len)) {
+			return;
+		}
+
+		K_SPINLOCK(&lock) {
+			s->state = SLOT_FREE;
+			stats.to_outbox++;
+		}
+	}
+}
+#endif /* CONFIG_APP_OUTBOX */
+
+static void send_ready(void)
+{
+	struct slot *s = NULL;
+
+	/* RAM batches first: buffers are scarce, the outbox is not */
+	while (window_room()) {
+		K_SPINLOCK(&lock) {
+			s = oldest(SLOT_READY);
+		}
+		if (!s) {
+			break;
+		}
+		if (publish_slot(s)) {
+			drop_connection();
+			return;
+		}
+	}
+
+#ifdef CONFIG_APP_OUTBOX
+	if (window_room() && outbox_pending()) {
+		(void)outbox_drain(outbox_send, NULL, window_room());
+	}
+#endif
+}
+
+/* Milliseconds until something is due, -1 for none */
+static int next_timeout(int64_t now, int64_t retry_at)
+{
+	int64_t due = INT64_MAX;
+	int keepalive;
+
+	if (conn == CONN_DOWN) {
+		due = retry_at;
+	} else {
+		keepalive = mqtt_keepalive_time_left(&client);
+		if (keepalive >= 0) {
+			due = now + keepalive;
+		}
+		if (conn == CONN_CONNECTING) {
+			due = MIN(due, connect_started + CONNACK_TIMEOUT_MS);
+		}
+	}
+
+	K_SPINLOCK(&lock) {
+		if (filling && filling->records) {
+			due = MIN(due, filling_since + CONFIG_APP_MQTT_PUBLISHER_LINGER_MS);
+		}
+	}
+
+	if (due == INT64_MAX) {
+		return -1;
+	}
+
+	return (int)CLAMP(due - now, 0, INT32_MAX);
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int mqtt_publisher_enqueue(const void *data, size_t len)
+{
+	return add_record(NULL, data, len);
+}
+
+void mqtt_publisher_flush(void)
+{
+	K_SPINLOCK(&lock) {
+		flush_requested = true;
+	}
+	wake();
+}
+
+void mqtt_publisher_stats_get(struct mqtt_publisher_stats *out)
+{
+	K_SPINLOCK(&lock) {
+		*out = stats;
+		out->rtt_avg_ms = stats.acked ? (uint32_t)(rtt_total_ms / stats.acked) : 0;
+	}
+}
+
+/*******************************************************************************
+ * Module Thread
+ ******************************************************************************/
+
+static void mqtt_publisher_thread(void *p1, void *p2, void *p3)
+{
+	struct zsock_pollfd fds[2];
+	zvfs_eventfd_t val;
+	int64_t retry_at = 0;
+	int64_t now;
+	int nfds;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	wake_fd = zvfs_eventfd(0, ZVFS_EFD_NONBLOCK);
+	if (wake_fd < 0) {
+		LOG_ERR("eventfd failed: %d", errno);
+		return;
+	}
+
+	LOG_INF("MQTT publisher started, window %d, batch %d bytes", WINDOW, BATCH_SIZE);
+
+	while (1) {
+		now = k_uptime_get();
+
+#ifdef CONFIG_APP_NET_READY
+		if (atomic_cas(&net_came_up, 1, 0)) {
+			retry_at = 0;
+		}
+#endif
+
+		if (conn == CONN_DOWN && now >= retry_at && network_usable()) {
+			if (broker_connect()) {
+				retry_at = now + CONFIG_APP_MQTT_PUBLISHER_RECONNECT_SECONDS * 1000;
+			}
+		} else if (conn == CONN_CONNECTING && now - connect_started >= CONNACK_TIMEOUT_MS) {
+			LOG_WRN("No CONNACK from broker");
+			drop_connection();
+			retry_at = now + CONFIG_APP_MQTT_PUBLISHER_RECONNECT_SECONDS * 1000;
+		}
+
+		seal_due(now);
+
+		if (conn == CONN_UP) {
+			send_ready();
+		}
+#ifdef CONFIG_APP_OUTBOX
+		else {
+			spill_to_outbox();
+		}
+#endif
+
+		nfds = 0;
+		fds[nfds++] = (struct zsock_pollfd){ .fd = wake_fd, .events = ZSOCK_POLLIN };
+		if (conn != CONN_DOWN) {
+			fds[nfds++] = (struct zsock_pollfd){ .fd = broker_sock(),
+							     .events = ZSOCK_POLLIN };
+		}
+
+		ret = zsock_poll(fds, nfds, next_timeout(k_uptime_get(), retry_at));
+		if (ret < 0) {
+			LOG_ERR("poll failed: %d", errno);
+			k_sleep(K_SECONDS(1));
+			continue;
+		}
+
+		if (fds[0].revents & ZSOCK_POLLIN) {
+			(void)zvfs_eventfd_read(wake_fd, &val);
+		}
+
+		if (nfds > 1 && (fds[1].revents & ZSOCK_POLLIN)) {
+			ret = mqtt_input(&client);
+			if (ret) {
+				LOG_WRN("mqtt_input failed: %d", ret);
+				drop_connection();
+			}
+		} else if (nfds > 1 && (fds[1].revents & (ZSOCK_POLLERR | ZSOCK_POLLHUP |
+							  ZSOCK_POLLNVAL))) {
+			drop_connection();
+		}
+
+		if (conn != CONN_DOWN) {
+			ret = mqtt_live(&client);
+			if (ret && ret != -EAGAIN) {
+				LOG_WRN("mqtt_live failed: %d", ret);
+				drop_connection();
+			}
+		}
+
+		if (conn == CONN_DOWN && retry_at <= now) {
+			retry_at = k_uptime_get() + CONFIG_APP_MQTT_PUBLISHER_RECONNECT_SECONDS * 1000;
+		}
+	}
+}
+
+K_THREAD_DEFINE(mqtt_publisher_module,
+		CONFIG_APP_MQTT_PUBLISHER_STACK_SIZE,
+		mqtt_publisher_thread,
+		NULL, NULL, NULL,
+		CONFIG_APP_MQTT_PUBLISHER_PRIORITY,
+		0, 0);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_MQTT_PUBLISHER_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct mqtt_publisher_stats s;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	mqtt_publisher_stats_get(&s);
+
+	shell_print(sh, "broker    %s:%d %s (%u connects)", CONFIG_APP_MQTT_PUBLISHER_BROKER_HOST,
+		    CONFIG_APP_MQTT_PUBLISHER_BROKER_PORT, s.connected ? "up" : "down", s.connects);
+	shell_print(sh, "records   %u (dropped %u), %u per publish", s.records, s.dropped,
+		    s.publishes ? s.records / s.publishes : 0);
+	shell_print(sh, "publishes %u  acked %u  resent %u  to_outbox %u", s.publishes, s.acked,
+		    s.resent, s.to_outbox);
+	shell_print(sh, "in flight %u of %d (max %u)", s.inflight, WINDOW, s.inflight_max);
+	shell_print(sh, "rtt       avg %u ms  max %u ms", s.rtt_avg_ms, s.rtt_max_ms);
+
+	return 0;
+}
+
+static int cmd_send(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+
+	err = mqtt_publisher_enqueue(argv[1], strlen(argv[1]));
+	if (err) {
+		shell_error(sh, "mqtt_publisher_enqueue failed: %d", err);
+	}
+
+	return err;
+}
+
+static int cmd_flush(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	mqtt_publisher_flush();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_mqtt_pub,
+	SHELL_CMD(show, NULL, "Connection, batching and window statistics", cmd_show),
+	SHELL_CMD_ARG(send, NULL, "Add a text record: send <text>", cmd_send, 2, 0),
+	SHELL_CMD(flush, NULL, "Publish the current batch now", cmd_flush),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(mqtt_pub, &sub_mqtt_pub, "Batched MQTT publisher", NULL);
+
+#endif /* CONFIG_APP_MQTT_PUBLISHER_SHELL */
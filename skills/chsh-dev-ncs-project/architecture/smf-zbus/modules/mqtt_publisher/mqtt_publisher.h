@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _MQTT_PUBLISHER_H_
+#define _MQTT_PUBLISHER_H_
+
+/**
+ * @file mqtt_publisher.h
+ * @brief Batched MQTT publisher with a QoS 1 in-flight window
+ *
+ * Modules bind a zbus channel to the publisher with an encoder that
+ * turns one message into one record (a line of JSON, for example):
+ *
+ * @code
+ * static int sensor_encode(const void *msg, char *buf, size_t len)
+ * {
+ *     const struct sensor_msg *m = msg;
+ *
+ *     if (m->type != SENSOR_DATA_READY) {
+ *         return 0;                       // not published
+ *     }
+ *     return snprintk(buf, len, "{\"ts\":%u}", m->timestamp);
+ * }
+ *
+ * MQTT_PUBLISHER_CHAN_DEFINE(SENSOR_CHAN, sensor_encode);
+ * @endcode
+ *
+ * Records are appended, newline separated, to a batch that is published
+ * as one QoS 1 message when it is full or CONFIG_APP_MQTT_PUBLISHER_LINGER_MS
+ * after its first record. Up to CONFIG_APP_MQTT_PUBLISHER_WINDOW batches
+ * are in flight at once: the next publish does not wait for the previous
+ * PUBACK, so throughput is window / round trip instead of 1 / round trip.
+ *
+ * Batch buffers are allocated statically; a batch stays in its buffer
+ * until its PUBACK, and the MQTT library sends the payload straight from
+ * it. Batches not acknowledged when the connection drops are sent again
+ * after reconnecting (at-least-once), or moved to the outbox with
+ * CONFIG_APP_OUTBOX. Batches drained from the outbox are marked delivered
+ * there only when their PUBACK arrives.
+ *
+ * Connection changes are published on MQTT_PUBLISHER_CHAN.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum mqtt_publisher_msg_type {
+	MQTT_PUBLISHER_DISCONNECTED = 0x1,
+	MQTT_PUBLISHER_CONNECTED,
+};
+
+struct mqtt_publisher_msg {
+	enum mqtt_publisher_msg_type type;
+};
+
+ZBUS_CHAN_DECLARE(MQTT_PUBLISHER_CHAN);
+
+/* Listener behind every MQTT_PUBLISHER_CHAN_DEFINE() */
+ZBUS_OBS_DECLARE(mqtt_publisher_lis);
+
+/**
+ * @brief Encode one channel message as a record
+ *
+ * Runs in the publishing thread, before the batch is locked, into a
+ * buffer of CONFIG_APP_MQTT_PUBLISHER_RECORD_SIZE bytes on its stack.
+ *
+ * @param msg Channel message
+ * @param buf Where to write the record, without a trailing newline
+ * @param len Room in @p buf
+ * @return Record length, 0 to skip the message, a value >= @p len when
+ *         it does not fit (snprintk() semantics), or negative errno
+ */
+typedef int (*mqtt_publisher_encode_t)(const void *msg, char *buf, size_t len);
+
+/** Channel bound to the publisher (ROM) */
+struct mqtt_publisher_binding {
+	const struct zbus_channel *chan;
+	mqtt_publisher_encode_t encode;
+};
+
+/**
+ * @brief Publish every message of a channel through the batcher
+ *
+ * @param _chan zbus channel
+ * @param _encode Encoder, see mqtt_publisher_encode_t
+ */
+#define MQTT_PUBLISHER_CHAN_DEFINE(_chan, _encode)					\
+	ZBUS_CHAN_ADD_OBS(_chan, mqtt_publisher_lis, 0);				\
+	static const STRUCT_SECTION_ITERABLE(mqtt_publisher_binding,			\
+					     _CONCAT(mqtt_publisher_bind_, _chan)) = {	\
+		.chan = &_chan,								\
+		.encode = _encode,							\
+	}
+
+/**
+ * @brief Publisher statistics since boot
+ */
+struct mqtt_publisher_stats {
+	uint32_t records;	/* Records added to a batch */
+	uint32_t dropped;	/* Records with no batch buffer left */
+	uint32_t publishes;	/* PUBLISH packets sent */
+	uint32_t acked;		/* PUBACKs received */
+	uint32_t resent;	/* Batches sent again after a reconnect */
+	uint32_t to_outbox;	/* Batches moved to the outbox while offline */
+	uint32_t connects;
+	uint32_t inflight;	/* Now */
+	uint32_t inflight_max;
+	uint32_t rtt_avg_ms;	/* PUBLISH to PUBACK */
+	uint32_t rtt_max_ms;
+	bool connected;
+};
+
+/**
+ * @brief Add a raw record to the current batch
+ *
+ * For data that does not come from a bound channel, such as the payload
+ * of NETWORK_SEND_DATA. Safe from any thread.
+ *
+ * @return 0 on success, -EMSGSIZE when it cannot fit a batch, -ENOBUFS
+ *         when every batch buffer is full or in flight
+ */
+int mqtt_publisher_enqueue(const void *data, size_t len);
+
+/**
+ * @brief Publish the current batch now instead of after the linger time
+ */
+void mqtt_publisher_flush(void);
+
+/**
+ * @brief Get the statistics
+ */
+void mqtt_publisher_stats_get(struct mqtt_publisher_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MQTT_PUBLISHER_H_ */
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Minimal MQTT 3.1.1 broker stand-in for testing mqtt_publisher on native_sim.
+
+Usage:
+    mqtt_stub_broker.py                       # port 1883, immediate PUBACKs
+    mqtt_stub_broker.py --rtt-ms 300          # simulate a 300 ms round trip
+    mqtt_stub_broker.py --drop-after 20       # close the connection after 20 publishes
+    mqtt_stub_broker.py --print               # print every record received
+
+Accepts CONNECT, PUBLISH (QoS 0 and 1), PINGREQ and DISCONNECT; nothing is
+routed to subscribers. Each PUBACK is delayed by --rtt-ms, so the device
+sees a high-latency link while the stub still answers in order. Once per
+second it prints publishes, records and the most PUBACKs outstanding, which
+is the in-flight window the device actually used.
+"""
+
+import argparse
+import asyncio
+import sys
+import time
+
+CONNECT, CONNACK, PUBLISH, PUBACK = 1, 2, 3, 4
+PINGREQ, PINGRESP, DISCONNECT = 12, 13, 14
+
+
+class Stats:
+    def __init__(self):
+        self.publishes = 0
+        self.records = 0
+        self.bytes = 0
+        self.outstanding = 0
+        self.outstanding_max = 0
+        self.connects = 0
+
+    def line(self, elapsed):
+        return (f"{elapsed:7.1f}s connects={self.connects} publishes={self.publishes} "
+                f"records={self.records} bytes={self.bytes} "
+                f"inflight_max={self.outstanding_max}")
+
+
+async def read_packet(reader):
+    """Return (type, flags, body) or None at end of stream."""
+    first = await reader.read(1)
+    if not first:
+        return None
+    length, shift = 0, 0
+    while True:
+        b = (await reader.readexactly(1))[0]
+        length |= (b & 0x7F) << shift
+        if not b & 0x80:
+            break
+        shift += 7
+    body = await reader.readexactly(length) if length else b""
+    return first[0] >> 4, first[0] & 0x0F, body
+
+
+async def delayed_puback(writer, msg_id, delay, stats):
+    await asyncio.sleep(delay)
+    if not writer.is_closing():
+        writer.write(bytes([PUBACK << 4, 2, msg_id >> 8, msg_id & 0xFF]))
+        await writer.drain()
+    stats.outstanding -= 1
+
+
+async def session(reader, writer, args, stats):
+    peer = writer.get_extra_info("peername")
+    pending = []
+    publishes = 0
+    try:
+        while True:
+            pkt = await read_packet(reader)
+            if pkt is None:
+                break
+            ptype, flags, body = pkt
+
+            if ptype == CONNECT:
+                stats.connects += 1
+                client_id_len = int.from_bytes(body[10:12], "big")
+                client_id = body[12:12 + client_id_len].decode(errors="replace")
+                print(f"CONNECT {client_id} from {peer[0]}:{peer[1]}")
+                writer.write(bytes([CONNACK << 4, 2, 0, 0]))
+            elif ptype == PUBLISH:
+                qos = (flags >> 1) & 3
+                topic_len = int.from_bytes(body[0:2], "big")
+                pos = 2 + topic_len
+                if qos:
+                    msg_id = int.from_bytes(body[pos:pos + 2], "big")
+                    pos += 2
+                payload = body[pos:]
+                stats.publishes += 1
+                stats.bytes += len(payload)
+                lines = [r for r in payload.split(b"\n") if r]
+                stats.records += len(lines)
+                if args.print:
+                    for r in lines:
+                        print(f"  {r.decode(errors='replace')}")
+                if qos:
+                    stats.outstanding += 1
+                    stats.outstanding_max = max(stats.outstanding_max, stats.outstanding)
+                    pending.append(asyncio.create_task(
+                        delayed_puback(writer, msg_id, args.rtt_ms / 1000, stats)))
+                publishes += 1
+                if args.drop_after and publishes >= args.drop_after:
+                    print(f"Dropping connection after {publishes} publishes")
+                    break
+            elif ptype == PINGREQ:
+                writer.write(bytes([PINGRESP << 4, 0]))
+            elif ptype == DISCONNECT:
+                break
+            await writer.drain()
+    except (asyncio.IncompleteReadError, ConnectionError):
+        pass
+    finally:
+        for task in pending:
+            task.cancel()
+        writer.close()
+        print(f"Closed {peer[0]}:{peer[1]}")
+
+
+async def report(stats, start):
+    while True:
+        await asyncio.sleep(1)
+        print(stats.line(time.monotonic() - start))
+
+
+async def main_async(args):
+    stats = Stats()
+    start = time.monotonic()
+    server = await asyncio.start_server(
+        lambda r, w: session(r, w, args, stats), args.host, args.port)
+    print(f"Listening on {args.host}:{args.port}, PUBACK after {args.rtt_ms} ms")
+    reporter = asyncio.create_task(report(stats, start)) if not args.quiet else None
+    try:
+        async with server:
+            await server.serve_forever()
+    finally:
+        if reporter:
+            reporter.cancel()
+        print(stats.line(time.monotonic() - start))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--rtt-ms", type=int, default=0,
+                        help="delay before each PUBACK (default: 0)")
+    parser.add_argument("--drop-after", type=int, default=0,
+                        help="close each connection after this many publishes")
+    parser.add_argument("--print", action="store_true", help="print every record")
+    parser.add_argument("--quiet", action="store_true", help="no per-second statistics")
+    args = parser.parse_args()
+
+    try:
+        asyncio.run(main_async(args))
+    except KeyboardInterrupt:
+        pass
+    except OSError as e:
+        sys.exit(f"Cannot listen on {args.host}:{args.port}: {e}")
+
+
+if __name__ == "__main__":
+    main()
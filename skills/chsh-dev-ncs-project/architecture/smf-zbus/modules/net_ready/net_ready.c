@@ -0,0 +1,483 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file net_ready.c
+ * @brief Network readiness probe publishing NETWORK_CONNECTED on zbus
+ *
+ * This module demonstrates:
+ * - Combining L4, DHCP and DNS net_mgmt events into one readiness signal
+ * - An optional active probe for the cases events cannot cover
+ * - Measuring how long each stage of bring-up takes
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_event.h>
+#include <zephyr/net/socket.h>
+#include <errno.h>
+#include <string.h>
+
+#ifdef CONFIG_DNS_RESOLVER
+#include <zephyr/net/dns_resolve.h>
+#endif
+
+#include "net_ready.h"
+
+LOG_MODULE_REGISTER(net_ready, CONFIG_APP_NET_READY_LOG_LEVEL);
+
+enum cond_idx {
+	COND_L4,
+	COND_DHCP,
+	COND_DNS,
+	COND_COUNT,
+};
+
+#define NEED (BIT(COND_L4) |									\
+	      (IS_ENABLED(CONFIG_APP_NET_READY_WAIT_DHCP) ? BIT(COND_DHCP) : 0) |		\
+	      (IS_ENABLED(CONFIG_APP_NET_READY_WAIT_DNS) ? BIT(COND_DNS) : 0))
+
+#define PROBE (IS_ENABLED(CONFIG_APP_NET_READY_PROBE_DNS) ||					\
+	       IS_ENABLED(CONFIG_APP_NET_READY_PROBE_TCP))
+
+#ifdef CONFIG_APP_NET_READY_PROBE_TCP
+#define PROBE_SERVICE STRINGIFY(CONFIG_APP_NET_READY_PROBE_PORT)
+#else
+#define PROBE_SERVICE NULL
+#endif
+
+/* The one definition of the template channel; other modules only publish on it */
+ZBUS_CHAN_DEFINE(NETWORK_CHAN,
+		 struct network_msg,
+		 NULL,
+		 NULL,
+		 ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(.type = NETWORK_DISCONNECTED)
+);
+
+static struct k_spinlock lock;
+static uint32_t have;			/* BIT(COND_*) seen since the last loss */
+static int64_t up_at;			/* Interface up, or first condition */
+static int64_t cond_at[COND_COUNT];
+static uint32_t generation;		/* Bumped on every loss */
+static struct net_ready_stats stats;
+
+/* Owned by ready_q */
+static bool ready;
+static uint32_t ready_gen;
+
+static atomic_t ready_flag;
+static K_EVENT_DEFINE(ready_evt);
+
+static struct net_mgmt_event_callback if_cb;
+static struct net_mgmt_event_callback l4_cb;
+static struct net_mgmt_event_callback ipv4_cb;
+#ifdef CONFIG_DNS_RESOLVER
+static struct net_mgmt_event_callback dns_cb;
+#endif
+
+/* Probes block in getaddrinfo()/connect(); keep them off the system queue */
+static K_THREAD_STACK_DEFINE(ready_stack, CONFIG_APP_NET_READY_STACK_SIZE);
+static struct k_work_q ready_q;
+
+static void eval_handler(struct k_work *work);
+static K_WORK_DEFINE(eval_work, eval_handler);
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static uint32_t since_up(int64_t t)
+{
+	return t && up_at && t > up_at ? (uint32_t)(t - up_at) : 0;
+}
+
+/* Lock held */
+static void mark(enum cond_idx c, int64_t now)
+{
+	/* A DNS server can be configured long before any link: not a start */
+	if (!up_at && c != COND_DNS) {
+		up_at = now;
+	}
+
+	if (!(have & BIT(c))) {
+		have |= BIT(c);
+		cond_at[c] = now;
+	}
+}
+
+/* Lock held */
+static void lose(void)
+{
+	have = 0;
+	up_at = 0;
+	memset(cond_at, 0, sizeof(cond_at));
+	generation++;
+}
+
+static bool stale(uint32_t gen)
+{
+	bool changed;
+
+	K_SPINLOCK(&lock) {
+		changed = gen != generation;
+	}
+
+	return changed;
+}
+
+/* Statically configured servers, or ones added before we listened */
+static bool dns_servers_known(void)
+{
+#ifdef CONFIG_DNS_RESOLVER
+	struct dns_resolve_context *ctx = dns_resolve_get_default();
+
+	for (size_t i = 0; ctx && i < ARRAY_SIZE(ctx->servers); i++) {
+		if (ctx->servers[i].dns_server.sa_family == AF_INET ||
+		    ctx->servers[i].dns_server.sa_family == AF_INET6) {
+			return true;
+		}
+	}
+#endif
+
+	return false;
+}
+
+static int probe_once(void)
+{
+#if PROBE
+	struct zsock_addrinfo hints = {
+		.ai_family = AF_UNSPEC,
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct zsock_addrinfo *res;
+#ifdef CONFIG_APP_NET_READY_PROBE_TCP
+	int sock;
+#endif
+	int err;
+
+	err = zsock_getaddrinfo(CONFIG_APP_NET_READY_PROBE_HOST, PROBE_SERVICE, &hints, &res);
+	if (err) {
+		LOG_DBG("Probe lookup failed: %d", err);
+		return -EHOSTUNREACH;
+	}
+
+#ifdef CONFIG_APP_NET_READY_PROBE_TCP
+	/* Lookup and route work; a handshake proves the path end to end */
+	sock = zsock_socket(res->ai_family, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 || zsock_connect(sock, res->ai_addr, res->ai_addrlen) < 0) {
+		err = -errno;
+		LOG_DBG("Probe connect failed: %d", err);
+	}
+	if (sock >= 0) {
+		zsock_close(sock);
+	}
+#endif
+
+	zsock_freeaddrinfo(res);
+
+	return err;
+#else
+	return 0;
+#endif
+}
+
+/* Retry until it works, the link goes away, or the timeout passes */
+static bool probe(uint32_t gen, int64_t *done_at)
+{
+	*done_at = 0;
+
+#if PROBE
+	int64_t deadline = k_uptime_get() + CONFIG_APP_NET_READY_PROBE_TIMEOUT_MS;
+
+	do {
+		if (probe_once() == 0) {
+			*done_at = k_uptime_get();
+			return true;
+		}
+		if (stale(gen)) {
+			return false;
+		}
+		k_sleep(K_MSEC(CONFIG_APP_NET_READY_PROBE_RETRY_MS));
+	} while (k_uptime_get() < deadline);
+
+	return false;
+#else
+	ARG_UNUSED(gen);
+
+	return true;
+#endif
+}
+
+static void publish(enum network_msg_type type, int error_code)
+{
+	struct network_msg msg = {
+		.type = type,
+		.error_code = error_code,
+	};
+	int err = zbus_chan_pub(&NETWORK_CHAN, &msg, K_SECONDS(1));
+
+	if (err) {
+		LOG_WRN("Publish failed: %d", err);
+	}
+}
+
+static void set_down(void)
+{
+	ready = false;
+	atomic_clear(&ready_flag);
+	k_event_clear(&ready_evt, BIT(0));
+
+	K_SPINLOCK(&lock) {
+		stats.lost++;
+	}
+
+	publish(NETWORK_DISCONNECTED, 0);
+	LOG_INF("Network lost");
+}
+
+static void set_ready(uint32_t gen, bool probe_ok, int64_t probe_at)
+{
+	int64_t now = k_uptime_get();
+	uint32_t ms;
+
+	K_SPINLOCK(&lock) {
+		ms = since_up(now);
+		stats.ready++;
+		stats.probe_failed += probe_ok ? 0 : 1;
+		stats.last_l4_ms = since_up(cond_at[COND_L4]);
+		stats.last_dhcp_ms = since_up(cond_at[COND_DHCP]);
+		stats.last_dns_ms = since_up(cond_at[COND_DNS]);
+		stats.last_probe_ms = since_up(probe_at);
+		stats.last_ready_ms = ms;
+		stats.min_ready_ms = stats.ready == 1 ? ms : MIN(stats.min_ready_ms, ms);
+		stats.max_ready_ms = MAX(stats.max_ready_ms, ms);
+		stats.total_ready_ms += ms;
+	}
+
+	ready = true;
+	ready_gen = gen;
+	atomic_set(&ready_flag, 1);
+	k_event_post(&ready_evt, BIT(0));
+
+	/* Usable but unproven: clients may connect, or wait for the next one */
+	publish(NETWORK_CONNECTED, probe_ok ? 0 : -ETIMEDOUT);
+
+	if (probe_ok) {
+		LOG_INF("Network ready in %u ms", ms);
+	} else {
+		LOG_WRN("Network up but probe failed, ready after %u ms", ms);
+	}
+}
+
+static void eval_handler(struct k_work *work)
+{
+	int64_t probe_at;
+	uint32_t gen;
+	uint32_t h;
+	bool ok;
+
+	ARG_UNUSED(work);
+
+	K_SPINLOCK(&lock) {
+		if ((NEED & BIT(COND_DNS)) && !(have & BIT(COND_DNS)) && dns_servers_known()) {
+			mark(COND_DNS, k_uptime_get());
+		}
+		h = have;
+		gen = generation;
+	}
+
+	/* A loss since we went ready, even if the link is back already */
+	if (ready && (gen != ready_gen || !(h & BIT(COND_L4)))) {
+		set_down();
+	}
+
+	if (ready || (h & NEED) != NEED) {
+		return;
+	}
+
+	ok = probe(gen, &probe_at);
+
+	if (stale(gen)) {
+		/* Lost while probing; the loss queued another evaluation */
+		return;
+	}
+
+	set_ready(gen, ok, probe_at);
+}
+
+/* net_mgmt context: record and hand over */
+static void event_cb(struct net_mgmt_event_callback *cb, uint64_t mgmt_event,
+		     struct net_if *iface)
+{
+	int64_t now = k_uptime_get();
+
+	ARG_UNUSED(cb);
+
+	K_SPINLOCK(&lock) {
+		switch (mgmt_event) {
+		case NET_EVENT_IF_UP:
+			if (iface == net_if_get_default() && !up_at) {
+				up_at = now;
+			}
+			break;
+		case NET_EVENT_IF_DOWN:
+			if (iface == net_if_get_default()) {
+				lose();
+			}
+			break;
+		case NET_EVENT_L4_CONNECTED:
+			mark(COND_L4, now);
+			break;
+		case NET_EVENT_L4_DISCONNECTED:
+			lose();
+			break;
+		case NET_EVENT_IPV4_DHCP_BOUND:
+			mark(COND_DHCP, now);
+			break;
+#ifdef CONFIG_DNS_RESOLVER
+		case NET_EVENT_DNS_SERVER_ADD:
+			mark(COND_DNS, now);
+			break;
+#endif
+		default:
+			break;
+		}
+	}
+
+	k_work_submit_to_queue(&ready_q, &eval_work);
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+bool net_ready_is_ready(void)
+{
+	return atomic_get(&ready_flag) != 0;
+}
+
+int net_ready_wait(k_timeout_t timeout)
+{
+	return k_event_wait(&ready_evt, BIT(0), false, timeout) ? 0 : -EAGAIN;
+}
+
+void net_ready_stats_get(struct net_ready_stats *out)
+{
+	K_SPINLOCK(&lock) {
+		*out = stats;
+	}
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+static int net_ready_init(void)
+{
+	struct net_if *iface = net_if_get_default();
+
+	k_work_queue_start(&ready_q, ready_stack, K_THREAD_STACK_SIZEOF(ready_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, NULL);
+	k_thread_name_set(&ready_q.thread, "net_ready");
+
+	net_mgmt_init_event_callback(&if_cb, event_cb, NET_EVENT_IF_UP | NET_EVENT_IF_DOWN);
+	net_mgmt_add_event_callback(&if_cb);
+	net_mgmt_init_event_callback(&l4_cb, event_cb,
+				     NET_EVENT_L4_CONNECTED | NET_EVENT_L4_DISCONNECTED);
+	net_mgmt_add_event_callback(&l4_cb);
+	net_mgmt_init_event_callback(&ipv4_cb, event_cb, NET_EVENT_IPV4_DHCP_BOUND);
+	net_mgmt_add_event_callback(&ipv4_cb);
+#ifdef CONFIG_DNS_RESOLVER
+	net_mgmt_init_event_callback(&dns_cb, event_cb, NET_EVENT_DNS_SERVER_ADD);
+	net_mgmt_add_event_callback(&dns_cb);
+#endif
+
+	/* Static addresses may be up before we listen: take them as given */
+	if (iface && net_if_is_up(iface) &&
+	    net_if_ipv4_get_global_addr(iface, NET_ADDR_PREFERRED)) {
+		K_SPINLOCK(&lock) {
+			mark(COND_L4, k_uptime_get());
+			mark(COND_DHCP, k_uptime_get());
+		}
+		k_work_submit_to_queue(&ready_q, &eval_work);
+	}
+
+	return 0;
+}
+
+SYS_INIT(net_ready_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_NET_READY_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct net_ready_stats s;
+	uint32_t h;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	net_ready_stats_get(&s);
+	K_SPINLOCK(&lock) {
+		h = have;
+	}
+
+	shell_print(sh, "%s, L4 %s, DHCP %s, DNS %s, probe %s",
+		    net_ready_is_ready() ? "ready" : "not ready",
+		    h & BIT(COND_L4) ? "up" : "down",
+		    !(NEED & BIT(COND_DHCP)) ? "-" : h & BIT(COND_DHCP) ? "bound" : "waiting",
+		    !(NEED & BIT(COND_DNS)) ? "-" : h & BIT(COND_DNS) ? "known" : "waiting",
+		    IS_ENABLED(CONFIG_APP_NET_READY_PROBE_TCP) ? "tcp" :
+		    IS_ENABLED(CONFIG_APP_NET_READY_PROBE_DNS) ? "dns" : "none");
+	shell_print(sh, "ready %u times, lost %u, probe failed %u", s.ready, s.lost,
+		    s.probe_failed);
+	shell_print(sh, "last, ms from interface up: L4 %u, DHCP %u, DNS %u, probe %u, ready %u",
+		    s.last_l4_ms, s.last_dhcp_ms, s.last_dns_ms, s.last_probe_ms, s.last_ready_ms);
+	shell_print(sh, "time to ready: min %u ms, mean %u ms, max %u ms", s.min_ready_ms,
+		    s.ready ? (uint32_t)(s.total_ready_ms / s.ready) : 0, s.max_ready_ms);
+
+	return 0;
+}
+
+static int cmd_probe(const struct shell *sh, size_t argc, char **argv)
+{
+	int64_t start = k_uptime_get();
+	int err;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (!PROBE) {
+		shell_warn(sh, "No probe configured");
+		return 0;
+	}
+
+	err = probe_once();
+	shell_print(sh, "Probe %s in %lld ms (%d)", err ? "failed" : "ok",
+		    (long long)(k_uptime_get() - start), err);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_net_ready,
+	SHELL_CMD(show, NULL, "Readiness state and time-to-ready", cmd_show),
+	SHELL_CMD(probe, NULL, "Run the active probe once", cmd_probe),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(net_ready, &sub_net_ready, "Network readiness", NULL);
+
+#endif /* CONFIG_APP_NET_READY_SHELL */
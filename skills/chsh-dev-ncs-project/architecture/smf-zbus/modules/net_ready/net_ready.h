@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _NET_READY_H_
+#define _NET_READY_H_
+
+/**
+ * @file net_ready.h
+ * @brief Network readiness from net_mgmt events instead of fixed delays
+ *
+ * The template NETWORK_CHAN (messages.h) carries NETWORK_CONNECTED as soon
+ * as the stack is usable: L4 connected, plus a DHCP lease and a DNS server
+ * when those are configured, plus an optional active probe (DNS lookup or
+ * TCP connect). NETWORK_DISCONNECTED follows when connectivity is lost.
+ * Clients connect on the message rather than sleeping a worst-case delay:
+ *
+ * @code
+ * static void network_cb(const struct zbus_channel *chan)
+ * {
+ *     const struct network_msg *msg = zbus_chan_const_msg(chan);
+ *
+ *     if (msg->type == NETWORK_CONNECTED) {
+ *         k_sem_give(&connect_sem);
+ *     }
+ * }
+ * @endcode
+ *
+ * error_code is -ETIMEDOUT on a NETWORK_CONNECTED published after the
+ * probe timed out, 0 otherwise. Threads can also block in
+ * net_ready_wait(). net_ready.c holds the only definition of NETWORK_CHAN;
+ * the data path messages (NETWORK_SEND_DATA, ...) share it.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "common/messages.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+ZBUS_CHAN_DECLARE(NETWORK_CHAN);
+
+/** Statistics since boot; stage times are from interface up */
+struct net_ready_stats {
+	uint32_t ready;			/* NETWORK_CONNECTED published */
+	uint32_t lost;			/* NETWORK_DISCONNECTED published */
+	uint32_t probe_failed;		/* Published without a successful probe */
+	uint32_t last_l4_ms;
+	uint32_t last_dhcp_ms;		/* 0 when not waited for */
+	uint32_t last_dns_ms;
+	uint32_t last_probe_ms;
+	uint32_t last_ready_ms;
+	uint32_t min_ready_ms;
+	uint32_t max_ready_ms;
+	uint64_t total_ready_ms;
+};
+
+/**
+ * @brief Whether NETWORK_CONNECTED is the current state
+ */
+bool net_ready_is_ready(void);
+
+/**
+ * @brief Block until the network is usable
+ *
+ * @return 0 when ready, -EAGAIN on timeout
+ */
+int net_ready_wait(k_timeout_t timeout);
+
+/**
+ * @brief Get the statistics
+ */
+void net_ready_stats_get(struct net_ready_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _NET_READY_H_ */
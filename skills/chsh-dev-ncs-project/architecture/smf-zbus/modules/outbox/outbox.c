@@ -0,0 +1,834 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file outbox.c
+ * @brief Flash-backed store-and-forward queue for outgoing messages
+ *
+ * This module demonstrates:
+ * - A flash circular buffer (FCB) as a persistent FIFO, where erasing the
+ *   oldest sector is the only way to delete
+ * - Batching records in RAM so one flash write carries many of them
+ * - Persisting delivery progress as append-only ACK entries, so recovery
+ *   is a single walk over the FCB at boot
+ * - Sending without holding the queue lock, so producers never wait on
+ *   the network
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/fs/fcb.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "outbox.h"
+
+LOG_MODULE_REGISTER(outbox, CONFIG_APP_OUTBOX_LOG_LEVEL);
+
+#if FIXED_PARTITION_EXISTS(outbox_partition)
+#define OUTBOX_AREA_ID FIXED_PARTITION_ID(outbox_partition)
+#else
+/* Fine for native_sim and first experiments; settings would share it */
+BUILD_ASSERT(!IS_ENABLED(CONFIG_SETTINGS),
+	     "storage_partition holds settings, define an outbox_partition");
+#define OUTBOX_AREA_ID FIXED_PARTITION_ID(storage_partition)
+#endif
+
+#define OUTBOX_MAGIC 0x584F424FU	/* "OBOX" */
+#define HDR_SIZE sizeof(struct outbox_entry_hdr)
+#define REC_HDR_SIZE sizeof(uint16_t)
+#define BATCH_SIZE CONFIG_APP_OUTBOX_BATCH_SIZE
+
+/* Largest flash write block supported, entries are padded to it */
+#define ALIGN_MAX 16
+
+static struct fcb fcb;
+static struct flash_sector sectors[CONFIG_APP_OUTBOX_MAX_SECTORS];
+static bool ready;
+
+/* Protects the FCB, the RAM batch and the counters below */
+static K_MUTEX_DEFINE(lock);
+
+/* One drain at a time */
+static K_MUTEX_DEFINE(drain_lock);
+
+/* RAM batch: entry header, then records, with room for padding */
+static uint8_t stage[BATCH_SIZE + ALIGN_MAX];
+static size_t stage_len = HDR_SIZE;
+static uint16_t stage_count;
+static uint32_t stage_seq;
+
+/* One FCB entry read back by outbox_drain() */
+static uint8_t rbuf[BATCH_SIZE + ALIGN_MAX];
+
+static uint32_t next_seq = 1;		/* Given to the next record */
+static uint32_t acked;			/* Delivered up to this sequence number */
+static uint32_t acked_persisted;	/* Last ACK entry in flash */
+static uint32_t handed;			/* Handed over up to this, awaiting outbox_ack() */
+static uint32_t flash_pending;		/* Records in flash past acked */
+static uint32_t rotations;		/* Sector erases, invalidate FCB walks */
+static bool full;			/* DROP_NEWEST: no room until a sector is erased */
+
+static struct outbox_stats stats;
+
+static void flush_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_handler);
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static int entry_hdr_read(const struct fcb_entry *loc, uint32_t *seq, uint16_t *count)
+{
+	struct outbox_entry_hdr hdr;
+	int err;
+
+	if (loc->fe_data_len < HDR_SIZE) {
+		return -EBADMSG;
+	}
+
+	err = flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF(*loc), &hdr, sizeof(hdr));
+	if (err) {
+		return err;
+	}
+
+	*seq = sys_le32_to_cpu(hdr.seq);
+	*count = sys_le16_to_cpu(hdr.count);
+
+	return hdr.type;
+}
+
+/* Records of a DATA entry that are past acked */
+static uint32_t undelivered(uint32_t seq, uint16_t count)
+{
+	uint32_t last = seq + count - 1;
+
+	if (!count || last <= acked) {
+		return 0;
+	}
+
+	return last - MAX(seq - 1, acked);
+}
+
+/* Undelivered records in the oldest sector, and the last sequence number in it */
+static uint32_t oldest_undelivered(uint32_t *last)
+{
+	struct fcb_entry loc = { 0 };
+	uint32_t total = 0;
+	uint32_t seq;
+	uint16_t count;
+
+	while (fcb_getnext(&fcb, &loc) == 0 && loc.fe_sector == fcb.f_oldest) {
+		if (entry_hdr_read(&loc, &seq, &count) == OUTBOX_ENTRY_DATA && count) {
+			total += undelivered(seq, count);
+			if (last) {
+				*last = MAX(*last, seq + count - 1);
+			}
+		}
+	}
+
+	return total;
+}
+
+/* Erase the oldest sector; its undelivered records count as dropped */
+static int erase_oldest(void)
+{
+	uint32_t last = 0;
+	uint32_t lost = oldest_undelivered(&last);
+	int err;
+
+	err = fcb_rotate(&fcb);
+	if (err) {
+		LOG_ERR("fcb_rotate failed: %d", err);
+		return err;
+	}
+
+	rotations++;
+	stats.erases++;
+	full = false;
+
+	if (lost) {
+		stats.dropped += lost;
+		flash_pending -= MIN(lost, flash_pending);
+		/* Gone from flash: a later cumulative ACK must not count them as sent */
+		acked = MAX(acked, last);
+		handed = MAX(handed, acked);
+		LOG_WRN("Outbox full, dropped %u oldest records", lost);
+	}
+
+	return 0;
+}
+
+/* Append one FCB entry, making room according to the full policy */
+static int write_entry(uint8_t *buf, size_t len)
+{
+	struct fcb_entry loc;
+	size_t padded = ROUND_UP(len, fcb.f_align);
+	int err;
+
+	memset(buf + len, 0, padded - len);
+
+	for (int tries = 0; tries <= fcb.f_sector_cnt; tries++) {
+		err = fcb_append(&fcb, padded, &loc);
+		if (err != -ENOSPC) {
+			break;
+		}
+
+		if (fcb.f_oldest == fcb.f_active.fe_sector) {
+			return -ENOSPC;
+		}
+
+		/* Delivered sectors go first, for free */
+		if (IS_ENABLED(CONFIG_APP_OUTBOX_DROP_NEWEST) && oldest_undelivered(NULL)) {
+			full = true;
+			return -ENOSPC;
+		}
+
+		err = erase_oldest();
+		if (err) {
+			return err;
+		}
+	}
+
+	if (err) {
+		return err;
+	}
+
+	err = flash_area_write(fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), buf, padded);
+	if (err) {
+		return err;
+	}
+
+	err = fcb_append_finish(&fcb, &loc);
+	if (err) {
+		return err;
+	}
+
+	stats.writes++;
+
+	return 0;
+}
+
+static int write_ack(uint32_t seq)
+{
+	uint8_t buf[HDR_SIZE + ALIGN_MAX];
+	struct outbox_entry_hdr hdr = {
+		.type = OUTBOX_ENTRY_ACK,
+		.seq = sys_cpu_to_le32(seq),
+	};
+	int err;
+
+	memcpy(buf, &hdr, sizeof(hdr));
+
+	err = write_entry(buf, sizeof(hdr));
+	if (!err) {
+		acked_persisted = seq;
+	}
+
+	return err;
+}
+
+/* Write the ACK entry if delivery moved on since the last one */
+static int persist_ack_locked(void)
+{
+	int err;
+
+	if (acked == acked_persisted) {
+		return 0;
+	}
+
+	err = write_ack(acked);
+	if (err) {
+		LOG_WRN("ACK not persisted, records after %u may be sent again",
+			acked_persisted);
+	}
+
+	return err;
+}
+
+/*
+ * Write the RAM batch as one entry. On -ENOSPC the batch stays in RAM and
+ * is written once a drain frees a sector; other errors drop it.
+ */
+static int flush_locked(void)
+{
+	struct outbox_entry_hdr hdr = {
+		.type = OUTBOX_ENTRY_DATA,
+		.count = sys_cpu_to_le16(stage_count),
+		.seq = sys_cpu_to_le32(stage_seq),
+	};
+	int err;
+
+	if (!stage_count) {
+		return 0;
+	}
+
+	(void)k_work_cancel_delayable(&flush_work);
+
+	memcpy(stage, &hdr, sizeof(hdr));
+
+	err = write_entry(stage, stage_len);
+	if (err == -ENOSPC) {
+		return err;
+	}
+
+	if (err) {
+		LOG_WRN("Dropped %u new records: %d", stage_count, err);
+		stats.dropped += stage_count;
+	} else {
+		flash_pending += stage_count;
+		/* Flash is written anyway, and the timer that would persist it is gone */
+		(void)persist_ack_locked();
+	}
+
+	stage_len = HDR_SIZE;
+	stage_count = 0;
+
+	return err;
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	(void)flush_locked();
+	(void)persist_ack_locked();
+	k_mutex_unlock(&lock);
+}
+
+/* Mark every record up to seq delivered; the ACK entry is written later */
+static void ack_locked(uint32_t seq)
+{
+	uint32_t n;
+
+	/* Staged records have not been handed to anyone */
+	seq = MIN(seq, next_seq - 1 - stage_count);
+	if (seq <= acked) {
+		return;
+	}
+
+	n = seq - acked;
+	acked = seq;
+	flash_pending -= MIN(n, flash_pending);
+	stats.sent += n;
+
+	if (CONFIG_APP_OUTBOX_FLUSH_MS) {
+		/* Does not push back a pending flush, so the delay stays bounded */
+		k_work_schedule(&flush_work, K_MSEC(CONFIG_APP_OUTBOX_FLUSH_MS));
+	}
+}
+
+static void ack_one(uint32_t seq)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	ack_locked(seq);
+	k_mutex_unlock(&lock);
+}
+
+/*
+ * Erase fully delivered sectors. An erase may take the last ACK entry with
+ * it, so persist delivery progress then, and write a batch that was waiting
+ * for the room.
+ */
+static int drain_finish_locked(void)
+{
+	uint32_t erased = rotations;
+	int err = 0;
+
+	while (fcb.f_oldest != fcb.f_active.fe_sector && oldest_undelivered(NULL) == 0) {
+		if (erase_oldest()) {
+			break;
+		}
+	}
+
+	if (rotations != erased) {
+		err = persist_ack_locked();
+		(void)flush_locked();
+	}
+
+	return err;
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int outbox_put(const void *data, size_t len)
+{
+	int err;
+
+	if (!ready) {
+		return -ENODEV;
+	}
+
+	if (len > BATCH_SIZE - HDR_SIZE - REC_HDR_SIZE || len > UINT16_MAX) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	/* Flash is full of undelivered records: reject this one, keep what is staged */
+	if (full) {
+		stats.dropped++;
+		k_mutex_unlock(&lock);
+		return -ENOSPC;
+	}
+
+	if (stage_len + REC_HDR_SIZE + len > BATCH_SIZE) {
+		err = flush_locked();
+		if (err == -ENOSPC) {
+			stats.dropped++;
+			k_mutex_unlock(&lock);
+			return err;
+		}
+	}
+
+	if (!stage_count) {
+		stage_seq = next_seq;
+		if (CONFIG_APP_OUTBOX_FLUSH_MS) {
+			k_work_schedule(&flush_work, K_MSEC(CONFIG_APP_OUTBOX_FLUSH_MS));
+		}
+	}
+
+	sys_put_le16(len, &stage[stage_len]);
+	memcpy(&stage[stage_len + REC_HDR_SIZE], data, len);
+	stage_len += REC_HDR_SIZE + len;
+	stage_count++;
+	next_seq++;
+	stats.put++;
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+int outbox_flush(void)
+{
+	int err;
+
+	if (!ready) {
+		return -ENODEV;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	err = flush_locked();
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+int outbox_drain(outbox_send_t send, void *user_data, size_t max)
+{
+	struct fcb_entry loc = { 0 };
+	uint32_t walk_rotations;
+	uint32_t seq;
+	uint16_t count;
+	size_t sent = 0;
+	size_t off;
+	uint16_t len;
+	bool stop;
+	int err = 0;
+	int ret;
+
+	if (!ready) {
+		return -ENODEV;
+	}
+
+	k_mutex_lock(&drain_lock, K_FOREVER);
+	k_mutex_lock(&lock, K_FOREVER);
+
+	(void)flush_locked();
+	walk_rotations = rotations;
+
+	/* Everything already handed over: nothing to read back */
+	stop = (MAX(acked, handed) + 1 == next_seq);
+
+	while (!stop) {
+		/* A sector erased by a concurrent put: restart, delivered records are skipped */
+		if (rotations != walk_rotations) {
+			loc = (struct fcb_entry){ 0 };
+			walk_rotations = rotations;
+		}
+
+		if (fcb_getnext(&fcb, &loc)) {
+			break;
+		}
+
+		if (entry_hdr_read(&loc, &seq, &count) != OUTBOX_ENTRY_DATA ||
+		    !undelivered(seq, count) || loc.fe_data_len > sizeof(rbuf)) {
+			continue;
+		}
+
+		err = flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), rbuf, loc.fe_data_len);
+		if (err) {
+			LOG_ERR("Flash read failed: %d", err);
+			break;
+		}
+
+		/* Send from the copy without the lock; producers keep queueing */
+		k_mutex_unlock(&lock);
+
+		off = HDR_SIZE;
+		for (uint16_t i = 0; i < count; i++, seq++) {
+			len = sys_get_le16(&rbuf[off]);
+			off += REC_HDR_SIZE;
+			if (off + len > loc.fe_data_len) {
+				LOG_ERR("Corrupt entry at seq %u, skipped", seq);
+				break;
+			}
+
+			if (seq > acked && seq > handed) {
+				if (max && sent == max) {
+					stop = true;
+					break;
+				}
+				ret = send(&rbuf[off], len, seq, user_data);
+				if (ret == -EINPROGRESS) {
+					/* Delivered once outbox_ack() confirms it */
+					k_mutex_lock(&lock, K_FOREVER);
+					handed = MAX(handed, seq);
+					k_mutex_unlock(&lock);
+				} else if (ret == 0) {
+					ack_one(seq);
+				} else {
+					stop = true;
+					break;
+				}
+				sent++;
+			}
+
+			off += len;
+		}
+
+		k_mutex_lock(&lock, K_FOREVER);
+	}
+
+	(void)drain_finish_locked();
+	if (!CONFIG_APP_OUTBOX_FLUSH_MS) {
+		/* No timer to persist it later */
+		(void)persist_ack_locked();
+	}
+
+	k_mutex_unlock(&lock);
+	k_mutex_unlock(&drain_lock);
+
+	if (sent) {
+		LOG_INF("Sent %zu records, %u pending", sent, outbox_pending());
+	}
+
+	return (err && !sent) ? err : (int)sent;
+}
+
+int outbox_ack(uint32_t seq)
+{
+	int err;
+
+	if (!ready) {
+		return -ENODEV;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	ack_locked(seq);
+	err = drain_finish_locked();
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+uint32_t outbox_pending(void)
+{
+	uint32_t pending;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	pending = flash_pending + stage_count;
+	k_mutex_unlock(&lock);
+
+	return pending;
+}
+
+void outbox_stats_get(struct outbox_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	out->pending = flash_pending + stage_count;
+	out->staged = stage_count;
+	out->sectors = ready ? fcb.f_sector_cnt : 0;
+	out->free_sectors = ready ? fcb_free_sector_cnt(&fcb) : 0;
+	k_mutex_unlock(&lock);
+}
+
+int outbox_clear(void)
+{
+	int err;
+
+	if (!ready) {
+		return -ENODEV;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	(void)k_work_cancel_delayable(&flush_work);
+	stage_len = HDR_SIZE;
+	stage_count = 0;
+
+	err = fcb_clear(&fcb);
+	if (!err) {
+		rotations++;
+		full = false;
+		flash_pending = 0;
+		acked = next_seq - 1;
+		handed = acked;
+		/* Keep numbering after a reset, duplicate detection relies on it */
+		err = write_ack(acked);
+	}
+
+	k_mutex_unlock(&lock);
+
+	return err;
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+/* One walk over the FCB rebuilds the sequence numbers and the backlog */
+static void recover(void)
+{
+	struct fcb_entry loc = { 0 };
+	uint32_t first = 0;
+	uint32_t ack = 0;
+	uint32_t seq;
+	uint16_t count;
+	int type;
+
+	while (fcb_getnext(&fcb, &loc) == 0) {
+		type = entry_hdr_read(&loc, &seq, &count);
+		if (type == OUTBOX_ENTRY_DATA && count) {
+			first = first ? first : seq;
+			next_seq = MAX(next_seq, seq + count);
+		} else if (type == OUTBOX_ENTRY_ACK) {
+			ack = MAX(ack, seq);
+		}
+	}
+
+	/* An ACK erased with its sector: everything before the oldest record was sent */
+	acked = MAX(ack, first ? first - 1 : 0);
+	acked_persisted = acked;
+	handed = acked;
+	next_seq = MAX(next_seq, acked + 1);
+
+	loc = (struct fcb_entry){ 0 };
+	while (fcb_getnext(&fcb, &loc) == 0) {
+		if (entry_hdr_read(&loc, &seq, &count) == OUTBOX_ENTRY_DATA) {
+			flash_pending += undelivered(seq, count);
+		}
+	}
+
+	stats.recovered = flash_pending;
+}
+
+static int outbox_init(void)
+{
+	const struct flash_area *fa;
+	uint32_t cnt = ARRAY_SIZE(sectors);
+	int err;
+
+	err = flash_area_get_sectors(OUTBOX_AREA_ID, &cnt, sectors);
+	if (err || cnt < 2) {
+		LOG_ERR("Outbox partition needs 2..%u sectors: %d",
+			CONFIG_APP_OUTBOX_MAX_SECTORS, err);
+		return 0;
+	}
+
+	for (uint32_t i = 0; i < cnt; i++) {
+		if (sectors[i].fs_size < BATCH_SIZE + 64) {
+			LOG_ERR("Sector of %u bytes too small for CONFIG_APP_OUTBOX_BATCH_SIZE",
+				(uint32_t)sectors[i].fs_size);
+			return 0;
+		}
+	}
+
+	fcb.f_magic = OUTBOX_MAGIC;
+	fcb.f_version = 1;
+	fcb.f_sectors = sectors;
+	fcb.f_sector_cnt = (uint8_t)cnt;
+
+	err = fcb_init(OUTBOX_AREA_ID, &fcb);
+	if (err) {
+		/* Not an outbox (first boot after a layout change): start empty */
+		LOG_WRN("No outbox in flash (%d), erasing partition", err);
+		err = flash_area_open(OUTBOX_AREA_ID, &fa);
+		if (!err) {
+			err = flash_area_erase(fa, 0, fa->fa_size);
+			flash_area_close(fa);
+		}
+		if (!err) {
+			err = fcb_init(OUTBOX_AREA_ID, &fcb);
+		}
+		if (err) {
+			LOG_ERR("fcb_init failed: %d", err);
+			return 0;
+		}
+	}
+
+	if (fcb.f_align > ALIGN_MAX) {
+		LOG_ERR("Flash write block of %u bytes not supported", fcb.f_align);
+		return 0;
+	}
+
+	recover();
+	ready = true;
+
+	LOG_INF("Outbox: %u records pending, %u of %u sectors free, next seq %u",
+		flash_pending, fcb_free_sector_cnt(&fcb), cnt, next_seq);
+
+	return 0;
+}
+
+SYS_INIT(outbox_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_OUTBOX_SHELL
+
+struct shell_drain {
+	const struct shell *sh;
+	size_t printed;
+};
+
+static int shell_send(const void *data, size_t len, uint32_t seq, void *user_data)
+{
+	struct shell_drain *ctx = user_data;
+
+	if (ctx->printed++ < 8) {
+		shell_print(ctx->sh, "seq=%u len=%zu", seq, len);
+	}
+
+	return 0;
+}
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct outbox_stats s;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	outbox_stats_get(&s);
+
+	shell_print(sh, "pending   %u (%u in RAM)", s.pending, s.staged);
+	shell_print(sh, "sectors   %u free of %u", s.free_sectors, s.sectors);
+	shell_print(sh, "put %u  sent %u  dropped %u  recovered %u", s.put, s.sent,
+		    s.dropped, s.recovered);
+	shell_print(sh, "flash writes %u  erases %u  (%u records per write)", s.writes,
+		    s.erases, s.writes ? s.put / s.writes : 0);
+
+	return 0;
+}
+
+static int cmd_put(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+
+	err = outbox_put(argv[1], strlen(argv[1]));
+	if (err) {
+		shell_error(sh, "outbox_put failed: %d", err);
+	}
+
+	return err;
+}
+
+static int cmd_fill(const struct shell *sh, size_t argc, char **argv)
+{
+	uint8_t buf[64];
+	uint32_t n = strtoul(argv[1], NULL, 0);
+	size_t len = (argc > 2) ? MIN(strtoul(argv[2], NULL, 0), sizeof(buf)) : 32;
+	uint32_t done = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = (uint8_t)i;
+	}
+
+	while (done < n && outbox_put(buf, len) == 0) {
+		done++;
+	}
+
+	shell_print(sh, "Queued %u of %u records of %zu bytes", done, n, len);
+
+	return 0;
+}
+
+static int cmd_drain(const struct shell *sh, size_t argc, char **argv)
+{
+	struct shell_drain ctx = { .sh = sh };
+	size_t max = (argc > 1) ? strtoul(argv[1], NULL, 0) : 0;
+	int ret;
+
+	ret = outbox_drain(shell_send, &ctx, max);
+	if (ret < 0) {
+		shell_error(sh, "outbox_drain failed: %d", ret);
+		return ret;
+	}
+
+	shell_print(sh, "Delivered %d records", ret);
+
+	return 0;
+}
+
+static int cmd_flush(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	err = outbox_flush();
+	if (err) {
+		shell_error(sh, "outbox_flush failed: %d", err);
+	}
+
+	return err;
+}
+
+static int cmd_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	err = outbox_clear();
+	if (err) {
+		shell_error(sh, "outbox_clear failed: %d", err);
+		return err;
+	}
+
+	shell_print(sh, "Outbox cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_outbox,
+	SHELL_CMD(show, NULL, "Backlog, flash use and counters", cmd_show),
+	SHELL_CMD_ARG(put, NULL, "Queue a text record: put <text>", cmd_put, 2, 0),
+	SHELL_CMD_ARG(fill, NULL, "Queue test records: fill <count> [len]", cmd_fill, 2, 1),
+	SHELL_CMD_ARG(drain, NULL, "Deliver to the console: drain [max]", cmd_drain, 1, 1),
+	SHELL_CMD(flush, NULL, "Write the RAM batch to flash", cmd_flush),
+	SHELL_CMD(clear, NULL, "Discard everything queued", cmd_clear),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(outbox, &sub_outbox, "Store-and-forward outbox", NULL);
+
+#endif /* CONFIG_APP_OUTBOX_SHELL */
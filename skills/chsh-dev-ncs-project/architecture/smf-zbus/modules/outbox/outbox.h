@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _OUTBOX_H_
+#define _OUTBOX_H_
+
+/**
+ * @file outbox.h
+ * @brief Flash-backed store-and-forward queue for outgoing messages
+ *
+ * While the network or cloud connection is down, the module that would
+ * send a message (NETWORK_SEND_DATA) puts it in the outbox instead, and
+ * drains the outbox oldest-first once connected again:
+ *
+ * @code
+ * // NETWORK_DISCONNECTED / CLOUD_CONNECTING
+ * outbox_put(msg->data, msg->len);
+ *
+ * // Entry of CLOUD_CONNECTED
+ * outbox_drain(send_one, NULL, 0);
+ * @endcode
+ *
+ * Storage is a flash circular buffer (FCB) on the outbox_partition fixed
+ * partition. Records are collected in RAM and written as one FCB entry per
+ * batch, so a flash write carries many records and a sector is only
+ * erased when it is full and delivered, or dropped by the full policy.
+ * Every record gets a sequence number; delivered records are persisted
+ * as small ACK entries, so after a reset delivery continues where it
+ * stopped. A torn write from a power loss fails its CRC and is skipped.
+ *
+ * Delivery is at-least-once: a reset between sending a record and
+ * writing its ACK sends it again, with the same sequence number. Senders
+ * that only learn later whether a record arrived (an MQTT PUBACK) return
+ * -EINPROGRESS from the callback and call outbox_ack() when it did, so a
+ * record is never marked delivered before the peer confirmed it. Records
+ * still in RAM when power is lost are gone; call outbox_flush() before a
+ * planned shutdown.
+ *
+ * On native_sim the partition lives in the flash simulator, so the same
+ * code runs on the host, and "-flash=<file>" keeps it across runs.
+ */
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief FCB entry types */
+enum outbox_entry_type {
+	OUTBOX_ENTRY_DATA = 0x01,	/* count records follow */
+	OUTBOX_ENTRY_ACK = 0x02,	/* Records up to seq were delivered */
+};
+
+/**
+ * @brief Header of every FCB entry
+ *
+ * A DATA entry is followed by count records of (uint16_t len, payload),
+ * numbered seq, seq + 1, ... Little endian.
+ */
+struct outbox_entry_hdr {
+	uint8_t type;		/* enum outbox_entry_type */
+	uint8_t reserved;
+	uint16_t count;
+	uint32_t seq;
+} __packed;
+
+/**
+ * @brief Outbox statistics since boot
+ */
+struct outbox_stats {
+	uint32_t pending;	/* Records not delivered yet, flash and RAM */
+	uint32_t staged;	/* Of those, still in RAM */
+	uint32_t put;		/* outbox_put() calls that queued a record */
+	uint32_t sent;		/* Records delivered, confirmed by outbox_ack() if async */
+	uint32_t dropped;	/* Records lost to the full policy */
+	uint32_t writes;	/* FCB entries written */
+	uint32_t erases;	/* Sectors erased */
+	uint32_t recovered;	/* Pending records found in flash at boot */
+	uint32_t free_sectors;
+	uint32_t sectors;
+};
+
+/**
+ * @brief Deliver one record
+ *
+ * @param data Record payload, valid during the call only
+ * @param len Payload length
+ * @param seq Record sequence number, for duplicate detection upstream
+ * @param user_data As passed to outbox_drain()
+ * @return 0 when the record was delivered, -EINPROGRESS when it was
+ *         handed over and outbox_ack() follows on delivery, other
+ *         negative errno to stop the drain and keep this record for the
+ *         next one
+ */
+typedef int (*outbox_send_t)(const void *data, size_t len, uint32_t seq, void *user_data);
+
+/**
+ * @brief Queue a message
+ *
+ * Copies the message into the RAM batch, which is written to flash when
+ * it is full or CONFIG_APP_OUTBOX_FLUSH_MS after its first record.
+ *
+ * @return 0 on success, -EMSGSIZE when the message cannot fit a batch,
+ *         -ENOSPC when flash is full and the policy drops new messages
+ *         (records already queued are kept),
+ *         -ENODEV when the partition could not be initialized
+ */
+int outbox_put(const void *data, size_t len);
+
+/**
+ * @brief Write the RAM batch to flash now
+ *
+ * @return 0 on success (also with nothing to write), negative errno
+ */
+int outbox_flush(void);
+
+/**
+ * @brief Deliver queued messages, oldest first
+ *
+ * Flushes the RAM batch, then reads flash one batch at a time and calls
+ * @p send for each record. The outbox is not locked during @p send, so
+ * outbox_put() from other threads does not wait for the network. Sectors
+ * whose records are all delivered are erased. The last delivered sequence
+ * number is persisted along with those erases, with the next batch or
+ * CONFIG_APP_OUTBOX_FLUSH_MS later (at the end of the drain when that is 0).
+ *
+ * Records handed over with -EINPROGRESS are skipped by later drains until
+ * a reset; the sender owns them and resends them itself if needed.
+ *
+ * @param send Delivery callback
+ * @param user_data Passed to @p send
+ * @param max Most records to deliver or hand over, 0 for all
+ * @return Number of records delivered or handed over, or negative errno on
+ *         a flash error
+ */
+int outbox_drain(outbox_send_t send, void *user_data, size_t max);
+
+/**
+ * @brief Confirm delivery of records handed over with -EINPROGRESS
+ *
+ * Marks every record up to @p seq delivered, so call it in sequence
+ * order (MQTT PUBACKs arrive in publish order). Erases sectors that are
+ * fully delivered. The ACK is kept in RAM and written like the one of
+ * outbox_drain(), not once per call; a reset before that sends the
+ * records again. Must not be called from ISRs.
+ *
+ * @param seq Sequence number passed to the send callback
+ * @return 0 on success, negative errno when an erase made the ACK due and
+ *         it could not be written
+ */
+int outbox_ack(uint32_t seq);
+
+/**
+ * @brief Number of records not delivered yet
+ */
+uint32_t outbox_pending(void);
+
+/**
+ * @brief Get the statistics
+ */
+void outbox_stats_get(struct outbox_stats *stats);
+
+/**
+ * @brief Discard everything queued, in flash and RAM
+ *
+ * @return 0 on success, negative errno
+ */
+int outbox_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _OUTBOX_H_ */
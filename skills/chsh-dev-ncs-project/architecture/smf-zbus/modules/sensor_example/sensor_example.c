@@ -24,6 +24,52 @@
 #include <zephyr/smf.h>
 
 #include "sensor_example.h"
+#include "zbus_latest.h"
+
+#include "app_stats.h"
+
+#include "log_hot.h"
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+#include "zbus_trace.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_TRACE
+#include "smf_trace.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_EXECUTOR
+#include "smf_executor.h"
+#endif
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+#include "wdt_supervisor.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_IDLE
+#include "smf_idle.h"
+#endif
+
+#ifdef CONFIG_APP_BOOT_GRAPH
+#include "boot_graph.h"
+#endif
+
+#ifdef CONFIG_APP_MQTT_PUBLISHER
+#include "mqtt_publisher.h"
+#endif
+
+#ifdef CONFIG_APP_COAP_SERVER
+#include "coap_server.h"
+#endif
+
+#ifdef CONFIG_APP_UDP_TELEMETRY
+#include <zephyr/sys/byteorder.h>
+#include "udp_telemetry.h"
+#endif
+
+#ifdef CONFIG_APP_UPLOAD_SCHED
+#include "upload_sched.h"
+#endif
 
 LOG_MODULE_REGISTER(sensor, CONFIG_APP_SENSOR_LOG_LEVEL);
 
@@ -40,11 +86,15 @@ ZBUS_CHAN_DEFINE(SENSOR_CHAN,
 		 ZBUS_MSG_INIT(.type = SENSOR_IDLE)
 );
 
+#ifdef CONFIG_APP_ZBUS_TRACE
+ZBUS_TRACE_CHAN_DEFINE(SENSOR_CHAN, struct sensor_msg);
+#endif
+
 /* Register as zbus subscriber */
 ZBUS_MSG_SUBSCRIBER_DEFINE(sensor);
 
-/* Observe sensor channel and APP_EVENT channel */
-ZBUS_CHAN_ADD_OBS(SENSOR_CHAN, sensor, 0);
+/* Observe sensor channel and APP_EVENT channel; SENSOR_IDLE updates coalesce */
+ZBUS_LATEST_CHAN_ADD_OBS_IF(SENSOR_CHAN, sensor, 0, sensor_msg_is_idle);
 /* ZBUS_CHAN_ADD_OBS(APP_EVENT_CHAN, sensor, 0);  // Uncomment when APP_EVENT exists */
 
 /*******************************************************************************
@@ -73,6 +123,7 @@ static void state_init_entry(void *obj);
 static enum smf_state_result state_init_run(void *obj);
 static void state_idle_entry(void *obj);
 static enum smf_state_result state_idle_run(void *obj);
+static void state_idle_exit(void *obj);
 static void state_sampling_entry(void *obj);
 static enum smf_state_result state_sampling_run(void *obj);
 static void state_data_ready_entry(void *obj);
@@ -89,7 +140,7 @@ static const struct smf_state states[] = {
 	[STATE_IDLE] = SMF_CREATE_STATE(
 		state_idle_entry,
 		state_idle_run,
-		NULL,
+		state_idle_exit,
 		NULL,
 		NULL
 	),
@@ -109,8 +160,88 @@ static const struct smf_state states[] = {
 	),
 };
 
+#ifdef CONFIG_APP_SMF_TRACE
+SMF_TRACE_MODULE_DEFINE(sensor, states, "INIT", "IDLE", "SAMPLING", "DATA_READY");
+#endif
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+/* Heartbeat on the shared supervisor instead of an own task_wdt channel */
+WDT_SUPERVISOR_MODULE_DEFINE(sensor, CONFIG_APP_SENSOR_WATCHDOG_TIMEOUT_SECONDS * 1000);
+#endif
+
+#ifdef CONFIG_APP_SMF_IDLE
+/*
+ * No timeout while IDLE. An own task_wdt channel still has to be fed, so
+ * without the supervisor wake up at half the watchdog timeout.
+ */
+SMF_IDLE_MODULE_DEFINE(sensor, IS_ENABLED(CONFIG_APP_WDT_SUPERVISOR) ? 0 :
+		       CONFIG_APP_SENSOR_WATCHDOG_TIMEOUT_SECONDS * 500);
+#endif
+
+#ifdef CONFIG_APP_BOOT_GRAPH
+/* Sampling needs no other module; add e.g. a settings module here */
+BOOT_GRAPH_MODULE_DEFINE(sensor);
+#endif
+
+#if defined(CONFIG_APP_MQTT_PUBLISHER) || defined(CONFIG_APP_COAP_SERVER) ||	\
+	defined(CONFIG_APP_UPLOAD_SCHED)
+/* One JSON line per sample; tenths avoid float printf support */
+static int sensor_encode(const void *msg, char *buf, size_t len)
+{
+	const struct sensor_msg *m = msg;
+
+	if (m->type != SENSOR_DATA_READY) {
+		return 0;
+	}
+
+	return snprintk(buf, len, "{\"ts\":%u,\"temp_dc\":%d,\"hum_dc\":%d}",
+			m->timestamp, (int)(m->temperature * 10.0f), (int)(m->humidity * 10.0f));
+}
+#endif
+
+#ifdef CONFIG_APP_MQTT_PUBLISHER
+MQTT_PUBLISHER_CHAN_DEFINE(SENSOR_CHAN, sensor_encode);
+#endif
+
+#ifdef CONFIG_APP_COAP_SERVER
+/* coap://device/sensor, observable */
+COAP_SERVER_CHAN_DEFINE(SENSOR_CHAN, "sensor", COAP_CONTENT_FORMAT_APP_JSON, sensor_encode);
+#endif
+
+#ifdef CONFIG_APP_UDP_TELEMETRY
+/* 8-byte record: ts u32, temp i16 and humidity u16 in hundredths */
+static int sensor_pack(const void *msg, uint8_t *buf, size_t len)
+{
+	const struct sensor_msg *m = msg;
+
+	if (m->type != SENSOR_DATA_READY) {
+		return 0;
+	}
+	if (len < 8) {
+		return 8;
+	}
+
+	sys_put_be32(m->timestamp, &buf[0]);
+	sys_put_be16((int16_t)(m->temperature * 100.0f), &buf[4]);
+	sys_put_be16((uint16_t)(m->humidity * 100.0f), &buf[6]);
+
+	return 8;
+}
+
+UDP_TELEMETRY_CHAN_DEFINE(SENSOR_CHAN, 1, sensor_pack);
+#endif
+
+#ifdef CONFIG_APP_UPLOAD_SCHED
+/* Batched with other JSON lines; sent when the link allows */
+UPLOAD_SCHED_CHAN_DEFINE(SENSOR_CHAN, sensor_encode);
+#endif
+
 static struct sensor_state_object state_obj;
 
+APP_STATS_COUNTER_DEFINE(sensor, samples);
+APP_STATS_COUNTER_DEFINE(sensor, publishes);
+APP_STATS_COUNTER_DEFINE(sensor, errors);
+
 /*******************************************************************************
  * Helper Functions
  ******************************************************************************/
@@ -125,12 +256,25 @@ static void publish_sensor_data(float temperature, float humidity)
 		.timestamp = k_uptime_get_32(),
 	};
 
-	LOG_DBG("Publishing sensor data: temp=%.1f, hum=%.1f", temperature, humidity);
+	LOG_HOT_DBG(10, 0, "Publishing sensor data: temp=%.1f, hum=%.1f", temperature, humidity);
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+	zbus_trace_stamp(&SENSOR_CHAN, &msg);
+#endif
 
 	err = zbus_chan_pub(&SENSOR_CHAN, &msg, K_SECONDS(1));
 	if (err) {
 		LOG_ERR("zbus_chan_pub failed: %d", err);
+		APP_STATS_INC(sensor, errors);
+		return;
 	}
+
+	APP_STATS_INC(sensor, publishes);
+
+#ifdef CONFIG_APP_BOOT_GRAPH
+	/* Time to first sample after reset, the cost of every duty cycle */
+	boot_graph_milestone("first_sample");
+#endif
 }
 
 static int read_sensor_data(float *temperature, float *humidity)
@@ -154,12 +298,18 @@ static void state_init_entry(void *obj)
 {
 	struct sensor_state_object *state = obj;
 
+#ifdef CONFIG_APP_BOOT_GRAPH
+	boot_graph_mark(BOOT_GRAPH_MODULE(sensor), BOOT_GRAPH_INIT_ENTRY);
+#endif
+
 	LOG_INF("Sensor module initializing");
 
 	/* Initialize sensor hardware here */
 	/* Example: sensor_init(); */
 
-#ifdef CONFIG_TASK_WDT
+/* With the executor, its workers own the task_wdt channels */
+#if defined(CONFIG_TASK_WDT) && !defined(CONFIG_APP_WDT_SUPERVISOR) &&	\
+	!defined(CONFIG_APP_SMF_EXECUTOR)
 	state->wdt_id = task_wdt_add(
 		CONFIG_APP_SENSOR_WATCHDOG_TIMEOUT_SECONDS * 1000,
 		NULL,
@@ -186,18 +336,23 @@ static void state_idle_entry(void *obj)
 		.type = SENSOR_IDLE,
 	};
 	zbus_chan_pub(&SENSOR_CHAN, &msg, K_NO_WAIT);
+
+#ifdef CONFIG_APP_BOOT_GRAPH
+	/* First IDLE entry ends INIT; the calls are no-ops after that */
+	boot_graph_mark(BOOT_GRAPH_MODULE(sensor), BOOT_GRAPH_INIT_EXIT);
+	boot_graph_done(BOOT_GRAPH_MODULE(sensor));
+#endif
+
+#ifdef CONFIG_APP_SMF_IDLE
+	/* Nothing to do until SENSOR_START */
+	smf_idle_enter(SMF_IDLE_MODULE(sensor));
+#endif
 }
 
 static enum smf_state_result state_idle_run(void *obj)
 {
 	struct sensor_state_object *state = obj;
 
-#ifdef CONFIG_TASK_WDT
-	if (state->wdt_id >= 0) {
-		task_wdt_feed(state->wdt_id);
-	}
-#endif
-
 	/* Check for start command */
 	if (state->chan == &SENSOR_CHAN) {
 		struct sensor_msg *msg = (struct sensor_msg *)state->msg_buf;
@@ -210,6 +365,15 @@ static enum smf_state_result state_idle_run(void *obj)
 	return SMF_STATE_HANDLED();
 }
 
+static void state_idle_exit(void *obj)
+{
+	ARG_UNUSED(obj);
+
+#ifdef CONFIG_APP_SMF_IDLE
+	smf_idle_exit(SMF_IDLE_MODULE(sensor));
+#endif
+}
+
 static void state_sampling_entry(void *obj)
 {
 	LOG_DBG("Starting sensor sampling");
@@ -224,11 +388,13 @@ static enum smf_state_result state_sampling_run(void *obj)
 	err = read_sensor_data(&state->temperature, &state->humidity);
 	if (err) {
 		LOG_ERR("Sensor read failed: %d", err);
+		APP_STATS_INC(sensor, errors);
 		smf_set_state(SMF_CTX(state), &states[STATE_IDLE]);
 		return SMF_STATE_TRANSITION();
 	}
 
 	state->sample_count++;
+	APP_STATS_INC(sensor, samples);
 
 	/* Transition to data ready */
 	return SMF_STATE_HANDLED();
@@ -257,8 +423,15 @@ static enum smf_state_result state_data_ready_run(void *obj)
 		}
 	}
 
+#ifdef CONFIG_APP_SMF_EXECUTOR
+	/* Don't block a shared worker; the executor timeout paces sampling */
+	if (state->chan != NULL) {
+		return SMF_STATE_HANDLED();
+	}
+#else
 	/* Wait for sampling interval */
 	k_sleep(K_SECONDS(CONFIG_APP_SENSOR_SAMPLE_INTERVAL_SECONDS));
+#endif
 
 	/* Continue sampling */
 	smf_set_state(SMF_CTX(state), &states[STATE_SAMPLING]);
@@ -269,6 +442,33 @@ static enum smf_state_result state_data_ready_run(void *obj)
  * Module Thread
  ******************************************************************************/
 
+#ifdef CONFIG_APP_SMF_EXECUTOR
+
+BUILD_ASSERT(CONFIG_APP_SENSOR_WATCHDOG_TIMEOUT_SECONDS >
+	     CONFIG_APP_SENSOR_SAMPLE_INTERVAL_SECONDS,
+	     "The executor feeds the watchdog once per sample interval");
+
+/* No thread of its own: run on the shared executor, woken every sample interval */
+SMF_EXECUTOR_MODULE_DEFINE(sensor, sensor, state_obj, &states[STATE_INIT],
+			   CONFIG_APP_SENSOR_SAMPLE_INTERVAL_SECONDS * 1000, NULL);
+
+#else
+
+/* Once per loop iteration, whatever state the module is in */
+static void feed_watchdog(struct sensor_state_object *state)
+{
+#if defined(CONFIG_APP_WDT_SUPERVISOR)
+	ARG_UNUSED(state);
+	wdt_supervisor_feed(WDT_SUPERVISOR_MODULE(sensor));
+#elif defined(CONFIG_TASK_WDT)
+	if (state->wdt_id >= 0) {
+		task_wdt_feed(state->wdt_id);
+	}
+#else
+	ARG_UNUSED(state);
+#endif
+}
+
 static void sensor_thread(void *p1, void *p2, void *p3)
 {
 	ARG_UNUSED(p1);
@@ -277,27 +477,65 @@ static void sensor_thread(void *p1, void *p2, void *p3)
 
 	LOG_INF("Sensor module thread started");
 
+#ifdef CONFIG_APP_BOOT_GRAPH
+	/* Timestamps the thread start; waits once dependencies are declared */
+	boot_graph_wait(BOOT_GRAPH_MODULE(sensor));
+#endif
+
 	/* Initialize state machine */
 	smf_set_initial(SMF_CTX(&state_obj), &states[STATE_INIT]);
 
+#ifdef CONFIG_APP_SMF_TRACE
+	smf_trace_record(SMF_TRACE_MODULE(sensor), NULL,
+			 SMF_CTX(&state_obj)->current, NULL);
+#endif
+
 	while (1) {
+		feed_watchdog(&state_obj);
+
 		/* Wait for zbus messages */
+#ifdef CONFIG_APP_SMF_IDLE
+		/* Same as below, but without the timeout while IDLE */
+		int err = smf_idle_wait_msg(SMF_IDLE_MODULE(sensor), &sensor, &state_obj.chan,
+					    state_obj.msg_buf,
+					    CONFIG_APP_SENSOR_MSG_PROCESSING_TIMEOUT_SECONDS * 1000);
+#else
 		int err = zbus_sub_wait_msg(&sensor, &state_obj.chan,
 					    state_obj.msg_buf,
 					    K_MSEC(CONFIG_APP_SENSOR_MSG_PROCESSING_TIMEOUT_SECONDS * 1000));
+#endif
 
 		if (err == -EAGAIN || err == -ENOMSG) {
-			/* Timeout - run state machine anyway */
+			/* Timeout or kick: run without a message, not the last one again */
+			state_obj.chan = NULL;
 		} else if (err) {
 			LOG_ERR("zbus_sub_wait_msg failed: %d", err);
 			continue;
+		} else {
+			/* Latest value of a coalesced status channel */
+			zbus_latest_received(&sensor, state_obj.chan, state_obj.msg_buf);
 		}
 
+#ifdef CONFIG_APP_ZBUS_TRACE
+		if (err == 0) {
+			zbus_trace_dispatch(&sensor, state_obj.chan, state_obj.msg_buf);
+		}
+#endif
+
+#ifdef CONFIG_APP_SMF_TRACE
+		const struct smf_state *prev = SMF_CTX(&state_obj)->current;
+#endif
+
 		/* Run state machine */
 		int32_t ret = smf_run_state(SMF_CTX(&state_obj));
 		if (ret) {
 			LOG_ERR("smf_run_state failed: %d", ret);
 		}
+
+#ifdef CONFIG_APP_SMF_TRACE
+		smf_trace_record(SMF_TRACE_MODULE(sensor), prev,
+				 SMF_CTX(&state_obj)->current, state_obj.chan);
+#endif
 	}
 }
 
@@ -307,3 +545,5 @@ K_THREAD_DEFINE(sensor_module,
 		NULL, NULL, NULL,
 		CONFIG_APP_SENSOR_PRIORITY,
 		0, 0);
+
+#endif /* CONFIG_APP_SMF_EXECUTOR */
@@ -26,10 +26,19 @@ struct sensor_msg {
 	float temperature;
 	float humidity;
 	uint32_t timestamp;
+#ifdef CONFIG_APP_ZBUS_TRACE
+	uint32_t trace_cycles;
+#endif
 };
 
 #define MSG_TO_SENSOR_MSG(_msg) (*(const struct sensor_msg *)_msg)
 
+/* Filter for ZBUS_LATEST_CHAN_ADD_OBS_IF(): SENSOR_IDLE coalesces, samples and commands queue */
+static inline bool sensor_msg_is_idle(const void *msg)
+{
+	return MSG_TO_SENSOR_MSG(msg).type == SENSOR_IDLE;
+}
+
 ZBUS_CHAN_DECLARE(SENSOR_CHAN);
 
 #ifdef __cplusplus
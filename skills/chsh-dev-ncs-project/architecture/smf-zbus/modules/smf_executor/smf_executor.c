@@ -0,0 +1,564 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file smf_executor.c
+ * @brief Shared SMF executor
+ *
+ * This module demonstrates:
+ * - k_poll() over many zbus message subscriber queues from one thread
+ * - A ready list feeding a small pool of worker threads
+ * - Per-module serialization (ordering) with round-robin batching (fairness)
+ * - Per-module run-time statistics over the shell
+ *
+ * Module life cycle: IDLE (polled by the dispatcher) -> READY (on the ready
+ * list) -> RUNNING (owned by one worker) -> IDLE or back to READY when
+ * messages are still queued.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/smf.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/task_wdt/task_wdt.h>
+#include <string.h>
+
+#include "smf_executor.h"
+#include "zbus_latest.h"
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+#include "zbus_trace.h"
+#endif
+
+LOG_MODULE_REGISTER(smf_executor, CONFIG_APP_SMF_EXECUTOR_LOG_LEVEL);
+
+enum exec_state {
+	EXEC_IDLE,
+	EXEC_READY,
+	EXEC_RUNNING,
+};
+
+/*******************************************************************************
+ * Executor State
+ ******************************************************************************/
+
+static sys_slist_t ready_list = SYS_SLIST_STATIC_INIT(&ready_list);
+static struct k_spinlock lock;
+static K_SEM_DEFINE(ready_sem, 0, K_SEM_MAX_LIMIT);
+
+/* Wakes the dispatcher when a module goes back to IDLE */
+static struct k_poll_signal kick = K_POLL_SIGNAL_INITIALIZER(kick);
+
+/* Queues the dispatcher may poll per module */
+#ifdef CONFIG_APP_ZBUS_LANES
+#define POLL_PER_MODULE ZBUS_LANE_COUNT
+#else
+#define POLL_PER_MODULE 1
+#endif
+
+/* Plus one smf_idle kick signal per module */
+#ifdef CONFIG_APP_SMF_IDLE
+#define POLL_PER_MODULE_ALL (POLL_PER_MODULE + 1)
+#else
+#define POLL_PER_MODULE_ALL POLL_PER_MODULE
+#endif
+
+#define POLL_MAX (CONFIG_APP_SMF_EXECUTOR_MAX_MODULES * POLL_PER_MODULE_ALL)
+
+/* In ms, so a 1 s watchdog timeout does not round down to no wait at all */
+#define WDT_FEED_MS (CONFIG_APP_SMF_EXECUTOR_WATCHDOG_TIMEOUT_SECONDS * 500)
+
+static struct k_poll_event events[POLL_MAX + 1];
+static const struct smf_exec_module *polled[POLL_MAX];
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_APP_SMF_EXECUTOR_WORKERS,
+				   CONFIG_APP_SMF_EXECUTOR_STACK_SIZE);
+static struct k_thread workers[CONFIG_APP_SMF_EXECUTOR_WORKERS];
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+/* Must be called with lock held */
+static void make_ready(const struct smf_exec_module *mod, bool timed_out)
+{
+	struct smf_exec_data *data = mod->data;
+
+	data->state = EXEC_READY;
+	data->timed_out = timed_out;
+	data->ready_cycles = k_cycle_get_32();
+	sys_slist_append(&ready_list, &data->node);
+	k_sem_give(&ready_sem);
+}
+
+static void rearm_timeout(const struct smf_exec_module *mod)
+{
+	uint32_t timeout_ms = mod->timeout_ms;
+
+#ifdef CONFIG_APP_SMF_IDLE
+	/* No deadline at all while the module is quiescent */
+	if (mod->data->idle) {
+		timeout_ms = smf_idle_wait_begin(mod->data->idle, timeout_ms);
+	}
+#endif
+
+	mod->data->deadline = timeout_ms ? k_uptime_get() + timeout_ms : 0;
+}
+
+#ifdef CONFIG_APP_SMF_IDLE
+static void idle_wait_end(const struct smf_exec_module *mod, bool msg)
+{
+	struct smf_exec_data *data = mod->data;
+
+	if (data->idle == NULL) {
+		return;
+	}
+
+	smf_idle_wait_end(data->idle, msg ? SMF_IDLE_WAKE_MSG :
+				      data->kicked ? SMF_IDLE_WAKE_KICK :
+				      SMF_IDLE_WAKE_TIMEOUT);
+}
+#endif
+
+static bool has_pending(const struct smf_exec_module *mod)
+{
+#ifdef CONFIG_APP_ZBUS_LANES
+	if (mod->lanes) {
+		return zbus_lanes_pending(mod->lanes);
+	}
+#endif
+	return !k_fifo_is_empty(mod->obs->message_fifo);
+}
+
+static int fetch_msg(const struct smf_exec_module *mod, const struct zbus_channel **chan)
+{
+	int err;
+
+#ifdef CONFIG_APP_ZBUS_LANES
+	if (mod->lanes) {
+		return zbus_lanes_wait_msg(mod->lanes, chan, mod->msg_buf, K_NO_WAIT);
+	}
+#endif
+	err = zbus_sub_wait_msg(mod->obs, chan, mod->msg_buf, K_NO_WAIT);
+	if (err == 0) {
+		/* Latest value of a coalesced status channel */
+		zbus_latest_received(mod->obs, *chan, mod->msg_buf);
+	}
+
+	return err;
+}
+
+/* Add the module's queues to the dispatcher poll set, returns events used */
+static size_t poll_add(const struct smf_exec_module *mod, struct k_poll_event *ev)
+{
+#ifdef CONFIG_APP_ZBUS_LANES
+	if (mod->lanes) {
+		for (int lane = 0; lane < ZBUS_LANE_COUNT; lane++) {
+			k_poll_event_init(&ev[lane], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+					  K_POLL_MODE_NOTIFY_ONLY, &mod->lanes->lanes[lane].fifo);
+		}
+		return ZBUS_LANE_COUNT;
+	}
+#endif
+	k_poll_event_init(ev, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, mod->obs->message_fifo);
+	return 1;
+}
+
+#ifdef CONFIG_APP_SMF_IDLE
+/* Add the module's smf_idle kick signal, returns events used */
+static size_t poll_add_kick(const struct smf_exec_module *mod, struct k_poll_event *ev)
+{
+	if (mod->data->idle == NULL) {
+		return 0;
+	}
+
+	k_poll_event_init(ev, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY,
+			  &mod->data->idle->data->kick);
+	return 1;
+}
+#endif
+
+static void run_once(const struct smf_exec_module *mod, const struct zbus_channel *chan)
+{
+	struct smf_exec_stats *stats = &mod->data->stats;
+	uint32_t start;
+	uint32_t us;
+	int32_t ret;
+#ifdef CONFIG_APP_SMF_TRACE
+	const struct smf_state *prev = mod->ctx->current;
+#endif
+
+	*mod->chan = chan;
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+	/* Module heartbeat per dispatch; a handler that hangs stops it */
+	if (mod->data->wdt) {
+		wdt_supervisor_feed(mod->data->wdt);
+	}
+#endif
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+	/* Lanes subscribers call the hook themselves, per lane listener */
+	if (chan && mod->obs) {
+		zbus_trace_dispatch(mod->obs, chan, mod->msg_buf);
+	}
+#endif
+
+	start = k_cycle_get_32();
+	ret = smf_run_state(mod->ctx);
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	if (ret) {
+		LOG_ERR("%s: smf_run_state failed: %d", mod->name, ret);
+	}
+
+	mod->stats(ret, chan != NULL, us);
+
+#ifdef CONFIG_APP_SMF_TRACE
+	smf_trace_record(mod->trace, prev, mod->ctx->current, chan);
+#endif
+
+	stats->runs++;
+	stats->run_total_us += us;
+	stats->run_max_us = MAX(stats->run_max_us, us);
+	if (chan) {
+		stats->msgs++;
+	}
+}
+
+/* Run one batch of a module; returns true when messages are still queued */
+static bool run_batch(const struct smf_exec_module *mod)
+{
+	const struct zbus_channel *chan;
+	int err;
+
+#ifdef CONFIG_APP_SMF_IDLE
+	idle_wait_end(mod, !mod->data->timed_out);
+#endif
+
+	if (mod->data->timed_out) {
+		run_once(mod, NULL);
+#ifdef CONFIG_APP_SMF_IDLE
+		if (mod->data->kicked) {
+			mod->data->kicked = false;
+			mod->data->stats.kicks++;
+		} else {
+			mod->data->stats.timeouts++;
+		}
+#else
+		mod->data->stats.timeouts++;
+#endif
+		rearm_timeout(mod);
+		return has_pending(mod);
+	}
+
+	for (int i = 0; i < CONFIG_APP_SMF_EXECUTOR_BATCH; i++) {
+		err = fetch_msg(mod, &chan);
+		if (err == -ENOMSG || err == -EAGAIN) {
+			break;
+		} else if (err) {
+			LOG_ERR("%s: zbus_sub_wait_msg failed: %d", mod->name, err);
+			break;
+		}
+
+		run_once(mod, chan);
+	}
+
+	rearm_timeout(mod);
+
+	return has_pending(mod);
+}
+
+/*******************************************************************************
+ * Worker Threads
+ ******************************************************************************/
+
+static void worker_thread(void *p1, void *p2, void *p3)
+{
+	const struct smf_exec_module *mod;
+	struct smf_exec_data *data;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+	uint32_t wait_us;
+	bool pending;
+	int wdt_id;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	wdt_id = task_wdt_add(CONFIG_APP_SMF_EXECUTOR_WATCHDOG_TIMEOUT_SECONDS * 1000,
+			      NULL, NULL);
+	if (wdt_id < 0) {
+		LOG_ERR("Worker %d: task_wdt_add failed: %d", (int)(uintptr_t)p1, wdt_id);
+	}
+
+	while (1) {
+		/* Feed at half the watchdog timeout while no module is ready */
+		int err = k_sem_take(&ready_sem, K_MSEC(WDT_FEED_MS));
+
+		if (wdt_id >= 0) {
+			task_wdt_feed(wdt_id);
+		}
+
+		if (err) {
+			continue;
+		}
+
+		key = k_spin_lock(&lock);
+		node = sys_slist_get(&ready_list);
+		if (node == NULL) {
+			k_spin_unlock(&lock, key);
+			continue;
+		}
+
+		data = CONTAINER_OF(node, struct smf_exec_data, node);
+		data->state = EXEC_RUNNING;
+		wait_us = k_cyc_to_us_floor32(k_cycle_get_32() - data->ready_cycles);
+		data->stats.wait_max_us = MAX(data->stats.wait_max_us, wait_us);
+		k_spin_unlock(&lock, key);
+
+		mod = data->mod;
+		pending = run_batch(mod);
+
+		key = k_spin_lock(&lock);
+		if (pending) {
+			/* Back of the line so other ready modules get a turn */
+			data->stats.yields++;
+			make_ready(mod, false);
+		} else {
+			data->state = EXEC_IDLE;
+		}
+		k_spin_unlock(&lock, key);
+
+		if (!pending) {
+			k_poll_signal_raise(&kick, 0);
+		}
+	}
+}
+
+/*******************************************************************************
+ * Dispatcher Thread
+ ******************************************************************************/
+
+static void dispatcher_thread(void)
+{
+	size_t module_count;
+	k_spinlock_key_t key;
+	k_timeout_t timeout;
+	int64_t next;
+	int64_t now;
+	size_t n;
+
+	STRUCT_SECTION_COUNT(smf_exec_module, &module_count);
+	if (module_count > CONFIG_APP_SMF_EXECUTOR_MAX_MODULES) {
+		LOG_ERR("%zu modules registered, increase CONFIG_APP_SMF_EXECUTOR_MAX_MODULES",
+			module_count);
+		return;
+	}
+
+	/* Initial states run here, before any worker exists */
+	STRUCT_SECTION_FOREACH(smf_exec_module, mod) {
+		mod->data->mod = mod;
+#ifdef CONFIG_APP_SMF_IDLE
+		mod->data->idle = smf_idle_find(mod->name);
+#endif
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+		mod->data->wdt = wdt_supervisor_find(mod->name);
+#endif
+		smf_set_initial(mod->ctx, mod->initial);
+#ifdef CONFIG_APP_SMF_TRACE
+		smf_trace_record(mod->trace, NULL, mod->ctx->current, NULL);
+#endif
+		if (mod->init) {
+			mod->init();
+		}
+
+		/* Run the initial state now, not at the first message or timeout */
+		run_once(mod, NULL);
+		memset(&mod->data->stats, 0, sizeof(mod->data->stats));
+		rearm_timeout(mod);
+	}
+
+	for (int i = 0; i < CONFIG_APP_SMF_EXECUTOR_WORKERS; i++) {
+		k_thread_create(&workers[i], worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				worker_thread, (void *)(uintptr_t)i, NULL, NULL,
+				CONFIG_APP_SMF_EXECUTOR_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&workers[i], "smf_exec_worker");
+	}
+
+	LOG_INF("Running %zu modules on %d workers", module_count,
+		CONFIG_APP_SMF_EXECUTOR_WORKERS);
+
+	while (1) {
+		n = 0;
+		next = INT64_MAX;
+		now = k_uptime_get();
+
+		key = k_spin_lock(&lock);
+		STRUCT_SECTION_FOREACH(smf_exec_module, mod) {
+			struct smf_exec_data *data = mod->data;
+
+			if (data->state != EXEC_IDLE) {
+				continue;
+			}
+
+			if (data->deadline && data->deadline <= now) {
+				make_ready(mod, true);
+				continue;
+			}
+
+			if (data->deadline) {
+				next = MIN(next, data->deadline);
+			}
+
+			for (size_t added = poll_add(mod, &events[n]); added > 0; added--) {
+				polled[n++] = mod;
+			}
+#ifdef CONFIG_APP_SMF_IDLE
+			for (size_t added = poll_add_kick(mod, &events[n]); added > 0; added--) {
+				polled[n++] = mod;
+			}
+#endif
+		}
+		k_spin_unlock(&lock, key);
+
+		k_poll_event_init(&events[n], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &kick);
+
+		timeout = (next == INT64_MAX) ? K_FOREVER : K_MSEC(MAX(next - now, 0));
+		(void)k_poll(events, n + 1, timeout);
+
+		key = k_spin_lock(&lock);
+		for (size_t i = 0; i < n; i++) {
+#ifdef CONFIG_APP_SMF_IDLE
+			if (events[i].state == K_POLL_STATE_SIGNALED) {
+				/* smf_idle_kick(): one run without a message */
+				k_poll_signal_reset(events[i].signal);
+				if (polled[i]->data->state == EXEC_IDLE) {
+					polled[i]->data->kicked = true;
+					make_ready(polled[i], true);
+				}
+				continue;
+			}
+#endif
+			if (events[i].state == K_POLL_STATE_FIFO_DATA_AVAILABLE &&
+			    polled[i]->data->state == EXEC_IDLE) {
+				/* A module with several lanes is made ready only once */
+				make_ready(polled[i], false);
+			}
+		}
+		k_spin_unlock(&lock, key);
+
+		if (events[n].state == K_POLL_STATE_SIGNALED) {
+			k_poll_signal_reset(&kick);
+		}
+	}
+}
+
+K_THREAD_DEFINE(smf_executor_dispatcher,
+		CONFIG_APP_SMF_EXECUTOR_DISPATCHER_STACK_SIZE,
+		dispatcher_thread,
+		NULL, NULL, NULL,
+		CONFIG_APP_SMF_EXECUTOR_PRIORITY,
+		0, 0);
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int smf_executor_stats_get(size_t idx, const char **name, struct smf_exec_stats *stats)
+{
+	const struct smf_exec_module *mod;
+	size_t count;
+	k_spinlock_key_t key;
+
+	STRUCT_SECTION_COUNT(smf_exec_module, &count);
+	if (idx >= count) {
+		return -ENOENT;
+	}
+
+	STRUCT_SECTION_GET(smf_exec_module, idx, &mod);
+
+	key = k_spin_lock(&lock);
+	*name = mod->name;
+	*stats = mod->data->stats;
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+void smf_executor_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	STRUCT_SECTION_FOREACH(smf_exec_module, mod) {
+		memset(&mod->data->stats, 0, sizeof(mod->data->stats));
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_SMF_EXECUTOR_SHELL
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	struct smf_exec_stats stats;
+	const char *name;
+	uint64_t total_us = 0;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (size_t i = 0; smf_executor_stats_get(i, &name, &stats) == 0; i++) {
+		total_us += stats.run_total_us;
+	}
+
+	shell_print(sh, "%-16s %8s %8s %8s %6s %6s %8s %8s %5s",
+		    "module", "runs", "msgs", "timeout", "kick", "yield",
+		    "run_max", "wait_max", "cpu%");
+
+	for (size_t i = 0; smf_executor_stats_get(i, &name, &stats) == 0; i++) {
+		uint32_t share = total_us ?
+				 (uint32_t)(stats.run_total_us * 100 / total_us) : 0;
+
+		shell_print(sh, "%-16s %8u %8u %8u %6u %6u %8u %8u %5u",
+			    name, stats.runs, stats.msgs, stats.timeouts, stats.kicks,
+			    stats.yields, stats.run_max_us, stats.wait_max_us, share);
+	}
+
+	shell_print(sh, "Times in us, cpu%% is the share of executor run time");
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	smf_executor_stats_reset();
+	shell_print(sh, "Executor statistics cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_smf_exec,
+	SHELL_CMD(stats, NULL, "Per-module run statistics", cmd_stats),
+	SHELL_CMD(reset, NULL, "Clear statistics", cmd_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(smf_exec, &sub_smf_exec, "Shared SMF executor", NULL);
+
+#endif /* CONFIG_APP_SMF_EXECUTOR_SHELL */
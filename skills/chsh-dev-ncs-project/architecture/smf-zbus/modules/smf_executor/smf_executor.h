@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SMF_EXECUTOR_H_
+#define _SMF_EXECUTOR_H_
+
+/**
+ * @file smf_executor.h
+ * @brief Shared executor running many SMF modules on a few threads
+ *
+ * Instead of one thread + stack per module, modules register their state
+ * object and message subscriber with SMF_EXECUTOR_MODULE_DEFINE(). One
+ * dispatcher thread waits on all subscriber queues with k_poll() and hands
+ * modules that have pending messages (or whose timeout expired) to a pool
+ * of CONFIG_APP_SMF_EXECUTOR_WORKERS worker threads.
+ *
+ * Guarantees:
+ * - A module runs on at most one worker at a time, so its messages are
+ *   handled in queue order, exactly like the per-thread loop.
+ * - A worker handles at most CONFIG_APP_SMF_EXECUTOR_BATCH messages of one
+ *   module before it goes to the back of the ready list (round robin).
+ *
+ * The state object must follow the module convention used in this repo:
+ *
+ * @code
+ * struct sensor_state_object {
+ *	struct smf_ctx ctx;                 // first member
+ *	const struct zbus_channel *chan;    // set before every run
+ *	uint8_t msg_buf[...];               // filled before every run
+ *	...
+ * };
+ * @endcode
+ *
+ * Handlers run on a shared worker, so they must not block for long
+ * (no k_sleep() waiting for hardware); use the module timeout instead.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/smf.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef CONFIG_APP_SMF_TRACE
+#include "smf_trace.h"
+#endif
+
+#ifdef CONFIG_APP_ZBUS_LANES
+#include "zbus_lanes.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_IDLE
+#include "smf_idle.h"
+#endif
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+#include "wdt_supervisor.h"
+#endif
+
+#include "app_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Per-module run-time statistics
+ */
+struct smf_exec_stats {
+	uint32_t runs;		/* smf_run_state() calls */
+	uint32_t msgs;		/* Runs triggered by a message */
+	uint32_t timeouts;	/* Runs triggered by the module timeout */
+	uint32_t kicks;		/* Runs triggered by smf_idle_kick() */
+	uint32_t yields;	/* Batches cut short to let other modules run */
+	uint32_t run_max_us;	/* Longest single smf_run_state() */
+	uint32_t wait_max_us;	/* Longest time ready but not yet running */
+	uint64_t run_total_us;
+};
+
+/** Runtime data of a registered module (RAM) */
+struct smf_exec_data {
+	sys_snode_t node;
+	const struct smf_exec_module *mod;	/* Owner, set by the dispatcher */
+	uint8_t state;
+	bool timed_out;
+	int64_t deadline;
+	uint32_t ready_cycles;
+	struct smf_exec_stats stats;
+#ifdef CONFIG_APP_SMF_IDLE
+	const struct smf_idle_module *idle;	/* Same-named SMF_IDLE_MODULE_DEFINE() */
+	bool kicked;
+#endif
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+	const struct wdt_supervisor_module *wdt;	/* Same-named supervisor module */
+#endif
+};
+
+/**
+ * @brief Registered module descriptor (ROM)
+ *
+ * Define one per module with SMF_EXECUTOR_MODULE_DEFINE().
+ */
+struct smf_exec_module {
+	const char *name;
+	const struct zbus_observer *obs;
+#ifdef CONFIG_APP_ZBUS_LANES
+	struct zbus_lanes *lanes;	/* Used instead of obs when set */
+#endif
+	struct smf_ctx *ctx;
+	const struct smf_state *initial;
+	const struct zbus_channel **chan;
+	void *msg_buf;
+	uint32_t timeout_ms;
+	void (*init)(void);
+	struct smf_exec_data *data;
+#ifdef CONFIG_APP_SMF_TRACE
+	const struct smf_trace_module *trace;
+#endif
+	void (*stats)(int ret, bool msg, uint32_t us);	/* Per-run app_stats update */
+};
+
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_APP_SMF_TRACE
+#define SMF_EXEC_TRACE_INIT(_name) .trace = SMF_TRACE_MODULE(_name),
+#else
+#define SMF_EXEC_TRACE_INIT(_name)
+#endif
+
+/* Statistics are named after the module, so each module gets its own updater */
+#define SMF_EXEC_STATS_DEFINE(_name)							\
+	APP_STATS_COUNTER_DEFINE(_name, msgs);						\
+	APP_STATS_COUNTER_DEFINE(_name, run_errors);					\
+	APP_STATS_HIST_DEFINE(_name, run_us);						\
+	static void _CONCAT(smf_exec_stats_, _name)(int ret, bool msg, uint32_t us)	\
+	{										\
+		if (ret) {								\
+			APP_STATS_INC(_name, run_errors);				\
+		}									\
+		if (msg) {								\
+			APP_STATS_INC(_name, msgs);					\
+		}									\
+		APP_STATS_RECORD(_name, run_us, us);					\
+	}
+
+#define Z_SMF_EXECUTOR_MODULE_DEFINE(_name, _source, _obj, _initial, _timeout_ms, _init)	\
+	SMF_EXEC_STATS_DEFINE(_name)							\
+	static struct smf_exec_data _CONCAT(smf_exec_data_, _name);			\
+	static const STRUCT_SECTION_ITERABLE(smf_exec_module,				\
+					     _CONCAT(smf_exec_mod_, _name)) = {		\
+		.name = STRINGIFY(_name),						\
+		_source,								\
+		.ctx = SMF_CTX(&_obj),							\
+		.initial = _initial,							\
+		.chan = &(_obj).chan,							\
+		.msg_buf = (_obj).msg_buf,						\
+		.timeout_ms = _timeout_ms,						\
+		.init = _init,								\
+		.data = &_CONCAT(smf_exec_data_, _name),				\
+		.stats = _CONCAT(smf_exec_stats_, _name),				\
+		SMF_EXEC_TRACE_INIT(_name)						\
+	}
+/** @endcond */
+
+/**
+ * @brief Run a module on the shared executor
+ *
+ * Replaces the module's K_THREAD_DEFINE() and thread loop. The executor
+ * calls smf_set_initial(), then @p _init, then runs the state machine once
+ * with chan == NULL. After that it runs once per received message, or with
+ * chan == NULL after @p _timeout_ms without a message.
+ *
+ * Hooks are looked up by @p _name and called by the executor:
+ * - CONFIG_APP_SMF_TRACE: transitions are recorded against the
+ *   SMF_TRACE_MODULE_DEFINE() of that name.
+ * - CONFIG_APP_ZBUS_TRACE: zbus_trace_dispatch() is called for every
+ *   message before the run (lanes subscribers call it themselves); this
+ *   hook does not depend on @p _name.
+ * - CONFIG_APP_SMF_IDLE: a same-named SMF_IDLE_MODULE_DEFINE() drops
+ *   @p _timeout_ms while the module is quiescent, and smf_idle_kick()
+ *   makes it run.
+ * - CONFIG_APP_WDT_SUPERVISOR: a same-named WDT_SUPERVISOR_MODULE_DEFINE()
+ *   is fed before every run, so handlers need not feed it. Its timeout
+ *   must be longer than @p _timeout_ms.
+ * - CONFIG_APP_STATS: the executor exports @p _name msgs, run_errors and
+ *   run_us (histogram) to the "stats" shell command; the module must not
+ *   define statistics of those names itself.
+ *
+ * @param _name Module name (identifier)
+ * @param _obs Message subscriber (ZBUS_MSG_SUBSCRIBER_DEFINE name)
+ * @param _obj Static state object
+ * @param _initial Initial state
+ * @param _timeout_ms Idle timeout in ms, 0 to only run on messages
+ * @param _init Called once on the executor after smf_set_initial(), or NULL
+ */
+#define SMF_EXECUTOR_MODULE_DEFINE(_name, _obs, _obj, _initial, _timeout_ms, _init)	\
+	Z_SMF_EXECUTOR_MODULE_DEFINE(_name, .obs = &_obs, _obj, _initial,		\
+				     _timeout_ms, _init)
+
+#ifdef CONFIG_APP_ZBUS_LANES
+/**
+ * @brief Run a module with a lanes subscriber on the shared executor
+ *
+ * Same as SMF_EXECUTOR_MODULE_DEFINE(), but messages come from a
+ * ZBUS_LANES_SUBSCRIBER_DEFINE() subscriber, HIGH lane first.
+ */
+#define SMF_EXECUTOR_LANES_MODULE_DEFINE(_name, _lanes, _obj, _initial, _timeout_ms, _init) \
+	Z_SMF_EXECUTOR_MODULE_DEFINE(_name, .lanes = &_lanes, _obj, _initial,		\
+				     _timeout_ms, _init)
+#endif
+
+/**
+ * @brief Get the statistics of one registered module
+ *
+ * @param idx Module index, starting at 0
+ * @param name Output module name
+ * @param stats Output statistics
+ * @return 0 on success, -ENOENT when idx is past the last module
+ */
+int smf_executor_stats_get(size_t idx, const char **name, struct smf_exec_stats *stats);
+
+/**
+ * @brief Clear the statistics of all modules
+ */
+void smf_executor_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SMF_EXECUTOR_H_ */
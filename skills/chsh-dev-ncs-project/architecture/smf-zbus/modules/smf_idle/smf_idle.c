@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file smf_idle.c
+ * @brief Idle-aware waiting for SMF modules
+ *
+ * This module demonstrates:
+ * - Dropping periodic timeouts while a module has nothing to do
+ * - k_poll() on a subscriber queue plus a signal, so interrupts can wake a
+ *   module without a message and without a lost-wakeup race
+ * - Suspending watchdog supervision only while a module is blocked
+ * - Per-module wakeup accounting over the shell
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/shell/shell.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "smf_idle.h"
+
+/* Start of the statistics window, uptime in ms */
+static atomic_t window_start_ms;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static uint32_t now_ms(void)
+{
+	return k_uptime_get_32();
+}
+
+/* Quiescent time since reset, including a period still in progress */
+static uint32_t quiescent_total_ms(const struct smf_idle_data *data, uint32_t now)
+{
+	uint32_t total = (uint32_t)atomic_get(&data->quiescent_ms);
+
+	if (atomic_get(&data->quiescent)) {
+		total += now - (uint32_t)atomic_get(&data->quiescent_since_ms);
+	}
+
+	return total;
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+void smf_idle_enter(const struct smf_idle_module *mod)
+{
+	struct smf_idle_data *data = mod->data;
+
+	atomic_set(&data->quiescent_since_ms, (atomic_val_t)now_ms());
+	atomic_set(&data->quiescent, 1);
+}
+
+void smf_idle_exit(const struct smf_idle_module *mod)
+{
+	struct smf_idle_data *data = mod->data;
+	uint32_t since;
+
+	if (!atomic_cas(&data->quiescent, 1, 0)) {
+		return;
+	}
+
+	since = (uint32_t)atomic_get(&data->quiescent_since_ms);
+	atomic_add(&data->quiescent_ms, (atomic_val_t)(now_ms() - since));
+}
+
+void smf_idle_kick(const struct smf_idle_module *mod)
+{
+	k_poll_signal_raise(&mod->data->kick, 0);
+}
+
+uint32_t smf_idle_wait_begin(const struct smf_idle_module *mod, uint32_t active_ms)
+{
+	if (!atomic_get(&mod->data->quiescent)) {
+		return active_ms;
+	}
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+	wdt_supervisor_suspend(mod->wdt);
+#endif
+
+	return mod->max_sleep_ms;
+}
+
+void smf_idle_wait_end(const struct smf_idle_module *mod, enum smf_idle_wake cause)
+{
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+	wdt_supervisor_resume(mod->wdt);
+#endif
+
+	atomic_inc(&mod->data->wakeups[cause]);
+}
+
+int smf_idle_wait_msg(const struct smf_idle_module *mod, const struct zbus_observer *obs,
+		      const struct zbus_channel **chan, void *msg, uint32_t active_ms)
+{
+	struct k_poll_event events[2];
+	enum smf_idle_wake cause;
+	uint32_t timeout_ms;
+	int err;
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, obs->message_fifo);
+	k_poll_event_init(&events[1], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &mod->data->kick);
+
+	timeout_ms = smf_idle_wait_begin(mod, active_ms);
+	(void)k_poll(events, ARRAY_SIZE(events), timeout_ms ? K_MSEC(timeout_ms) : K_FOREVER);
+
+	if (events[1].state == K_POLL_STATE_SIGNALED) {
+		k_poll_signal_reset(&mod->data->kick);
+	}
+
+	/* Messages first: a kick never delays queued work */
+	err = zbus_sub_wait_msg(obs, chan, msg, K_NO_WAIT);
+	if (err == 0) {
+		cause = SMF_IDLE_WAKE_MSG;
+	} else if (events[1].state == K_POLL_STATE_SIGNALED) {
+		cause = SMF_IDLE_WAKE_KICK;
+	} else {
+		cause = SMF_IDLE_WAKE_TIMEOUT;
+	}
+
+	smf_idle_wait_end(mod, cause);
+
+	return err;
+}
+
+const struct smf_idle_module *smf_idle_find(const char *name)
+{
+	STRUCT_SECTION_FOREACH(smf_idle_module, mod) {
+		if (strcmp(mod->name, name) == 0) {
+			return mod;
+		}
+	}
+
+	return NULL;
+}
+
+bool smf_idle_all_quiescent(void)
+{
+	STRUCT_SECTION_FOREACH(smf_idle_module, mod) {
+		if (!atomic_get(&mod->data->quiescent)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int smf_idle_stats_get(size_t idx, const struct smf_idle_module **mod,
+		       struct smf_idle_stats *stats)
+{
+	const struct smf_idle_data *data;
+	uint32_t now = now_ms();
+	size_t count;
+
+	STRUCT_SECTION_COUNT(smf_idle_module, &count);
+	if (idx >= count) {
+		return -ENOENT;
+	}
+
+	STRUCT_SECTION_GET(smf_idle_module, idx, mod);
+	data = (*mod)->data;
+
+	for (size_t i = 0; i < ARRAY_SIZE(stats->wakeups); i++) {
+		stats->wakeups[i] = (uint32_t)atomic_get(&data->wakeups[i]);
+	}
+	stats->quiescent = atomic_get(&data->quiescent);
+	stats->quiescent_ms = quiescent_total_ms(data, now);
+	stats->window_ms = now - (uint32_t)atomic_get(&window_start_ms);
+
+	return 0;
+}
+
+void smf_idle_stats_reset(void)
+{
+	uint32_t now = now_ms();
+
+	STRUCT_SECTION_FOREACH(smf_idle_module, mod) {
+		struct smf_idle_data *data = mod->data;
+
+		for (size_t i = 0; i < ARRAY_SIZE(data->wakeups); i++) {
+			atomic_clear(&data->wakeups[i]);
+		}
+		atomic_clear(&data->quiescent_ms);
+		atomic_set(&data->quiescent_since_ms, (atomic_val_t)now);
+	}
+
+	atomic_set(&window_start_ms, (atomic_val_t)now);
+}
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_SMF_IDLE_SHELL
+
+/* Print a rate in events per second with one decimal */
+static void rate_str(char *buf, size_t len, uint32_t events, uint32_t window_ms)
+{
+	uint64_t tenths = window_ms ? ((uint64_t)events * 10000U) / window_ms : 0;
+
+	snprintf(buf, len, "%u.%u", (uint32_t)(tenths / 10), (uint32_t)(tenths % 10));
+}
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct smf_idle_module *mod;
+	struct smf_idle_stats stats;
+	uint32_t total = 0;
+	uint32_t window_ms = 0;
+	uint32_t quiet_pct;
+	char msg[12];
+	char tmo[12];
+	char kick[12];
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-16s %-6s %8s %8s %8s %7s", "module", "state",
+		    "msg/s", "tmo/s", "kick/s", "quiet%");
+
+	for (size_t i = 0; smf_idle_stats_get(i, &mod, &stats) == 0; i++) {
+		window_ms = stats.window_ms;
+		quiet_pct = window_ms ? (uint32_t)(((uint64_t)stats.quiescent_ms * 100U) /
+						   window_ms) : 0;
+		rate_str(msg, sizeof(msg), stats.wakeups[SMF_IDLE_WAKE_MSG], window_ms);
+		rate_str(tmo, sizeof(tmo), stats.wakeups[SMF_IDLE_WAKE_TIMEOUT], window_ms);
+		rate_str(kick, sizeof(kick), stats.wakeups[SMF_IDLE_WAKE_KICK], window_ms);
+
+		shell_print(sh, "%-16s %-6s %8s %8s %8s %6u%%", mod->name,
+			    stats.quiescent ? "quiet" : "active", msg, tmo, kick, quiet_pct);
+
+		total += stats.wakeups[SMF_IDLE_WAKE_MSG] +
+			 stats.wakeups[SMF_IDLE_WAKE_TIMEOUT] +
+			 stats.wakeups[SMF_IDLE_WAKE_KICK];
+	}
+
+	rate_str(msg, sizeof(msg), total, window_ms);
+	shell_print(sh, "%s module wakeups/s over %u s", msg, window_ms / 1000);
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	smf_idle_stats_reset();
+	shell_print(sh, "Idle statistics cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_smf_idle,
+	SHELL_CMD(show, NULL, "Wakeups per second and quiescent share per module", cmd_show),
+	SHELL_CMD(reset, NULL, "Clear counters and restart the window", cmd_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(smf_idle, &sub_smf_idle, "Idle-aware module waiting", NULL);
+
+#endif /* CONFIG_APP_SMF_IDLE_SHELL */
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SMF_IDLE_H_
+#define _SMF_IDLE_H_
+
+/**
+ * @file smf_idle.h
+ * @brief Idle-aware waiting for SMF modules
+ *
+ * A module loop that waits with a fixed timeout wakes the CPU every
+ * timeout just to run a state machine that has nothing to do. With this
+ * module a state declares that the module is quiescent (it only reacts
+ * to messages), and the module then blocks without a timeout until a
+ * message arrives or smf_idle_kick() is called:
+ *
+ * @code
+ * SMF_IDLE_MODULE_DEFINE(sensor, 0);
+ *
+ * static void state_idle_entry(void *obj) { smf_idle_enter(SMF_IDLE_MODULE(sensor)); }
+ * static void state_idle_exit(void *obj)  { smf_idle_exit(SMF_IDLE_MODULE(sensor)); }
+ *
+ * // Thread loop, instead of zbus_sub_wait_msg(&sensor, ..., K_SECONDS(n))
+ * err = smf_idle_wait_msg(SMF_IDLE_MODULE(sensor), &sensor, &chan, buf, n * 1000);
+ * @endcode
+ *
+ * With no module timer pending, the kernel's next timeout is far away and
+ * the PM subsystem can pick a deep idle state. Every wakeup is counted by
+ * cause (message, timeout, kick), so "smf_idle show" lists the modules
+ * that keep the system awake.
+ *
+ * While blocked and quiescent, a module is suspended from the watchdog
+ * supervisor (the WDT_SUPERVISOR_MODULE_DEFINE() with the same name). A
+ * module that feeds its own task_wdt channel instead must pass a
+ * @p _max_sleep_ms below its watchdog timeout.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+#include "wdt_supervisor.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Why a module stopped waiting */
+enum smf_idle_wake {
+	SMF_IDLE_WAKE_MSG,	/* Message in the queue */
+	SMF_IDLE_WAKE_TIMEOUT,	/* Module timeout expired */
+	SMF_IDLE_WAKE_KICK,	/* smf_idle_kick(), e.g. from an ISR */
+};
+
+/** Runtime data of a registered module (RAM) */
+struct smf_idle_data {
+	atomic_t quiescent;
+	atomic_t quiescent_since_ms;	/* Uptime of the last smf_idle_enter() */
+	atomic_t quiescent_ms;		/* Finished quiescent periods since reset */
+	atomic_t wakeups[3];		/* Per enum smf_idle_wake */
+	struct k_poll_signal kick;
+};
+
+/**
+ * @brief Registered module descriptor (ROM)
+ *
+ * Define one per module with SMF_IDLE_MODULE_DEFINE().
+ */
+struct smf_idle_module {
+	const char *name;
+	uint32_t max_sleep_ms;
+	struct smf_idle_data *data;
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+	const struct wdt_supervisor_module *wdt;
+#endif
+};
+
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+#define SMF_IDLE_WDT_INIT(_name) .wdt = WDT_SUPERVISOR_MODULE(_name),
+#else
+#define SMF_IDLE_WDT_INIT(_name)
+#endif
+/** @endcond */
+
+/**
+ * @brief Register a module for idle-aware waiting
+ *
+ * With CONFIG_APP_WDT_SUPERVISOR, @p _name must match the module's
+ * WDT_SUPERVISOR_MODULE_DEFINE() name. With CONFIG_APP_SMF_EXECUTOR it
+ * must match the SMF_EXECUTOR_MODULE_DEFINE() name.
+ *
+ * @param _name Module name (identifier)
+ * @param _max_sleep_ms Longest wait while quiescent, 0 for no limit
+ */
+#define SMF_IDLE_MODULE_DEFINE(_name, _max_sleep_ms)					\
+	static struct smf_idle_data _CONCAT(smf_idle_data_, _name) = {			\
+		.kick = K_POLL_SIGNAL_INITIALIZER(_CONCAT(smf_idle_data_, _name).kick),	\
+	};										\
+	static const STRUCT_SECTION_ITERABLE(smf_idle_module,				\
+					     _CONCAT(smf_idle_mod_, _name)) = {		\
+		.name = STRINGIFY(_name),						\
+		.max_sleep_ms = _max_sleep_ms,						\
+		.data = &_CONCAT(smf_idle_data_, _name),				\
+		SMF_IDLE_WDT_INIT(_name)						\
+	}
+
+/** Reference a descriptor defined with SMF_IDLE_MODULE_DEFINE() */
+#define SMF_IDLE_MODULE(_name) (&_CONCAT(smf_idle_mod_, _name))
+
+/**
+ * @brief Per-module wakeup statistics since the last reset
+ */
+struct smf_idle_stats {
+	uint32_t wakeups[3];	/* Per enum smf_idle_wake */
+	uint32_t quiescent_ms;	/* Time spent quiescent */
+	uint32_t window_ms;	/* Time since the last reset */
+	bool quiescent;
+};
+
+/**
+ * @brief Declare the module quiescent
+ *
+ * Call from the entry of a state that only waits for messages. Safe from
+ * ISRs.
+ */
+void smf_idle_enter(const struct smf_idle_module *mod);
+
+/**
+ * @brief Declare the module active again
+ *
+ * Call from the exit of the state that called smf_idle_enter(). Safe from
+ * ISRs.
+ */
+void smf_idle_exit(const struct smf_idle_module *mod);
+
+/**
+ * @brief Make the module run its state machine once, without a message
+ *
+ * For events that reach the module outside zbus (interrupts, driver
+ * callbacks). The run looks like a timeout to the module (chan == NULL).
+ * Safe from ISRs; a kick while the module is not waiting is kept until the
+ * next wait.
+ */
+void smf_idle_kick(const struct smf_idle_module *mod);
+
+/**
+ * @brief Start waiting
+ *
+ * Returns the timeout to wait with, and suspends watchdog supervision if
+ * the module is quiescent. Every call must be followed by
+ * smf_idle_wait_end(). smf_idle_wait_msg() does both; this pair is for
+ * loops that wait on something else (zbus lanes, the shared executor).
+ *
+ * @param mod Module descriptor
+ * @param active_ms Timeout while active, 0 for none
+ * @return Timeout in ms, 0 to wait without timeout
+ */
+uint32_t smf_idle_wait_begin(const struct smf_idle_module *mod, uint32_t active_ms);
+
+/**
+ * @brief Stop waiting
+ *
+ * Resumes watchdog supervision and counts the wakeup.
+ *
+ * @param mod Module descriptor
+ * @param cause Why the wait ended
+ */
+void smf_idle_wait_end(const struct smf_idle_module *mod, enum smf_idle_wake cause);
+
+/**
+ * @brief Idle-aware zbus_sub_wait_msg()
+ *
+ * Waits up to @p active_ms while the module is active, and for a message
+ * or smf_idle_kick() only (bounded by max_sleep_ms) while it is
+ * quiescent.
+ *
+ * @p chan is only written with a message: on -ENOMSG the caller sets its
+ * channel to NULL before running the state machine.
+ *
+ * @return 0 with a message, -ENOMSG on timeout or kick, negative errno
+ *         from zbus_sub_wait_msg() otherwise
+ */
+int smf_idle_wait_msg(const struct smf_idle_module *mod, const struct zbus_observer *obs,
+		      const struct zbus_channel **chan, void *msg, uint32_t active_ms);
+
+/**
+ * @brief Find a registered module by name
+ *
+ * @return Descriptor, or NULL when no module has that name
+ */
+const struct smf_idle_module *smf_idle_find(const char *name);
+
+/**
+ * @brief Check whether every registered module is quiescent
+ *
+ * For application PM policy code.
+ */
+bool smf_idle_all_quiescent(void);
+
+/**
+ * @brief Get the statistics of one registered module
+ *
+ * @param idx Module index, starting at 0
+ * @param mod Output descriptor
+ * @param stats Output statistics
+ * @return 0 on success, -ENOENT when idx is past the last module
+ */
+int smf_idle_stats_get(size_t idx, const struct smf_idle_module **mod,
+		       struct smf_idle_stats *stats);
+
+/**
+ * @brief Clear the statistics of all modules and restart the window
+ */
+void smf_idle_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SMF_IDLE_H_ */
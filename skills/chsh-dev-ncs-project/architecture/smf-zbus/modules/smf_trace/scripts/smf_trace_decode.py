@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Decode an "smf_trace dump" capture into a state-transition timeline.
+
+Usage:
+    smf_trace_decode.py uart.log            # human readable timeline
+    smf_trace_decode.py uart.log --csv      # one CSV row per transition
+    smf_trace_decode.py uart.log -m sensor  # only one module
+
+The input is any text file that contains the shell hexdump lines printed by
+"smf_trace dump" (other log lines are ignored). Binary layout is documented
+in smf_trace.h.
+
+A buffer retained across warm resets holds several boots. Times restart at
+each boot marker and are relative to that boot; the CSV "boot" column counts
+boots in the capture, from 0.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+MAGIC = 0x54464D53
+ID_NONE = 0xFF
+TRIGGERS = {0xFF: "timeout", 0xFE: "init"}
+TRIG_BOOT = 0xFD
+NAME_LEN = 12
+CHAN_NAME_LEN = 16
+
+HEXDUMP_RE = re.compile(r"^\s*[0-9a-fA-F]{8}:\s+((?:[0-9a-fA-F]{2}\s+)+)")
+
+
+def read_bytes(path):
+    data = bytearray()
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            m = HEXDUMP_RE.match(line)
+            if m:
+                data.extend(bytes.fromhex(m.group(1).replace(" ", "")))
+    return bytes(data)
+
+
+def cstr(raw):
+    return raw.split(b"\0", 1)[0].decode("ascii", errors="replace")
+
+
+def parse(data):
+    hdr = struct.Struct("<IBBBBIII")
+    start = data.find(struct.pack("<I", MAGIC))
+    if start < 0:
+        sys.exit("No smf_trace dump found in input")
+
+    (_, version, module_count, chan_count, entry_size,
+     ticks_per_sec, entry_count, overwritten) = hdr.unpack_from(data, start)
+    if version != 1 or entry_size != 8:
+        sys.exit(f"Unsupported dump version {version} / entry size {entry_size}")
+
+    off = start + hdr.size
+    modules = []
+    for _ in range(module_count):
+        name = cstr(data[off:off + NAME_LEN])
+        state_count = data[off + NAME_LEN]
+        off += NAME_LEN + 1
+        states = []
+        for _ in range(state_count):
+            states.append(cstr(data[off:off + NAME_LEN]))
+            off += NAME_LEN
+        modules.append((name, states))
+
+    chans = []
+    for _ in range(chan_count):
+        chans.append(cstr(data[off:off + CHAN_NAME_LEN]))
+        off += CHAN_NAME_LEN
+
+    entries = []
+    for ts, mod, frm, to, chan in struct.iter_unpack("<IBBBB", data[off:off + entry_count * 8]):
+        entries.append((ts, mod, frm, to, chan))
+
+    return ticks_per_sec, overwritten, modules, chans, entries
+
+
+def unwrap(entries):
+    """Extend 32-bit tick stamps to 64 bits, per boot.
+
+    Yields (boot, ticks, module, from, to, chan). A boot marker starts a new
+    timeline; otherwise a decreasing stamp is a 32-bit wrap.
+    """
+    boot = 0
+    base = 0
+    prev = None
+    for ts, mod, frm, to, chan in entries:
+        if chan == TRIG_BOOT:
+            # Entries before the first marker belong to an overwritten boot
+            boot += prev is not None
+            base = 0
+        elif prev is not None and ts < prev:
+            base += 1 << 32
+        prev = ts
+        yield (boot, base + ts, mod, frm, to, chan)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", help="UART/RTT log containing the dump")
+    parser.add_argument("--csv", action="store_true", help="CSV output")
+    parser.add_argument("-m", "--module", help="Only show this module")
+    args = parser.parse_args()
+
+    ticks_per_sec, overwritten, modules, chans, entries = parse(read_bytes(args.capture))
+
+    def state(mod, sid):
+        if sid == ID_NONE or mod >= len(modules) or sid >= len(modules[mod][1]):
+            return "-"
+        return modules[mod][1][sid]
+
+    def trigger(chan):
+        if chan < len(chans):
+            return chans[chan]
+        return TRIGGERS.get(chan, f"chan{chan}")
+
+    if args.csv:
+        print("boot,time_s,module,from,to,channel")
+    elif overwritten:
+        print(f"# {overwritten} older transitions were overwritten")
+
+    for boot, ticks, mod, frm, to, chan in unwrap(entries):
+        t = ticks / ticks_per_sec
+        if chan == TRIG_BOOT:
+            if not args.csv:
+                print(f"{t:12.6f} s  ---- boot {boot} ----")
+            continue
+        name = modules[mod][0] if mod < len(modules) else f"mod{mod}"
+        if args.module and name != args.module:
+            continue
+        if args.csv:
+            print(f"{boot},{t:.6f},{name},{state(mod, frm)},{state(mod, to)},"
+                  f"{trigger(chan)}")
+        else:
+            print(f"{t:12.6f} s  {name:<12} {state(mod, frm):<14} -> "
+                  f"{state(mod, to):<14} [{trigger(chan)}]")
+
+
+if __name__ == "__main__":
+    main()
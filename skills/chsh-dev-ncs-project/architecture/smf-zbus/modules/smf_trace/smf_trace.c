@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file smf_trace.c
+ * @brief SMF state-transition trace buffer
+ *
+ * This module demonstrates:
+ * - An 8-byte (timestamp, module, from, to, channel) transition record
+ * - Lock-protected ring buffer that overwrites the oldest entry
+ * - Optional retention of the buffer across warm resets (.noinit), with a
+ *   boot marker entry per boot
+ * - Shell readout and binary dump for host-side decoding
+ *
+ * Recording is a spinlock, two pointer subtractions and an 8-byte store;
+ * no string formatting happens on the device until someone asks for it.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/smf.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/linker/section_tags.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "smf_trace.h"
+
+LOG_MODULE_REGISTER(smf_trace, CONFIG_APP_SMF_TRACE_LOG_LEVEL);
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_APP_SMF_TRACE_ENTRIES),
+	     "Trace buffer size must be a power of two");
+
+#define RING_MASK (CONFIG_APP_SMF_TRACE_ENTRIES - 1)
+
+/* Marks a valid ring after a warm reset */
+#define RING_VALID_MAGIC 0x534D4652U
+
+/*******************************************************************************
+ * Ring Buffer
+ ******************************************************************************/
+
+struct smf_trace_ring {
+	uint32_t magic;
+	uint32_t head;		/* Total entries ever written (free running) */
+	uint32_t overwritten;
+	struct smf_trace_entry entries[CONFIG_APP_SMF_TRACE_ENTRIES];
+};
+
+#ifdef CONFIG_APP_SMF_TRACE_RETAIN
+static __noinit struct smf_trace_ring ring;
+#else
+static struct smf_trace_ring ring;
+#endif
+
+static struct k_spinlock lock;
+static bool frozen;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static uint8_t module_id(const struct smf_trace_module *mod)
+{
+	const struct smf_trace_module *first;
+
+	STRUCT_SECTION_GET(smf_trace_module, 0, &first);
+
+	return (uint8_t)(mod - first);
+}
+
+static uint8_t trigger_id(const struct smf_state *from, const struct zbus_channel *chan)
+{
+	const struct zbus_channel *first;
+
+	if (from == NULL) {
+		return SMF_TRACE_TRIG_INIT;
+	} else if (chan == NULL) {
+		return SMF_TRACE_TRIG_TIMEOUT;
+	}
+
+	STRUCT_SECTION_GET(zbus_channel, 0, &first);
+
+	return (uint8_t)(chan - first);
+}
+
+static uint8_t state_id(const struct smf_trace_module *mod, const struct smf_state *state)
+{
+	if (state == NULL) {
+		return SMF_TRACE_ID_NONE;
+	}
+
+	return (uint8_t)(state - mod->states);
+}
+
+static const char *state_name(const struct smf_trace_module *mod, uint8_t id)
+{
+	return (id < mod->state_count) ? mod->state_names[id] : "-";
+}
+
+static uint32_t ring_count(void)
+{
+	return MIN(ring.head, CONFIG_APP_SMF_TRACE_ENTRIES);
+}
+
+/* Caller holds the lock */
+static void ring_put_locked(uint8_t module, uint8_t from, uint8_t to, uint8_t chan)
+{
+	struct smf_trace_entry *entry;
+
+	if (ring.head >= CONFIG_APP_SMF_TRACE_ENTRIES) {
+		ring.overwritten++;
+	}
+
+	entry = &ring.entries[ring.head & RING_MASK];
+	entry->timestamp = (uint32_t)k_uptime_ticks();
+	entry->module = module;
+	entry->from = from;
+	entry->to = to;
+	entry->chan = chan;
+	ring.head++;
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+void smf_trace_record(const struct smf_trace_module *mod,
+		      const struct smf_state *from,
+		      const struct smf_state *to,
+		      const struct zbus_channel *chan)
+{
+	k_spinlock_key_t key;
+
+	if (from == to) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (frozen) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	ring_put_locked(module_id(mod), state_id(mod, from), state_id(mod, to),
+			trigger_id(from, chan));
+
+	k_spin_unlock(&lock, key);
+}
+
+size_t smf_trace_read(struct smf_trace_entry *out, size_t max)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t count = MIN(ring_count(), max);
+	uint32_t start = ring.head - count;
+
+	for (uint32_t i = 0; i < count; i++) {
+		out[i] = ring.entries[(start + i) & RING_MASK];
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
+
+void smf_trace_freeze(bool freeze)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	frozen = freeze;
+
+	k_spin_unlock(&lock, key);
+}
+
+void smf_trace_clear(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	ring.head = 0;
+	ring.overwritten = 0;
+
+	k_spin_unlock(&lock, key);
+}
+
+static int smf_trace_init(void)
+{
+	size_t chan_count;
+	k_spinlock_key_t key;
+
+	STRUCT_SECTION_COUNT(zbus_channel, &chan_count);
+	if (chan_count >= SMF_TRACE_TRIG_BOOT) {
+		LOG_ERR("%zu zbus channels, triggers above %u are misread",
+			chan_count, SMF_TRACE_TRIG_BOOT - 1);
+	}
+
+	if (ring.magic != RING_VALID_MAGIC) {
+		memset(&ring, 0, sizeof(ring));
+		ring.magic = RING_VALID_MAGIC;
+	} else {
+		/* Retained buffer survived a warm reset; keep it for readout */
+		LOG_INF("Retained %u transitions from previous boot", ring_count());
+	}
+
+	/* Timestamps restart here; the decoder resets its timeline on it */
+	key = k_spin_lock(&lock);
+	ring_put_locked(SMF_TRACE_ID_NONE, SMF_TRACE_ID_NONE, SMF_TRACE_ID_NONE,
+			SMF_TRACE_TRIG_BOOT);
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+SYS_INIT(smf_trace_init, APPLICATION, 0);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_SMF_TRACE_SHELL
+
+static void pad_name(char *dst, size_t len, const char *src)
+{
+	memset(dst, 0, len);
+	strncpy(dst, src, len - 1);
+}
+
+static const char *trigger_name(uint8_t trigger, size_t chan_count)
+{
+	const struct zbus_channel *chan;
+
+	if (trigger < chan_count) {
+		STRUCT_SECTION_GET(zbus_channel, trigger, &chan);
+		return zbus_chan_name(chan);
+	}
+
+	switch (trigger) {
+	case SMF_TRACE_TRIG_INIT:
+		return "init";
+	default:
+		return "timeout";
+	}
+}
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct smf_trace_entry entry;
+	const struct smf_trace_module *mod;
+	size_t module_count;
+	size_t chan_count;
+	uint32_t count;
+	uint32_t shown;
+	uint32_t start;
+
+	STRUCT_SECTION_COUNT(smf_trace_module, &module_count);
+	STRUCT_SECTION_COUNT(zbus_channel, &chan_count);
+
+	count = ring_count();
+	shown = (argc > 1) ? MIN((uint32_t)strtoul(argv[1], NULL, 10), count) : count;
+	start = ring.head - shown;
+
+	for (uint32_t i = 0; i < shown; i++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		entry = ring.entries[(start + i) & RING_MASK];
+		k_spin_unlock(&lock, key);
+
+		if (entry.chan == SMF_TRACE_TRIG_BOOT) {
+			shell_print(sh, "%10u ms  ---- boot ----",
+				    (uint32_t)k_ticks_to_ms_floor64(entry.timestamp));
+			continue;
+		} else if (entry.module >= module_count) {
+			continue;
+		}
+
+		STRUCT_SECTION_GET(smf_trace_module, entry.module, &mod);
+
+		shell_print(sh, "%10u ms  %-12s %-14s -> %-14s [%s]",
+			    (uint32_t)k_ticks_to_ms_floor64(entry.timestamp),
+			    mod->name, state_name(mod, entry.from),
+			    state_name(mod, entry.to), trigger_name(entry.chan, chan_count));
+	}
+
+	shell_print(sh, "%u of %u entries shown, %u overwritten%s",
+		    shown, count, ring.overwritten, frozen ? " (frozen)" : "");
+
+	return 0;
+}
+
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	struct smf_trace_dump_hdr hdr;
+	struct smf_trace_entry chunk[16];
+	char name[SMF_TRACE_CHAN_NAME_LEN];
+	size_t module_count;
+	size_t chan_count;
+	uint32_t count;
+	uint32_t start;
+	bool was_frozen = frozen;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	STRUCT_SECTION_COUNT(smf_trace_module, &module_count);
+	STRUCT_SECTION_COUNT(zbus_channel, &chan_count);
+
+	/* Hold the buffer still while it is streamed out */
+	smf_trace_freeze(true);
+
+	count = ring_count();
+	start = ring.head - count;
+
+	hdr.magic = SMF_TRACE_DUMP_MAGIC;
+	hdr.version = SMF_TRACE_DUMP_VERSION;
+	hdr.module_count = module_count;
+	hdr.chan_count = chan_count;
+	hdr.entry_size = sizeof(struct smf_trace_entry);
+	hdr.ticks_per_sec = CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+	hdr.entry_count = count;
+	hdr.overwritten = ring.overwritten;
+	shell_hexdump(sh, (const uint8_t *)&hdr, sizeof(hdr));
+
+	STRUCT_SECTION_FOREACH(smf_trace_module, mod) {
+		pad_name(name, SMF_TRACE_NAME_LEN, mod->name);
+		name[SMF_TRACE_NAME_LEN] = mod->state_count;
+		shell_hexdump(sh, (const uint8_t *)name, SMF_TRACE_NAME_LEN + 1);
+
+		for (uint8_t i = 0; i < mod->state_count; i++) {
+			pad_name(name, SMF_TRACE_NAME_LEN, mod->state_names[i]);
+			shell_hexdump(sh, (const uint8_t *)name, SMF_TRACE_NAME_LEN);
+		}
+	}
+
+	STRUCT_SECTION_FOREACH(zbus_channel, chan) {
+		pad_name(name, SMF_TRACE_CHAN_NAME_LEN, zbus_chan_name(chan));
+		shell_hexdump(sh, (const uint8_t *)name, SMF_TRACE_CHAN_NAME_LEN);
+	}
+
+	for (uint32_t i = 0; i < count; i += ARRAY_SIZE(chunk)) {
+		uint32_t n = MIN(count - i, ARRAY_SIZE(chunk));
+
+		for (uint32_t j = 0; j < n; j++) {
+			chunk[j] = ring.entries[(start + i + j) & RING_MASK];
+		}
+		shell_hexdump(sh, (const uint8_t *)chunk, n * sizeof(chunk[0]));
+	}
+
+	smf_trace_freeze(was_frozen);
+
+	return 0;
+}
+
+static int cmd_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	smf_trace_clear();
+	shell_print(sh, "SMF trace cleared");
+
+	return 0;
+}
+
+static int cmd_freeze(const struct shell *sh, size_t argc, char **argv)
+{
+	bool freeze = (argc < 2) || (strcmp(argv[1], "off") != 0);
+
+	smf_trace_freeze(freeze);
+	shell_print(sh, "SMF trace %s", freeze ? "frozen" : "recording");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_smf_trace,
+	SHELL_CMD_ARG(show, NULL, "Decode last [n] transitions", cmd_show, 1, 1),
+	SHELL_CMD(dump, NULL, "Hex dump for smf_trace_decode.py", cmd_dump),
+	SHELL_CMD(clear, NULL, "Drop all entries", cmd_clear),
+	SHELL_CMD_ARG(freeze, NULL, "Stop recording [on|off]", cmd_freeze, 1, 1),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(smf_trace, &sub_smf_trace, "SMF transition trace", NULL);
+
+#endif /* CONFIG_APP_SMF_TRACE_SHELL */
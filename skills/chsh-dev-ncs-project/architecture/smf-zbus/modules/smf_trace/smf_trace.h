@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SMF_TRACE_H_
+#define _SMF_TRACE_H_
+
+/**
+ * @file smf_trace.h
+ * @brief Compact SMF state-transition trace buffer
+ *
+ * Records every state change of traced modules into an 8-byte-per-entry
+ * ring buffer. Cheap enough to leave on in production; read it back with
+ * "smf_trace dump" and decode with scripts/smf_trace_decode.py.
+ *
+ * Every boot starts with a boot marker entry, so a buffer retained across
+ * warm resets (CONFIG_APP_SMF_TRACE_RETAIN) shows where each boot begins
+ * and the decoder restarts its timeline there.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/smf.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Binary dump magic ("SMFT", little endian) */
+#define SMF_TRACE_DUMP_MAGIC 0x54464D53U
+
+/** Binary dump format version */
+#define SMF_TRACE_DUMP_VERSION 1
+
+/** Module/state index meaning "none" (initial entry, boot marker) */
+#define SMF_TRACE_ID_NONE 0xFF
+
+/**
+ * @name Trigger values of an entry's chan field, above any channel index
+ * @{
+ */
+#define SMF_TRACE_TRIG_TIMEOUT 0xFF	/* Run without a message (module timeout) */
+#define SMF_TRACE_TRIG_INIT 0xFE	/* Initial state set */
+#define SMF_TRACE_TRIG_BOOT 0xFD	/* Boot marker; module, from and to are unused */
+/** @} */
+
+/** Name length of modules and states in the dump */
+#define SMF_TRACE_NAME_LEN 12
+
+/** Name length of channels in the dump */
+#define SMF_TRACE_CHAN_NAME_LEN 16
+
+/**
+ * @brief Traced module descriptor
+ *
+ * Define one per module with SMF_TRACE_MODULE_DEFINE(). The module id in
+ * trace entries is the descriptor's index in the iterable section.
+ */
+struct smf_trace_module {
+	const char *name;
+	const struct smf_state *states;
+	const char *const *state_names;
+	uint8_t state_count;
+};
+
+/**
+ * @brief Register a module for transition tracing
+ *
+ * @param _name Module name (identifier, also used as the printed name)
+ * @param _states The module's SMF state table
+ * @param ... State names in state table order
+ */
+#define SMF_TRACE_MODULE_DEFINE(_name, _states, ...)					\
+	static const char *const _CONCAT(smf_trace_names_, _name)[] = {			\
+		__VA_ARGS__								\
+	};										\
+	BUILD_ASSERT(ARRAY_SIZE(_CONCAT(smf_trace_names_, _name)) ==			\
+		     ARRAY_SIZE(_states), "One name per state required");		\
+	static const STRUCT_SECTION_ITERABLE(smf_trace_module,				\
+					     _CONCAT(smf_trace_mod_, _name)) = {	\
+		.name = STRINGIFY(_name),						\
+		.states = _states,							\
+		.state_names = _CONCAT(smf_trace_names_, _name),			\
+		.state_count = ARRAY_SIZE(_states),					\
+	}
+
+/** Reference a descriptor defined with SMF_TRACE_MODULE_DEFINE() */
+#define SMF_TRACE_MODULE(_name) (&_CONCAT(smf_trace_mod_, _name))
+
+/**
+ * @brief One trace entry (8 bytes)
+ *
+ * timestamp is the low 32 bits of k_uptime_ticks(), counted from the last
+ * boot marker before the entry.
+ */
+struct smf_trace_entry {
+	uint32_t timestamp;
+	uint8_t module;
+	uint8_t from;
+	uint8_t to;
+	uint8_t chan;	/* Channel index, or SMF_TRACE_TRIG_* */
+} __packed;
+
+BUILD_ASSERT(sizeof(struct smf_trace_entry) == 8);
+
+/**
+ * @brief Binary dump header
+ *
+ * Layout of a dump, all little endian:
+ * - struct smf_trace_dump_hdr
+ * - module_count x { char name[12]; uint8_t state_count;
+ *                    state_count x char state_name[12] }
+ * - chan_count x char chan_name[16]
+ * - entry_count x struct smf_trace_entry, oldest first
+ */
+struct smf_trace_dump_hdr {
+	uint32_t magic;
+	uint8_t version;
+	uint8_t module_count;
+	uint8_t chan_count;
+	uint8_t entry_size;
+	uint32_t ticks_per_sec;
+	uint32_t entry_count;
+	uint32_t overwritten;
+} __packed;
+
+/**
+ * @brief Record a state change
+ *
+ * Nothing is recorded when from == to. Safe to call from ISRs.
+ *
+ * @param mod Module descriptor (SMF_TRACE_MODULE())
+ * @param from Previous state, NULL for the initial state (recorded as init)
+ * @param to New state
+ * @param chan Channel whose message triggered the run, NULL for timeouts
+ */
+void smf_trace_record(const struct smf_trace_module *mod,
+		      const struct smf_state *from,
+		      const struct smf_state *to,
+		      const struct zbus_channel *chan);
+
+/**
+ * @brief Copy recorded entries, oldest first
+ *
+ * @param out Output array
+ * @param max Capacity of out
+ * @return Number of entries copied
+ */
+size_t smf_trace_read(struct smf_trace_entry *out, size_t max);
+
+/**
+ * @brief Stop or resume recording
+ *
+ * Freeze from a fatal error or assert handler to keep the lead-up intact.
+ *
+ * @param frozen true to stop recording
+ */
+void smf_trace_freeze(bool frozen);
+
+/**
+ * @brief Drop all recorded entries
+ */
+void smf_trace_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SMF_TRACE_H_ */
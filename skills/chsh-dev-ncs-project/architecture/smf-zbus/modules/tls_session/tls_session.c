@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file tls_session.c
+ * @brief Shared TLS session resumption and handshake cost measurement
+ *
+ * This module demonstrates:
+ * - Turning on the TLS socket session cache from every client path
+ * - Attributing the mbedTLS heap high-water mark to individual handshakes
+ *   without losing the overall peak other monitors rely on
+ * - Bounding the mbedTLS heap by letting full handshakes take turns
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/net/socket.h>
+#include <errno.h>
+#include <string.h>
+
+#include "tls_session.h"
+
+#if defined(CONFIG_MBEDTLS_ENABLE_HEAP) && defined(CONFIG_MBEDTLS_MEMORY_DEBUG)
+#include <mbedtls/memory_buffer_alloc.h>
+#define HEAP_STATS 1
+#else
+#define HEAP_STATS 0
+#endif
+
+#ifdef TLS_CERT_VERIFY_CALLBACK
+#include <mbedtls/x509_crt.h>
+#endif
+
+LOG_MODULE_REGISTER(tls_session, CONFIG_APP_TLS_SESSION_LOG_LEVEL);
+
+struct peer {
+	const char *name;
+	uint32_t full;
+	uint32_t resumed;
+	uint32_t failed;
+	uint64_t full_ms_total;
+	uint64_t resumed_ms_total;
+	uint32_t full_ms_max;
+	uint32_t resumed_ms_max;
+	uint32_t full_heap_peak;
+	uint32_t resumed_heap_peak;
+	bool connected;		/* A handshake succeeded, the cache may hold a session */
+};
+
+static struct peer peers[CONFIG_APP_TLS_SESSION_PEERS];
+static size_t peer_count;
+
+static K_MUTEX_DEFINE(lock);
+
+/* Held for the duration of a full handshake */
+static K_SEM_DEFINE(full_sem, 1, 1);
+
+static bool cache_on = true;
+static int active;		/* Handshakes in progress */
+static size_t heap_peak_all;	/* Overall peak before the last reset, HEAP_RESET only */
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static size_t heap_max(void)
+{
+#if HEAP_STATS
+	size_t used;
+	size_t blocks;
+
+	mbedtls_memory_buffer_alloc_max_get(&used, &blocks);
+
+	return used;
+#else
+	return 0;
+#endif
+}
+
+/*
+ * Lock held. Fold the high-water mark into the overall peak, then restart
+ * it. Only when asked to: other heap monitors read the same counter.
+ */
+static void heap_max_restart(void)
+{
+#if HEAP_STATS && defined(CONFIG_APP_TLS_SESSION_HEAP_RESET)
+	heap_peak_all = MAX(heap_peak_all, heap_max());
+	mbedtls_memory_buffer_alloc_max_reset();
+#endif
+}
+
+/* Lock held */
+static int peer_find(const char *name)
+{
+	for (size_t i = 0; i < peer_count; i++) {
+		if (peers[i].name == name || strcmp(peers[i].name, name) == 0) {
+			return (int)i;
+		}
+	}
+
+	if (peer_count == ARRAY_SIZE(peers)) {
+		return -1;
+	}
+
+	peers[peer_count].name = name;
+
+	return peer_count++;
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int tls_session_sock_setup(int sock)
+{
+	int val = TLS_SESSION_CACHE_ENABLED;
+
+	if (!tls_session_cache_enabled()) {
+		return 0;
+	}
+
+	if (zsock_setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE, &val, sizeof(val))) {
+		LOG_WRN("TLS_SESSION_CACHE failed: %d", errno);
+		return -errno;
+	}
+
+	return 0;
+}
+
+bool tls_session_cache_enabled(void)
+{
+	return cache_on;
+}
+
+void tls_session_cache_set(bool enable)
+{
+	cache_on = enable;
+	LOG_INF("Session cache %s for new connections", enable ? "on" : "off");
+}
+
+void tls_session_handshake_begin(struct tls_session_probe *probe, const char *peer)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	probe->peer = peer_find(peer);
+	probe->resume = cache_on && probe->peer >= 0 && peers[probe->peer].connected;
+	k_mutex_unlock(&lock);
+
+	probe->confirm = false;
+	probe->cert_seen = false;
+	probe->serialized = IS_ENABLED(CONFIG_APP_TLS_SESSION_SERIALIZE_FULL) && !probe->resume;
+	if (probe->serialized) {
+		k_sem_take(&full_sem, K_FOREVER);
+	}
+
+	/* Overlapping handshakes share one measurement window */
+	k_mutex_lock(&lock, K_FOREVER);
+	if (active++ == 0) {
+		heap_max_restart();
+	}
+	k_mutex_unlock(&lock);
+
+	probe->start = k_uptime_get();
+}
+
+#ifdef TLS_CERT_VERIFY_CALLBACK
+/* Called by mbedTLS per certificate of the chain, in the connecting thread */
+static int cert_seen_cb(void *ctx, mbedtls_x509_crt *crt, int depth, uint32_t *flags)
+{
+	struct tls_session_probe *probe = ctx;
+
+	ARG_UNUSED(crt);
+	ARG_UNUSED(depth);
+	ARG_UNUSED(flags);
+
+	/* Leave flags alone: verification itself is unchanged */
+	probe->cert_seen = true;
+
+	return 0;
+}
+#endif
+
+int tls_session_sock_probe(struct tls_session_probe *probe, int sock)
+{
+#ifdef TLS_CERT_VERIFY_CALLBACK
+	struct tls_cert_verify_cb cb = {
+		.cb = cert_seen_cb,
+		.ctx = probe,
+	};
+
+	if (zsock_setsockopt(sock, SOL_TLS, TLS_CERT_VERIFY_CALLBACK, &cb, sizeof(cb))) {
+		LOG_WRN("TLS_CERT_VERIFY_CALLBACK failed: %d", errno);
+		return -errno;
+	}
+
+	probe->confirm = true;
+
+	return 0;
+#else
+	ARG_UNUSED(probe);
+	ARG_UNUSED(sock);
+
+	return -ENOTSUP;
+#endif
+}
+
+void tls_session_handshake_end(struct tls_session_probe *probe, int result)
+{
+	uint32_t ms = (uint32_t)(k_uptime_get() - probe->start);
+	const char *name = "?";
+	uint32_t heap;
+	struct peer *p;
+
+	/* The server decides: an offered session it declined is a full handshake */
+	if (probe->confirm && result == 0) {
+		probe->resume = !probe->cert_seen;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	heap = heap_max();
+	active--;
+
+	if (probe->peer >= 0) {
+		p = &peers[probe->peer];
+		name = p->name;
+		if (result) {
+			p->failed++;
+		} else if (probe->resume) {
+			p->resumed++;
+			p->resumed_ms_total += ms;
+			p->resumed_ms_max = MAX(p->resumed_ms_max, ms);
+			p->resumed_heap_peak = MAX(p->resumed_heap_peak, heap);
+		} else {
+			p->full++;
+			p->full_ms_total += ms;
+			p->full_ms_max = MAX(p->full_ms_max, ms);
+			p->full_heap_peak = MAX(p->full_heap_peak, heap);
+			p->connected = true;
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	if (probe->serialized) {
+		k_sem_give(&full_sem);
+	}
+
+	if (result) {
+		LOG_WRN("%s: %s handshake failed after %u ms: %d", name,
+			probe->resume ? "resumed" : "full", ms, result);
+		return;
+	}
+
+	LOG_INF("%s: %s handshake %u ms, mbedTLS heap peak %u B", name,
+		probe->resume ? "resumed" : "full", ms, heap);
+}
+
+int tls_session_peer_get(size_t idx, struct tls_session_peer_stats *out)
+{
+	const struct peer *p;
+	int ret = -ENOENT;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (idx < peer_count) {
+		p = &peers[idx];
+		*out = (struct tls_session_peer_stats){
+			.name = p->name,
+			.full = p->full,
+			.resumed = p->resumed,
+			.failed = p->failed,
+			.full_ms_avg = p->full ? (uint32_t)(p->full_ms_total / p->full) : 0,
+			.full_ms_max = p->full_ms_max,
+			.resumed_ms_avg = p->resumed ?
+					  (uint32_t)(p->resumed_ms_total / p->resumed) : 0,
+			.resumed_ms_max = p->resumed_ms_max,
+			.full_heap_peak = p->full_heap_peak,
+			.resumed_heap_peak = p->resumed_heap_peak,
+		};
+		ret = 0;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+size_t tls_session_heap_peak(void)
+{
+	size_t peak;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	peak = MAX(heap_peak_all, heap_max());
+	k_mutex_unlock(&lock);
+
+	return peak;
+}
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_TLS_SESSION_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct tls_session_peer_stats s;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "Session cache %s", tls_session_cache_enabled() ? "on" : "off");
+	shell_print(sh, "%-24s %5s %7s %7s %7s | %5s %7s %7s %7s | %4s", "peer", "full",
+		    "avg_ms", "max_ms", "heap_B", "resum", "avg_ms", "max_ms", "heap_B", "fail");
+
+	for (size_t i = 0; tls_session_peer_get(i, &s) == 0; i++) {
+		shell_print(sh, "%-24s %5u %7u %7u %7u | %5u %7u %7u %7u | %4u", s.name, s.full,
+			    s.full_ms_avg, s.full_ms_max, s.full_heap_peak, s.resumed,
+			    s.resumed_ms_avg, s.resumed_ms_max, s.resumed_heap_peak, s.failed);
+	}
+
+#if HEAP_STATS
+	shell_print(sh, "mbedTLS heap peak since boot: %zu of %d B", tls_session_heap_peak(),
+		    CONFIG_MBEDTLS_HEAP_SIZE);
+#else
+	shell_print(sh, "mbedTLS heap statistics need CONFIG_MBEDTLS_ENABLE_HEAP");
+#endif
+
+	return 0;
+}
+
+static int cmd_cache(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+
+	if (strcmp(argv[1], "on") == 0) {
+		tls_session_cache_set(true);
+	} else if (strcmp(argv[1], "off") == 0) {
+		tls_session_cache_set(false);
+	} else {
+		shell_error(sh, "Usage: tls_session cache on|off");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_tls_session,
+	SHELL_CMD(show, NULL, "Handshake time and heap per peer, full vs resumed", cmd_show),
+	SHELL_CMD_ARG(cache, NULL, "Offer cached sessions on new connects: cache on|off",
+		      cmd_cache, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(tls_session, &sub_tls_session, "TLS session resumption", NULL);
+
+#endif /* CONFIG_APP_TLS_SESSION_SHELL */
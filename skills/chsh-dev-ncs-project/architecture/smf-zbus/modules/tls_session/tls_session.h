@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _TLS_SESSION_H_
+#define _TLS_SESSION_H_
+
+/**
+ * @file tls_session.h
+ * @brief Shared TLS session resumption and handshake cost measurement
+ *
+ * Zephyr's TLS sockets keep the sessions of client connections in a cache
+ * shared by all sockets (CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT
+ * entries, keyed by peer address). A socket with TLS_SESSION_CACHE set
+ * offers the cached session ID or ticket on connect, and the server can
+ * resume it with an abbreviated handshake: no certificate chain, no key
+ * exchange, a fraction of the time and of the mbedTLS heap.
+ *
+ * Every TLS client path enables it the same way and wraps its connect:
+ *
+ * @code
+ * struct tls_session_probe probe;
+ *
+ * tls_session_sock_setup(fd);                     // or mqtt_sec_config.session_cache
+ * tls_session_handshake_begin(&probe, "api.example.com");
+ * tls_session_sock_probe(&probe, fd);             // own sockets only
+ * err = zsock_connect(fd, addr, addrlen);          // handshake happens here
+ * tls_session_handshake_end(&probe, err);
+ * @endcode
+ *
+ * The probe records the handshake time and the mbedTLS heap peak per peer,
+ * separately for full and resumed handshakes. A resumed handshake skips
+ * the server certificate, so on a socket passed to tls_session_sock_probe()
+ * mbedTLS's certificate verify callback tells them apart. Where the socket
+ * is out of reach (the MQTT library opens its own), a resumption attempt
+ * (a connect with the cache enabled after an earlier success with the
+ * same peer) is counted as resumed.
+ * With CONFIG_APP_TLS_SESSION_SERIALIZE_FULL, full handshakes take turns,
+ * so the mbedTLS heap only has to fit one of them even when every module
+ * reconnects at once after a Wi-Fi drop.
+ */
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Handshake cost of one peer since boot */
+struct tls_session_peer_stats {
+	const char *name;
+	uint32_t full;			/* Full handshakes */
+	uint32_t resumed;		/* Resumption attempts */
+	uint32_t failed;
+	uint32_t full_ms_avg;
+	uint32_t full_ms_max;
+	uint32_t resumed_ms_avg;
+	uint32_t resumed_ms_max;
+	uint32_t full_heap_peak;	/* mbedTLS heap in use, bytes, 0 without heap stats */
+	uint32_t resumed_heap_peak;
+};
+
+/** One handshake in progress; on the caller's stack */
+struct tls_session_probe {
+	int peer;		/* Index in the peer table, -1 when full */
+	int64_t start;
+	bool resume;
+	bool serialized;
+	bool confirm;		/* Verify callback installed by tls_session_sock_probe() */
+	bool cert_seen;		/* Server sent a certificate: full handshake */
+};
+
+/**
+ * @brief Enable session resumption on a TLS socket
+ *
+ * Call after zsock_socket() and before zsock_connect(). Does nothing while
+ * the cache is switched off with tls_session_cache_set().
+ *
+ * @return 0 on success, negative errno from setsockopt
+ */
+int tls_session_sock_setup(int sock);
+
+/**
+ * @brief Whether TLS client paths should enable the session cache
+ *
+ * For libraries that take a flag instead of a socket, such as
+ * mqtt_sec_config.session_cache.
+ */
+bool tls_session_cache_enabled(void);
+
+/**
+ * @brief Switch the cache on or off for new connections, to compare both
+ */
+void tls_session_cache_set(bool enable);
+
+/**
+ * @brief Start measuring a handshake
+ *
+ * May block while another full handshake runs, with
+ * CONFIG_APP_TLS_SESSION_SERIALIZE_FULL.
+ *
+ * @param probe Probe to fill in
+ * @param peer Host name; must stay valid (a string literal or Kconfig value)
+ */
+void tls_session_handshake_begin(struct tls_session_probe *probe, const char *peer);
+
+/**
+ * @brief Tell full and resumed handshakes apart by the mbedTLS session state
+ *
+ * Installs a certificate verify callback on the socket, which mbedTLS only
+ * calls when the server sends its certificate chain, that is on a full
+ * handshake. Call after tls_session_handshake_begin() and before connect.
+ * Needs peer verification (the default for TLS clients); without
+ * TLS_CERT_VERIFY_CALLBACK support the attempt is counted as before.
+ *
+ * @param probe Probe passed to tls_session_handshake_begin()
+ * @param sock TLS socket about to connect
+ * @return 0 on success, negative errno from setsockopt
+ */
+int tls_session_sock_probe(struct tls_session_probe *probe, int sock);
+
+/**
+ * @brief Finish measuring a handshake
+ *
+ * @param probe Probe passed to tls_session_handshake_begin()
+ * @param result Result of the connect, 0 on success
+ */
+void tls_session_handshake_end(struct tls_session_probe *probe, int result);
+
+/**
+ * @brief Get the statistics of a peer
+ *
+ * @param idx Peer index, in the order first seen
+ * @return 0 on success, -ENOENT when idx is past the last peer
+ */
+int tls_session_peer_get(size_t idx, struct tls_session_peer_stats *stats);
+
+/**
+ * @brief Highest mbedTLS heap use since boot, in bytes
+ *
+ * With CONFIG_APP_TLS_SESSION_HEAP_RESET handshake probes reset the
+ * mbedTLS allocator's high-water mark, so heap monitors must read the
+ * overall peak here instead of from mbedtls_memory_buffer_alloc_max_get().
+ * 0 without heap statistics.
+ */
+size_t tls_session_heap_peak(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TLS_SESSION_H_ */
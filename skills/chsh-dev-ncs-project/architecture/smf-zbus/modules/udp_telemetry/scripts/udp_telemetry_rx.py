@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Collector for udp_telemetry datagrams.
+
+Usage:
+    udp_telemetry_rx.py                  # listen on UDP 4242
+    udp_telemetry_rx.py --port 5000
+    udp_telemetry_rx.py --print          # decode every record
+
+Checks the sequence number of every datagram per boot id and counts lost,
+duplicated and reordered datagrams; a new boot id starts a new sequence.
+Once per second it prints datagrams, records, records per datagram and
+loss. With --print, type 1 records are decoded as the sensor example's
+(timestamp u32, temperature i16 in 0.01 C, humidity u16 in 0.01 %).
+"""
+
+import argparse
+import socket
+import struct
+import sys
+import time
+
+HDR = struct.Struct(">BBHI")
+VERSION = 1
+
+
+class Stream:
+    """Sequence tracking for one device boot."""
+
+    def __init__(self, seq):
+        self.next = seq + 1
+        self.seen = 1
+        self.lost = 0
+        self.dup = 0
+        self.reordered = 0
+        self.missing = set()
+
+    def update(self, seq):
+        if seq == self.next:
+            self.next += 1
+        elif seq > self.next:
+            self.missing.update(range(self.next, seq))
+            self.lost += seq - self.next
+            self.next = seq + 1
+        elif seq in self.missing:
+            self.missing.discard(seq)
+            self.lost -= 1
+            self.reordered += 1
+        else:
+            self.dup += 1
+            return
+        self.seen += 1
+        # Gaps older than this are not coming back
+        self.missing = {s for s in self.missing if s > self.next - 1024}
+
+
+def parse(data):
+    """Return (boot id, seq, [(type, bytes)]) or raise ValueError."""
+    if len(data) < HDR.size:
+        raise ValueError("short datagram")
+    ver, _flags, boot, seq = HDR.unpack_from(data)
+    if ver != VERSION:
+        raise ValueError(f"version {ver}")
+    records = []
+    off = HDR.size
+    while off < len(data):
+        if off + 2 > len(data):
+            raise ValueError("truncated record header")
+        rtype, rlen = data[off], data[off + 1]
+        off += 2
+        if off + rlen > len(data):
+            raise ValueError("truncated record")
+        records.append((rtype, data[off:off + rlen]))
+        off += rlen
+    return boot, seq, records
+
+
+def describe(rtype, rdata):
+    if rtype == 1 and len(rdata) == 8:
+        ts, temp, hum = struct.unpack(">IhH", rdata)
+        return f"sensor t={ts} temp={temp / 100:.2f}C hum={hum / 100:.2f}%"
+    try:
+        text = rdata.decode()
+        if text.isprintable():
+            return f"type {rtype} '{text}'"
+    except UnicodeDecodeError:
+        pass
+    return f"type {rtype} {rdata.hex()}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=4242)
+    parser.add_argument("--print", action="store_true", help="print every record")
+    parser.add_argument("--quiet", action="store_true", help="no per-second statistics")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    try:
+        sock.bind((args.host, args.port))
+    except OSError as e:
+        sys.exit(f"Cannot bind {args.host}:{args.port}: {e}")
+    sock.settimeout(1.0)
+    print(f"Listening on UDP {args.host}:{args.port}")
+
+    streams = {}
+    datagrams = records = payload = bad = 0
+    start = last = time.monotonic()
+    try:
+        while True:
+            try:
+                data, peer = sock.recvfrom(65535)
+            except socket.timeout:
+                data = None
+            if data is not None:
+                try:
+                    boot, seq, recs = parse(data)
+                except ValueError as e:
+                    bad += 1
+                    print(f"Bad datagram from {peer[0]}: {e}")
+                    continue
+                key = (peer[0], boot)
+                if key not in streams:
+                    print(f"{peer[0]} boot 0x{boot:04x} starts at seq {seq}")
+                    streams[key] = Stream(seq)
+                else:
+                    streams[key].update(seq)
+                datagrams += 1
+                records += len(recs)
+                payload += len(data)
+                if args.print:
+                    print(f"  0x{boot:04x}#{seq} {len(data)} B, {len(recs)} records")
+                    for rtype, rdata in recs:
+                        print(f"    {describe(rtype, rdata)}")
+
+            now = time.monotonic()
+            if not args.quiet and now - last >= 1.0:
+                last = now
+                lost = sum(s.lost for s in streams.values())
+                sent = sum(s.seen for s in streams.values()) + lost
+                per_dgram = records / datagrams if datagrams else 0
+                print(f"{now - start:7.1f}s datagrams={datagrams} records={records} "
+                      f"per_dgram={per_dgram:.1f} bytes={payload} lost={lost} "
+                      f"({100 * lost / sent if sent else 0:.1f}%) "
+                      f"dup={sum(s.dup for s in streams.values())} "
+                      f"reordered={sum(s.reordered for s in streams.values())} bad={bad}")
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,662 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file udp_telemetry.c
+ * @brief UDP telemetry sender packing many records per datagram
+ *
+ * This module demonstrates:
+ * - Filling datagrams up to the path MTU instead of sending one per sample
+ * - Encoding records in place in net_pkt buffers and handing the packet to
+ *   the IP stack, bypassing the socket copy
+ * - Sequence numbers and a boot id for loss detection at the receiver
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "udp_telemetry.h"
+
+#ifdef CONFIG_APP_UDP_TELEMETRY_ZERO_COPY
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#endif
+
+LOG_MODULE_REGISTER(udp_telemetry, CONFIG_APP_UDP_TELEMETRY_LOG_LEVEL);
+
+/* UDP payload that fits the path MTU without fragmentation */
+#define PAYLOAD_MAX (CONFIG_APP_UDP_TELEMETRY_PATH_MTU - NET_IPV4UDPH_LEN)
+#define REC_HDR_LEN 2
+#define RATE_WINDOW_MS (10 * MSEC_PER_SEC)
+
+BUILD_ASSERT(PAYLOAD_MAX > UDP_TELEMETRY_HDR_LEN + REC_HDR_LEN, "Path MTU too small");
+
+/* Raw record for udp_telemetry_put(), passed through the encoder path */
+struct raw_record {
+	const void *data;
+	size_t len;
+};
+
+static K_MUTEX_DEFINE(lock);
+
+static struct sockaddr_in server;
+static uint16_t boot_id;
+static uint32_t seq;
+static uint16_t count;		/* Records in the datagram being filled */
+static int64_t first_at;	/* When its first record was added */
+static size_t payload_max;	/* Limit for the datagram being filled */
+
+static struct udp_telemetry_stats stats;
+static struct {
+	int64_t start;
+	uint32_t datagrams;
+	uint32_t records;
+	uint32_t bytes;
+} window;
+
+/* Sealed datagrams, in sequence order */
+static K_FIFO_DEFINE(ready);
+
+static void send_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(send_work, send_handler);
+
+/* Records that straddle a buffer boundary are encoded here and copied */
+static uint8_t scratch[REC_HDR_LEN + UDP_TELEMETRY_RECORD_MAX];
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static void header_fill(uint8_t *h)
+{
+	h[0] = UDP_TELEMETRY_VERSION;
+	h[1] = 0;
+	sys_put_be16(boot_id, &h[2]);
+	sys_put_be32(seq++, &h[4]);
+}
+
+#ifdef CONFIG_APP_UDP_TELEMETRY_ZERO_COPY
+
+/*
+ * Datagram = net_pkt. The IPv4 and UDP headers are reserved when the packet
+ * is opened and written when it is sealed, once the length is known.
+ */
+
+static struct net_pkt *cur;
+static uint16_t ip_id;
+
+/* Ones' complement sum of big-endian words; odd carries a byte across buffers */
+static uint32_t csum_add(uint32_t sum, const uint8_t *p, size_t len, bool *odd)
+{
+	for (size_t i = 0; i < len; i++) {
+		sum += *odd ? p[i] : (uint32_t)p[i] << 8;
+		*odd = !*odd;
+	}
+
+	return sum;
+}
+
+static uint16_t csum_fold(uint32_t sum)
+{
+	while (sum >> 16) {
+		sum = (sum & 0xFFFF) + (sum >> 16);
+	}
+
+	return (uint16_t)~sum;
+}
+
+static int dg_open(void)
+{
+	struct net_if *iface = net_if_ipv4_select_src_iface(&server.sin_addr);
+
+	if (!iface) {
+		return -ENETUNREACH;
+	}
+
+	payload_max = MIN(PAYLOAD_MAX, net_if_get_mtu(iface) - NET_IPV4UDPH_LEN);
+
+	cur = net_pkt_alloc_with_buffer(iface, payload_max, AF_INET, IPPROTO_UDP, K_NO_WAIT);
+	if (!cur) {
+		return -ENOBUFS;
+	}
+
+	/* Skipping in write mode only grows the buffer: headers come at sealing */
+	net_pkt_skip(cur, NET_IPV4UDPH_LEN + UDP_TELEMETRY_HDR_LEN);
+
+	return 0;
+}
+
+static size_t dg_used(void)
+{
+	return net_pkt_get_len(cur) - NET_IPV4UDPH_LEN;
+}
+
+/* Where the next record goes, and how much of it fits in this buffer */
+static uint8_t *dg_tail(size_t *contig)
+{
+	*contig = MIN(net_pkt_get_contiguous_len(cur), payload_max - dg_used());
+
+	return net_pkt_cursor_get_pos(cur);
+}
+
+static void dg_commit(size_t len)
+{
+	/* The record is already in place; only the buffer length moves */
+	net_pkt_skip(cur, len);
+}
+
+static int dg_append(const uint8_t *data, size_t len)
+{
+	stats.copied++;
+
+	return net_pkt_write(cur, data, len);
+}
+
+static void dg_seal(void)
+{
+	struct {
+		struct net_ipv4_hdr ip;
+		struct net_udp_hdr udp;
+		uint8_t app[UDP_TELEMETRY_HDR_LEN];
+	} __packed hdr = { 0 };
+	const struct in_addr *src = net_if_ipv4_select_src_addr(net_pkt_iface(cur),
+								&server.sin_addr);
+	size_t len = net_pkt_get_len(cur);
+	size_t skip = sizeof(hdr);
+	uint32_t sum = 0;
+	bool odd = false;
+
+	hdr.ip.vhl = 0x45;
+	sys_put_be16(len, hdr.ip.len);
+	sys_put_be16(ip_id++, hdr.ip.id);
+	hdr.ip.offset[0] = 0x40;	/* Don't fragment: we sized it to fit */
+	hdr.ip.ttl = 64;
+	hdr.ip.proto = IPPROTO_UDP;
+	memcpy(hdr.ip.src, src, sizeof(hdr.ip.src));
+	memcpy(hdr.ip.dst, &server.sin_addr, sizeof(hdr.ip.dst));
+	sys_put_be16(csum_fold(csum_add(0, (uint8_t *)&hdr.ip, NET_IPV4H_LEN, &odd)),
+		     (uint8_t *)&hdr.ip.chksum);
+
+	hdr.udp.src_port = htons(CONFIG_APP_UDP_TELEMETRY_SRC_PORT);
+	hdr.udp.dst_port = server.sin_port;
+	hdr.udp.len = htons(len - NET_IPV4H_LEN);
+	header_fill(hdr.app);
+
+	/* UDP checksum: pseudo header, UDP header, then the payload in place */
+	odd = false;
+	sum = csum_add(sum, hdr.ip.src, 8, &odd);
+	sum += IPPROTO_UDP + (len - NET_IPV4H_LEN);
+	sum = csum_add(sum, (uint8_t *)&hdr.udp, sizeof(hdr) - NET_IPV4H_LEN, &odd);
+	for (struct net_buf *b = cur->buffer; b; b = b->frags) {
+		size_t s = MIN(skip, b->len);
+
+		sum = csum_add(sum, b->data + s, b->len - s, &odd);
+		skip -= s;
+	}
+	/* A computed zero is sent as all ones; zero means "no checksum" */
+	sum = csum_fold(sum);
+	hdr.udp.chksum = htons(sum ? sum : 0xFFFF);
+
+	net_pkt_cursor_init(cur);
+	net_pkt_set_overwrite(cur, true);
+	net_pkt_write(cur, &hdr, sizeof(hdr));
+	net_pkt_set_ip_hdr_len(cur, NET_IPV4H_LEN);
+	net_pkt_cursor_init(cur);
+
+	k_fifo_put(&ready, cur);
+	cur = NULL;
+}
+
+static size_t dg_payload_len(void *d)
+{
+	return net_pkt_get_len(d) - NET_IPV4UDPH_LEN;
+}
+
+static int dg_send(void *d)
+{
+	int err = net_send_data(d);
+
+	if (err < 0) {
+		net_pkt_unref(d);
+	}
+
+	return err;
+}
+
+#else /* !CONFIG_APP_UDP_TELEMETRY_ZERO_COPY */
+
+/* Datagram = static buffer, sent with one sendto() */
+
+struct dgram {
+	void *fifo_reserved;
+	size_t len;
+	uint8_t data[PAYLOAD_MAX];
+};
+
+static struct dgram dgrams[CONFIG_APP_UDP_TELEMETRY_BUFFERS];
+static K_FIFO_DEFINE(free_q);
+static struct dgram *cur;
+static int sock = -1;
+
+static int dg_open(void)
+{
+	cur = k_fifo_get(&free_q, K_NO_WAIT);
+	if (!cur) {
+		return -ENOBUFS;
+	}
+
+	payload_max = PAYLOAD_MAX;
+	cur->len = UDP_TELEMETRY_HDR_LEN;
+
+	return 0;
+}
+
+static size_t dg_used(void)
+{
+	return cur->len;
+}
+
+static uint8_t *dg_tail(size_t *contig)
+{
+	*contig = payload_max - cur->len;
+
+	return &cur->data[cur->len];
+}
+
+static void dg_commit(size_t len)
+{
+	cur->len += len;
+}
+
+static int dg_append(const uint8_t *data, size_t len)
+{
+	memcpy(&cur->data[cur->len], data, len);
+	cur->len += len;
+
+	return 0;
+}
+
+static void dg_seal(void)
+{
+	header_fill(cur->data);
+	k_fifo_put(&ready, cur);
+	cur = NULL;
+}
+
+static size_t dg_payload_len(void *d)
+{
+	return ((struct dgram *)d)->len;
+}
+
+static int dg_send(void *d)
+{
+	struct dgram *dg = d;
+	int err = 0;
+
+	if (sock < 0) {
+		sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	}
+
+	if (sock < 0 || zsock_sendto(sock, dg->data, dg->len, 0, (struct sockaddr *)&server,
+				     sizeof(server)) < 0) {
+		err = -errno;
+	}
+
+	k_fifo_put(&free_q, dg);
+
+	return err;
+}
+
+#endif /* CONFIG_APP_UDP_TELEMETRY_ZERO_COPY */
+
+/* Lock held */
+static void seal(void)
+{
+	if (cur && count) {
+		dg_seal();
+		count = 0;
+	}
+}
+
+/* Lock held */
+static void rate_tick(int64_t now)
+{
+	int64_t elapsed = now - window.start;
+
+	if (elapsed < RATE_WINDOW_MS) {
+		return;
+	}
+
+	stats.datagrams_per_min = window.datagrams * 60 * MSEC_PER_SEC / elapsed;
+	stats.records_per_min = window.records * 60 * MSEC_PER_SEC / elapsed;
+	stats.bytes_per_s = window.bytes * MSEC_PER_SEC / elapsed;
+	window.start = now;
+	window.datagrams = 0;
+	window.records = 0;
+	window.bytes = 0;
+}
+
+/* Encoder semantics: length, 0 to skip, > len when it does not fit */
+static int encode_into(udp_telemetry_encode_t encode, const void *msg, uint8_t *buf,
+		       size_t len)
+{
+	return encode(msg, buf, MIN(len, UDP_TELEMETRY_RECORD_MAX));
+}
+
+/*
+ * Lock held. Encode in place if the record fits in the current buffer,
+ * else beside and copy if it fits in the datagram, else seal and retry.
+ * Returns 1 when a datagram was sealed.
+ */
+static int record_add(uint8_t type, udp_telemetry_encode_t encode, const void *msg)
+{
+	bool sealed = false;
+	size_t contig;
+	size_t room;
+	uint8_t *tail;
+	int n;
+
+	for (int attempt = 0; attempt < 2; attempt++) {
+		if (!cur) {
+			if (dg_open()) {
+				stats.dropped++;
+				return -ENOBUFS;
+			}
+			first_at = k_uptime_get();
+		}
+
+		room = payload_max - dg_used();
+		tail = dg_tail(&contig);
+
+		if (contig > REC_HDR_LEN) {
+			n = encode_into(encode, msg, tail + REC_HDR_LEN, contig - REC_HDR_LEN);
+			if (n <= 0) {
+				return n;
+			}
+			if ((size_t)n <= MIN(contig - REC_HDR_LEN, UDP_TELEMETRY_RECORD_MAX)) {
+				tail[0] = type;
+				tail[1] = n;
+				dg_commit(REC_HDR_LEN + n);
+				goto added;
+			}
+		}
+
+		n = encode_into(encode, msg, &scratch[REC_HDR_LEN], UDP_TELEMETRY_RECORD_MAX);
+		if (n <= 0) {
+			return n;
+		}
+		if (n > UDP_TELEMETRY_RECORD_MAX) {
+			return -EMSGSIZE;
+		}
+		if (REC_HDR_LEN + (size_t)n <= room) {
+			scratch[0] = type;
+			scratch[1] = n;
+			if (dg_append(scratch, REC_HDR_LEN + n) == 0) {
+				goto added;
+			}
+		}
+
+		if (!count) {
+			/* Does not fit an empty datagram */
+			return -EMSGSIZE;
+		}
+		seal();
+		sealed = true;
+	}
+
+	return -EMSGSIZE;
+
+added:
+	count++;
+	stats.records++;
+	window.records++;
+
+	if (count == 1) {
+		k_work_reschedule(&send_work, K_MSEC(CONFIG_APP_UDP_TELEMETRY_LINGER_MS));
+	}
+
+	return sealed ? 1 : 0;
+}
+
+static int raw_encode(const void *msg, uint8_t *buf, size_t len)
+{
+	const struct raw_record *r = msg;
+
+	if (r->len <= len) {
+		memcpy(buf, r->data, r->len);
+	}
+
+	return r->len;
+}
+
+static void send_handler(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+	size_t len;
+	void *d;
+	int err;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (count && now - first_at >= CONFIG_APP_UDP_TELEMETRY_LINGER_MS) {
+		seal();
+	} else if (count) {
+		k_work_reschedule(&send_work,
+				  K_MSEC(first_at + CONFIG_APP_UDP_TELEMETRY_LINGER_MS - now));
+	}
+	k_mutex_unlock(&lock);
+
+	while ((d = k_fifo_get(&ready, K_NO_WAIT)) != NULL) {
+		len = dg_payload_len(d);
+		err = dg_send(d);
+
+		k_mutex_lock(&lock, K_FOREVER);
+		if (err) {
+			stats.send_errors++;
+		} else {
+			stats.datagrams++;
+			stats.bytes += len;
+			window.datagrams++;
+			window.bytes += len;
+		}
+		rate_tick(k_uptime_get());
+		k_mutex_unlock(&lock);
+
+		if (err) {
+			LOG_DBG("Send failed: %d", err);
+		}
+	}
+}
+
+static void listener_cb(const struct zbus_channel *chan)
+{
+	int ret = 0;
+
+	STRUCT_SECTION_FOREACH(udp_telemetry_binding, bind) {
+		if (bind->chan == chan) {
+			k_mutex_lock(&lock, K_FOREVER);
+			ret = record_add(bind->type, bind->encode, zbus_chan_const_msg(chan));
+			k_mutex_unlock(&lock);
+			break;
+		}
+	}
+
+	if (ret > 0) {
+		k_work_reschedule(&send_work, K_NO_WAIT);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(udp_telemetry_lis, listener_cb);
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int udp_telemetry_put(uint8_t type, const void *data, size_t len)
+{
+	struct raw_record r = { .data = data, .len = len };
+	int ret;
+
+	if (len == 0 || len > UDP_TELEMETRY_RECORD_MAX) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	ret = record_add(type, raw_encode, &r);
+	k_mutex_unlock(&lock);
+
+	if (ret > 0) {
+		k_work_reschedule(&send_work, K_NO_WAIT);
+	}
+
+	return MIN(ret, 0);
+}
+
+void udp_telemetry_flush(void)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	seal();
+	k_mutex_unlock(&lock);
+
+	k_work_reschedule(&send_work, K_NO_WAIT);
+}
+
+void udp_telemetry_stats_get(struct udp_telemetry_stats *out)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+	rate_tick(k_uptime_get());
+	*out = stats;
+	out->seq = seq;
+	out->payload_max = payload_max ? payload_max : PAYLOAD_MAX;
+	k_mutex_unlock(&lock);
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+static int udp_telemetry_init(void)
+{
+	server.sin_family = AF_INET;
+	server.sin_port = htons(CONFIG_APP_UDP_TELEMETRY_SERVER_PORT);
+	if (zsock_inet_pton(AF_INET, CONFIG_APP_UDP_TELEMETRY_SERVER, &server.sin_addr) != 1) {
+		LOG_ERR("Invalid server address %s", CONFIG_APP_UDP_TELEMETRY_SERVER);
+		return -EINVAL;
+	}
+
+	/* Lets the receiver tell a reboot (new id, seq 0) from loss */
+	boot_id = sys_rand16_get();
+
+#ifndef CONFIG_APP_UDP_TELEMETRY_ZERO_COPY
+	for (size_t i = 0; i < ARRAY_SIZE(dgrams); i++) {
+		k_fifo_put(&free_q, &dgrams[i]);
+	}
+#endif
+
+	window.start = k_uptime_get();
+
+	return 0;
+}
+
+SYS_INIT(udp_telemetry_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_UDP_TELEMETRY_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct udp_telemetry_stats s;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	udp_telemetry_stats_get(&s);
+
+	shell_print(sh, "%s:%d, boot id 0x%04x, next seq %u, payload up to %u B (%s)",
+		    CONFIG_APP_UDP_TELEMETRY_SERVER, CONFIG_APP_UDP_TELEMETRY_SERVER_PORT, boot_id,
+		    s.seq, s.payload_max,
+		    IS_ENABLED(CONFIG_APP_UDP_TELEMETRY_ZERO_COPY) ? "net_pkt" : "socket");
+	shell_print(sh, "records %u in %u datagrams (%u per datagram), %u bytes", s.records,
+		    s.datagrams, s.datagrams ? s.records / s.datagrams : 0, s.bytes);
+	shell_print(sh, "dropped %u, send errors %u, copied %u", s.dropped, s.send_errors,
+		    s.copied);
+	shell_print(sh, "rate: %u datagrams/min, %u records/min, %u B/s", s.datagrams_per_min,
+		    s.records_per_min, s.bytes_per_s);
+
+	return 0;
+}
+
+static int cmd_flush(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	udp_telemetry_flush();
+	shell_print(sh, "Flushed");
+
+	return 0;
+}
+
+static int cmd_put(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+
+	err = udp_telemetry_put((uint8_t)strtoul(argv[1], NULL, 0), argv[2], strlen(argv[2]));
+	if (err) {
+		shell_error(sh, "Put failed: %d", err);
+	}
+
+	return err;
+}
+
+static int cmd_burst(const struct shell *sh, size_t argc, char **argv)
+{
+	static uint8_t rec[UDP_TELEMETRY_RECORD_MAX];
+	uint32_t n = strtoul(argv[1], NULL, 10);
+	size_t len = CLAMP(strtoul(argv[2], NULL, 10), 1, sizeof(rec));
+	uint32_t failed = 0;
+
+	ARG_UNUSED(argc);
+
+	for (uint32_t i = 0; i < n; i++) {
+		sys_put_be32(i, rec);
+		failed += udp_telemetry_put(0xFF, rec, len) ? 1 : 0;
+	}
+	udp_telemetry_flush();
+
+	shell_print(sh, "%u records of %zu bytes queued, %u dropped", n - failed, len, failed);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_udp_tel,
+	SHELL_CMD(show, NULL, "Packing, loss counters and send rate", cmd_show),
+	SHELL_CMD(flush, NULL, "Send the datagram being filled", cmd_flush),
+	SHELL_CMD_ARG(put, NULL, "Add a record: put <type> <text>", cmd_put, 3, 0),
+	SHELL_CMD_ARG(burst, NULL, "Add records back to back: burst <count> <bytes>",
+		      cmd_burst, 3, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(udp_tel, &sub_udp_tel, "UDP telemetry sender", NULL);
+
+#endif /* CONFIG_APP_UDP_TELEMETRY_SHELL */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _UDP_TELEMETRY_H_
+#define _UDP_TELEMETRY_H_
+
+/**
+ * @file udp_telemetry.h
+ * @brief UDP telemetry sender packing many records per datagram
+ *
+ * Modules bind a channel and a binary encoder:
+ *
+ * @code
+ * static int sensor_pack(const void *msg, uint8_t *buf, size_t len)
+ * {
+ *     const struct sensor_msg *m = msg;
+ *
+ *     if (len < 4) {
+ *         return 4;                               // does not fit
+ *     }
+ *     sys_put_be32(m->timestamp, buf);
+ *     return 4;
+ * }
+ *
+ * UDP_TELEMETRY_CHAN_DEFINE(SENSOR_CHAN, 1, sensor_pack);
+ * @endcode
+ *
+ * Records are encoded straight into the datagram being filled, which is
+ * sent when the next record does not fit in the path MTU or
+ * CONFIG_APP_UDP_TELEMETRY_LINGER_MS after its first record. Datagram
+ * layout, all big endian:
+ *
+ *   version (1) | flags (1) | boot id (2) | sequence (4)
+ *   then per record: type (1) | length (1) | data (length)
+ *
+ * The sequence number counts datagrams from 0 at each boot, so the
+ * receiver detects loss from gaps and reboots from a new boot id.
+ *
+ * With CONFIG_APP_UDP_TELEMETRY_ZERO_COPY the datagram is a net_pkt:
+ * records are encoded directly in its network buffers and the packet is
+ * handed to the IP stack as is, with no socket copy in between.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UDP_TELEMETRY_VERSION 1
+#define UDP_TELEMETRY_HDR_LEN 8
+#define UDP_TELEMETRY_RECORD_MAX 255
+
+/* Listener behind every UDP_TELEMETRY_CHAN_DEFINE() */
+ZBUS_OBS_DECLARE(udp_telemetry_lis);
+
+/**
+ * @brief Encode one channel message as a record
+ *
+ * Runs in the publishing thread with the datagram locked.
+ *
+ * @param msg Channel message
+ * @param buf Where to write the record data
+ * @param len Room in @p buf
+ * @return Record length, 0 to skip the message, a value > @p len when it
+ *         does not fit, or negative errno
+ */
+typedef int (*udp_telemetry_encode_t)(const void *msg, uint8_t *buf, size_t len);
+
+/** Channel bound to the sender (ROM) */
+struct udp_telemetry_binding {
+	const struct zbus_channel *chan;
+	uint8_t type;
+	udp_telemetry_encode_t encode;
+};
+
+/**
+ * @brief Send every message of a channel as a telemetry record
+ *
+ * @param _chan zbus channel
+ * @param _type Record type, application defined
+ * @param _encode Encoder, see udp_telemetry_encode_t
+ */
+#define UDP_TELEMETRY_CHAN_DEFINE(_chan, _type, _encode)				\
+	ZBUS_CHAN_ADD_OBS(_chan, udp_telemetry_lis, 0);					\
+	static const STRUCT_SECTION_ITERABLE(udp_telemetry_binding,			\
+					     _CONCAT(udp_telemetry_bind_, _chan)) = {	\
+		.chan = &_chan,								\
+		.type = _type,								\
+		.encode = _encode,							\
+	}
+
+/**
+ * @brief Sender statistics since boot, rates over the last full window
+ */
+struct udp_telemetry_stats {
+	uint32_t records;
+	uint32_t datagrams;
+	uint32_t bytes;			/* UDP payload sent */
+	uint32_t dropped;		/* Records with no datagram buffer */
+	uint32_t send_errors;		/* Datagrams the stack refused */
+	uint32_t copied;		/* Records that had to be copied (zero copy only) */
+	uint32_t seq;			/* Next sequence number */
+	uint32_t payload_max;		/* Datagram payload limit in use */
+	uint32_t datagrams_per_min;
+	uint32_t records_per_min;
+	uint32_t bytes_per_s;
+};
+
+/**
+ * @brief Add a record that does not come from a channel, e.g. status
+ *
+ * @param type Record type
+ * @param data Record data
+ * @param len Up to UDP_TELEMETRY_RECORD_MAX bytes
+ * @return 0 on success, -EMSGSIZE when too long, -ENOBUFS when no
+ *         datagram buffer is free
+ */
+int udp_telemetry_put(uint8_t type, const void *data, size_t len);
+
+/**
+ * @brief Send the datagram being filled now
+ */
+void udp_telemetry_flush(void);
+
+/**
+ * @brief Get the statistics
+ */
+void udp_telemetry_stats_get(struct udp_telemetry_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _UDP_TELEMETRY_H_ */
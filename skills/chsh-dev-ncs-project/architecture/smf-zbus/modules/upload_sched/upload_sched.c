@@ -0,0 +1,711 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file upload_sched.c
+ * @brief Batch uploads and send them when the link is cheap to use
+ *
+ * This module demonstrates:
+ * - Classifying the link from RSSI and measured throughput
+ * - Deferring batches on a poor link, with a size and age bound
+ * - Estimating bytes per joule from radio-on time
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/zbus/zbus.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(CONFIG_NET_L2_WIFI_MGMT) || defined(CONFIG_APP_WIFI_RECONNECT_MOCK)
+#define POLL_RSSI 1
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/wifi_mgmt.h>
+#else
+#define POLL_RSSI 0
+#endif
+
+#ifdef CONFIG_APP_UPLOAD_SCHED_HTTP_POOL
+#include "http_pool.h"
+#endif
+
+#ifdef CONFIG_APP_NET_READY
+#include "net_ready.h"
+#endif
+
+#include "upload_sched.h"
+#include "app_stats.h"
+
+LOG_MODULE_REGISTER(upload_sched, CONFIG_APP_UPLOAD_SCHED_LOG_LEVEL);
+
+#define BUF_SIZE CONFIG_APP_UPLOAD_SCHED_BUFFER_SIZE
+
+/* An old throughput figure says little about the link now */
+#define TPUT_MAX_AGE_MS (10 * 60 * MSEC_PER_SEC)
+
+enum reason {
+	REASON_NONE,
+	REASON_INTERVAL,
+	REASON_LINK,
+	REASON_SIZE,
+	REASON_AGE,
+	REASON_FLUSH,
+};
+
+static struct k_spinlock lock;
+
+/* Records go to active; sched_q uploads sending and keeps it on failure */
+static uint8_t bufs[2][BUF_SIZE];
+static uint8_t *active = bufs[0];
+static size_t active_len;
+static int64_t active_since;
+static uint8_t *sending = bufs[1];
+static size_t sending_len;
+static int64_t sending_since;
+
+static int8_t rssi_fed;
+static int64_t rssi_fed_at;
+static uint32_t tput_bps;
+static int64_t tput_at;
+static bool flush_requested;
+static struct upload_sched_stats stats;
+
+static upload_sched_send_t backend;
+static atomic_t interval_s = ATOMIC_INIT(CONFIG_APP_UPLOAD_SCHED_INTERVAL_SECONDS);
+
+/* Owned by sched_q */
+static int64_t retry_at;
+static bool deferral_counted;
+
+/* Backends block for the whole request */
+static K_THREAD_STACK_DEFINE(sched_stack, CONFIG_APP_UPLOAD_SCHED_STACK_SIZE);
+static struct k_work_q sched_q;
+
+static void check_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(check_work, check_handler);
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static const char *link_str(enum upload_sched_link link)
+{
+	switch (link) {
+	case UPLOAD_SCHED_LINK_DOWN:
+		return "down";
+	case UPLOAD_SCHED_LINK_POOR:
+		return "poor";
+	case UPLOAD_SCHED_LINK_FAIR:
+		return "fair";
+	case UPLOAD_SCHED_LINK_GOOD:
+		return "good";
+	default:
+		return "?";
+	}
+}
+
+static void kick(void)
+{
+	k_work_reschedule_for_queue(&sched_q, &check_work, K_NO_WAIT);
+}
+
+/* Lock held */
+static int append(const void *data, size_t len)
+{
+	/* Room for the record and its newline */
+	if (len + 1 > BUF_SIZE - active_len) {
+		stats.dropped++;
+		return -ENOMEM;
+	}
+
+	if (!active_len) {
+		active_since = k_uptime_get();
+	}
+	memcpy(&active[active_len], data, len);
+	active[active_len + len] = '\n';
+	active_len += len + 1;
+
+	return 0;
+}
+
+/* Lock held; only crossing a threshold is worth an early check */
+static bool crossed(size_t before)
+{
+	size_t after = active_len + sending_len;
+
+	return (before < CONFIG_APP_UPLOAD_SCHED_SIZE_THRESHOLD &&
+		after >= CONFIG_APP_UPLOAD_SCHED_SIZE_THRESHOLD) ||
+	       (before < CONFIG_APP_UPLOAD_SCHED_OPPORTUNISTIC_BYTES &&
+		after >= CONFIG_APP_UPLOAD_SCHED_OPPORTUNISTIC_BYTES);
+}
+
+static void queued(bool urgent)
+{
+	if (urgent) {
+		kick();
+	} else {
+		/* First record after idle starts the periodic check */
+		k_work_schedule_for_queue(&sched_q, &check_work,
+					  K_SECONDS(CONFIG_APP_UPLOAD_SCHED_CHECK_SECONDS));
+	}
+}
+
+static void listener_cb(const struct zbus_channel *chan)
+{
+	STRUCT_SECTION_FOREACH(upload_sched_binding, bind) {
+		char rec[CONFIG_APP_UPLOAD_SCHED_RECORD_SIZE];
+		k_spinlock_key_t key;
+		size_t before;
+		bool urgent = false;
+		int n;
+
+		if (bind->chan != chan) {
+			continue;
+		}
+
+		/* Encode on the publisher's stack, only the copy runs under the lock */
+		n = bind->encode(zbus_chan_const_msg(chan), rec, sizeof(rec));
+		if (n <= 0) {
+			return;
+		}
+
+		key = k_spin_lock(&lock);
+		if ((size_t)n >= sizeof(rec)) {
+			stats.dropped++;
+			n = -EMSGSIZE;
+		} else {
+			before = active_len + sending_len;
+			n = append(rec, n);
+			urgent = crossed(before);
+		}
+		k_spin_unlock(&lock, key);
+
+		if (n == 0) {
+			queued(urgent);
+		}
+		return;
+	}
+}
+
+ZBUS_LISTENER_DEFINE(upload_sched_lis, listener_cb);
+
+static int8_t rssi_polled(void)
+{
+#if POLL_RSSI
+	struct wifi_iface_status st = { 0 };
+#ifdef CONFIG_APP_WIFI_RECONNECT_MOCK
+	struct net_if *iface = net_if_get_default();
+#else
+	struct net_if *iface = net_if_get_first_wifi();
+#endif
+
+	if (iface && !net_mgmt(NET_REQUEST_WIFI_IFACE_STATUS, iface, &st, sizeof(st)) &&
+	    st.state == WIFI_STATE_COMPLETED) {
+		return (int8_t)st.rssi;
+	}
+#endif
+
+	return 0;
+}
+
+/* A report from the application wins while it is fresh */
+static int8_t rssi_get(int64_t now)
+{
+	const int64_t max_age = CONFIG_APP_UPLOAD_SCHED_RSSI_MAX_AGE_SECONDS * MSEC_PER_SEC;
+	int8_t rssi = 0;
+
+	K_SPINLOCK(&lock) {
+		if (rssi_fed_at && now - rssi_fed_at <= max_age) {
+			rssi = rssi_fed;
+		}
+	}
+
+	return rssi ? rssi : rssi_polled();
+}
+
+/* Unknown RSSI or throughput counts as neither good nor poor */
+static enum upload_sched_link link_get(int64_t now, int8_t rssi)
+{
+	uint32_t tput = 0;
+
+#ifdef CONFIG_APP_NET_READY
+	if (!net_ready_is_ready()) {
+		return UPLOAD_SCHED_LINK_DOWN;
+	}
+#endif
+
+	K_SPINLOCK(&lock) {
+		if (tput_at && now - tput_at <= TPUT_MAX_AGE_MS) {
+			tput = tput_bps;
+		}
+	}
+
+	if ((rssi && rssi < CONFIG_APP_UPLOAD_SCHED_RSSI_POOR) ||
+	    (tput && tput < CONFIG_APP_UPLOAD_SCHED_THROUGHPUT_POOR_BPS)) {
+		return UPLOAD_SCHED_LINK_POOR;
+	}
+	if (rssi && rssi >= CONFIG_APP_UPLOAD_SCHED_RSSI_GOOD) {
+		return UPLOAD_SCHED_LINK_GOOD;
+	}
+
+	return UPLOAD_SCHED_LINK_FAIR;
+}
+
+static enum reason decide(enum upload_sched_link link, size_t pending, uint32_t age_s,
+			  bool flush)
+{
+	if (!pending || link == UPLOAD_SCHED_LINK_DOWN) {
+		return REASON_NONE;
+	}
+	if (flush) {
+		return REASON_FLUSH;
+	}
+	if (pending >= CONFIG_APP_UPLOAD_SCHED_SIZE_THRESHOLD) {
+		return REASON_SIZE;
+	}
+	if (age_s >= CONFIG_APP_UPLOAD_SCHED_MAX_DEFER_SECONDS) {
+		return REASON_AGE;
+	}
+
+	switch (link) {
+	case UPLOAD_SCHED_LINK_GOOD:
+		if (pending >= CONFIG_APP_UPLOAD_SCHED_OPPORTUNISTIC_BYTES) {
+			return REASON_LINK;
+		}
+		__fallthrough;
+	case UPLOAD_SCHED_LINK_FAIR:
+		return age_s >= (uint32_t)atomic_get(&interval_s) ? REASON_INTERVAL : REASON_NONE;
+	default:
+		return REASON_NONE;
+	}
+}
+
+/* Lock held */
+static void count_reason(enum reason reason)
+{
+	switch (reason) {
+	case REASON_INTERVAL:
+		stats.by_interval++;
+		break;
+	case REASON_LINK:
+		stats.by_link++;
+		break;
+	case REASON_SIZE:
+		stats.by_size++;
+		break;
+	case REASON_AGE:
+		stats.by_age++;
+		break;
+	case REASON_FLUSH:
+		stats.by_flush++;
+		break;
+	default:
+		break;
+	}
+}
+
+/* Lock held */
+static uint32_t bytes_per_joule(void)
+{
+	return stats.energy_uj ? (uint32_t)(stats.bytes * USEC_PER_SEC / stats.energy_uj) : 0;
+}
+
+/* Lock held */
+static uint32_t success_pct(void)
+{
+	uint32_t tries = stats.uploads + stats.failures;
+
+	return tries ? stats.uploads * 100U / tries : 0;
+}
+
+static int upload(const uint8_t *data, size_t len)
+{
+	int64_t start = k_uptime_get();
+	bool reused = false;
+	uint32_t ms;
+	int err;
+
+	err = backend(data, len, &reused);
+	ms = MAX((uint32_t)(k_uptime_get() - start), 1U);
+
+	K_SPINLOCK(&lock) {
+		/* mW x ms = uJ; time with the radio busy stands in for a meter */
+		stats.energy_uj += (uint64_t)ms * CONFIG_APP_UPLOAD_SCHED_RADIO_MW;
+
+		if (err) {
+			stats.failures++;
+		} else {
+			stats.uploads++;
+			stats.bytes += len;
+		}
+
+		/*
+		 * A new connection's handshakes and a small batch's round trip
+		 * would read as a slow link; only big batches on a warm
+		 * connection say something about the radio.
+		 */
+		if (!err && reused && len >= CONFIG_APP_UPLOAD_SCHED_THROUGHPUT_MIN_BYTES) {
+			uint32_t bps = (uint32_t)((uint64_t)len * 8U * MSEC_PER_SEC / ms);
+
+			tput_bps = tput_at ? (3U * tput_bps + bps) / 4U : bps;
+			tput_at = k_uptime_get();
+		}
+	}
+
+	if (err) {
+		LOG_WRN("Upload of %zu bytes failed: %d", len, err);
+	} else {
+		LOG_DBG("Uploaded %zu bytes in %u ms", len, ms);
+	}
+
+	return err;
+}
+
+static void check_handler(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+	int8_t rssi = rssi_get(now);
+	enum upload_sched_link link = link_get(now, rssi);
+	enum reason reason;
+	size_t pending;
+	int64_t oldest;
+	uint32_t age_s;
+	bool flush;
+
+	ARG_UNUSED(work);
+
+	K_SPINLOCK(&lock) {
+		pending = active_len + sending_len;
+		oldest = sending_len ? sending_since : active_since;
+		flush = flush_requested;
+		flush_requested = false;
+		stats.rssi = rssi;
+		stats.link = link;
+	}
+
+	age_s = pending ? (uint32_t)((now - oldest) / MSEC_PER_SEC) : 0;
+	reason = decide(link, pending, age_s, flush);
+
+	if (reason == REASON_NONE && link == UPLOAD_SCHED_LINK_POOR && !deferral_counted &&
+	    decide(UPLOAD_SCHED_LINK_FAIR, pending, age_s, false) != REASON_NONE) {
+		/* Would have gone out on a fair link */
+		deferral_counted = true;
+		K_SPINLOCK(&lock) {
+			stats.deferred++;
+		}
+		LOG_INF("Deferring %zu bytes, RSSI %d dBm", pending, rssi);
+	}
+
+	if (reason == REASON_NONE || !backend || (reason != REASON_FLUSH && now < retry_at)) {
+		goto out;
+	}
+
+	K_SPINLOCK(&lock) {
+		if (!sending_len) {
+			uint8_t *tmp = sending;
+
+			sending = active;
+			sending_len = active_len;
+			sending_since = active_since;
+			active = tmp;
+			active_len = 0;
+		}
+		count_reason(reason);
+	}
+
+	LOG_DBG("Uploading %zu bytes (%s link, reason %d)", sending_len, link_str(link), reason);
+
+	if (upload(sending, sending_len)) {
+		retry_at = now + CONFIG_APP_UPLOAD_SCHED_RETRY_SECONDS * MSEC_PER_SEC;
+		goto out;
+	}
+
+	K_SPINLOCK(&lock) {
+		sending_len = 0;
+		pending = active_len;
+	}
+	retry_at = 0;
+	deferral_counted = false;
+
+	/* What piled up meanwhile may be due already */
+	if (pending) {
+		kick();
+		return;
+	}
+
+out:
+	K_SPINLOCK(&lock) {
+		pending = active_len + sending_len;
+	}
+	if (pending) {
+		k_work_schedule_for_queue(&sched_q, &check_work,
+					  K_SECONDS(CONFIG_APP_UPLOAD_SCHED_CHECK_SECONDS));
+	}
+}
+
+#ifdef CONFIG_APP_UPLOAD_SCHED_HTTP_POOL
+static int http_send(const uint8_t *data, size_t len, bool *reused)
+{
+	struct http_pool_request req = {
+		.method = HTTP_POST,
+		.host = CONFIG_APP_UPLOAD_SCHED_HOST,
+		.url = CONFIG_APP_UPLOAD_SCHED_URL,
+		.content_type = "application/x-ndjson",
+		.payload = data,
+		.payload_len = len,
+	};
+	struct http_pool_response rsp;
+	int err;
+
+	err = http_pool_request(&req, &rsp, CONFIG_APP_UPLOAD_SCHED_TIMEOUT_MS);
+	if (err) {
+		return err;
+	}
+
+	*reused = rsp.reused;
+
+	if (rsp.status < 200 || rsp.status >= 300) {
+		LOG_WRN("Server answered %u", rsp.status);
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_APP_STATS
+static uint32_t stat_bytes_per_j(void)
+{
+	uint32_t v;
+
+	K_SPINLOCK(&lock) {
+		v = bytes_per_joule();
+	}
+
+	return v;
+}
+
+static uint32_t stat_success_pct(void)
+{
+	uint32_t v;
+
+	K_SPINLOCK(&lock) {
+		v = success_pct();
+	}
+
+	return v;
+}
+
+static uint32_t stat_deferred(void)
+{
+	uint32_t v;
+
+	K_SPINLOCK(&lock) {
+		v = stats.deferred;
+	}
+
+	return v;
+}
+#endif
+
+APP_STATS_FN_DEFINE(upload_sched, bytes_per_j, stat_bytes_per_j);
+APP_STATS_FN_DEFINE(upload_sched, success_pct, stat_success_pct);
+APP_STATS_FN_DEFINE(upload_sched, deferred, stat_deferred);
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int upload_sched_put(const void *data, size_t len)
+{
+	k_spinlock_key_t key;
+	size_t before;
+	bool urgent;
+	int err;
+
+	if (!data || !len) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+	before = active_len + sending_len;
+	err = append(data, len);
+	urgent = crossed(before);
+	k_spin_unlock(&lock, key);
+
+	if (!err) {
+		queued(urgent);
+	}
+
+	return err;
+}
+
+void upload_sched_backend_set(upload_sched_send_t send)
+{
+	backend = send;
+	kick();
+}
+
+void upload_sched_interval_set(uint32_t seconds)
+{
+	atomic_set(&interval_s, seconds ? seconds : CONFIG_APP_UPLOAD_SCHED_INTERVAL_SECONDS);
+	kick();
+}
+
+void upload_sched_rssi_set(int8_t rssi)
+{
+	enum upload_sched_link before;
+	bool improved;
+
+	K_SPINLOCK(&lock) {
+		before = stats.link;
+		rssi_fed = rssi;
+		rssi_fed_at = k_uptime_get();
+		improved = (before == UPLOAD_SCHED_LINK_POOR &&
+			    rssi >= CONFIG_APP_UPLOAD_SCHED_RSSI_POOR) ||
+			   (before != UPLOAD_SCHED_LINK_GOOD &&
+			    rssi >= CONFIG_APP_UPLOAD_SCHED_RSSI_GOOD);
+	}
+
+	/* A deferred batch should go out as soon as the link recovers */
+	if (improved) {
+		kick();
+	}
+}
+
+void upload_sched_flush(void)
+{
+	K_SPINLOCK(&lock) {
+		flush_requested = true;
+	}
+	kick();
+}
+
+void upload_sched_stats_get(struct upload_sched_stats *out)
+{
+	int64_t now = k_uptime_get();
+
+	K_SPINLOCK(&lock) {
+		*out = stats;
+		out->pending = active_len + sending_len;
+		out->bytes_per_joule = bytes_per_joule();
+		out->success_pct = success_pct();
+		out->throughput_bps = tput_at && now - tput_at <= TPUT_MAX_AGE_MS ? tput_bps : 0;
+	}
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+static int upload_sched_init(void)
+{
+	k_work_queue_start(&sched_q, sched_stack, K_THREAD_STACK_SIZEOF(sched_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, NULL);
+	k_thread_name_set(&sched_q.thread, "upload_sched");
+
+#ifdef CONFIG_APP_UPLOAD_SCHED_HTTP_POOL
+	backend = http_send;
+#endif
+
+	LOG_INF("Upload scheduler: every %u s, early above %d dBm, defer below %d dBm",
+		CONFIG_APP_UPLOAD_SCHED_INTERVAL_SECONDS, CONFIG_APP_UPLOAD_SCHED_RSSI_GOOD,
+		CONFIG_APP_UPLOAD_SCHED_RSSI_POOR);
+
+	return 0;
+}
+
+SYS_INIT(upload_sched_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_UPLOAD_SCHED_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct upload_sched_stats s;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	upload_sched_stats_get(&s);
+
+	shell_print(sh, "Link:        %s, RSSI %d dBm, %u bit/s", link_str(s.link), s.rssi,
+		    s.throughput_bps);
+	shell_print(sh, "Pending:     %u bytes, interval %ld s", s.pending,
+		    atomic_get(&interval_s));
+	shell_print(sh, "Uploads:     %u ok, %u failed (%u%%)", s.uploads, s.failures,
+		    s.success_pct);
+	shell_print(sh, "Sent by:     interval %u, good link %u, size %u, age %u, flush %u",
+		    s.by_interval, s.by_link, s.by_size, s.by_age, s.by_flush);
+	shell_print(sh, "Deferred:    %u batches, %u records dropped", s.deferred, s.dropped);
+	shell_print(sh, "Energy:      %llu uJ est., %llu bytes, %u bytes/J",
+		    (unsigned long long)s.energy_uj, (unsigned long long)s.bytes,
+		    s.bytes_per_joule);
+
+	return 0;
+}
+
+static int cmd_flush(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	upload_sched_flush();
+	shell_print(sh, "Flush requested");
+
+	return 0;
+}
+
+static int cmd_put(const struct shell *sh, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+
+	err = upload_sched_put(argv[1], strlen(argv[1]));
+	if (err) {
+		shell_error(sh, "Put failed: %d", err);
+		return err;
+	}
+
+	return 0;
+}
+
+static int cmd_rssi(const struct shell *sh, size_t argc, char **argv)
+{
+	int rssi = strtol(argv[1], NULL, 10);
+
+	ARG_UNUSED(argc);
+
+	if (rssi < -127 || rssi > 0) {
+		shell_error(sh, "RSSI must be -127..0 dBm");
+		return -EINVAL;
+	}
+
+	upload_sched_rssi_set((int8_t)rssi);
+	shell_print(sh, "RSSI %d dBm", rssi);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_upload_sched,
+	SHELL_CMD(show, NULL, "Link, pending bytes and statistics", cmd_show),
+	SHELL_CMD(flush, NULL, "Upload what is pending now", cmd_flush),
+	SHELL_CMD_ARG(put, NULL, "Queue a record: put <text>", cmd_put, 2, 0),
+	SHELL_CMD_ARG(rssi, NULL, "Report link RSSI: rssi <dBm>", cmd_rssi, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(upload_sched, &sub_upload_sched, "Link-aware upload scheduler", NULL);
+
+#endif /* CONFIG_APP_UPLOAD_SCHED_SHELL */
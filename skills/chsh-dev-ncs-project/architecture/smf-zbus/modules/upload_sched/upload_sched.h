@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _UPLOAD_SCHED_H_
+#define _UPLOAD_SCHED_H_
+
+/**
+ * @file upload_sched.h
+ * @brief Upload scheduler that waits for a good link before sending
+ *
+ * Records from bound channels or upload_sched_put() are batched, newline
+ * separated, and uploaded as one request. When the batch goes out
+ * depends on the link:
+ *
+ * - good (RSSI >= RSSI_GOOD and recent throughput not low): as soon as
+ *   OPPORTUNISTIC_BYTES are pending, or when the interval is due
+ * - fair: when the interval is due
+ * - poor (RSSI < RSSI_POOR or throughput < THROUGHPUT_POOR_BPS):
+ *   deferred until the batch reaches SIZE_THRESHOLD or its oldest
+ *   record is MAX_DEFER_SECONDS old
+ *
+ * @code
+ * static int location_encode(const void *msg, char *buf, size_t len)
+ * {
+ *     const struct location_msg *m = msg;
+ *
+ *     return snprintk(buf, len, "{\"lat_e6\":%d,\"lon_e6\":%d}",
+ *                     (int)(m->latitude * 1e6), (int)(m->longitude * 1e6));
+ * }
+ *
+ * UPLOAD_SCHED_CHAN_DEFINE(LOCATION_CHAN, location_encode);
+ * @endcode
+ *
+ * Energy is estimated as radio-on time during uploads times
+ * CONFIG_APP_UPLOAD_SCHED_RADIO_MW. A weak link shows up as longer
+ * uploads for the same bytes, hence fewer bytes per joule.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Listener behind every UPLOAD_SCHED_CHAN_DEFINE() */
+ZBUS_OBS_DECLARE(upload_sched_lis);
+
+/**
+ * @brief Encode one channel message as a record
+ *
+ * Runs in the publisher's context, into a CONFIG_APP_UPLOAD_SCHED_RECORD_SIZE
+ * buffer on its stack.
+ *
+ * @return Length, 0 to skip the message, a value >= @p len when it does
+ *         not fit (snprintk() semantics), or negative errno
+ */
+typedef int (*upload_sched_encode_t)(const void *msg, char *buf, size_t len);
+
+/**
+ * @brief Send one batch
+ *
+ * Runs on the scheduler's work queue and may block.
+ *
+ * @param reused Set to true when the batch went over a connection that was
+ *               already open. Only such uploads feed the throughput
+ *               estimate; leave it false when unknown.
+ * @return 0 when the server accepted it; the batch is kept and retried
+ *         otherwise
+ */
+typedef int (*upload_sched_send_t)(const uint8_t *data, size_t len, bool *reused);
+
+/** Channel bound to the scheduler (ROM) */
+struct upload_sched_binding {
+	const struct zbus_channel *chan;
+	upload_sched_encode_t encode;
+};
+
+/**
+ * @brief Upload every message of a channel through the scheduler
+ *
+ * @param _chan zbus channel
+ * @param _encode Encoder, see upload_sched_encode_t
+ */
+#define UPLOAD_SCHED_CHAN_DEFINE(_chan, _encode)					\
+	ZBUS_CHAN_ADD_OBS(_chan, upload_sched_lis, 0);					\
+	static const STRUCT_SECTION_ITERABLE(upload_sched_binding,			\
+					     _CONCAT(upload_sched_bind_, _chan)) = {	\
+		.chan = &_chan,								\
+		.encode = _encode,							\
+	}
+
+enum upload_sched_link {
+	UPLOAD_SCHED_LINK_DOWN,
+	UPLOAD_SCHED_LINK_POOR,
+	UPLOAD_SCHED_LINK_FAIR,
+	UPLOAD_SCHED_LINK_GOOD,
+};
+
+/** Statistics since boot */
+struct upload_sched_stats {
+	uint32_t uploads;		/* Accepted by the server */
+	uint32_t failures;
+	uint32_t by_interval;		/* Why batches went out */
+	uint32_t by_link;		/* Early, on a good link */
+	uint32_t by_size;
+	uint32_t by_age;		/* Deferred up to MAX_DEFER_SECONDS */
+	uint32_t by_flush;
+	uint32_t deferred;		/* Batches held back for a poor link */
+	uint32_t dropped;		/* Records that found the buffer full */
+	uint32_t pending;		/* Bytes waiting now */
+	uint64_t bytes;			/* Uploaded successfully */
+	uint64_t energy_uj;		/* Estimated, all attempts */
+	uint32_t bytes_per_joule;
+	uint32_t success_pct;
+	int8_t rssi;			/* 0 when unknown */
+	uint32_t throughput_bps;	/* Recent average, 0 when unknown */
+	enum upload_sched_link link;
+};
+
+/**
+ * @brief Queue a record
+ *
+ * @return 0 on success, -ENOMEM when the buffer is full
+ */
+int upload_sched_put(const void *data, size_t len);
+
+/**
+ * @brief Set the backend; without one, batches wait
+ *
+ * With CONFIG_APP_UPLOAD_SCHED_HTTP_POOL a POST through http_pool is set
+ * at boot.
+ */
+void upload_sched_backend_set(upload_sched_send_t send);
+
+/**
+ * @brief Change the nominal upload interval
+ *
+ * E.g. from an APP_UPLOAD_DATA message's interval_seconds.
+ */
+void upload_sched_interval_set(uint32_t seconds);
+
+/**
+ * @brief Report the link RSSI
+ *
+ * E.g. from a struct wifi_msg listener. Reports older than
+ * CONFIG_APP_UPLOAD_SCHED_RSSI_MAX_AGE_SECONDS are ignored; without
+ * reports the Wi-Fi interface is polled when there is one.
+ */
+void upload_sched_rssi_set(int8_t rssi);
+
+/**
+ * @brief Upload what is pending now, whatever the link
+ */
+void upload_sched_flush(void);
+
+/**
+ * @brief Get the statistics
+ */
+void upload_sched_stats_get(struct upload_sched_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _UPLOAD_SCHED_H_ */
@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file wdt_supervisor.c
+ * @brief Watchdog supervisor
+ *
+ * This module demonstrates:
+ * - One task_wdt channel guarding any number of module heartbeats
+ * - Per-module timeouts checked by a high-priority supervisor thread
+ * - Feed-interval histograms and near-miss counting
+ * - Stall report in .noinit RAM that survives the watchdog reset
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/task_wdt/task_wdt.h>
+#include <zephyr/linker/section_tags.h>
+#include <string.h>
+
+#include "wdt_supervisor.h"
+
+LOG_MODULE_REGISTER(wdt_supervisor, CONFIG_APP_WDT_SUPERVISOR_LOG_LEVEL);
+
+BUILD_ASSERT(CONFIG_APP_WDT_SUPERVISOR_CHECK_PERIOD_MS <
+	     CONFIG_APP_WDT_SUPERVISOR_TIMEOUT_MS,
+	     "Supervisor must check more often than its own watchdog timeout");
+
+/* Marks valid retained data after a warm reset */
+#define RETAINED_MAGIC 0x57445350U
+
+/*******************************************************************************
+ * Retained State
+ ******************************************************************************/
+
+struct wdt_supervisor_retained {
+	uint32_t magic;
+	uint32_t module_count;
+	struct wdt_supervisor_stall stall;
+	struct wdt_supervisor_stats stats[CONFIG_APP_WDT_SUPERVISOR_MAX_MODULES];
+};
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR_RETAIN
+static __noinit struct wdt_supervisor_retained retained;
+#else
+static struct wdt_supervisor_retained retained;
+#endif
+
+/* Stall report of the previous boot, taken out of retained RAM at init */
+static struct wdt_supervisor_stall prev_stall;
+
+static struct k_spinlock lock;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static size_t module_idx(const struct wdt_supervisor_module *mod)
+{
+	const struct wdt_supervisor_module *first;
+
+	STRUCT_SECTION_GET(wdt_supervisor_module, 0, &first);
+
+	return mod - first;
+}
+
+static uint32_t bucket_index(uint32_t ms)
+{
+	uint32_t idx;
+
+	if (ms == 0) {
+		return 0;
+	}
+
+	idx = 32 - __builtin_clz(ms);
+
+	return MIN(idx, WDT_SUPERVISOR_HIST_BUCKETS - 1);
+}
+
+static bool is_near_miss(const struct wdt_supervisor_module *mod, uint32_t interval_ms)
+{
+	return (uint64_t)interval_ms * 100 >
+	       (uint64_t)mod->timeout_ms * CONFIG_APP_WDT_SUPERVISOR_NEAR_MISS_PERCENT;
+}
+
+/* Longest silence relative to its timeout; returns the worst module */
+static const struct wdt_supervisor_module *worst_module(uint32_t now, uint32_t *silent_ms)
+{
+	const struct wdt_supervisor_module *worst = NULL;
+	uint64_t worst_ratio = 0;
+
+	STRUCT_SECTION_FOREACH(wdt_supervisor_module, mod) {
+		uint32_t silent;
+		uint64_t ratio;
+
+		if (mod->data->suspended) {
+			continue;
+		}
+
+		silent = now - mod->data->last_feed_ms;
+		ratio = ((uint64_t)silent << 16) / MAX(mod->timeout_ms, 1);
+
+		if (worst == NULL || ratio > worst_ratio) {
+			worst = mod;
+			worst_ratio = ratio;
+			*silent_ms = silent;
+		}
+	}
+
+	return worst;
+}
+
+static void record_stall(const struct wdt_supervisor_module *mod, uint32_t now,
+			 uint32_t silent_ms)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(&retained.stall, 0, sizeof(retained.stall));
+	strncpy(retained.stall.module, mod->name, sizeof(retained.stall.module) - 1);
+	retained.stall.uptime_ms = now;
+	retained.stall.silent_ms = silent_ms;
+	retained.stall.timeout_ms = mod->timeout_ms;
+	retained.stats[module_idx(mod)].stalls++;
+
+	k_spin_unlock(&lock, key);
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+void wdt_supervisor_feed(const struct wdt_supervisor_module *mod)
+{
+	struct wdt_supervisor_data *data = mod->data;
+	struct wdt_supervisor_stats *stats;
+	uint32_t now = k_uptime_get_32();
+	uint32_t interval;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+
+	interval = now - data->last_feed_ms;
+	data->last_feed_ms = now;
+
+	/* The first interval is measured from boot, not a real heartbeat */
+	if (data->fed) {
+		stats = &retained.stats[module_idx(mod)];
+		stats->feeds++;
+		stats->max_interval_ms = MAX(stats->max_interval_ms, interval);
+		stats->hist[bucket_index(interval)]++;
+		if (is_near_miss(mod, interval)) {
+			stats->near_misses++;
+		}
+	}
+	data->fed = true;
+
+	k_spin_unlock(&lock, key);
+}
+
+void wdt_supervisor_suspend(const struct wdt_supervisor_module *mod)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	mod->data->suspended = true;
+
+	k_spin_unlock(&lock, key);
+}
+
+void wdt_supervisor_resume(const struct wdt_supervisor_module *mod)
+{
+	struct wdt_supervisor_data *data = mod->data;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (data->suspended) {
+		data->suspended = false;
+		data->last_feed_ms = k_uptime_get_32();
+		/* Next interval starts now, not at the last feed before suspend */
+		data->fed = false;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+const struct wdt_supervisor_module *wdt_supervisor_find(const char *name)
+{
+	STRUCT_SECTION_FOREACH(wdt_supervisor_module, mod) {
+		if (strcmp(mod->name, name) == 0) {
+			return mod;
+		}
+	}
+
+	return NULL;
+}
+
+int wdt_supervisor_stats_get(size_t idx, const struct wdt_supervisor_module **mod,
+			     struct wdt_supervisor_stats *stats)
+{
+	k_spinlock_key_t key;
+	size_t count;
+
+	STRUCT_SECTION_COUNT(wdt_supervisor_module, &count);
+	if (idx >= count) {
+		return -ENOENT;
+	}
+
+	STRUCT_SECTION_GET(wdt_supervisor_module, idx, mod);
+
+	key = k_spin_lock(&lock);
+	*stats = retained.stats[idx];
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int wdt_supervisor_last_stall(struct wdt_supervisor_stall *stall)
+{
+	if (prev_stall.module[0] == '\0') {
+		return -ENOENT;
+	}
+
+	*stall = prev_stall;
+
+	return 0;
+}
+
+void wdt_supervisor_clear(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(retained.stats, 0, sizeof(retained.stats));
+	memset(&retained.stall, 0, sizeof(retained.stall));
+	memset(&prev_stall, 0, sizeof(prev_stall));
+
+	k_spin_unlock(&lock, key);
+}
+
+/*******************************************************************************
+ * Supervisor Thread
+ ******************************************************************************/
+
+static void supervisor_thread(void)
+{
+	const struct wdt_supervisor_module *worst;
+	uint32_t silent_ms = 0;
+	bool stalled = false;
+	uint32_t now;
+	int wdt_id;
+
+	/* Every module gets a full timeout from supervisor start */
+	now = k_uptime_get_32();
+	STRUCT_SECTION_FOREACH(wdt_supervisor_module, mod) {
+		if (!mod->data->fed) {
+			mod->data->last_feed_ms = now;
+		}
+	}
+
+	wdt_id = task_wdt_add(CONFIG_APP_WDT_SUPERVISOR_TIMEOUT_MS, NULL, NULL);
+	if (wdt_id < 0) {
+		LOG_ERR("task_wdt_add failed: %d", wdt_id);
+		return;
+	}
+
+	while (1) {
+		now = k_uptime_get_32();
+		worst = worst_module(now, &silent_ms);
+
+		if (worst && silent_ms > worst->timeout_ms) {
+			if (!stalled) {
+				/* Stop feeding; the hardware watchdog resets us */
+				stalled = true;
+				record_stall(worst, now, silent_ms);
+				LOG_ERR("Module %s stalled: no feed for %u ms (timeout %u ms), "
+					"reset in <= %d ms", worst->name, silent_ms,
+					worst->timeout_ms, CONFIG_APP_WDT_SUPERVISOR_TIMEOUT_MS);
+				log_panic();
+			}
+		} else if (!stalled) {
+			task_wdt_feed(wdt_id);
+		}
+
+		k_sleep(K_MSEC(CONFIG_APP_WDT_SUPERVISOR_CHECK_PERIOD_MS));
+	}
+}
+
+K_THREAD_DEFINE(wdt_supervisor_thread_id,
+		CONFIG_APP_WDT_SUPERVISOR_STACK_SIZE,
+		supervisor_thread,
+		NULL, NULL, NULL,
+		CONFIG_APP_WDT_SUPERVISOR_THREAD_PRIORITY,
+		0, 0);
+
+static int wdt_supervisor_init(void)
+{
+	size_t count;
+
+	STRUCT_SECTION_COUNT(wdt_supervisor_module, &count);
+	if (count > CONFIG_APP_WDT_SUPERVISOR_MAX_MODULES) {
+		LOG_ERR("%zu modules registered, increase "
+			"CONFIG_APP_WDT_SUPERVISOR_MAX_MODULES", count);
+		k_panic();
+	}
+
+	if (retained.magic != RETAINED_MAGIC || retained.module_count != count) {
+		memset(&retained, 0, sizeof(retained));
+		retained.magic = RETAINED_MAGIC;
+		retained.module_count = count;
+		return 0;
+	}
+
+	/* Hand the previous boot's stall report over and re-arm */
+	prev_stall = retained.stall;
+	memset(&retained.stall, 0, sizeof(retained.stall));
+
+	if (prev_stall.module[0] != '\0') {
+		LOG_WRN("Previous reset: %s silent for %u ms (timeout %u ms) at uptime %u ms",
+			prev_stall.module, prev_stall.silent_ms, prev_stall.timeout_ms,
+			prev_stall.uptime_ms);
+	}
+
+	return 0;
+}
+
+SYS_INIT(wdt_supervisor_init, APPLICATION, 0);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct wdt_supervisor_module *mod;
+	struct wdt_supervisor_stats stats;
+	struct wdt_supervisor_stall stall;
+	uint32_t now = k_uptime_get_32();
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-16s %8s %8s %8s %8s %6s %6s",
+		    "module", "timeout", "silent", "max_int", "feeds", "near", "stalls");
+
+	for (size_t i = 0; wdt_supervisor_stats_get(i, &mod, &stats) == 0; i++) {
+		/* Suspended modules are not expected to feed: show 0 silence */
+		shell_print(sh, "%-16s %8u %8u %8u %8u %6u %6u",
+			    mod->name, mod->timeout_ms,
+			    mod->data->suspended ? 0 : now - mod->data->last_feed_ms,
+			    stats.max_interval_ms, stats.feeds, stats.near_misses,
+			    stats.stalls);
+	}
+
+	shell_print(sh, "Times in ms, near = interval above %d%% of timeout",
+		    CONFIG_APP_WDT_SUPERVISOR_NEAR_MISS_PERCENT);
+
+	if (wdt_supervisor_last_stall(&stall) == 0) {
+		shell_warn(sh, "Last reset: %s silent %u ms (timeout %u ms) at %u ms",
+			   stall.module, stall.silent_ms, stall.timeout_ms, stall.uptime_ms);
+	}
+
+	return 0;
+}
+
+static int cmd_hist(const struct shell *sh, size_t argc, char **argv)
+{
+	const struct wdt_supervisor_module *mod;
+	struct wdt_supervisor_stats stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	for (size_t i = 0; wdt_supervisor_stats_get(i, &mod, &stats) == 0; i++) {
+		shell_print(sh, "%s (feed interval, ms):", mod->name);
+		for (int b = 0; b < WDT_SUPERVISOR_HIST_BUCKETS; b++) {
+			if (stats.hist[b] == 0) {
+				continue;
+			}
+			shell_print(sh, "  < %6lu: %u", BIT(b), stats.hist[b]);
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	wdt_supervisor_clear();
+	shell_print(sh, "Watchdog supervisor statistics cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_wdt_sup,
+	SHELL_CMD(show, NULL, "Per-module heartbeat margins", cmd_show),
+	SHELL_CMD(hist, NULL, "Feed-interval histograms", cmd_hist),
+	SHELL_CMD(clear, NULL, "Clear statistics and stall report", cmd_clear),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(wdt_sup, &sub_wdt_sup, "Watchdog supervisor", NULL);
+
+#endif /* CONFIG_APP_WDT_SUPERVISOR_SHELL */
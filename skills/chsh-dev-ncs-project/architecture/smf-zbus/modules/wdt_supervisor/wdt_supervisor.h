@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _WDT_SUPERVISOR_H_
+#define _WDT_SUPERVISOR_H_
+
+/**
+ * @file wdt_supervisor.h
+ * @brief Watchdog supervisor multiplexing module heartbeats onto one task_wdt channel
+ *
+ * Modules register a heartbeat with WDT_SUPERVISOR_MODULE_DEFINE() and call
+ * wdt_supervisor_feed() instead of owning a task_wdt channel. A supervisor
+ * thread feeds the single task_wdt channel only while every module fed
+ * within its own timeout. When one does not, the stalled module is written
+ * to retained RAM and logged, then the hardware watchdog resets the device.
+ *
+ * Every feed also updates a per-module feed-interval histogram (retained
+ * across warm resets), so near-misses show up long before a real reset.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Feed-interval histogram buckets: [2^(i-1), 2^i) ms, last bucket = overflow */
+#define WDT_SUPERVISOR_HIST_BUCKETS 16
+
+/** Runtime data of a supervised module (RAM) */
+struct wdt_supervisor_data {
+	uint32_t last_feed_ms;
+	bool fed;
+	bool suspended;
+};
+
+/**
+ * @brief Supervised module descriptor (ROM)
+ *
+ * Define one per module with WDT_SUPERVISOR_MODULE_DEFINE().
+ */
+struct wdt_supervisor_module {
+	const char *name;
+	uint32_t timeout_ms;
+	struct wdt_supervisor_data *data;
+};
+
+/**
+ * @brief Register a module heartbeat
+ *
+ * @param _name Module name (identifier)
+ * @param _timeout_ms Longest allowed time between two feeds
+ */
+#define WDT_SUPERVISOR_MODULE_DEFINE(_name, _timeout_ms)				\
+	static struct wdt_supervisor_data _CONCAT(wdt_sup_data_, _name);		\
+	static const STRUCT_SECTION_ITERABLE(wdt_supervisor_module,			\
+					     _CONCAT(wdt_sup_mod_, _name)) = {		\
+		.name = STRINGIFY(_name),						\
+		.timeout_ms = _timeout_ms,						\
+		.data = &_CONCAT(wdt_sup_data_, _name),					\
+	}
+
+/** Reference a descriptor defined with WDT_SUPERVISOR_MODULE_DEFINE() */
+#define WDT_SUPERVISOR_MODULE(_name) (&_CONCAT(wdt_sup_mod_, _name))
+
+/**
+ * @brief Per-module statistics (retained across warm resets)
+ */
+struct wdt_supervisor_stats {
+	uint32_t feeds;
+	uint32_t max_interval_ms;
+	uint32_t near_misses;	/* Intervals above the near-miss threshold */
+	uint32_t stalls;	/* Times this module caused a reset */
+	uint32_t hist[WDT_SUPERVISOR_HIST_BUCKETS];
+};
+
+/**
+ * @brief Stall report of the last supervisor-initiated reset
+ */
+struct wdt_supervisor_stall {
+	char module[16];	/* Empty when the last reset was not a stall */
+	uint32_t uptime_ms;	/* Uptime when the stall was detected */
+	uint32_t silent_ms;	/* Time since the module's last feed */
+	uint32_t timeout_ms;
+};
+
+/**
+ * @brief Report a module heartbeat
+ *
+ * Cheap enough for every loop iteration; safe from ISRs.
+ *
+ * @param mod Module descriptor (WDT_SUPERVISOR_MODULE())
+ */
+void wdt_supervisor_feed(const struct wdt_supervisor_module *mod);
+
+/**
+ * @brief Stop expecting heartbeats from a module
+ *
+ * For a module that is about to block on its message queue without a
+ * timeout: it cannot hang there, and feeding would mean waking up for
+ * nothing. Safe from ISRs.
+ *
+ * @param mod Module descriptor (WDT_SUPERVISOR_MODULE())
+ */
+void wdt_supervisor_suspend(const struct wdt_supervisor_module *mod);
+
+/**
+ * @brief Expect heartbeats again, with a full timeout from now
+ *
+ * The suspended period is not counted as a feed interval. Safe from ISRs.
+ *
+ * @param mod Module descriptor (WDT_SUPERVISOR_MODULE())
+ */
+void wdt_supervisor_resume(const struct wdt_supervisor_module *mod);
+
+/**
+ * @brief Find a registered module by name
+ *
+ * @return Descriptor, or NULL when no module has that name
+ */
+const struct wdt_supervisor_module *wdt_supervisor_find(const char *name);
+
+/**
+ * @brief Get the statistics of one supervised module
+ *
+ * @param idx Module index, starting at 0
+ * @param mod Output descriptor
+ * @param stats Output statistics
+ * @return 0 on success, -ENOENT when idx is past the last module
+ */
+int wdt_supervisor_stats_get(size_t idx, const struct wdt_supervisor_module **mod,
+			     struct wdt_supervisor_stats *stats);
+
+/**
+ * @brief Get the stall that caused the previous reset
+ *
+ * @param stall Output report
+ * @return 0 if the previous reset was a supervisor stall, -ENOENT otherwise
+ */
+int wdt_supervisor_last_stall(struct wdt_supervisor_stall *stall);
+
+/**
+ * @brief Clear statistics and the stall report
+ */
+void wdt_supervisor_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _WDT_SUPERVISOR_H_ */
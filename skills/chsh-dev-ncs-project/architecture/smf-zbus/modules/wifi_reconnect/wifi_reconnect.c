@@ -0,0 +1,641 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file wifi_reconnect.c
+ * @brief Wi-Fi reconnect manager
+ *
+ * This module demonstrates:
+ * - Reconnecting to a known BSSID and channel before paying for a full scan
+ * - Exponential backoff with jitter so a fleet spreads out after an outage
+ * - Measuring time to reconnect as a histogram rather than an average
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/wifi.h>
+#include <zephyr/net/wifi_mgmt.h>
+#include <zephyr/random/random.h>
+#include <errno.h>
+#include <string.h>
+
+#ifdef CONFIG_WIFI_CREDENTIALS
+#include <zephyr/net/wifi_credentials.h>
+#endif
+
+#include "wifi_reconnect.h"
+
+LOG_MODULE_REGISTER(wifi_reconnect, CONFIG_APP_WIFI_RECONNECT_LOG_LEVEL);
+
+#define WIFI_EVENTS (NET_EVENT_WIFI_CONNECT_RESULT | NET_EVENT_WIFI_DISCONNECT_RESULT)
+
+/* How long a cancelled attempt may take to wind down before we move on */
+#define ABORT_POLL_MS 100
+#define ABORT_POLLS 20
+#define ABORT_WINDOW_MS (ABORT_POLL_MS * ABORT_POLLS)
+
+enum event_type {
+	EV_CONNECTED,
+	EV_CONNECT_FAILED,
+	EV_DISCONNECTED,
+};
+
+struct event {
+	enum event_type type;
+	int status;
+};
+
+/* Access point of the last successful connection */
+struct ap {
+	bool valid;
+	uint8_t ssid[WIFI_SSID_MAX_LEN];
+	uint8_t ssid_len;
+	uint8_t bssid[WIFI_MAC_ADDR_LEN];
+	uint8_t channel;
+	uint8_t band;
+	enum wifi_security_type security;
+};
+
+static const uint32_t hist_edges_ms[WIFI_RECONNECT_HIST_BUCKETS] = {
+	500, 1000, 2000, 5000, 10000, 30000, 60000, UINT32_MAX,
+};
+
+static struct k_spinlock lock;
+static struct wifi_reconnect_stats stats;
+
+/* Owned by the system work queue */
+static enum wifi_reconnect_state state;
+static struct ap ap;
+static int64_t down_at;		/* Start of the current outage, 0 when none */
+static uint32_t round_no;
+static bool aborting;		/* Cancelling an attempt that timed out */
+static uint8_t abort_polls;
+static int64_t aborted_at;	/* Its disconnect event may come after we moved on */
+
+#ifdef CONFIG_WIFI_CREDENTIALS
+static struct wifi_credentials_personal creds;
+#endif
+
+static struct net_mgmt_event_callback wifi_cb;
+
+/* Events are handled in arrival order, on the system work queue */
+K_MSGQ_DEFINE(event_q, sizeof(struct event), 8, 4);
+
+static void event_handler(struct k_work *work);
+static void timer_handler(struct k_work *work);
+static void on_connected(void);
+static void on_failed(int status);
+static K_WORK_DEFINE(event_work, event_handler);
+static K_WORK_DELAYABLE_DEFINE(timer_work, timer_handler);
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static struct net_if *wifi_iface(void)
+{
+#ifdef CONFIG_APP_WIFI_RECONNECT_MOCK
+	return net_if_get_default();
+#else
+	return net_if_get_first_wifi();
+#endif
+}
+
+static const char *state_str(enum wifi_reconnect_state s)
+{
+	switch (s) {
+	case WIFI_RECONNECT_CONNECTED:
+		return "connected";
+	case WIFI_RECONNECT_TARGETED:
+		return "targeted connect";
+	case WIFI_RECONNECT_SCANNING:
+		return "full scan";
+	case WIFI_RECONNECT_BACKOFF:
+		return "backoff";
+	case WIFI_RECONNECT_PAUSED:
+		return "paused";
+	default:
+		return "?";
+	}
+}
+
+static int iface_status(struct wifi_iface_status *st)
+{
+	memset(st, 0, sizeof(*st));
+
+	return net_mgmt(NET_REQUEST_WIFI_IFACE_STATUS, wifi_iface(), st, sizeof(*st));
+}
+
+/* Keep what a targeted connect needs; called once associated */
+static void remember(void)
+{
+	struct wifi_iface_status st;
+
+	if (iface_status(&st) || st.state < WIFI_STATE_ASSOCIATED ||
+	    st.ssid_len > sizeof(ap.ssid)) {
+		return;
+	}
+
+	if (ap.valid && memcmp(ap.bssid, st.bssid, sizeof(ap.bssid)) != 0) {
+		LOG_DBG("AP changed, now channel %u", st.channel);
+	}
+
+	memcpy(ap.ssid, st.ssid, st.ssid_len);
+	ap.ssid_len = st.ssid_len;
+	memcpy(ap.bssid, st.bssid, sizeof(ap.bssid));
+	ap.channel = st.channel;
+	ap.band = st.band;
+	ap.security = st.security;
+	ap.valid = true;
+}
+
+static bool link_up(void)
+{
+	struct wifi_iface_status st;
+
+	return iface_status(&st) == 0 && st.state == WIFI_STATE_COMPLETED;
+}
+
+/* Doubles per round up to the maximum; the upper half is picked at random */
+static uint32_t backoff_ms(uint32_t n)
+{
+	uint32_t ms = CONFIG_APP_WIFI_RECONNECT_BACKOFF_BASE_MS;
+
+	for (uint32_t i = 1; i < n && ms < CONFIG_APP_WIFI_RECONNECT_BACKOFF_MAX_MS; i++) {
+		ms *= 2;
+	}
+	ms = MIN(ms, CONFIG_APP_WIFI_RECONNECT_BACKOFF_MAX_MS);
+
+	return ms / 2 + sys_rand32_get() % (ms / 2 + 1);
+}
+
+static void backoff(void)
+{
+	uint32_t ms;
+
+	round_no++;
+	ms = backoff_ms(round_no);
+
+	K_SPINLOCK(&lock) {
+		stats.rounds++;
+	}
+
+	state = WIFI_RECONNECT_BACKOFF;
+	k_work_reschedule(&timer_work, K_MSEC(ms));
+	LOG_INF("Still disconnected, round %u in %u ms", round_no + 1, ms);
+}
+
+static void try_scan(void)
+{
+	int err = net_mgmt(NET_REQUEST_WIFI_CONNECT_STORED, wifi_iface(), NULL, 0);
+
+	if (err) {
+		LOG_DBG("Connect with stored credentials: %d", err);
+		backoff();
+		return;
+	}
+
+	state = WIFI_RECONNECT_SCANNING;
+	k_work_reschedule(&timer_work, K_MSEC(CONFIG_APP_WIFI_RECONNECT_SCAN_TIMEOUT_MS));
+}
+
+static int creds_fill(struct wifi_connect_req_params *p)
+{
+#ifdef CONFIG_WIFI_CREDENTIALS
+	int err = wifi_credentials_get_by_ssid_personal_struct((const char *)ap.ssid,
+							       ap.ssid_len, &creds);
+
+	if (err) {
+		return err;
+	}
+
+	p->security = creds.header.type;
+	if (p->security != WIFI_SECURITY_TYPE_NONE) {
+		p->psk = (const uint8_t *)creds.password;
+		p->psk_length = creds.password_len;
+	}
+	if (p->security == WIFI_SECURITY_TYPE_SAE) {
+		p->sae_password = p->psk;
+		p->sae_password_length = p->psk_length;
+	}
+
+	return 0;
+#else
+	/* Without a credentials store only open networks can be rejoined */
+	p->security = ap.security;
+
+	return ap.security == WIFI_SECURITY_TYPE_NONE ? 0 : -ENOTSUP;
+#endif
+}
+
+/* Connect to the remembered BSSID; the supplicant only scans its channel */
+static int try_targeted(void)
+{
+	struct wifi_connect_req_params p = {
+		.ssid = ap.ssid,
+		.ssid_length = ap.ssid_len,
+		.band = ap.band,
+		.channel = ap.channel,
+		.mfp = WIFI_MFP_OPTIONAL,
+		.timeout = SYS_FOREVER_MS,
+	};
+	int err;
+
+	memcpy(p.bssid, ap.bssid, sizeof(p.bssid));
+
+	err = creds_fill(&p);
+	if (!err) {
+		err = net_mgmt(NET_REQUEST_WIFI_CONNECT, wifi_iface(), &p, sizeof(p));
+	}
+	if (err) {
+		LOG_DBG("Targeted connect: %d", err);
+		return err;
+	}
+
+	state = WIFI_RECONNECT_TARGETED;
+	k_work_reschedule(&timer_work, K_MSEC(CONFIG_APP_WIFI_RECONNECT_TARGETED_TIMEOUT_MS));
+
+	return 0;
+}
+
+/*
+ * The supplicant is still busy
+ * with an attempt that gave no result in time, and rejects the next
+ * connect (-EALREADY) until it stops. Cancel it, wait for the interface to
+ * go idle, then carry on as after a failure. Its late results and the
+ * disconnect we caused are ignored meanwhile, so the cancel never looks
+ * like a user request that pauses the manager.
+ */
+static void abort_poll(void)
+{
+	struct wifi_iface_status st;
+	int err = iface_status(&st);
+
+	if (!err && st.state == WIFI_STATE_COMPLETED) {
+		/* It got through after all */
+		aborting = false;
+		on_connected();
+		return;
+	}
+
+	if (!err && st.state >= WIFI_STATE_SCANNING && abort_polls < ABORT_POLLS) {
+		abort_polls++;
+		k_work_reschedule(&timer_work, K_MSEC(ABORT_POLL_MS));
+		return;
+	}
+
+	aborting = false;
+	on_failed(-ETIMEDOUT);
+}
+
+static void abort_attempt(void)
+{
+	int err = net_mgmt(NET_REQUEST_WIFI_DISCONNECT, wifi_iface(), NULL, 0);
+
+	if (err) {
+		LOG_DBG("Cancelling the attempt: %d", err);
+	}
+
+	aborting = true;
+	abort_polls = 0;
+	aborted_at = k_uptime_get();
+	abort_poll();
+}
+
+static void start_round(void)
+{
+	if (link_up()) {
+		/* Someone else got there; a queued result event finds us connected */
+		on_connected();
+		return;
+	}
+
+	if (ap.valid && try_targeted() == 0) {
+		return;
+	}
+
+	try_scan();
+}
+
+static void start_outage(const char *why)
+{
+	uint32_t first = sys_rand32_get() % (CONFIG_APP_WIFI_RECONNECT_FIRST_DELAY_MAX_MS + 1);
+
+	down_at = k_uptime_get();
+	round_no = 0;
+
+	K_SPINLOCK(&lock) {
+		stats.outages++;
+	}
+
+	state = WIFI_RECONNECT_BACKOFF;
+	k_work_reschedule(&timer_work, K_MSEC(first));
+	LOG_INF("%s, reconnecting in %u ms", why, first);
+}
+
+static void on_connected(void)
+{
+	enum wifi_reconnect_state was = state;
+	uint32_t ms;
+	size_t b;
+
+	k_work_cancel_delayable(&timer_work);
+	remember();
+	state = WIFI_RECONNECT_CONNECTED;
+	round_no = 0;
+	aborting = false;
+
+	if (!down_at) {
+		return;
+	}
+
+	ms = (uint32_t)(k_uptime_get() - down_at);
+	down_at = 0;
+
+	for (b = 0; ms > hist_edges_ms[b]; b++) {
+	}
+
+	K_SPINLOCK(&lock) {
+		stats.reconnects++;
+		stats.last_ms = ms;
+		stats.max_ms = MAX(stats.max_ms, ms);
+		stats.total_ms += ms;
+		stats.hist[b]++;
+		if (was == WIFI_RECONNECT_TARGETED) {
+			stats.targeted_ok++;
+		} else if (was == WIFI_RECONNECT_SCANNING) {
+			stats.scan_ok++;
+		} else {
+			stats.other_ok++;
+		}
+	}
+
+	LOG_INF("Reconnected in %u ms (%s)", ms, state_str(was));
+}
+
+static void on_failed(int status)
+{
+	if (aborting) {
+		/* The attempt we are cancelling; abort_poll() decides */
+		LOG_DBG("Cancelled attempt ended: %d", status);
+		return;
+	}
+
+	switch (state) {
+	case WIFI_RECONNECT_TARGETED:
+		LOG_DBG("Targeted connect failed: %d", status);
+		K_SPINLOCK(&lock) {
+			stats.targeted_failed++;
+		}
+		try_scan();
+		break;
+	case WIFI_RECONNECT_SCANNING:
+		LOG_DBG("Full scan connect failed: %d", status);
+		K_SPINLOCK(&lock) {
+			stats.scan_failed++;
+		}
+		backoff();
+		break;
+	case WIFI_RECONNECT_CONNECTED:
+		/* A connect we did not start failed, e.g. at boot: take over */
+		start_outage("Connect failed");
+		break;
+	default:
+		/* Late result of an attempt we already gave up on */
+		break;
+	}
+}
+
+static void on_disconnected(int reason)
+{
+	if (reason == WIFI_REASON_DISCONN_USER_REQUEST && aborted_at &&
+	    k_uptime_get() - aborted_at < ABORT_WINDOW_MS) {
+		/* Our own cancel, not a request to stay offline */
+		return;
+	}
+
+	if (reason == WIFI_REASON_DISCONN_USER_REQUEST) {
+		k_work_cancel_delayable(&timer_work);
+		state = WIFI_RECONNECT_PAUSED;
+		down_at = 0;
+		LOG_INF("Disconnected on request, not reconnecting");
+		return;
+	}
+
+	/* Failed attempts can also report a disconnect; only a lost link counts */
+	if (state == WIFI_RECONNECT_CONNECTED) {
+		start_outage("Link lost");
+	}
+}
+
+static void event_handler(struct k_work *work)
+{
+	struct event ev;
+
+	ARG_UNUSED(work);
+
+	while (k_msgq_get(&event_q, &ev, K_NO_WAIT) == 0) {
+		switch (ev.type) {
+		case EV_CONNECTED:
+			on_connected();
+			break;
+		case EV_CONNECT_FAILED:
+			on_failed(ev.status);
+			break;
+		case EV_DISCONNECTED:
+			on_disconnected(ev.status);
+			break;
+		}
+	}
+}
+
+static void timer_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	switch (state) {
+	case WIFI_RECONNECT_BACKOFF:
+		start_round();
+		break;
+	case WIFI_RECONNECT_TARGETED:
+	case WIFI_RECONNECT_SCANNING:
+		/* No result in time: stop it, then same as a failure */
+		if (aborting) {
+			abort_poll();
+		} else {
+			abort_attempt();
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/* net_mgmt thread: queue and return */
+static void wifi_event_cb(struct net_mgmt_event_callback *cb, uint64_t mgmt_event,
+			  struct net_if *iface)
+{
+	const struct wifi_status *st = cb->info;
+	struct event ev = { .status = st ? st->status : 0 };
+
+	ARG_UNUSED(iface);
+
+	if (mgmt_event == NET_EVENT_WIFI_CONNECT_RESULT) {
+		ev.type = ev.status ? EV_CONNECT_FAILED : EV_CONNECTED;
+	} else if (mgmt_event == NET_EVENT_WIFI_DISCONNECT_RESULT) {
+		ev.type = EV_DISCONNECTED;
+	} else {
+		return;
+	}
+
+	if (k_msgq_put(&event_q, &ev, K_NO_WAIT)) {
+		LOG_WRN("Event queue full, event %d lost", ev.type);
+	}
+	k_work_submit(&event_work);
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+enum wifi_reconnect_state wifi_reconnect_state_get(void)
+{
+	return state;
+}
+
+void wifi_reconnect_stats_get(struct wifi_reconnect_stats *out)
+{
+	K_SPINLOCK(&lock) {
+		*out = stats;
+	}
+}
+
+void wifi_reconnect_stats_reset(void)
+{
+	K_SPINLOCK(&lock) {
+		memset(&stats, 0, sizeof(stats));
+	}
+}
+
+uint32_t wifi_reconnect_hist_edge_ms(size_t bucket)
+{
+	return bucket < ARRAY_SIZE(hist_edges_ms) ? hist_edges_ms[bucket] : UINT32_MAX;
+}
+
+static void forget_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	ap.valid = false;
+}
+
+static K_WORK_DEFINE(forget_work, forget_handler);
+
+void wifi_reconnect_forget(void)
+{
+	/* ap belongs to the work queue */
+	k_work_submit(&forget_work);
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+static int wifi_reconnect_init(void)
+{
+	net_mgmt_init_event_callback(&wifi_cb, wifi_event_cb, WIFI_EVENTS);
+	net_mgmt_add_event_callback(&wifi_cb);
+
+	LOG_DBG("Backoff %u..%u ms, targeted timeout %u ms",
+		CONFIG_APP_WIFI_RECONNECT_BACKOFF_BASE_MS,
+		CONFIG_APP_WIFI_RECONNECT_BACKOFF_MAX_MS,
+		CONFIG_APP_WIFI_RECONNECT_TARGETED_TIMEOUT_MS);
+
+	return 0;
+}
+
+SYS_INIT(wifi_reconnect_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_WIFI_RECONNECT_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct wifi_reconnect_stats s;
+	struct ap a = ap;	/* Snapshot; the work queue may update it */
+	uint32_t lo = 0;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	wifi_reconnect_stats_get(&s);
+
+	shell_print(sh, "state: %s", state_str(state));
+	if (a.valid) {
+		shell_print(sh, "remembered: %.*s %02x:%02x:%02x:%02x:%02x:%02x channel %u",
+			    a.ssid_len, a.ssid, a.bssid[0], a.bssid[1], a.bssid[2], a.bssid[3],
+			    a.bssid[4], a.bssid[5], a.channel);
+	} else {
+		shell_print(sh, "remembered: none (full scan)");
+	}
+	shell_print(sh, "outages %u, reconnects %u, backoff rounds %u", s.outages, s.reconnects,
+		    s.rounds);
+	shell_print(sh, "targeted ok %u failed %u, full scan ok %u failed %u, other %u",
+		    s.targeted_ok, s.targeted_failed, s.scan_ok, s.scan_failed, s.other_ok);
+	shell_print(sh, "time to reconnect: last %u ms, mean %u ms, max %u ms", s.last_ms,
+		    s.reconnects ? (uint32_t)(s.total_ms / s.reconnects) : 0, s.max_ms);
+
+	for (size_t b = 0; b < ARRAY_SIZE(hist_edges_ms); b++) {
+		if (hist_edges_ms[b] == UINT32_MAX) {
+			shell_print(sh, "  > %6u ms  %u", lo, s.hist[b]);
+		} else {
+			shell_print(sh, "  <= %5u ms  %u", hist_edges_ms[b], s.hist[b]);
+		}
+		lo = hist_edges_ms[b];
+	}
+
+	return 0;
+}
+
+static int cmd_forget(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	wifi_reconnect_forget();
+	shell_print(sh, "Forgot the access point, next round scans");
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	wifi_reconnect_stats_reset();
+	shell_print(sh, "Statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_wifi_rc,
+	SHELL_CMD(show, NULL, "State, remembered AP and time-to-reconnect histogram", cmd_show),
+	SHELL_CMD(forget, NULL, "Forget the remembered AP", cmd_forget),
+	SHELL_CMD(reset, NULL, "Reset statistics", cmd_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(wifi_rc, &sub_wifi_rc, "Wi-Fi reconnect manager", NULL);
+
+#endif /* CONFIG_APP_WIFI_RECONNECT_SHELL */
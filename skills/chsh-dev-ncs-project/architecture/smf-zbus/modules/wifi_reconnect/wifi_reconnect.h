@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _WIFI_RECONNECT_H_
+#define _WIFI_RECONNECT_H_
+
+/**
+ * @file wifi_reconnect.h
+ * @brief Wi-Fi reconnect manager: targeted connect first, jittered backoff
+ *
+ * After every successful connection the BSSID, channel and band of the
+ * access point are kept. When the link drops, a reconnect round starts:
+ *
+ * 1. Connect to the remembered BSSID on its channel. The supplicant
+ *    scans that one channel instead of the whole band.
+ * 2. If that fails, connect with the stored credentials (full scan).
+ * 3. If that fails too, wait and start the next round. The wait doubles
+ *    each round up to CONFIG_APP_WIFI_RECONNECT_BACKOFF_MAX_MS and is
+ *    randomized over its upper half, so devices that lost the same
+ *    router do not come back in lockstep.
+ *
+ * Time from disconnect to connect is kept in a histogram. Disconnects
+ * the application asked for do not start a round.
+ *
+ * On native_sim without Wi-Fi, wifi_reconnect_mock.c stands in for the
+ * Wi-Fi management layer so outages and channel changes can be replayed
+ * from the shell.
+ */
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Histogram buckets; upper edges in wifi_reconnect_hist_edge_ms() */
+#define WIFI_RECONNECT_HIST_BUCKETS 8
+
+/** Manager state */
+enum wifi_reconnect_state {
+	WIFI_RECONNECT_CONNECTED,	/* Or never connected yet */
+	WIFI_RECONNECT_TARGETED,	/* Connecting to the remembered BSSID */
+	WIFI_RECONNECT_SCANNING,	/* Connecting with a full scan */
+	WIFI_RECONNECT_BACKOFF,		/* Waiting for the next round */
+	WIFI_RECONNECT_PAUSED,		/* Disconnected on request */
+};
+
+/** Statistics since boot or the last reset */
+struct wifi_reconnect_stats {
+	uint32_t outages;		/* Disconnects that started a round */
+	uint32_t reconnects;		/* Outages that ended */
+	uint32_t targeted_ok;
+	uint32_t targeted_failed;
+	uint32_t scan_ok;
+	uint32_t scan_failed;
+	uint32_t other_ok;		/* Connected by someone else, e.g. a shell command */
+	uint32_t rounds;		/* Rounds that ended in backoff */
+	uint32_t last_ms;		/* Time to reconnect, last outage */
+	uint32_t max_ms;
+	uint64_t total_ms;
+	uint32_t hist[WIFI_RECONNECT_HIST_BUCKETS];
+};
+
+/**
+ * @brief Get the current state
+ */
+enum wifi_reconnect_state wifi_reconnect_state_get(void);
+
+/**
+ * @brief Get the statistics
+ */
+void wifi_reconnect_stats_get(struct wifi_reconnect_stats *stats);
+
+/**
+ * @brief Reset the statistics
+ */
+void wifi_reconnect_stats_reset(void);
+
+/**
+ * @brief Upper edge of a histogram bucket
+ *
+ * @return Milliseconds, UINT32_MAX for the last bucket
+ */
+uint32_t wifi_reconnect_hist_edge_ms(size_t bucket);
+
+/**
+ * @brief Forget the remembered access point
+ *
+ * The next round goes straight to the full scan. Use after changing
+ * credentials.
+ */
+void wifi_reconnect_forget(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _WIFI_RECONNECT_H_ */
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file wifi_reconnect_mock.c
+ * @brief Simulated access point behind the Wi-Fi net_mgmt requests
+ *
+ * Built on native_sim when no Wi-Fi management layer is present. It
+ * implements the requests wifi_reconnect.c issues (connect, connect
+ * stored, interface status, disconnect) and raises the same
+ * NET_EVENT_WIFI_* events a driver would, so the reconnect manager runs
+ * unmodified. The "wifi_mock" shell command takes the access point down,
+ * moves it to another channel or drops the link.
+ *
+ * Connect times model an nRF70 roughly: a full 2.4 + 5 GHz scan takes
+ * seconds, a single-channel probe a few hundred milliseconds.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/wifi.h>
+#include <zephyr/net/wifi_mgmt.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+LOG_MODULE_DECLARE(wifi_reconnect, CONFIG_APP_WIFI_RECONNECT_LOG_LEVEL);
+
+#define MOCK_SSID "mock-ap"
+#define MOCK_SCAN_MS 2600
+#define MOCK_TARGETED_MS 350
+#define MOCK_BOOT_DELAY_MS 100
+
+static const uint8_t mock_bssid[WIFI_MAC_ADDR_LEN] = { 0xf4, 0xce, 0x36, 0x00, 0x00, 0x01 };
+
+static struct {
+	bool up;		/* Beaconing */
+	uint8_t channel;
+	bool associated;
+	bool connecting;
+	uint8_t want_channel;	/* Of the connect in progress, WIFI_CHANNEL_ANY for a scan */
+} mock = {
+	.up = true,
+	.channel = 6,
+};
+
+static K_MUTEX_DEFINE(mock_lock);
+
+static void result_handler(struct k_work *work);
+static void ap_up_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(result_work, result_handler);
+static K_WORK_DELAYABLE_DEFINE(ap_up_work, ap_up_handler);
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static void notify(uint64_t event, int status)
+{
+	struct wifi_status st = { .status = status };
+
+	net_mgmt_event_notify_with_info(event, net_if_get_default(), &st, sizeof(st));
+}
+
+static void result_handler(struct k_work *work)
+{
+	bool ok;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&mock_lock, K_FOREVER);
+	ok = mock.up && (mock.want_channel == WIFI_CHANNEL_ANY ||
+			 mock.want_channel == mock.channel);
+	mock.connecting = false;
+	mock.associated = ok;
+	k_mutex_unlock(&mock_lock);
+
+	notify(NET_EVENT_WIFI_CONNECT_RESULT, ok ? WIFI_STATUS_CONN_SUCCESS :
+						   WIFI_STATUS_CONN_AP_NOT_FOUND);
+}
+
+static void ap_up_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&mock_lock, K_FOREVER);
+	mock.up = true;
+	k_mutex_unlock(&mock_lock);
+
+	LOG_INF("mock: AP up on channel %u", mock.channel);
+}
+
+static int start_connect(uint8_t channel, uint32_t ms)
+{
+	int err = 0;
+
+	k_mutex_lock(&mock_lock, K_FOREVER);
+	if (mock.connecting || mock.associated) {
+		err = -EALREADY;
+	} else {
+		mock.connecting = true;
+		mock.want_channel = channel;
+		k_work_reschedule(&result_work, K_MSEC(ms));
+	}
+	k_mutex_unlock(&mock_lock);
+
+	return err;
+}
+
+/* Lock held */
+static void link_drop(int reason)
+{
+	if (mock.associated) {
+		mock.associated = false;
+		notify(NET_EVENT_WIFI_DISCONNECT_RESULT, reason);
+	}
+}
+
+/*******************************************************************************
+ * net_mgmt Requests
+ ******************************************************************************/
+
+static int mock_connect(uint64_t req, struct net_if *iface, void *data, size_t len)
+{
+	const struct wifi_connect_req_params *p = data;
+
+	ARG_UNUSED(req);
+	ARG_UNUSED(iface);
+
+	if (!p || len != sizeof(*p)) {
+		return -EINVAL;
+	}
+
+	if (p->ssid_length != strlen(MOCK_SSID) || memcmp(p->ssid, MOCK_SSID, p->ssid_length)) {
+		/* Unknown network: scans everything, channel 0 never matches */
+		return start_connect(0, MOCK_SCAN_MS);
+	}
+
+	if (p->channel != WIFI_CHANNEL_ANY) {
+		return start_connect(p->channel, MOCK_TARGETED_MS);
+	}
+
+	return start_connect(WIFI_CHANNEL_ANY, MOCK_SCAN_MS);
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_CONNECT, mock_connect);
+
+static int mock_connect_stored(uint64_t req, struct net_if *iface, void *data, size_t len)
+{
+	ARG_UNUSED(req);
+	ARG_UNUSED(iface);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return start_connect(WIFI_CHANNEL_ANY, MOCK_SCAN_MS);
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_CONNECT_STORED, mock_connect_stored);
+
+static int mock_disconnect(uint64_t req, struct net_if *iface, void *data, size_t len)
+{
+	ARG_UNUSED(req);
+	ARG_UNUSED(iface);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	k_mutex_lock(&mock_lock, K_FOREVER);
+	if (mock.connecting) {
+		/* Cancels the attempt in progress, without a result */
+		mock.connecting = false;
+		k_work_cancel_delayable(&result_work);
+	}
+	link_drop(WIFI_REASON_DISCONN_USER_REQUEST);
+	k_mutex_unlock(&mock_lock);
+
+	return 0;
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_DISCONNECT, mock_disconnect);
+
+static int mock_iface_status(uint64_t req, struct net_if *iface, void *data, size_t len)
+{
+	struct wifi_iface_status *st = data;
+
+	ARG_UNUSED(req);
+	ARG_UNUSED(iface);
+
+	if (!st || len != sizeof(*st)) {
+		return -EINVAL;
+	}
+
+	memset(st, 0, sizeof(*st));
+
+	k_mutex_lock(&mock_lock, K_FOREVER);
+	if (mock.associated) {
+		st->state = WIFI_STATE_COMPLETED;
+		st->ssid_len = strlen(MOCK_SSID);
+		memcpy(st->ssid, MOCK_SSID, st->ssid_len);
+		memcpy(st->bssid, mock_bssid, sizeof(mock_bssid));
+		st->band = WIFI_FREQ_BAND_2_4_GHZ;
+		st->channel = mock.channel;
+		st->security = WIFI_SECURITY_TYPE_NONE;
+		st->rssi = -55;
+	} else {
+		st->state = mock.connecting ? WIFI_STATE_SCANNING : WIFI_STATE_DISCONNECTED;
+	}
+	k_mutex_unlock(&mock_lock);
+
+	return 0;
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_WIFI_IFACE_STATUS, mock_iface_status);
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+/* Stands in for the connection manager's auto-connect at boot */
+static int wifi_reconnect_mock_init(void)
+{
+	k_mutex_lock(&mock_lock, K_FOREVER);
+	mock.connecting = true;
+	mock.want_channel = WIFI_CHANNEL_ANY;
+	k_work_reschedule(&result_work, K_MSEC(MOCK_BOOT_DELAY_MS + MOCK_SCAN_MS));
+	k_mutex_unlock(&mock_lock);
+
+	return 0;
+}
+
+SYS_INIT(wifi_reconnect_mock_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_SHELL
+
+static int cmd_down(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t ms = strtoul(argv[1], NULL, 10);
+
+	ARG_UNUSED(argc);
+
+	k_mutex_lock(&mock_lock, K_FOREVER);
+	mock.up = false;
+	link_drop(WIFI_REASON_DISCONN_AP_LEAVING);
+	k_work_reschedule(&ap_up_work, K_MSEC(ms));
+	k_mutex_unlock(&mock_lock);
+
+	shell_print(sh, "AP down for %u ms", ms);
+
+	return 0;
+}
+
+static int cmd_move(const struct shell *sh, size_t argc, char **argv)
+{
+	uint8_t channel = strtoul(argv[1], NULL, 10);
+
+	ARG_UNUSED(argc);
+
+	k_mutex_lock(&mock_lock, K_FOREVER);
+	mock.channel = channel;
+	link_drop(WIFI_REASON_DISCONN_AP_LEAVING);
+	k_mutex_unlock(&mock_lock);
+
+	shell_print(sh, "AP now on channel %u", channel);
+
+	return 0;
+}
+
+static int cmd_drop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_mutex_lock(&mock_lock, K_FOREVER);
+	link_drop(WIFI_REASON_DISCONN_INACTIVITY);
+	k_mutex_unlock(&mock_lock);
+
+	shell_print(sh, "Link dropped, AP still up");
+
+	return 0;
+}
+
+static int cmd_status(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "AP %s on channel %u, station %s", mock.up ? "up" : "down",
+		    mock.channel, mock.associated ? "associated" :
+		    mock.connecting ? "connecting" : "disconnected");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_wifi_mock,
+	SHELL_CMD_ARG(down, NULL, "Take the AP down: down <ms>", cmd_down, 2, 0),
+	SHELL_CMD_ARG(move, NULL, "Move the AP: move <channel>", cmd_move, 2, 0),
+	SHELL_CMD(drop, NULL, "Drop the link, AP stays up", cmd_drop),
+	SHELL_CMD(status, NULL, "Simulated AP and station state", cmd_status),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(wifi_mock, &sub_wifi_mock, "Simulated access point", NULL);
+
+#endif /* CONFIG_SHELL */
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file zbus_lanes.c
+ * @brief Priority lanes for zbus message subscribers
+ *
+ * This module demonstrates:
+ * - Listener-based message copy into per-lane FIFOs
+ * - Strict priority dequeue with k_poll() over several FIFOs
+ * - Per-lane depth and enqueue-to-dequeue wait statistics
+ * - Last-value-wins coalescing of status channels in the queue
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+
+#include "zbus_lanes.h"
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+#include "zbus_trace.h"
+#endif
+
+LOG_MODULE_REGISTER(zbus_lanes, CONFIG_APP_ZBUS_LANES_LOG_LEVEL);
+
+/* Stored in each buffer's user data */
+struct lane_meta {
+	const struct zbus_channel *chan;
+	const struct zbus_observer *obs;
+	struct zbus_lanes_slot *slot;
+	uint32_t enqueue_cycles;
+};
+
+NET_BUF_POOL_FIXED_DEFINE(zbus_lanes_pool, CONFIG_APP_ZBUS_LANES_POOL_SIZE,
+			  CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX,
+			  sizeof(struct lane_meta), NULL);
+
+static struct k_spinlock lock;
+
+static const char *const lane_names[ZBUS_LANE_COUNT] = {
+	[ZBUS_LANE_HIGH] = "HIGH",
+	[ZBUS_LANE_NORMAL] = "NORMAL",
+};
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+void zbus_lanes_enqueue(struct zbus_lanes *sub, enum zbus_lane lane,
+			const struct zbus_observer *obs,
+			struct zbus_lanes_slot *slot,
+			const struct zbus_channel *chan)
+{
+	struct zbus_lane_queue *q = &sub->lanes[lane];
+	struct lane_meta *meta;
+	struct net_buf *buf;
+	k_spinlock_key_t key;
+	size_t size = zbus_chan_msg_size(chan);
+	bool status = slot && (slot->is_status == NULL ||
+			       slot->is_status(zbus_chan_const_msg(chan)));
+
+	if (status) {
+		key = k_spin_lock(&lock);
+		if (slot->pending) {
+			/* Still queued: replace in place, keep its queue position */
+			memcpy(slot->pending->data, zbus_chan_const_msg(chan), size);
+			q->stats.coalesced++;
+			k_spin_unlock(&lock, key);
+			return;
+		}
+		k_spin_unlock(&lock, key);
+	}
+
+	buf = (size <= CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX) ?
+	      net_buf_alloc(&zbus_lanes_pool, K_NO_WAIT) : NULL;
+	if (buf == NULL) {
+		uint32_t dropped;
+
+		key = k_spin_lock(&lock);
+		dropped = ++q->stats.dropped;
+		k_spin_unlock(&lock, key);
+
+		/* The publisher sees success; warn on drop 1, 2, 4, 8, ... */
+		if (IS_POWER_OF_TWO(dropped)) {
+			if (size > CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX) {
+				LOG_WRN("%s %s: %zu-byte message dropped, lanes hold %d (%u drops)",
+					sub->name, lane_names[lane], size,
+					CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX, dropped);
+			} else {
+				LOG_WRN("%s %s: pool exhausted, message dropped (%u drops)",
+					sub->name, lane_names[lane], dropped);
+			}
+		}
+		return;
+	}
+
+	/* Listener runs with the channel locked, the message is stable */
+	net_buf_add_mem(buf, zbus_chan_const_msg(chan), size);
+
+	meta = net_buf_user_data(buf);
+	meta->chan = chan;
+	meta->obs = obs;
+	meta->slot = slot;
+	meta->enqueue_cycles = k_cycle_get_32();
+
+	key = k_spin_lock(&lock);
+	if (slot) {
+		/* A status queued behind another message must not be overtaken */
+		slot->pending = status ? buf : NULL;
+	}
+	q->stats.enqueued++;
+	q->stats.depth++;
+	q->stats.max_depth = MAX(q->stats.max_depth, q->stats.depth);
+	k_spin_unlock(&lock, key);
+
+	k_fifo_put(&q->fifo, buf);
+}
+
+static int lanes_get(struct zbus_lanes *sub, const struct zbus_channel **chan, void *msg)
+{
+	for (int lane = 0; lane < ZBUS_LANE_COUNT; lane++) {
+		struct zbus_lane_queue *q = &sub->lanes[lane];
+		struct lane_meta *meta;
+		struct net_buf *buf;
+		k_spinlock_key_t key;
+		uint32_t us;
+
+		buf = k_fifo_get(&q->fifo, K_NO_WAIT);
+		if (buf == NULL) {
+			continue;
+		}
+
+		meta = net_buf_user_data(buf);
+		us = k_cyc_to_us_floor32(k_cycle_get_32() - meta->enqueue_cycles);
+
+		key = k_spin_lock(&lock);
+		q->stats.dequeued++;
+		q->stats.depth--;
+		q->stats.wait_total_us += us;
+		q->stats.wait_max_us = MAX(q->stats.wait_max_us, us);
+
+		/* Copy under the lock so a coalescing publish can't tear it */
+		if (meta->slot && meta->slot->pending == buf) {
+			meta->slot->pending = NULL;
+		}
+		memcpy(msg, buf->data, buf->len);
+		k_spin_unlock(&lock, key);
+
+		*chan = meta->chan;
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+		zbus_trace_dispatch(meta->obs, meta->chan, msg);
+#endif
+
+		net_buf_unref(buf);
+
+		return 0;
+	}
+
+	return -ENOMSG;
+}
+
+int zbus_lanes_wait_msg(struct zbus_lanes *sub, const struct zbus_channel **chan,
+			void *msg, k_timeout_t timeout)
+{
+	struct k_poll_event events[ZBUS_LANE_COUNT];
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int err;
+
+	while (1) {
+		if (lanes_get(sub, chan, msg) == 0) {
+			return 0;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		for (int lane = 0; lane < ZBUS_LANE_COUNT; lane++) {
+			k_poll_event_init(&events[lane], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+					  K_POLL_MODE_NOTIFY_ONLY, &sub->lanes[lane].fifo);
+		}
+
+		err = k_poll(events, ARRAY_SIZE(events), sys_timepoint_timeout(end));
+		if (err == -EAGAIN) {
+			return -EAGAIN;
+		}
+	}
+}
+
+bool zbus_lanes_pending(struct zbus_lanes *sub)
+{
+	for (int lane = 0; lane < ZBUS_LANE_COUNT; lane++) {
+		if (!k_fifo_is_empty(&sub->lanes[lane].fifo)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void zbus_lanes_stats_get(struct zbus_lanes *sub, enum zbus_lane lane,
+			  struct zbus_lane_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = sub->lanes[lane].stats;
+
+	k_spin_unlock(&lock, key);
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+/* Catch channels too large for a lane buffer at boot, not at the first drop */
+static int zbus_lanes_check(void)
+{
+	int err = 0;
+
+	STRUCT_SECTION_FOREACH(zbus_lanes_obs, o) {
+		size_t size = zbus_chan_msg_size(o->chan);
+
+		if (size > CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX) {
+			LOG_ERR("%s observes %s: %zu-byte messages, "
+				"CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX is %d",
+				o->sub->name, o->chan_name, size,
+				CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX);
+			err = -EMSGSIZE;
+		}
+	}
+
+	__ASSERT(err == 0, "zbus_lanes: observed channel larger than a lane buffer");
+
+	return err;
+}
+
+SYS_INIT(zbus_lanes_check, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_ZBUS_LANES_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct zbus_lane_stats s;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-20s %-6s %6s %6s %8s %8s %7s %9s %8s %8s",
+		    "subscriber", "lane", "depth", "max", "enq", "deq",
+		    "dropped", "coalesced", "wait_avg", "wait_max");
+
+	STRUCT_SECTION_FOREACH(zbus_lanes, sub) {
+		for (int lane = 0; lane < ZBUS_LANE_COUNT; lane++) {
+			zbus_lanes_stats_get(sub, lane, &s);
+			shell_print(sh, "%-20s %-6s %6u %6u %8u %8u %7u %9u %8u %8u",
+				    sub->name, lane_names[lane], s.depth, s.max_depth,
+				    s.enqueued, s.dequeued, s.dropped, s.coalesced,
+				    s.dequeued ? (uint32_t)(s.wait_total_us / s.dequeued) : 0,
+				    s.wait_max_us);
+		}
+	}
+
+	shell_print(sh, "Wait times in us, pool %d x %d bytes",
+		    CONFIG_APP_ZBUS_LANES_POOL_SIZE, CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX);
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	key = k_spin_lock(&lock);
+	STRUCT_SECTION_FOREACH(zbus_lanes, sub) {
+		for (int lane = 0; lane < ZBUS_LANE_COUNT; lane++) {
+			struct zbus_lane_stats *s = &sub->lanes[lane].stats;
+			uint32_t depth = s->depth;
+
+			memset(s, 0, sizeof(*s));
+			s->depth = depth;
+			s->max_depth = depth;
+		}
+	}
+	k_spin_unlock(&lock, key);
+
+	shell_print(sh, "Lane statistics cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_zbus_lanes,
+	SHELL_CMD(show, NULL, "Per-lane depth and wait time", cmd_show),
+	SHELL_CMD(reset, NULL, "Clear statistics", cmd_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(zbus_lanes, &sub_zbus_lanes, "zbus subscriber priority lanes", NULL);
+
+#endif /* CONFIG_APP_ZBUS_LANES_SHELL */
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _ZBUS_LANES_H_
+#define _ZBUS_LANES_H_
+
+/**
+ * @file zbus_lanes.h
+ * @brief Priority lanes for zbus message subscribers
+ *
+ * A drop-in alternative to ZBUS_MSG_SUBSCRIBER_DEFINE() with one queue per
+ * priority lane. The lane is chosen per observed channel when the
+ * observation is added, and zbus_lanes_wait_msg() always drains the HIGH
+ * lane before the NORMAL lane:
+ *
+ * @code
+ * ZBUS_LANES_SUBSCRIBER_DEFINE(module_template_sub);
+ * ZBUS_LANES_CHAN_ADD_OBS(BUTTON_CHAN, module_template_sub, HIGH, 0);
+ * ZBUS_LANES_CHAN_ADD_OBS(SENSOR_CHAN, module_template_sub, NORMAL, 0);
+ *
+ * err = zbus_lanes_wait_msg(&module_template_sub, &chan, msg_buf, K_FOREVER);
+ * @endcode
+ *
+ * Each lane is a zbus listener that copies the message into a net_buf
+ * from a shared pool, so routing costs nothing at run time and urgent
+ * messages never queue behind bulk traffic. Ordering is preserved within
+ * a lane, not across lanes.
+ *
+ * Status channels where only the latest value matters can be observed with
+ * ZBUS_LANES_CHAN_ADD_OBS_LATEST() instead: while a message of that channel
+ * is still queued, a new publish overwrites it in place rather than taking
+ * another buffer (last value wins). With ZBUS_LANES_CHAN_ADD_OBS_LATEST_IF()
+ * only the messages a filter accepts coalesce, so BUTTON_IDLE updates collapse
+ * while presses on the same channel all queue. Plain message subscribers get
+ * the same from zbus_latest.h.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Lanes in dequeue order */
+enum zbus_lane {
+	ZBUS_LANE_HIGH,
+	ZBUS_LANE_NORMAL,
+	ZBUS_LANE_COUNT,
+};
+
+/**
+ * @brief Per-lane statistics
+ */
+struct zbus_lane_stats {
+	uint32_t enqueued;
+	uint32_t dequeued;
+	uint32_t dropped;	/* Pool exhausted or message too large */
+	uint32_t coalesced;	/* Overwrote a still-queued message in place */
+	uint32_t depth;		/* Currently queued */
+	uint32_t max_depth;
+	uint32_t wait_max_us;	/* Longest enqueue-to-dequeue time */
+	uint64_t wait_total_us;
+};
+
+/** Queued-message slot of one last-value-wins observation */
+struct zbus_lanes_slot {
+	struct net_buf *pending;		/* Newest queued message, if a status */
+	bool (*is_status)(const void *msg);	/* NULL: every message is a status */
+};
+
+/** Channel observed through a lane, checked against the buffer size at boot (ROM) */
+struct zbus_lanes_obs {
+	const struct zbus_channel *chan;
+	const char *chan_name;
+	const struct zbus_lanes *sub;
+};
+
+/** One lane of a subscriber */
+struct zbus_lane_queue {
+	struct k_fifo fifo;
+	struct zbus_lane_stats stats;
+};
+
+/**
+ * @brief Lanes subscriber
+ *
+ * Define with ZBUS_LANES_SUBSCRIBER_DEFINE().
+ */
+struct zbus_lanes {
+	const char *name;
+	struct zbus_lane_queue lanes[ZBUS_LANE_COUNT];
+};
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_ZBUS_LANE_INIT(_name, _lane)							\
+	[_lane] = { .fifo = Z_FIFO_INITIALIZER(_name.lanes[_lane].fifo) }
+
+#define Z_ZBUS_LANE_LISTENER_DEFINE(_name, _lane)					\
+	ZBUS_OBS_DECLARE(_CONCAT(_name, _##_lane));					\
+	static void _CONCAT(_CONCAT(_name, _##_lane), _cb)(const struct zbus_channel *chan) \
+	{										\
+		zbus_lanes_enqueue(&_name, ZBUS_LANE_##_lane,				\
+				   &_CONCAT(_name, _##_lane), NULL, chan);		\
+	}										\
+	ZBUS_LISTENER_DEFINE(_CONCAT(_name, _##_lane),					\
+			     _CONCAT(_CONCAT(_name, _##_lane), _cb))
+
+#define Z_ZBUS_LANES_OBS_ENTRY(_chan, _name, _entry)					\
+	static const STRUCT_SECTION_ITERABLE(zbus_lanes_obs, _entry) = {		\
+		.chan = &_chan,								\
+		.chan_name = STRINGIFY(_chan),						\
+		.sub = &_name,								\
+	}
+/** @endcond */
+
+/**
+ * @brief Define a subscriber with HIGH and NORMAL lanes
+ *
+ * Also defines the listeners <_name>_HIGH and <_name>_NORMAL that
+ * ZBUS_LANES_CHAN_ADD_OBS() attaches to channels.
+ *
+ * @param _name Subscriber name
+ */
+#define ZBUS_LANES_SUBSCRIBER_DEFINE(_name)						\
+	STRUCT_SECTION_ITERABLE(zbus_lanes, _name) = {					\
+		.name = STRINGIFY(_name),						\
+		.lanes = {								\
+			Z_ZBUS_LANE_INIT(_name, ZBUS_LANE_HIGH),			\
+			Z_ZBUS_LANE_INIT(_name, ZBUS_LANE_NORMAL),			\
+		},									\
+	};										\
+	Z_ZBUS_LANE_LISTENER_DEFINE(_name, HIGH);					\
+	Z_ZBUS_LANE_LISTENER_DEFINE(_name, NORMAL)
+
+/**
+ * @brief Observe a channel on one lane of a lanes subscriber
+ *
+ * @param _chan Channel to observe
+ * @param _name Lanes subscriber (ZBUS_LANES_SUBSCRIBER_DEFINE name)
+ * @param _lane HIGH or NORMAL
+ * @param _prio Observer priority, as for ZBUS_CHAN_ADD_OBS()
+ */
+#define ZBUS_LANES_CHAN_ADD_OBS(_chan, _name, _lane, _prio)				\
+	Z_ZBUS_LANES_OBS_ENTRY(_chan, _name,						\
+			       _CONCAT(_CONCAT(_CONCAT(_name, _), _chan), _size));		\
+	ZBUS_CHAN_ADD_OBS(_chan, _CONCAT(_name, _##_lane), _prio)
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_ZBUS_LANES_LATEST_OBS(_chan, _name)						\
+	_CONCAT(_CONCAT(_CONCAT(_name, _), _chan), _latest)
+
+#define Z_ZBUS_LANES_CHAN_ADD_OBS_LATEST(_chan, _name, _lane, _prio, _is_status)	\
+	static struct zbus_lanes_slot _CONCAT(Z_ZBUS_LANES_LATEST_OBS(_chan, _name), _slot) = { \
+		.is_status = _is_status,						\
+	};										\
+	ZBUS_OBS_DECLARE(Z_ZBUS_LANES_LATEST_OBS(_chan, _name));			\
+	static void _CONCAT(Z_ZBUS_LANES_LATEST_OBS(_chan, _name), _cb)(		\
+		const struct zbus_channel *chan)					\
+	{										\
+		zbus_lanes_enqueue(&_name, ZBUS_LANE_##_lane,				\
+				   &Z_ZBUS_LANES_LATEST_OBS(_chan, _name),		\
+				   &_CONCAT(Z_ZBUS_LANES_LATEST_OBS(_chan, _name), _slot), \
+				   chan);						\
+	}										\
+	ZBUS_LISTENER_DEFINE(Z_ZBUS_LANES_LATEST_OBS(_chan, _name),			\
+			     _CONCAT(Z_ZBUS_LANES_LATEST_OBS(_chan, _name), _cb));	\
+	Z_ZBUS_LANES_OBS_ENTRY(_chan, _name,						\
+			       _CONCAT(Z_ZBUS_LANES_LATEST_OBS(_chan, _name), _size));	\
+	ZBUS_CHAN_ADD_OBS(_chan, Z_ZBUS_LANES_LATEST_OBS(_chan, _name), _prio)
+/** @endcond */
+
+/**
+ * @brief Observe a status channel on one lane, last value wins
+ *
+ * At most one message of @p _chan is queued for @p _name at any time;
+ * publishes while it is queued replace its content and are counted as
+ * coalesced. Use for state/status channels, never for event channels
+ * where every message matters (button presses, commands with payload).
+ *
+ * @param _chan Channel to observe
+ * @param _name Lanes subscriber (ZBUS_LANES_SUBSCRIBER_DEFINE name)
+ * @param _lane HIGH or NORMAL
+ * @param _prio Observer priority, as for ZBUS_CHAN_ADD_OBS()
+ */
+#define ZBUS_LANES_CHAN_ADD_OBS_LATEST(_chan, _name, _lane, _prio)			\
+	Z_ZBUS_LANES_CHAN_ADD_OBS_LATEST(_chan, _name, _lane, _prio, NULL)
+
+/**
+ * @brief Observe a channel on one lane, last value wins for status messages
+ *
+ * Like ZBUS_LANES_CHAN_ADD_OBS_LATEST(), but only messages @p _is_status
+ * accepts coalesce, and only into a status message that is the newest one
+ * of @p _chan still queued. Every other message queues as usual.
+ *
+ * @param _chan Channel to observe
+ * @param _name Lanes subscriber (ZBUS_LANES_SUBSCRIBER_DEFINE name)
+ * @param _lane HIGH or NORMAL
+ * @param _prio Observer priority, as for ZBUS_CHAN_ADD_OBS()
+ * @param _is_status bool (*)(const void *msg), called in the publisher's context
+ */
+#define ZBUS_LANES_CHAN_ADD_OBS_LATEST_IF(_chan, _name, _lane, _prio, _is_status)	\
+	Z_ZBUS_LANES_CHAN_ADD_OBS_LATEST(_chan, _name, _lane, _prio, _is_status)
+
+/**
+ * @brief Queue a message on a lane (called by the lane listeners)
+ *
+ * Runs in the publisher's context. Drops the message, counts it and logs a
+ * warning when the buffer pool is exhausted or the message is larger than
+ * CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX; the publish itself still succeeds.
+ * With a @p slot, a message still queued through the same slot is
+ * overwritten instead.
+ */
+void zbus_lanes_enqueue(struct zbus_lanes *sub, enum zbus_lane lane,
+			const struct zbus_observer *obs,
+			struct zbus_lanes_slot *slot,
+			const struct zbus_channel *chan);
+
+/**
+ * @brief Wait for the next message, highest lane first
+ *
+ * Same contract as zbus_sub_wait_msg(). With CONFIG_APP_ZBUS_TRACE the
+ * zbus_trace dispatch hook is called here, per lane listener.
+ *
+ * @param sub Lanes subscriber
+ * @param chan Output channel the message came from
+ * @param msg Output buffer, at least the size of the largest observed message
+ * @param timeout How long to wait
+ * @return 0 on success, -ENOMSG (K_NO_WAIT) or -EAGAIN when nothing arrived
+ */
+int zbus_lanes_wait_msg(struct zbus_lanes *sub, const struct zbus_channel **chan,
+			void *msg, k_timeout_t timeout);
+
+/**
+ * @brief Check whether any lane has a queued message
+ */
+bool zbus_lanes_pending(struct zbus_lanes *sub);
+
+/**
+ * @brief Get a copy of one lane's statistics
+ */
+void zbus_lanes_stats_get(struct zbus_lanes *sub, enum zbus_lane lane,
+			  struct zbus_lane_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ZBUS_LANES_H_ */
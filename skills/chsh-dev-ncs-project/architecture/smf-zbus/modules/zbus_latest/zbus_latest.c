@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file zbus_latest.c
+ * @brief Last-value-wins observation of status channels for message subscribers
+ *
+ * This module demonstrates:
+ * - Per-publish notification masks decided by a listener ahead of the subscriber
+ * - Handing the channel's current value to the subscriber at receive time
+ * - Per-observation delivered/coalesced counters over the shell
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+
+#include "zbus_latest.h"
+
+LOG_MODULE_REGISTER(zbus_latest, CONFIG_APP_ZBUS_LATEST_LOG_LEVEL);
+
+static struct k_spinlock lock;
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+void zbus_latest_gate(const struct zbus_latest *latest, const struct zbus_channel *chan)
+{
+	struct zbus_latest_data *data = latest->data;
+	bool status = latest->is_status == NULL || latest->is_status(zbus_chan_const_msg(chan));
+	k_spinlock_key_t key;
+	bool hold;
+
+	key = k_spin_lock(&lock);
+
+	/*
+	 * A message we let through can still be lost when the subscriber
+	 * buffer pool is empty. An empty queue proves nothing is pending.
+	 */
+	if (k_fifo_is_empty(latest->sub->message_fifo)) {
+		data->queued = 0;
+	}
+
+	hold = status && data->last_status && data->queued > 0;
+	if (hold) {
+		data->held = true;
+		data->coalesced++;
+	} else {
+		data->queued++;
+		data->last_status = status;
+		data->held = false;
+		data->delivered++;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	/* Takes effect for this publish: zbus checks the mask after we return */
+	(void)zbus_obs_set_chan_notification_mask(latest->sub, chan, hold);
+}
+
+void zbus_latest_received(const struct zbus_observer *sub, const struct zbus_channel *chan,
+			  void *msg)
+{
+	STRUCT_SECTION_FOREACH(zbus_latest, latest) {
+		struct zbus_latest_data *data = latest->data;
+		k_spinlock_key_t key;
+		bool refresh;
+
+		if (latest->sub != sub || latest->chan != chan) {
+			continue;
+		}
+
+		key = k_spin_lock(&lock);
+		if (data->queued > 0) {
+			data->queued--;
+		}
+		refresh = data->queued == 0 && data->held;
+		data->held = false;
+		k_spin_unlock(&lock, key);
+
+		/*
+		 * Newest queued message of the channel with publishes held back
+		 * behind it: hand over the current value instead. A publish in
+		 * progress (channel busy) is not held back, it arrives next.
+		 */
+		if (refresh && zbus_chan_claim(chan, K_NO_WAIT) == 0) {
+			const void *cur = zbus_chan_const_msg(chan);
+
+			if (latest->is_status == NULL || latest->is_status(cur)) {
+				memcpy(msg, cur, zbus_chan_msg_size(chan));
+			}
+			(void)zbus_chan_finish(chan);
+		}
+
+		return;
+	}
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+/* Catch a subscriber that does not observe the channel at boot */
+static int zbus_latest_init(void)
+{
+	int err = 0;
+
+	STRUCT_SECTION_FOREACH(zbus_latest, latest) {
+		if (latest->sub->type != ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE) {
+			LOG_ERR("%s is not a message subscriber", latest->sub_name);
+			err = -EINVAL;
+			continue;
+		}
+
+		if (zbus_obs_set_chan_notification_mask(latest->sub, latest->chan, false)) {
+			LOG_ERR("%s does not observe %s", latest->sub_name, latest->chan_name);
+			err = -ESRCH;
+		}
+	}
+
+	__ASSERT(err == 0, "zbus_latest: invalid observation");
+
+	return err;
+}
+
+SYS_INIT(zbus_latest_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_ZBUS_LATEST_SHELL
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct zbus_latest_data d;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-20s %-20s %6s %9s %9s", "subscriber", "channel",
+		    "queued", "delivered", "coalesced");
+
+	STRUCT_SECTION_FOREACH(zbus_latest, latest) {
+		key = k_spin_lock(&lock);
+		d = *latest->data;
+		k_spin_unlock(&lock, key);
+
+		shell_print(sh, "%-20s %-20s %6u %9u %9u", latest->sub_name,
+			    latest->chan_name, d.queued, d.delivered, d.coalesced);
+	}
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	key = k_spin_lock(&lock);
+	STRUCT_SECTION_FOREACH(zbus_latest, latest) {
+		latest->data->delivered = 0;
+		latest->data->coalesced = 0;
+	}
+	k_spin_unlock(&lock, key);
+
+	shell_print(sh, "Coalescing statistics cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_zbus_latest,
+	SHELL_CMD(show, NULL, "Delivered and coalesced per observation", cmd_show),
+	SHELL_CMD(reset, NULL, "Clear statistics", cmd_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(zbus_latest, &sub_zbus_latest, "zbus last-value-wins observers", NULL);
+
+#endif /* CONFIG_APP_ZBUS_LATEST_SHELL */
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _ZBUS_LATEST_H_
+#define _ZBUS_LATEST_H_
+
+/**
+ * @file zbus_latest.h
+ * @brief Last-value-wins observation of status channels for message subscribers
+ *
+ * zbus queues a copy of every publish into a ZBUS_MSG_SUBSCRIBER_DEFINE()
+ * subscriber, even on status channels where only the current value
+ * matters. Observe those with ZBUS_LATEST_CHAN_ADD_OBS() instead of
+ * ZBUS_CHAN_ADD_OBS(), and report every received message:
+ *
+ * @code
+ * ZBUS_MSG_SUBSCRIBER_DEFINE(sensor);
+ * ZBUS_LATEST_CHAN_ADD_OBS_IF(SENSOR_CHAN, sensor, 0, sensor_msg_is_idle);
+ *
+ * err = zbus_sub_wait_msg(&sensor, &chan, msg_buf, K_FOREVER);
+ * if (err == 0) {
+ *	zbus_latest_received(&sensor, chan, msg_buf);
+ * }
+ * @endcode
+ *
+ * A gate listener runs right before the subscriber on every publish.
+ * While a status message of the channel is still queued for the
+ * subscriber, it masks the subscriber's notification, so the publish
+ * takes no buffer and counts as coalesced. When the queued message is
+ * received, zbus_latest_received() replaces it with the channel's current
+ * value: the subscriber sees the latest status, once.
+ *
+ * With a filter (..._IF), only messages it accepts coalesce. The others
+ * (button presses, samples, commands) always queue, and a status message
+ * never replaces one queued ahead of them.
+ *
+ * Without CONFIG_APP_ZBUS_LATEST the macros add plain observations and
+ * zbus_latest_received() does nothing, so modules need no #ifdef.
+ * zbus_lanes subscribers use ZBUS_LANES_CHAN_ADD_OBS_LATEST() instead.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Tells status messages, which coalesce, from messages that must all be delivered
+ */
+typedef bool (*zbus_latest_filter_t)(const void *msg);
+
+#ifdef CONFIG_APP_ZBUS_LATEST
+
+/** Runtime data of one observation (RAM) */
+struct zbus_latest_data {
+	uint16_t queued;	/* Messages of the channel queued for the subscriber */
+	bool last_status;	/* The newest of them is a status message */
+	bool held;		/* Publishes were held back since it was queued */
+	uint32_t delivered;
+	uint32_t coalesced;
+};
+
+/**
+ * @brief Last-value-wins observation (ROM)
+ *
+ * Define with ZBUS_LATEST_CHAN_ADD_OBS() or ZBUS_LATEST_CHAN_ADD_OBS_IF().
+ */
+struct zbus_latest {
+	const struct zbus_channel *chan;
+	const struct zbus_observer *sub;
+	const char *chan_name;
+	const char *sub_name;
+	zbus_latest_filter_t is_status;
+	struct zbus_latest_data *data;
+};
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_ZBUS_LATEST_NAME(_chan, _sub)							\
+	_CONCAT(_CONCAT(_CONCAT(_sub, _), _chan), _latest)
+
+/*
+ * zbus notifies the observers of a channel in section name order, which
+ * ends in priority then observer name. Appending 0 and 1 to the priority
+ * puts the gate right before the subscriber.
+ */
+#define Z_ZBUS_LATEST_CHAN_ADD_OBS(_chan, _sub, _prio, _is_status)			\
+	static struct zbus_latest_data _CONCAT(Z_ZBUS_LATEST_NAME(_chan, _sub), _data);	\
+	static const STRUCT_SECTION_ITERABLE(zbus_latest, Z_ZBUS_LATEST_NAME(_chan, _sub)) = { \
+		.chan = &_chan,								\
+		.sub = &_sub,								\
+		.chan_name = STRINGIFY(_chan),						\
+		.sub_name = STRINGIFY(_sub),						\
+		.is_status = _is_status,						\
+		.data = &_CONCAT(Z_ZBUS_LATEST_NAME(_chan, _sub), _data),		\
+	};										\
+	static void _CONCAT(Z_ZBUS_LATEST_NAME(_chan, _sub), _cb)(			\
+		const struct zbus_channel *chan)					\
+	{										\
+		zbus_latest_gate(&Z_ZBUS_LATEST_NAME(_chan, _sub), chan);		\
+	}										\
+	ZBUS_LISTENER_DEFINE(_CONCAT(Z_ZBUS_LATEST_NAME(_chan, _sub), _gate),		\
+			     _CONCAT(Z_ZBUS_LATEST_NAME(_chan, _sub), _cb));		\
+	ZBUS_CHAN_ADD_OBS(_chan, _CONCAT(Z_ZBUS_LATEST_NAME(_chan, _sub), _gate),	\
+			  _CONCAT(_prio, 0));						\
+	ZBUS_CHAN_ADD_OBS(_chan, _sub, _CONCAT(_prio, 1))
+/** @endcond */
+
+/**
+ * @brief Observe a status channel, last value wins
+ *
+ * Every message of @p _chan is a status: at most one is queued for
+ * @p _sub at any time. Replaces ZBUS_CHAN_ADD_OBS(@p _chan, @p _sub, ...);
+ * do not add both.
+ *
+ * @param _chan Channel to observe
+ * @param _sub Message subscriber (ZBUS_MSG_SUBSCRIBER_DEFINE name)
+ * @param _prio Observer priority, a decimal literal as for ZBUS_CHAN_ADD_OBS()
+ */
+#define ZBUS_LATEST_CHAN_ADD_OBS(_chan, _sub, _prio)					\
+	Z_ZBUS_LATEST_CHAN_ADD_OBS(_chan, _sub, _prio, NULL)
+
+/**
+ * @brief Observe a channel, last value wins for the messages @p _is_status accepts
+ *
+ * @param _chan Channel to observe
+ * @param _sub Message subscriber (ZBUS_MSG_SUBSCRIBER_DEFINE name)
+ * @param _prio Observer priority, a decimal literal as for ZBUS_CHAN_ADD_OBS()
+ * @param _is_status zbus_latest_filter_t, called in the publisher's context
+ */
+#define ZBUS_LATEST_CHAN_ADD_OBS_IF(_chan, _sub, _prio, _is_status)			\
+	Z_ZBUS_LATEST_CHAN_ADD_OBS(_chan, _sub, _prio, _is_status)
+
+/**
+ * @brief Let a publish through to the subscriber or hold it back (gate listener)
+ *
+ * Runs in the publisher's context with the channel locked.
+ */
+void zbus_latest_gate(const struct zbus_latest *latest, const struct zbus_channel *chan);
+
+/**
+ * @brief Report a message received by a message subscriber
+ *
+ * Call after every successful zbus_sub_wait_msg(). When publishes of
+ * @p chan were held back while this message was queued, @p msg is
+ * replaced with the channel's current value. Messages of channels not
+ * observed with ZBUS_LATEST_CHAN_ADD_OBS*() are left alone.
+ *
+ * @param sub Subscriber that received the message
+ * @param chan Channel the message came from
+ * @param msg Received message, updated in place
+ */
+void zbus_latest_received(const struct zbus_observer *sub, const struct zbus_channel *chan,
+			  void *msg);
+
+#else
+
+#define ZBUS_LATEST_CHAN_ADD_OBS(_chan, _sub, _prio)					\
+	ZBUS_CHAN_ADD_OBS(_chan, _sub, _prio)
+#define ZBUS_LATEST_CHAN_ADD_OBS_IF(_chan, _sub, _prio, _is_status)			\
+	ZBUS_CHAN_ADD_OBS(_chan, _sub, _prio)
+
+static inline void zbus_latest_received(const struct zbus_observer *sub,
+					const struct zbus_channel *chan, void *msg)
+{
+	ARG_UNUSED(sub);
+	ARG_UNUSED(chan);
+	ARG_UNUSED(msg);
+}
+
+#endif /* CONFIG_APP_ZBUS_LATEST */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ZBUS_LATEST_H_ */
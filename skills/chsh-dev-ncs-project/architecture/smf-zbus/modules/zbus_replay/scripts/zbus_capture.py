@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Convert, summarize and list zbus_replay captures.
+
+Usage:
+    zbus_capture.py convert uart.log -o field.zbr   # "zbus_replay dump" output -> capture file
+    zbus_capture.py info field.zbr                  # per-channel count, rate and peak rate
+    zbus_capture.py dump field.zbr [--chan NAME]    # one line per publish
+
+info and dump also accept the UART log directly. Binary layout is
+documented in zbus_replay.h. The capture file replays on native_sim with
+zephyr.exe -zbus_replay=field.zbr.
+"""
+
+import argparse
+import re
+import struct
+import sys
+from collections import defaultdict
+
+MAGIC = 0x5052425A
+HDR = struct.Struct("<IB3xI")
+REC = struct.Struct("<BBHI")
+REC_CHAN, REC_MSG = 0, 1
+
+HEXDUMP_RE = re.compile(r"^\s*[0-9a-fA-F]{8}:\s+((?:[0-9a-fA-F]{2}\s+)+)")
+
+
+def from_hexdump(path):
+    data = bytearray()
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            m = HEXDUMP_RE.match(line)
+            if m:
+                data.extend(bytes.fromhex(m.group(1).replace(" ", "")))
+    start = data.find(struct.pack("<I", MAGIC))
+    if start < 0:
+        sys.exit(f"No zbus_replay dump found in {path}")
+    return bytes(data[start:])
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) >= 4 and struct.unpack_from("<I", data)[0] == MAGIC:
+        return data
+    return from_hexdump(path)
+
+
+def records(data):
+    """Yield (t_us, chan_name, payload) per publish; returns lost count."""
+    magic, version, lost = HDR.unpack_from(data)
+    if magic != MAGIC or version != 1:
+        sys.exit(f"Not a version 1 capture (magic {magic:#x}, version {version})")
+    names = {}
+    t_us = 0
+    off = HDR.size
+    while off + REC.size <= len(data):
+        typ, chan_id, length, dt_us = REC.unpack_from(data, off)
+        payload = data[off + REC.size:off + REC.size + length]
+        if len(payload) < length:
+            break
+        off += REC.size + length
+        t_us += dt_us
+        if typ == REC_CHAN:
+            names[chan_id] = payload.decode("ascii", errors="replace")
+        elif typ == REC_MSG:
+            yield t_us, names.get(chan_id, f"#{chan_id}"), payload
+    if off != len(data):
+        print(f"# capture truncated at byte {off} of {len(data)}", file=sys.stderr)
+    if lost:
+        print(f"# {lost} publishes lost while recording (buffer full)", file=sys.stderr)
+
+
+def cmd_convert(args):
+    data = from_hexdump(args.input)
+    with open(args.output, "wb") as f:
+        f.write(data)
+    print(f"{len(data)} bytes -> {args.output}")
+
+
+def cmd_info(args):
+    count = defaultdict(int)
+    size = {}
+    per_window = defaultdict(lambda: defaultdict(int))
+    end_us = 0
+    for t_us, name, payload in records(load(args.input)):
+        count[name] += 1
+        size[name] = len(payload)
+        per_window[name][t_us // (args.window * 1000)] += 1
+        end_us = t_us
+
+    duration = max(end_us / 1e6, 1e-6)
+    print(f"# {sum(count.values())} publishes over {end_us / 1e6:.3f} s")
+    print(f"{'channel':<24} {'bytes':>6} {'msgs':>8} {'msg/s':>9} "
+          f"{'peak/' + str(args.window) + 'ms':>12}")
+    for name in sorted(count, key=count.get, reverse=True):
+        peak = max(per_window[name].values())
+        print(f"{name:<24} {size[name]:>6} {count[name]:>8} "
+              f"{count[name] / duration:>9.1f} {peak:>12}")
+
+
+def cmd_dump(args):
+    for t_us, name, payload in records(load(args.input)):
+        if args.chan and name != args.chan:
+            continue
+        print(f"{t_us / 1000:12.3f} ms  {name:<24} {payload.hex(' ')}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("convert", help="extract a capture from a UART/RTT log")
+    p.add_argument("input")
+    p.add_argument("-o", "--output", required=True)
+    p.set_defaults(func=cmd_convert)
+
+    p = sub.add_parser("info", help="per-channel load profile")
+    p.add_argument("input")
+    p.add_argument("--window", type=int, default=100, help="peak rate window in ms")
+    p.set_defaults(func=cmd_info)
+
+    p = sub.add_parser("dump", help="list publishes")
+    p.add_argument("input")
+    p.add_argument("--chan", help="only this channel")
+    p.set_defaults(func=cmd_dump)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
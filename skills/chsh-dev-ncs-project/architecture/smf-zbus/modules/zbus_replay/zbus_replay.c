@@ -0,0 +1,742 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file zbus_replay.c
+ * @brief Record zbus traffic and replay it into the modules
+ *
+ * This module demonstrates:
+ * - One runtime listener on every channel as a passive bus tap
+ * - A capture buffer in .noinit RAM that survives a warm reset
+ * - Pacing with absolute timeouts so the schedule does not drift
+ * - native_sim command line options and host file access
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "zbus_replay.h"
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+#include "zbus_trace.h"
+#endif
+
+#ifdef CONFIG_APP_ZBUS_REPLAY_NATIVE
+#include <posix_board_if.h>
+#include <posix_native_task.h>
+#include "cmdline.h"
+#include "zbus_replay_native.h"
+#endif
+
+LOG_MODULE_REGISTER(zbus_replay, CONFIG_APP_ZBUS_REPLAY_LOG_LEVEL);
+
+#define CAPTURE_VALID 0x5A524356U
+#define FILTER_LEN 64
+
+/* Capture buffer; data[0..used) is a complete capture file */
+struct capture {
+	uint32_t valid;		/* CAPTURE_VALID once initialized */
+	uint32_t used;
+	uint8_t data[CONFIG_APP_ZBUS_REPLAY_BUFFER_SIZE];
+};
+
+#ifdef CONFIG_APP_ZBUS_REPLAY_RETAIN
+static __noinit struct capture cap;
+#else
+static struct capture cap;
+#endif
+
+/* Replay bookkeeping per capture channel id */
+struct replay_chan {
+	const struct zbus_channel *chan;	/* NULL: filtered or not in this build */
+	uint32_t published;
+	uint32_t dropped;
+};
+
+static struct k_spinlock lock;
+static atomic_t recording;
+static atomic_t replaying;
+
+/* Recorder state, protected by lock */
+static const struct zbus_channel *rec_chans[CONFIG_APP_ZBUS_REPLAY_MAX_CHANNELS];
+static size_t rec_chan_count;
+static int64_t rec_last_ticks;
+
+/* Replay request and results, owned by the replay thread while replaying */
+static uint32_t req_speed;
+static uint32_t req_delay_ms;
+static char req_chans[FILTER_LEN];
+static struct replay_chan replay_chans[CONFIG_APP_ZBUS_REPLAY_MAX_CHANNELS];
+static struct zbus_replay_report report;
+static bool report_valid;
+
+static K_SEM_DEFINE(start_sem, 0, 1);
+
+static void record_cb(const struct zbus_channel *chan);
+ZBUS_LISTENER_DEFINE(zbus_replay_lis, record_cb);
+
+#ifdef CONFIG_APP_ZBUS_REPLAY_NATIVE
+static char *record_path;
+static char *replay_path;
+static char *replay_chan_list;
+static uint32_t replay_speed = 1;
+#endif
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static struct zbus_replay_file_hdr *file_hdr(void)
+{
+	return (struct zbus_replay_file_hdr *)cap.data;
+}
+
+static bool capture_valid(void)
+{
+	return cap.valid == CAPTURE_VALID && cap.used >= sizeof(struct zbus_replay_file_hdr) &&
+	       cap.used <= sizeof(cap.data) && file_hdr()->magic == ZBUS_REPLAY_MAGIC &&
+	       file_hdr()->version == ZBUS_REPLAY_VERSION;
+}
+
+static void capture_clear(void)
+{
+	struct zbus_replay_file_hdr *hdr = file_hdr();
+
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->magic = ZBUS_REPLAY_MAGIC;
+	hdr->version = ZBUS_REPLAY_VERSION;
+	cap.used = sizeof(*hdr);
+	cap.valid = CAPTURE_VALID;
+}
+
+/* Called with lock held; space is checked by the caller */
+static void capture_append(uint8_t type, uint8_t id, uint32_t dt_us, const void *payload,
+			   size_t len)
+{
+	struct zbus_replay_rec_hdr rec = {
+		.type = type,
+		.chan_id = id,
+		.len = len,
+		.dt_us = dt_us,
+	};
+
+	memcpy(&cap.data[cap.used], &rec, sizeof(rec));
+	memcpy(&cap.data[cap.used + sizeof(rec)], payload, len);
+	cap.used += sizeof(rec) + len;
+}
+
+/* Returns -ENOENT at the end of the capture, -EBADMSG if it is truncated */
+static int capture_next(size_t *off, struct zbus_replay_rec_hdr *rec, uint8_t **payload)
+{
+	if (*off + sizeof(*rec) > cap.used) {
+		return (*off == cap.used) ? -ENOENT : -EBADMSG;
+	}
+
+	memcpy(rec, &cap.data[*off], sizeof(*rec));
+	if (*off + sizeof(*rec) + rec->len > cap.used) {
+		return -EBADMSG;
+	}
+
+	*payload = &cap.data[*off + sizeof(*rec)];
+	*off += sizeof(*rec) + rec->len;
+
+	return 0;
+}
+
+/* Listener: runs in the publisher's context with the channel locked */
+static void record_cb(const struct zbus_channel *chan)
+{
+	const char *name = zbus_chan_name(chan);
+	size_t len = zbus_chan_msg_size(chan);
+	k_spinlock_key_t key;
+	size_t need;
+	int64_t now;
+	uint64_t dt_us;
+	size_t id;
+
+	if (!atomic_get(&recording)) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	for (id = 0; id < rec_chan_count; id++) {
+		if (rec_chans[id] == chan) {
+			break;
+		}
+	}
+
+	need = sizeof(struct zbus_replay_rec_hdr) + len;
+	if (id == rec_chan_count) {
+		need += sizeof(struct zbus_replay_rec_hdr) + strlen(name);
+	}
+
+	if (id == ARRAY_SIZE(rec_chans) || cap.used + need > sizeof(cap.data)) {
+		file_hdr()->lost++;
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	now = k_uptime_ticks();
+	dt_us = (cap.used == sizeof(struct zbus_replay_file_hdr)) ? 0 :
+		k_ticks_to_us_floor64(now - rec_last_ticks);
+	rec_last_ticks = now;
+
+	if (id == rec_chan_count) {
+		rec_chans[rec_chan_count++] = chan;
+		capture_append(ZBUS_REPLAY_REC_CHAN, id, MIN(dt_us, UINT32_MAX), name,
+			       strlen(name));
+		dt_us = 0;
+	}
+
+	capture_append(ZBUS_REPLAY_REC_MSG, id, MIN(dt_us, UINT32_MAX), zbus_chan_const_msg(chan),
+		       len);
+
+	k_spin_unlock(&lock, key);
+}
+
+/* Match a channel name against a comma-separated list, NULL/empty matches all */
+static bool chan_selected(const char *list, const char *name, size_t name_len)
+{
+	const char *p = list;
+	const char *end;
+
+	if (list == NULL || list[0] == '\0') {
+		return true;
+	}
+
+	while (*p) {
+		end = strchr(p, ',');
+		if (end == NULL) {
+			end = p + strlen(p);
+		}
+		if ((size_t)(end - p) == name_len && strncmp(p, name, name_len) == 0) {
+			return true;
+		}
+		p = *end ? end + 1 : end;
+	}
+
+	return false;
+}
+
+static const struct zbus_channel *chan_lookup(const char *name, size_t name_len)
+{
+	STRUCT_SECTION_FOREACH(zbus_channel, chan) {
+		const char *cn = zbus_chan_name(chan);
+
+		if (strlen(cn) == name_len && strncmp(cn, name, name_len) == 0) {
+			return chan;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Cost of a publish in us. Simulated time stands still while code runs on
+ * native_sim, so use the host clock there.
+ */
+static uint32_t cost_start(void)
+{
+#ifdef CONFIG_APP_ZBUS_REPLAY_NATIVE
+	return (uint32_t)zbus_replay_native_host_us();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static uint32_t cost_us(uint32_t start)
+{
+#ifdef CONFIG_APP_ZBUS_REPLAY_NATIVE
+	return (uint32_t)zbus_replay_native_host_us() - start;
+#else
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+#endif
+}
+
+/* Wait for the record's slot in the schedule, returns the lag behind it */
+static uint32_t pace(int64_t t0, uint64_t sched_us, uint32_t speed)
+{
+	int64_t target;
+	int64_t now;
+
+	if (speed == 0) {
+		k_yield();
+		return 0;
+	}
+
+	target = t0 + (int64_t)k_us_to_ticks_ceil64(sched_us / speed);
+	if (k_uptime_ticks() < target) {
+		k_sleep(K_TIMEOUT_ABS_TICKS(target));
+	}
+
+	now = k_uptime_ticks();
+
+	return (now > target) ? (uint32_t)MIN(k_ticks_to_us_floor64(now - target), UINT32_MAX) : 0;
+}
+
+static int replay_run(uint32_t speed, const char *chans, struct zbus_replay_report *r)
+{
+	size_t off = sizeof(struct zbus_replay_file_hdr);
+	struct zbus_replay_rec_hdr rec;
+	struct replay_chan *rc;
+	uint64_t sched_us = 0;
+	uint64_t pub_sum_us = 0;
+	int64_t start_ms;
+	int64_t t0;
+	uint8_t *payload;
+	uint32_t start;
+	uint32_t us;
+	int err;
+
+	memset(r, 0, sizeof(*r));
+	memset(replay_chans, 0, sizeof(replay_chans));
+	r->speed = speed;
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+	zbus_trace_reset();
+#endif
+
+	start_ms = k_uptime_get();
+	t0 = k_uptime_ticks();
+
+	while ((err = capture_next(&off, &rec, &payload)) == 0) {
+		sched_us += rec.dt_us;
+		rc = (rec.chan_id < ARRAY_SIZE(replay_chans)) ? &replay_chans[rec.chan_id] : NULL;
+
+		if (rec.type == ZBUS_REPLAY_REC_CHAN && rc) {
+			rc->chan = chan_selected(chans, (const char *)payload, rec.len) ?
+				   chan_lookup((const char *)payload, rec.len) : NULL;
+			continue;
+		}
+
+		/* Unknown types are from a newer recorder */
+		if (rec.type != ZBUS_REPLAY_REC_MSG) {
+			continue;
+		}
+
+		r->msgs++;
+		if (rc == NULL || rc->chan == NULL || rec.len != zbus_chan_msg_size(rc->chan)) {
+			r->skipped++;
+			continue;
+		}
+
+		r->lag_max_us = MAX(r->lag_max_us, pace(t0, sched_us, speed));
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+		/* In place: the recorded stamp is stale anyway */
+		zbus_trace_stamp(rc->chan, payload);
+#endif
+
+		start = cost_start();
+		err = zbus_chan_pub(rc->chan, payload,
+				    K_MSEC(CONFIG_APP_ZBUS_REPLAY_PUB_TIMEOUT_MS));
+		us = cost_us(start);
+
+		pub_sum_us += us;
+		r->pub_max_us = MAX(r->pub_max_us, us);
+
+		if (err) {
+			LOG_DBG("%s: publish failed: %d", zbus_chan_name(rc->chan), err);
+			rc->dropped++;
+			r->dropped++;
+		} else {
+			rc->published++;
+			r->published++;
+		}
+	}
+
+	/* Let the subscribers drain their queues before reading latencies */
+	k_sleep(K_MSEC(CONFIG_APP_ZBUS_REPLAY_SETTLE_MS));
+
+	r->elapsed_ms = (uint32_t)(k_uptime_get() - start_ms);
+	if (r->published + r->dropped) {
+		r->pub_avg_us = (uint32_t)(pub_sum_us / (r->published + r->dropped));
+	}
+
+	return (err == -ENOENT) ? 0 : err;
+}
+
+/* Machine-readable result lines, see README "Replay Production Traffic" */
+static void report_print(const struct zbus_replay_report *r)
+{
+	printk("REPLAY done msgs=%u published=%u dropped=%u skipped=%u speed=%u elapsed_ms=%u "
+	       "pub_avg_us=%u pub_max_us=%u lag_max_us=%u\n",
+	       r->msgs, r->published, r->dropped, r->skipped, r->speed, r->elapsed_ms,
+	       r->pub_avg_us, r->pub_max_us, r->lag_max_us);
+
+	for (size_t i = 0; i < ARRAY_SIZE(replay_chans); i++) {
+		if (replay_chans[i].chan == NULL) {
+			continue;
+		}
+		printk("REPLAY chan=%s published=%u dropped=%u\n",
+		       zbus_chan_name(replay_chans[i].chan), replay_chans[i].published,
+		       replay_chans[i].dropped);
+	}
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+	struct zbus_trace_stats stats;
+
+	/* Publish-to-dispatch latency under the replayed load */
+	for (size_t i = 0; zbus_trace_stats_get(i, &stats) == 0; i++) {
+		printk("REPLAY latency chan=%s obs=%s n=%u p50_us=%u p99_us=%u max_us=%u\n",
+		       zbus_chan_name(stats.chan), zbus_obs_name(stats.obs), stats.count,
+		       stats.p50_us, stats.p99_us, stats.max_us);
+	}
+#endif
+}
+
+static void replay_thread(void)
+{
+	int err;
+
+	while (true) {
+		k_sem_take(&start_sem, K_FOREVER);
+		k_sleep(K_MSEC(req_delay_ms));
+
+		err = replay_run(req_speed, req_chans, &report);
+		if (err) {
+			LOG_ERR("Capture is truncated, replay stopped early");
+		}
+
+		report_valid = true;
+		report_print(&report);
+		atomic_clear(&replaying);
+
+#ifdef CONFIG_APP_ZBUS_REPLAY_NATIVE
+		/* Started from the command line: the run is the test */
+		if (replay_path) {
+			posix_exit(err ? 2 : (report.dropped ? 1 : 0));
+		}
+#endif
+	}
+}
+
+K_THREAD_DEFINE(zbus_replay_tid,
+		CONFIG_APP_ZBUS_REPLAY_STACK_SIZE,
+		replay_thread,
+		NULL, NULL, NULL,
+		CONFIG_APP_ZBUS_REPLAY_THREAD_PRIORITY,
+		0, 0);
+
+static int replay_queue(uint32_t speed, const char *chans, uint32_t delay_ms)
+{
+	if (chans && strlen(chans) >= sizeof(req_chans)) {
+		return -EINVAL;
+	}
+
+	if (atomic_get(&recording)) {
+		return -EBUSY;
+	}
+
+	if (!capture_valid() || cap.used == sizeof(struct zbus_replay_file_hdr)) {
+		return -ENODATA;
+	}
+
+	if (!atomic_cas(&replaying, 0, 1)) {
+		return -EBUSY;
+	}
+
+	req_speed = speed;
+	req_delay_ms = delay_ms;
+	strncpy(req_chans, chans ? chans : "", sizeof(req_chans) - 1);
+	req_chans[sizeof(req_chans) - 1] = '\0';
+	k_sem_give(&start_sem);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int zbus_replay_record_start(void)
+{
+	k_spinlock_key_t key;
+
+	if (atomic_get(&replaying)) {
+		return -EBUSY;
+	}
+
+	key = k_spin_lock(&lock);
+	capture_clear();
+	rec_chan_count = 0;
+	k_spin_unlock(&lock, key);
+
+	atomic_set(&recording, 1);
+
+	return 0;
+}
+
+void zbus_replay_record_stop(void)
+{
+	atomic_clear(&recording);
+}
+
+int zbus_replay_capture_get(const uint8_t **data, size_t *len)
+{
+	if (!capture_valid() || cap.used == sizeof(struct zbus_replay_file_hdr)) {
+		return -ENODATA;
+	}
+
+	*data = cap.data;
+	*len = cap.used;
+
+	return 0;
+}
+
+int zbus_replay_start(uint32_t speed, const char *chans)
+{
+	return replay_queue(speed, chans, 0);
+}
+
+int zbus_replay_report_get(struct zbus_replay_report *out)
+{
+	if (!report_valid || atomic_get(&replaying)) {
+		return -ENODATA;
+	}
+
+	*out = report;
+
+	return 0;
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_ZBUS_REPLAY_NATIVE
+
+static void native_options(void)
+{
+	static struct args_struct_t options[] = {
+		{ .option = "zbus_record", .name = "file", .type = 's',
+		  .dest = (void *)&record_path,
+		  .descript = "Record every zbus publish from boot, write the capture on exit" },
+		{ .option = "zbus_replay", .name = "file", .type = 's',
+		  .dest = (void *)&replay_path,
+		  .descript = "Replay a capture after boot, print REPLAY lines and exit "
+			      "(0 ok, 1 publishes dropped, 2 bad capture)" },
+		{ .option = "zbus_replay_speed", .name = "factor", .type = 'u',
+		  .dest = (void *)&replay_speed,
+		  .descript = "Replay pace factor, 0 for back-to-back (default 1)" },
+		{ .option = "zbus_replay_chan", .name = "names", .type = 's',
+		  .dest = (void *)&replay_chan_list,
+		  .descript = "Comma-separated channels to replay (default all)" },
+		ARG_TABLE_ENDMARKER
+	};
+
+	native_add_command_line_opts(options);
+}
+NATIVE_TASK(native_options, PRE_BOOT_1, 1);
+
+static void native_write_capture(void)
+{
+	if (record_path == NULL || !capture_valid()) {
+		return;
+	}
+
+	if (zbus_replay_native_write(record_path, cap.data, cap.used)) {
+		printk("zbus_replay: cannot write %s\n", record_path);
+	}
+}
+NATIVE_TASK(native_write_capture, ON_EXIT, 1);
+
+static void native_start(void)
+{
+	long len;
+	int err;
+
+	/* One buffer holds either the recording or the capture to replay */
+	if (record_path && replay_path) {
+		LOG_ERR("-zbus_record and -zbus_replay cannot be combined");
+		posix_exit(2);
+	}
+
+	if (record_path) {
+		(void)zbus_replay_record_start();
+		LOG_INF("Recording to %s", record_path);
+	}
+
+	if (replay_path == NULL) {
+		return;
+	}
+
+	cap.valid = 0;
+	len = zbus_replay_native_read(replay_path, cap.data, sizeof(cap.data));
+	cap.used = (len > 0) ? (uint32_t)len : 0;
+	cap.valid = CAPTURE_VALID;
+
+	if (len < 0 || !capture_valid()) {
+		LOG_ERR("%s is not a capture or exceeds "
+			"CONFIG_APP_ZBUS_REPLAY_BUFFER_SIZE", replay_path);
+		posix_exit(2);
+	}
+
+	err = replay_queue(replay_speed, replay_chan_list, CONFIG_APP_ZBUS_REPLAY_START_DELAY_MS);
+	if (err) {
+		LOG_ERR("Cannot replay %s: %d", replay_path, err);
+		posix_exit(2);
+	}
+}
+
+#endif /* CONFIG_APP_ZBUS_REPLAY_NATIVE */
+
+static int zbus_replay_init(void)
+{
+	int err;
+
+	if (!capture_valid()) {
+		capture_clear();
+	}
+
+	STRUCT_SECTION_FOREACH(zbus_channel, chan) {
+		err = zbus_chan_add_obs(chan, &zbus_replay_lis, K_MSEC(100));
+		if (err) {
+			LOG_WRN("%s will not be recorded: %d", zbus_chan_name(chan), err);
+		}
+	}
+
+#ifdef CONFIG_APP_ZBUS_REPLAY_NATIVE
+	native_start();
+#endif
+
+	return 0;
+}
+
+SYS_INIT(zbus_replay_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_ZBUS_REPLAY_SHELL
+
+static int cmd_record(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (zbus_replay_record_start()) {
+		shell_error(sh, "Replay in progress");
+		return -EBUSY;
+	}
+
+	shell_print(sh, "Recording into %u byte buffer", (uint32_t)sizeof(cap.data));
+
+	return 0;
+}
+
+static int cmd_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	zbus_replay_record_stop();
+	shell_print(sh, "Stopped, %u bytes captured", cap.used);
+
+	return 0;
+}
+
+static int cmd_play(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t speed = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1;
+	const char *chans = (argc > 2) ? argv[2] : NULL;
+	int err;
+
+	err = zbus_replay_start(speed, chans);
+	switch (err) {
+	case 0:
+		if (speed) {
+			shell_print(sh, "Replaying at %ux, report follows", speed);
+		} else {
+			shell_print(sh, "Replaying back-to-back, report follows");
+		}
+		break;
+	case -ENODATA:
+		shell_error(sh, "No capture, run \"zbus_replay record\" first");
+		break;
+	case -EINVAL:
+		shell_error(sh, "Channel list too long (max %d chars)", FILTER_LEN - 1);
+		break;
+	default:
+		shell_error(sh, "Recording or replay in progress");
+		break;
+	}
+
+	return err;
+}
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	size_t off = sizeof(struct zbus_replay_file_hdr);
+	struct zbus_replay_rec_hdr rec;
+	uint64_t duration_us = 0;
+	uint32_t msgs = 0;
+	uint32_t chans = 0;
+	uint8_t *payload;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	while (capture_next(&off, &rec, &payload) == 0) {
+		duration_us += rec.dt_us;
+		msgs += (rec.type == ZBUS_REPLAY_REC_MSG);
+		chans += (rec.type == ZBUS_REPLAY_REC_CHAN);
+	}
+
+	shell_print(sh, "%s: %u msgs on %u channels over %u ms, %u/%u bytes, %u lost",
+		    atomic_get(&recording) ? "recording" : "capture", msgs, chans,
+		    (uint32_t)(duration_us / 1000), cap.used, (uint32_t)sizeof(cap.data),
+		    file_hdr()->lost);
+
+	if (atomic_get(&replaying)) {
+		shell_print(sh, "Replay in progress");
+	} else if (report_valid) {
+		shell_print(sh, "Last replay: %u published, %u dropped, %u skipped in %u ms "
+			    "(pub avg %u us, max %u us, lag max %u us)",
+			    report.published, report.dropped, report.skipped, report.elapsed_ms,
+			    report.pub_avg_us, report.pub_max_us, report.lag_max_us);
+	}
+
+	return 0;
+}
+
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	const uint8_t *data;
+	size_t len;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (zbus_replay_capture_get(&data, &len)) {
+		shell_error(sh, "No capture");
+		return -ENODATA;
+	}
+
+	shell_hexdump(sh, data, len);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_zbus_replay,
+	SHELL_CMD(record, NULL, "Start recording (clears the capture)", cmd_record),
+	SHELL_CMD(stop, NULL, "Stop recording", cmd_stop),
+	SHELL_CMD_ARG(play, NULL, "Replay [speed, 0 = max] [CHAN,CHAN]", cmd_play, 1, 2),
+	SHELL_CMD(show, NULL, "Capture summary and last replay", cmd_show),
+	SHELL_CMD(dump, NULL, "Hex dump for zbus_capture.py", cmd_dump),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(zbus_replay, &sub_zbus_replay, "zbus record and replay", NULL);
+
+#endif /* CONFIG_APP_ZBUS_REPLAY_SHELL */
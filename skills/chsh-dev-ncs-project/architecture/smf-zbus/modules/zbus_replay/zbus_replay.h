@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _ZBUS_REPLAY_H_
+#define _ZBUS_REPLAY_H_
+
+/**
+ * @file zbus_replay.h
+ * @brief Record zbus traffic and replay it into the modules
+ *
+ * A listener on every channel copies each publish (channel, time since
+ * the previous publish, payload) into a capture buffer. The buffer is a
+ * plain capture file: on native_sim it is written to the host with
+ * -zbus_record=<file>, on a device it sits in .noinit RAM and survives a
+ * warm reset until "zbus_replay dump" reads it out.
+ *
+ * The replayer publishes the capture again, at the recorded pace scaled
+ * by a speed factor or back-to-back, and reports per channel how many
+ * publishes failed (full subscriber queue or buffer pool). With
+ * CONFIG_APP_ZBUS_TRACE, traced messages are re-stamped before each
+ * publish, so the subscribers' publish-to-dispatch latency is measured
+ * under the replayed load.
+ *
+ * On native_sim a capture taken on the device replays into the same
+ * modules without hardware, in simulated time:
+ *
+ * @code
+ * ./zephyr.exe -zbus_replay=field.zbr -zbus_replay_speed=10 -zbus_replay_chan=BUTTON_CHAN
+ * @endcode
+ *
+ * The run prints "REPLAY" lines and exits with 0, 1 when a publish was
+ * dropped, or 2 when the capture cannot be read.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Capture magic, "ZBRP" in little endian */
+#define ZBUS_REPLAY_MAGIC 0x5052425AU
+
+/** @brief Capture format version */
+#define ZBUS_REPLAY_VERSION 1
+
+/**
+ * @brief Capture file header
+ *
+ * A capture is this header followed by records until the end of the
+ * file. All fields are little endian.
+ */
+struct zbus_replay_file_hdr {
+	uint32_t magic;		/* ZBUS_REPLAY_MAGIC */
+	uint8_t version;	/* ZBUS_REPLAY_VERSION */
+	uint8_t reserved[3];
+	uint32_t lost;		/* Publishes not recorded, capture full */
+} __packed;
+
+/** @brief Record types */
+enum zbus_replay_rec_type {
+	ZBUS_REPLAY_REC_CHAN = 0,	/* Payload: channel name, no terminator */
+	ZBUS_REPLAY_REC_MSG = 1,	/* Payload: message as published */
+};
+
+/**
+ * @brief Record header, followed by len payload bytes
+ *
+ * A channel's CHAN record comes before its first MSG record and maps
+ * chan_id to the channel name, so a capture replays into any build that
+ * has channels of the same name and message size.
+ */
+struct zbus_replay_rec_hdr {
+	uint8_t type;		/* enum zbus_replay_rec_type */
+	uint8_t chan_id;
+	uint16_t len;
+	uint32_t dt_us;		/* Time since the previous record */
+} __packed;
+
+/**
+ * @brief Result of one replay
+ */
+struct zbus_replay_report {
+	uint32_t msgs;		/* MSG records in the capture */
+	uint32_t published;
+	uint32_t dropped;	/* zbus_chan_pub() failed */
+	uint32_t skipped;	/* Channel filtered, unknown or size changed */
+	uint32_t speed;		/* Speed factor, 0 for back-to-back */
+	uint32_t elapsed_ms;	/* Kernel uptime (simulated on native_sim) */
+	uint32_t pub_avg_us;	/* Time inside zbus_chan_pub() */
+	uint32_t pub_max_us;
+	uint32_t lag_max_us;	/* Worst publish delay behind the schedule */
+};
+
+/**
+ * @brief Start recording
+ *
+ * Discards the previous capture.
+ *
+ * @return 0 on success, -EBUSY while a replay is running
+ */
+int zbus_replay_record_start(void);
+
+/**
+ * @brief Stop recording, keeping the capture
+ */
+void zbus_replay_record_stop(void);
+
+/**
+ * @brief Get the capture buffer
+ *
+ * @param data Output pointer to the capture (file header first)
+ * @param len Output capture length in bytes
+ * @return 0 on success, -ENODATA when nothing was recorded
+ */
+int zbus_replay_capture_get(const uint8_t **data, size_t *len);
+
+/**
+ * @brief Replay the capture from the replay thread
+ *
+ * Returns once the replay is queued; the report is printed when it
+ * finishes and can be read with zbus_replay_report_get().
+ *
+ * @param speed Pace factor (1 = as recorded, 10 = ten times faster),
+ *              0 to publish back-to-back
+ * @param chans Comma-separated channel names to replay, NULL for all
+ * @return 0 on success, -EBUSY while recording or replaying, -ENODATA
+ *         without a capture, -EINVAL when @p chans is too long
+ */
+int zbus_replay_start(uint32_t speed, const char *chans);
+
+/**
+ * @brief Get the report of the last finished replay
+ *
+ * @return 0 on success, -ENODATA when no replay finished yet
+ */
+int zbus_replay_report_get(struct zbus_replay_report *report);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ZBUS_REPLAY_H_ */
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _ZBUS_REPLAY_NATIVE_H_
+#define _ZBUS_REPLAY_NATIVE_H_
+
+/**
+ * @file zbus_replay_native.h
+ * @brief Host side of zbus_replay on native_sim
+ *
+ * Implemented in zbus_replay_native.c, which is built into the native
+ * simulator runner against the host C library. Shared by both sides, so
+ * no Zephyr headers here.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Read a host file into a buffer
+ *
+ * @return Bytes read, or -1 when the file cannot be read or does not fit
+ */
+long zbus_replay_native_read(const char *path, void *buf, size_t size);
+
+/**
+ * @brief Write a buffer to a host file, replacing it
+ *
+ * @return 0 on success, -1 on error
+ */
+int zbus_replay_native_write(const char *path, const void *buf, size_t len);
+
+/**
+ * @brief Host monotonic clock in microseconds
+ *
+ * Simulated time stands still while embedded code runs, so the cost of
+ * a publish is only visible on the host clock.
+ */
+uint64_t zbus_replay_native_host_us(void);
+
+#endif /* _ZBUS_REPLAY_NATIVE_H_ */
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file zbus_trace.c
+ * @brief zbus publish-to-handler latency tracing
+ *
+ * This module demonstrates:
+ * - Cycle-count stamping of zbus messages at publish time
+ * - Per (channel, subscriber) log2 latency histograms at dispatch
+ * - p50/p99/max reporting over the shell
+ * - Binary export for offline analysis
+ *
+ * The hot path (stamp + dispatch) is a section lookup, one memcpy and a
+ * spinlock-protected counter update; no logging and no allocation.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "zbus_trace.h"
+
+LOG_MODULE_REGISTER(zbus_trace, CONFIG_APP_ZBUS_TRACE_LOG_LEVEL);
+
+/*******************************************************************************
+ * Latency Storage
+ ******************************************************************************/
+
+struct zbus_trace_pair {
+	const struct zbus_channel *chan;
+	const struct zbus_observer *obs;
+	uint32_t count;
+	uint32_t max_us;
+	uint64_t sum_us;
+	uint32_t hist[ZBUS_TRACE_HIST_BUCKETS];
+};
+
+static struct zbus_trace_pair pairs[CONFIG_APP_ZBUS_TRACE_MAX_PAIRS];
+static size_t pair_count;
+static uint32_t overflow_count;
+static struct k_spinlock lock;
+
+/*******************************************************************************
+ * Helper Functions
+ ******************************************************************************/
+
+static const struct zbus_trace_chan *trace_chan_find(const struct zbus_channel *chan)
+{
+	STRUCT_SECTION_FOREACH(zbus_trace_chan, tc) {
+		if (tc->chan == chan) {
+			return tc;
+		}
+	}
+
+	return NULL;
+}
+
+static uint32_t bucket_index(uint32_t us)
+{
+	uint32_t idx;
+
+	if (us == 0) {
+		return 0;
+	}
+
+	/* [2^(i-1), 2^i) us lands in bucket i */
+	idx = 32 - __builtin_clz(us);
+
+	return MIN(idx, ZBUS_TRACE_HIST_BUCKETS - 1);
+}
+
+static uint32_t bucket_upper_us(uint32_t idx)
+{
+	return BIT(idx);
+}
+
+static uint32_t hist_percentile(const uint32_t *hist, uint32_t count, uint32_t pct)
+{
+	uint64_t target = DIV_ROUND_UP((uint64_t)count * pct, 100);
+	uint64_t seen = 0;
+
+	for (uint32_t i = 0; i < ZBUS_TRACE_HIST_BUCKETS; i++) {
+		seen += hist[i];
+		if (seen >= target) {
+			return bucket_upper_us(i);
+		}
+	}
+
+	return bucket_upper_us(ZBUS_TRACE_HIST_BUCKETS - 1);
+}
+
+/* Must be called with lock held */
+static struct zbus_trace_pair *pair_get(const struct zbus_channel *chan,
+					const struct zbus_observer *obs)
+{
+	for (size_t i = 0; i < pair_count; i++) {
+		if (pairs[i].chan == chan && pairs[i].obs == obs) {
+			return &pairs[i];
+		}
+	}
+
+	if (pair_count == ARRAY_SIZE(pairs)) {
+		return NULL;
+	}
+
+	pairs[pair_count].chan = chan;
+	pairs[pair_count].obs = obs;
+
+	return &pairs[pair_count++];
+}
+
+static void fill_stats(const struct zbus_trace_pair *pair, struct zbus_trace_stats *stats)
+{
+	stats->chan = pair->chan;
+	stats->obs = pair->obs;
+	stats->count = pair->count;
+	stats->max_us = pair->max_us;
+	stats->avg_us = pair->count ? (uint32_t)(pair->sum_us / pair->count) : 0;
+	stats->p50_us = pair->count ? hist_percentile(pair->hist, pair->count, 50) : 0;
+	stats->p99_us = pair->count ? hist_percentile(pair->hist, pair->count, 99) : 0;
+}
+
+static void fill_dump_entry(const struct zbus_trace_pair *pair,
+			    struct zbus_trace_dump_entry *entry)
+{
+	memset(entry, 0, sizeof(*entry));
+	strncpy(entry->chan, zbus_chan_name(pair->chan), sizeof(entry->chan) - 1);
+	strncpy(entry->obs, zbus_obs_name(pair->obs), sizeof(entry->obs) - 1);
+	entry->count = pair->count;
+	entry->max_us = pair->max_us;
+	entry->sum_us = pair->sum_us;
+	memcpy(entry->hist, pair->hist, sizeof(entry->hist));
+}
+
+/* Must be called with lock held */
+static void fill_dump_hdr(struct zbus_trace_dump_hdr *hdr, size_t entries)
+{
+	hdr->magic = ZBUS_TRACE_DUMP_MAGIC;
+	hdr->version = ZBUS_TRACE_DUMP_VERSION;
+	hdr->bucket_count = ZBUS_TRACE_HIST_BUCKETS;
+	hdr->entry_count = entries;
+	hdr->cycles_per_sec = sys_clock_hw_cycles_per_sec();
+	hdr->overflow = overflow_count;
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+void zbus_trace_stamp(const struct zbus_channel *chan, void *msg)
+{
+	const struct zbus_trace_chan *tc = trace_chan_find(chan);
+	uint32_t now;
+
+	if (tc == NULL) {
+		return;
+	}
+
+	/* 0 means "not stamped" at dispatch */
+	now = k_cycle_get_32() | 1U;
+	memcpy((uint8_t *)msg + tc->stamp_offset, &now, sizeof(now));
+}
+
+void zbus_trace_dispatch(const struct zbus_observer *obs,
+			 const struct zbus_channel *chan,
+			 const void *msg)
+{
+	const struct zbus_trace_chan *tc = trace_chan_find(chan);
+	struct zbus_trace_pair *pair;
+	k_spinlock_key_t key;
+	uint32_t stamp;
+	uint32_t us;
+
+	if (tc == NULL) {
+		return;
+	}
+
+	memcpy(&stamp, (const uint8_t *)msg + tc->stamp_offset, sizeof(stamp));
+	if (stamp == 0) {
+		return;
+	}
+
+	/* Unsigned subtraction handles a single cycle counter wrap */
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - stamp);
+
+	key = k_spin_lock(&lock);
+
+	pair = pair_get(chan, obs);
+	if (pair == NULL) {
+		overflow_count++;
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	pair->count++;
+	pair->sum_us += us;
+	pair->max_us = MAX(pair->max_us, us);
+	pair->hist[bucket_index(us)]++;
+
+	k_spin_unlock(&lock, key);
+}
+
+int zbus_trace_stats_get(size_t idx, struct zbus_trace_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int err = -ENOENT;
+
+	if (idx < pair_count) {
+		fill_stats(&pairs[idx], stats);
+		err = 0;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return err;
+}
+
+int zbus_trace_dump(uint8_t *buf, size_t size)
+{
+	struct zbus_trace_dump_hdr hdr;
+	struct zbus_trace_dump_entry entry;
+	k_spinlock_key_t key;
+	size_t entries;
+	size_t needed;
+	size_t off;
+
+	key = k_spin_lock(&lock);
+	entries = pair_count;
+	fill_dump_hdr(&hdr, entries);
+	k_spin_unlock(&lock, key);
+
+	needed = sizeof(hdr) + entries * sizeof(entry);
+	if (size < needed) {
+		return -ENOMEM;
+	}
+
+	memcpy(buf, &hdr, sizeof(hdr));
+	off = sizeof(hdr);
+
+	for (size_t i = 0; i < entries; i++) {
+		key = k_spin_lock(&lock);
+		fill_dump_entry(&pairs[i], &entry);
+		k_spin_unlock(&lock, key);
+
+		memcpy(buf + off, &entry, sizeof(entry));
+		off += sizeof(entry);
+	}
+
+	return off;
+}
+
+void zbus_trace_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(pairs, 0, sizeof(pairs));
+	pair_count = 0;
+	overflow_count = 0;
+
+	k_spin_unlock(&lock, key);
+
+	LOG_INF("Latency histograms cleared");
+}
+
+/*******************************************************************************
+ * Shell Commands
+ ******************************************************************************/
+
+#ifdef CONFIG_APP_ZBUS_TRACE_SHELL
+
+static void print_pair(const struct shell *sh, const struct zbus_trace_stats *s)
+{
+	shell_print(sh, "%-16s -> %-16s n=%-8u p50<=%-8u p99<=%-8u max=%-8u avg=%u",
+		    zbus_chan_name(s->chan), zbus_obs_name(s->obs),
+		    s->count, s->p50_us, s->p99_us, s->max_us, s->avg_us);
+}
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct zbus_trace_stats stats;
+	struct zbus_trace_pair chan_sum;
+	k_spinlock_key_t key;
+	uint32_t overflow;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "Per subscriber latency (us):");
+	for (size_t i = 0; zbus_trace_stats_get(i, &stats) == 0; i++) {
+		print_pair(sh, &stats);
+	}
+
+	shell_print(sh, "Per channel latency (us):");
+	STRUCT_SECTION_FOREACH(zbus_trace_chan, tc) {
+		memset(&chan_sum, 0, sizeof(chan_sum));
+		chan_sum.chan = tc->chan;
+
+		key = k_spin_lock(&lock);
+		for (size_t i = 0; i < pair_count; i++) {
+			if (pairs[i].chan != tc->chan) {
+				continue;
+			}
+			chan_sum.count += pairs[i].count;
+			chan_sum.sum_us += pairs[i].sum_us;
+			chan_sum.max_us = MAX(chan_sum.max_us, pairs[i].max_us);
+			for (size_t b = 0; b < ZBUS_TRACE_HIST_BUCKETS; b++) {
+				chan_sum.hist[b] += pairs[i].hist[b];
+			}
+		}
+		k_spin_unlock(&lock, key);
+
+		fill_stats(&chan_sum, &stats);
+		shell_print(sh, "%-16s n=%-8u p50<=%-8u p99<=%-8u max=%-8u avg=%u",
+			    zbus_chan_name(tc->chan), stats.count, stats.p50_us,
+			    stats.p99_us, stats.max_us, stats.avg_us);
+	}
+
+	key = k_spin_lock(&lock);
+	overflow = overflow_count;
+	k_spin_unlock(&lock, key);
+
+	if (overflow) {
+		shell_warn(sh, "%u samples dropped, increase "
+			   "CONFIG_APP_ZBUS_TRACE_MAX_PAIRS", overflow);
+	}
+
+	return 0;
+}
+
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	struct zbus_trace_dump_hdr hdr;
+	struct zbus_trace_dump_entry entry;
+	k_spinlock_key_t key;
+	size_t entries;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	/* Stream header + entries so no dump-sized buffer is needed */
+	key = k_spin_lock(&lock);
+	entries = pair_count;
+	fill_dump_hdr(&hdr, entries);
+	k_spin_unlock(&lock, key);
+
+	shell_hexdump(sh, (const uint8_t *)&hdr, sizeof(hdr));
+
+	for (size_t i = 0; i < entries; i++) {
+		key = k_spin_lock(&lock);
+		fill_dump_entry(&pairs[i], &entry);
+		k_spin_unlock(&lock, key);
+
+		shell_hexdump(sh, (const uint8_t *)&entry, sizeof(entry));
+	}
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	zbus_trace_reset();
+	shell_print(sh, "zbus trace cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_zbus_trace,
+	SHELL_CMD(show, NULL, "Show latency percentiles", cmd_show),
+	SHELL_CMD(dump, NULL, "Hex dump of binary histograms", cmd_dump),
+	SHELL_CMD(reset, NULL, "Clear latency histograms", cmd_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(zbus_trace, &sub_zbus_trace, "zbus latency trace", NULL);
+
+#endif /* CONFIG_APP_ZBUS_TRACE_SHELL */
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _ZBUS_TRACE_H_
+#define _ZBUS_TRACE_H_
+
+/**
+ * @file zbus_trace.h
+ * @brief Opt-in zbus publish-to-handler latency tracing
+ *
+ * Publishers stamp each message with a hardware cycle count right before
+ * zbus_chan_pub(). Subscribers call zbus_trace_dispatch() right before
+ * smf_run_state() handles the message. The difference is accumulated into a
+ * log2 histogram per (channel, subscriber) pair.
+ *
+ * A traced message type carries the stamp as a member named trace_cycles:
+ *
+ * @code
+ * struct sensor_msg {
+ *	enum sensor_msg_type type;
+ *	...
+ * #ifdef CONFIG_APP_ZBUS_TRACE
+ *	uint32_t trace_cycles;
+ * #endif
+ * };
+ * @endcode
+ *
+ * Messages with trace_cycles == 0 (e.g. ZBUS_MSG_INIT values or publishers
+ * that do not call zbus_trace_stamp()) are ignored at dispatch.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of log2 latency buckets (bucket 0 = <1 us, last bucket = overflow) */
+#define ZBUS_TRACE_HIST_BUCKETS 24
+
+/** Binary dump magic ("ZBTR", little endian) */
+#define ZBUS_TRACE_DUMP_MAGIC 0x5254425AU
+
+/** Binary dump format version */
+#define ZBUS_TRACE_DUMP_VERSION 1
+
+/** Maximum name length stored per entry in the binary dump */
+#define ZBUS_TRACE_NAME_LEN 16
+
+/**
+ * @brief Traced channel descriptor
+ *
+ * Tells the trace layer where the publish stamp lives inside the channel's
+ * message. Define one per traced channel with ZBUS_TRACE_CHAN_DEFINE().
+ */
+struct zbus_trace_chan {
+	const struct zbus_channel *chan;
+	size_t stamp_offset;
+};
+
+/**
+ * @brief Register a channel for latency tracing
+ *
+ * Place next to ZBUS_CHAN_DEFINE() in the module that owns the channel.
+ *
+ * @param _chan Channel name (as passed to ZBUS_CHAN_DEFINE)
+ * @param _msg_type Message type of the channel, must have a trace_cycles member
+ */
+#define ZBUS_TRACE_CHAN_DEFINE(_chan, _msg_type)					\
+	static const STRUCT_SECTION_ITERABLE(zbus_trace_chan,				\
+					     _CONCAT(zbus_trace_chan_, _chan)) = {	\
+		.chan = &_chan,								\
+		.stamp_offset = offsetof(_msg_type, trace_cycles),			\
+	}
+
+/**
+ * @brief Latency summary for one (channel, subscriber) pair
+ *
+ * Percentiles are bucket upper bounds, so they over-estimate by at most 2x.
+ */
+struct zbus_trace_stats {
+	const struct zbus_channel *chan;
+	const struct zbus_observer *obs;
+	uint32_t count;
+	uint32_t p50_us;
+	uint32_t p99_us;
+	uint32_t max_us;
+	uint32_t avg_us;
+};
+
+/**
+ * @brief Binary dump header
+ *
+ * Followed by entry_count struct zbus_trace_dump_entry records.
+ * All fields are little endian.
+ */
+struct zbus_trace_dump_hdr {
+	uint32_t magic;
+	uint8_t version;
+	uint8_t bucket_count;
+	uint16_t entry_count;
+	uint32_t cycles_per_sec;
+	uint32_t overflow;
+} __packed;
+
+/**
+ * @brief Binary dump record, one per (channel, subscriber) pair
+ *
+ * hist[0] counts latencies below 1 us, hist[i] counts [2^(i-1), 2^i) us and
+ * the last bucket collects everything above.
+ */
+struct zbus_trace_dump_entry {
+	char chan[ZBUS_TRACE_NAME_LEN];
+	char obs[ZBUS_TRACE_NAME_LEN];
+	uint32_t count;
+	uint32_t max_us;
+	uint64_t sum_us;
+	uint32_t hist[ZBUS_TRACE_HIST_BUCKETS];
+} __packed;
+
+/**
+ * @brief Stamp a message with the current cycle count
+ *
+ * Call right before zbus_chan_pub(). No-op for channels without a
+ * ZBUS_TRACE_CHAN_DEFINE().
+ *
+ * @param chan Channel the message is about to be published on
+ * @param msg Message to stamp
+ */
+void zbus_trace_stamp(const struct zbus_channel *chan, void *msg);
+
+/**
+ * @brief Record the publish-to-dispatch latency of a received message
+ *
+ * Call from the subscriber thread after zbus_sub_wait_msg() returned a
+ * message and before smf_run_state() handles it.
+ *
+ * @param obs Subscriber that received the message
+ * @param chan Channel the message came from
+ * @param msg Received message buffer
+ */
+void zbus_trace_dispatch(const struct zbus_observer *obs,
+			 const struct zbus_channel *chan,
+			 const void *msg);
+
+/**
+ * @brief Get the latency summary of one traced pair
+ *
+ * @param idx Pair index, starting at 0
+ * @param stats Output summary
+ * @return 0 on success, -ENOENT when idx is past the last recorded pair
+ */
+int zbus_trace_stats_get(size_t idx, struct zbus_trace_stats *stats);
+
+/**
+ * @brief Export all histograms as a binary dump
+ *
+ * @param buf Output buffer
+ * @param size Size of buf
+ * @return Number of bytes written, or -ENOMEM if buf is too small
+ */
+int zbus_trace_dump(uint8_t *buf, size_t size);
+
+/**
+ * @brief Clear all recorded latencies
+ */
+void zbus_trace_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _ZBUS_TRACE_H_ */
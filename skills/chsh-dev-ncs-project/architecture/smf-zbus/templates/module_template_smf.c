@@ -27,6 +27,39 @@
 
 #include "common/messages.h"
 #include "MODULE_TEMPLATE.h"
+#include "zbus_latest.h"
+
+#include "app_stats.h"
+
+#include "log_hot.h"
+
+#ifdef CONFIG_APP_ZBUS_TRACE
+#include "zbus_trace.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_TRACE
+#include "smf_trace.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_EXECUTOR
+#include "smf_executor.h"
+#endif
+
+#ifdef CONFIG_APP_ZBUS_LANES
+#include "zbus_lanes.h"
+#endif
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+#include "wdt_supervisor.h"
+#endif
+
+#ifdef CONFIG_APP_SMF_IDLE
+#include "smf_idle.h"
+#endif
+
+#ifdef CONFIG_APP_BOOT_GRAPH
+#include "boot_graph.h"
+#endif
 
 /* Register log module */
 LOG_MODULE_REGISTER(MODULE_TEMPLATE, CONFIG_APP_MODULE_TEMPLATE_LOG_LEVEL);
@@ -52,6 +85,27 @@ ZBUS_CHAN_DEFINE(MODULE_TEMPLATE_CHAN,
                  ZBUS_MSG_INIT(.type = MODULE_TEMPLATE_IDLE)
 );
 
+#ifdef CONFIG_APP_ZBUS_TRACE
+/* Register the channel for publish-to-handler latency tracing */
+ZBUS_TRACE_CHAN_DEFINE(MODULE_TEMPLATE_CHAN, struct module_template_msg);
+#endif
+
+#ifdef CONFIG_APP_ZBUS_LANES
+
+/**
+ * Register as a subscriber with HIGH and NORMAL priority lanes.
+ * Control-plane channels go on HIGH so they never wait behind bulk data.
+ */
+ZBUS_LANES_SUBSCRIBER_DEFINE(module_template_sub);
+
+ZBUS_LANES_CHAN_ADD_OBS(BUTTON_CHAN, module_template_sub, HIGH, 0);
+/* Bulk data channels go on the NORMAL lane */
+/* ZBUS_LANES_CHAN_ADD_OBS(SENSOR_CHAN, module_template_sub, NORMAL, 0); */
+/* Status channels where only the latest value matters: last value wins */
+/* ZBUS_LANES_CHAN_ADD_OBS_LATEST(NETWORK_CHAN, module_template_sub, HIGH, 0); */
+
+#else
+
 /**
  * Register as a message subscriber.
  * This allows the module to queue messages from other channels.
@@ -65,6 +119,10 @@ ZBUS_MSG_SUBSCRIBER_DEFINE(module_template_sub);
 ZBUS_CHAN_ADD_OBS(BUTTON_CHAN, module_template_sub, 0);
 /* Add more subscriptions as needed */
 /* ZBUS_CHAN_ADD_OBS(OTHER_CHAN, module_template_sub, 0); */
+/* Status channels where only the latest value matters: last value wins */
+/* ZBUS_LATEST_CHAN_ADD_OBS(NETWORK_CHAN, module_template_sub, 0); */
+
+#endif /* CONFIG_APP_ZBUS_LANES */
 
 /* ============================================================================
  * CONFIGURATION
@@ -72,6 +130,42 @@ ZBUS_CHAN_ADD_OBS(BUTTON_CHAN, module_template_sub, 0);
 
 #define MAX_MSG_SIZE 128  /* Maximum message size this module handles */
 
+/**
+ * Exported to the "stats" shell command (compile out without CONFIG_APP_STATS).
+ * With CONFIG_APP_SMF_EXECUTOR the executor runs the state machine and
+ * exports the same module_template msgs/run_errors/run_us itself.
+ */
+#ifndef CONFIG_APP_SMF_EXECUTOR
+APP_STATS_COUNTER_DEFINE(module_template, msgs);
+APP_STATS_COUNTER_DEFINE(module_template, run_errors);
+APP_STATS_HIST_DEFINE(module_template, run_us);
+#endif
+
+#if defined(CONFIG_APP_STATS) && defined(CONFIG_APP_ZBUS_LANES)
+/*
+ * Messages waiting for this module. A plain message subscriber queues in a
+ * k_fifo without a count, so queue depth is only exported with lanes.
+ */
+static uint32_t stat_queue_depth(void)
+{
+    struct zbus_lane_stats s;
+    uint32_t depth = 0;
+
+    for (int lane = 0; lane < ZBUS_LANE_COUNT; lane++) {
+        zbus_lanes_stats_get(&module_template_sub, lane, &s);
+        depth += s.depth;
+    }
+
+    return depth;
+}
+APP_STATS_FN_DEFINE(module_template, queue_depth, stat_queue_depth);
+#endif
+
+#ifdef CONFIG_APP_ZBUS_LANES
+BUILD_ASSERT(MAX_MSG_SIZE >= CONFIG_APP_ZBUS_LANES_MSG_SIZE_MAX,
+             "msg_buf must hold the largest message a lane can deliver");
+#endif
+
 /* ============================================================================
  * STATE MACHINE DEFINITION
  * ============================================================================ */
@@ -126,9 +220,11 @@ struct module_template_state_obj {
 /* Forward declarations of state handlers */
 static void state_init_entry(void *obj);
 static enum smf_state_result state_init_run(void *obj);
+static void state_init_exit(void *obj);
 static void state_running_entry(void *obj);
 static void state_idle_entry(void *obj);
 static enum smf_state_result state_idle_run(void *obj);
+static void state_idle_exit(void *obj);
 static void state_active_entry(void *obj);
 static enum smf_state_result state_active_run(void *obj);
 static void state_active_exit(void *obj);
@@ -151,7 +247,7 @@ static const struct smf_state states[] = {
     [STATE_INIT] = SMF_CREATE_STATE(
         state_init_entry,
         state_init_run,
-        NULL,                       /* No exit action */
+        state_init_exit,
         NULL,                       /* No parent state */
         NULL                        /* No initial transition */
     ),
@@ -165,7 +261,7 @@ static const struct smf_state states[] = {
     [STATE_IDLE] = SMF_CREATE_STATE(
         state_idle_entry,
         state_idle_run,
-        NULL,                       /* No exit action */
+        state_idle_exit,
         &states[STATE_RUNNING],     /* Parent state */
         NULL                        /* No initial transition */
     ),
@@ -185,6 +281,46 @@ static const struct smf_state states[] = {
     ),
 };
 
+#ifdef CONFIG_APP_SMF_TRACE
+/* Register for the transition trace buffer; one name per state, in order */
+SMF_TRACE_MODULE_DEFINE(module_template, states,
+                        "INIT", "RUNNING", "IDLE", "ACTIVE", "ERROR");
+#endif
+
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+/*
+ * Heartbeat on the shared supervisor; no task_wdt channel of our own.
+ * Fed by the thread loop, or before every run by the executor, which
+ * finds it by the same name.
+ */
+WDT_SUPERVISOR_MODULE_DEFINE(module_template,
+                             CONFIG_APP_MODULE_TEMPLATE_WATCHDOG_TIMEOUT_SECONDS * 1000);
+#endif
+
+#ifdef CONFIG_APP_SMF_IDLE
+/**
+ * Wait without a timeout while in IDLE (see state_idle_entry/exit).
+ * An own task_wdt channel still needs feeding: without the supervisor,
+ * wake up at half the watchdog timeout.
+ */
+SMF_IDLE_MODULE_DEFINE(module_template,
+                       IS_ENABLED(CONFIG_APP_WDT_SUPERVISOR) ? 0 :
+                       CONFIG_APP_MODULE_TEMPLATE_WATCHDOG_TIMEOUT_SECONDS * 500);
+#endif
+
+#ifdef CONFIG_APP_BOOT_GRAPH
+/**
+ * Start only after the modules this one needs are running; list them
+ * after the name. Modules not related through this graph start in
+ * parallel.
+ */
+BOOT_GRAPH_MODULE_DEFINE(module_template);
+/* BOOT_GRAPH_MODULE_DEFINE(module_template, sensor, button); */
+#endif
+
+/* State object (static so the shared executor can reach it too) */
+static struct module_template_state_obj state_obj;
+
 /* ============================================================================
  * HELPER FUNCTIONS
  * ============================================================================ */
@@ -194,10 +330,14 @@ static const struct smf_state states[] = {
  * 
  * @param msg Pointer to the message to publish
  */
-static void module_template_publish(const struct module_template_msg *msg)
+static void module_template_publish(struct module_template_msg *msg)
 {
     int err;
     
+#ifdef CONFIG_APP_ZBUS_TRACE
+    zbus_trace_stamp(&MODULE_TEMPLATE_CHAN, msg);
+#endif
+    
     err = zbus_chan_pub(&MODULE_TEMPLATE_CHAN, msg, K_SECONDS(1));
     if (err) {
         LOG_ERR("Failed to publish message: %d", err);
@@ -241,6 +381,10 @@ static void state_init_entry(void *obj)
 {
     struct module_template_state_obj *state = obj;
     
+#ifdef CONFIG_APP_BOOT_GRAPH
+    boot_graph_mark(BOOT_GRAPH_MODULE(module_template), BOOT_GRAPH_INIT_ENTRY);
+#endif
+    
     LOG_INF("Module initializing");
     
     /* Initialize module-specific data */
@@ -277,6 +421,20 @@ static enum smf_state_result state_init_run(void *obj)
     return SMF_STATE_TRANSITION_HANDLED;
 }
 
+/**
+ * @brief Exit action for INIT state
+ *
+ * Called once when INIT hands over to RUNNING or ERROR.
+ */
+static void state_init_exit(void *obj)
+{
+    ARG_UNUSED(obj);
+    
+#ifdef CONFIG_APP_BOOT_GRAPH
+    boot_graph_mark(BOOT_GRAPH_MODULE(module_template), BOOT_GRAPH_INIT_EXIT);
+#endif
+}
+
 /**
  * @brief Entry action for RUNNING state
  */
@@ -288,6 +446,11 @@ static void state_running_entry(void *obj)
     
     LOG_INF("Module running");
     
+#ifdef CONFIG_APP_BOOT_GRAPH
+    /* Release the modules that wait for this one */
+    boot_graph_done(BOOT_GRAPH_MODULE(module_template));
+#endif
+    
     /* Publish status */
     module_template_publish(&msg);
 }
@@ -298,6 +461,11 @@ static void state_running_entry(void *obj)
 static void state_idle_entry(void *obj)
 {
     LOG_DBG("Module idle, waiting for events");
+    
+#ifdef CONFIG_APP_SMF_IDLE
+    /* Only messages can move us on: stop the periodic timeout */
+    smf_idle_enter(SMF_IDLE_MODULE(module_template));
+#endif
 }
 
 /**
@@ -322,6 +490,18 @@ static enum smf_state_result state_idle_run(void *obj)
     return SMF_STATE_WAIT_FOR_EVENT;
 }
 
+/**
+ * @brief Exit action for IDLE state
+ */
+static void state_idle_exit(void *obj)
+{
+    ARG_UNUSED(obj);
+    
+#ifdef CONFIG_APP_SMF_IDLE
+    smf_idle_exit(SMF_IDLE_MODULE(module_template));
+#endif
+}
+
 /**
  * @brief Entry action for ACTIVE state
  */
@@ -350,8 +530,11 @@ static enum smf_state_result state_active_run(void *obj)
     /* Perform work */
     LOG_DBG("Processing... event count: %u", state->event_count);
     
-    /* Simulate some work */
-    k_sleep(K_SECONDS(2));
+    /*
+     * Never k_sleep() here: with CONFIG_APP_SMF_EXECUTOR this runs on a
+     * shared worker. Start long work in the entry action and stay in
+     * ACTIVE until its completion message (or the module timeout) arrives.
+     */
     
     /* Return to IDLE when done */
     smf_set_state(SMF_CTX(state), &states[STATE_IDLE]);
@@ -389,10 +572,11 @@ static void state_error_entry(void *obj)
  */
 static enum smf_state_result state_error_run(void *obj)
 {
-    /* Stay in error state */
-    /* In production, might attempt recovery */
-    k_sleep(K_SECONDS(10));
-    
+    /*
+     * Stay in error state without blocking. In production, attempt
+     * recovery when the module timeout runs the state machine with
+     * state->chan == NULL.
+     */
     return SMF_STATE_WAIT_FOR_EVENT;
 }
 
@@ -400,25 +584,86 @@ static enum smf_state_result state_error_run(void *obj)
  * MODULE THREAD
  * ============================================================================ */
 
+#ifdef CONFIG_APP_SMF_EXECUTOR
+
+/**
+ * Run on the shared executor instead of a dedicated thread.
+ * Saves CONFIG_APP_MODULE_TEMPLATE_STACK_SIZE of RAM; state handlers then
+ * share a worker with other modules and must not block (no k_sleep()).
+ */
+#ifdef CONFIG_APP_ZBUS_LANES
+SMF_EXECUTOR_LANES_MODULE_DEFINE(module_template, module_template_sub, state_obj,
+                                 &states[STATE_INIT],
+                                 CONFIG_APP_MODULE_TEMPLATE_MSG_PROCESSING_TIMEOUT_SECONDS * 1000,
+                                 NULL);
+#else
+SMF_EXECUTOR_MODULE_DEFINE(module_template, module_template_sub, state_obj,
+                           &states[STATE_INIT],
+                           CONFIG_APP_MODULE_TEMPLATE_MSG_PROCESSING_TIMEOUT_SECONDS * 1000,
+                           NULL);
+#endif
+
+#else
+
+/**
+ * @brief Run the state machine once
+ *
+ * @param chan Channel of the message in state_obj.msg_buf, NULL for a run
+ *             without a message (initial run, timeout, smf_idle_kick())
+ */
+static void module_template_run(const struct zbus_channel *chan)
+{
+    int err;
+#ifdef CONFIG_APP_SMF_TRACE
+    const struct smf_state *prev_state = SMF_CTX(&state_obj)->current;
+#endif
+#ifdef CONFIG_APP_STATS
+    uint32_t run_start = k_cycle_get_32();
+#endif
+    
+    state_obj.chan = chan;
+    
+    err = smf_run_state(SMF_CTX(&state_obj));
+    if (err) {
+        LOG_ERR("State machine run error: %d", err);
+        APP_STATS_INC(module_template, run_errors);
+    }
+    
+#ifdef CONFIG_APP_STATS
+    APP_STATS_RECORD(module_template, run_us,
+                     k_cyc_to_us_floor32(k_cycle_get_32() - run_start));
+#endif
+    
+#ifdef CONFIG_APP_SMF_TRACE
+    smf_trace_record(SMF_TRACE_MODULE(module_template), prev_state,
+                     SMF_CTX(&state_obj)->current, chan);
+#endif
+}
+
 /**
  * @brief Main module thread
  * 
  * This thread:
- * 1. Initializes the state machine
- * 2. Runs the state machine
+ * 1. Initializes the state machine and runs the initial state
+ * 2. Feeds the watchdog
  * 3. Waits for messages
- * 4. Processes messages through the state machine
- * 5. Feeds the watchdog
+ * 4. Runs the state machine once per message, or with chan == NULL
+ *    when the wait times out
  */
 static void module_template_thread(void)
 {
     int err;
-    struct module_template_state_obj state_obj = {0};
     const struct zbus_channel *chan;
+#ifndef CONFIG_APP_WDT_SUPERVISOR
     int task_wdt_id;
+#endif
+#if defined(CONFIG_APP_SMF_IDLE) && defined(CONFIG_APP_ZBUS_LANES)
+    uint32_t wait_ms;
+#endif
     
     LOG_INF("Module thread started");
     
+#ifndef CONFIG_APP_WDT_SUPERVISOR
     /* Register with task watchdog */
     task_wdt_id = task_wdt_add(
         CONFIG_APP_MODULE_TEMPLATE_WATCHDOG_TIMEOUT_SECONDS * 1000,
@@ -428,52 +673,103 @@ static void module_template_thread(void)
     if (task_wdt_id < 0) {
         LOG_ERR("Failed to add task watchdog: %d", task_wdt_id);
     }
+#endif
+    
+#ifdef CONFIG_APP_BOOT_GRAPH
+    /* Wait for the dependencies declared in BOOT_GRAPH_MODULE_DEFINE() */
+    boot_graph_wait(BOOT_GRAPH_MODULE(module_template));
+#endif
     
     /* Set initial state */
     smf_set_initial(SMF_CTX(&state_obj), &states[STATE_INIT]);
     
+#ifdef CONFIG_APP_SMF_TRACE
+    smf_trace_record(SMF_TRACE_MODULE(module_template), NULL,
+                     SMF_CTX(&state_obj)->current, NULL);
+#endif
+    
+    /* Run the initial state once, without a message */
+    module_template_run(NULL);
+    
     /* Main loop */
     while (1) {
         /* Feed watchdog */
+#ifdef CONFIG_APP_WDT_SUPERVISOR
+        wdt_supervisor_feed(WDT_SUPERVISOR_MODULE(module_template));
+#else
         if (task_wdt_id >= 0) {
             err = task_wdt_feed(task_wdt_id);
             if (err) {
                 LOG_ERR("Failed to feed watchdog: %d", err);
             }
         }
-        
-        /* Run state machine (process current state) */
-        err = smf_run_state(SMF_CTX(&state_obj));
-        if (err) {
-            LOG_ERR("State machine run error: %d", err);
-        }
+#endif
         
         /* Wait for message with timeout */
+#if defined(CONFIG_APP_SMF_IDLE) && defined(CONFIG_APP_ZBUS_LANES)
+        /* No timeout while IDLE; lanes have no kick, messages only */
+        wait_ms = smf_idle_wait_begin(
+            SMF_IDLE_MODULE(module_template),
+            CONFIG_APP_MODULE_TEMPLATE_MSG_PROCESSING_TIMEOUT_SECONDS * 1000
+        );
+        err = zbus_lanes_wait_msg(
+            &module_template_sub,
+            &chan,
+            state_obj.msg_buf,
+            wait_ms ? K_MSEC(wait_ms) : K_FOREVER
+        );
+        smf_idle_wait_end(SMF_IDLE_MODULE(module_template),
+                          err ? SMF_IDLE_WAKE_TIMEOUT : SMF_IDLE_WAKE_MSG);
+#elif defined(CONFIG_APP_SMF_IDLE)
+        /* No timeout while IDLE; returns -ENOMSG on timeout or kick */
+        err = smf_idle_wait_msg(
+            SMF_IDLE_MODULE(module_template),
+            &module_template_sub,
+            &chan,
+            state_obj.msg_buf,
+            CONFIG_APP_MODULE_TEMPLATE_MSG_PROCESSING_TIMEOUT_SECONDS * 1000
+        );
+#elif defined(CONFIG_APP_ZBUS_LANES)
+        /* HIGH lane first, then NORMAL */
+        err = zbus_lanes_wait_msg(
+            &module_template_sub,
+            &chan,
+            state_obj.msg_buf,
+            K_SECONDS(CONFIG_APP_MODULE_TEMPLATE_MSG_PROCESSING_TIMEOUT_SECONDS)
+        );
+#else
         err = zbus_sub_wait_msg(
             &module_template_sub,
             &chan,
             state_obj.msg_buf,
             K_SECONDS(CONFIG_APP_MODULE_TEMPLATE_MSG_PROCESSING_TIMEOUT_SECONDS)
         );
+#endif
         
-        if (err == -EAGAIN) {
-            /* Timeout - no message received, continue */
-            continue;
+        if (err == -EAGAIN || err == -ENOMSG) {
+            /* Timeout (or smf_idle_kick()) - run once without a message */
+            chan = NULL;
         } else if (err) {
             LOG_ERR("zbus_sub_wait_msg error: %d", err);
             continue;
+        } else {
+            APP_STATS_INC(module_template, msgs);
+            
+#ifndef CONFIG_APP_ZBUS_LANES
+            /* Latest value of a coalesced status channel */
+            zbus_latest_received(&module_template_sub, chan, state_obj.msg_buf);
+#endif
+            
+#if defined(CONFIG_APP_ZBUS_TRACE) && !defined(CONFIG_APP_ZBUS_LANES)
+            /* Record how long the message waited in the subscriber queue */
+            zbus_trace_dispatch(&module_template_sub, chan, state_obj.msg_buf);
+#endif
+            
+            /* Once per message: sampled, compiles out without CONFIG_APP_LOG_HOT */
+            LOG_HOT_DBG(16, 1000, "Message received on channel: %s", zbus_chan_name(chan));
         }
         
-        /* Message received - store channel info */
-        state_obj.chan = chan;
-        
-        LOG_DBG("Message received on channel: %s", zbus_chan_name(chan));
-        
-        /* Run state machine to process the message */
-        err = smf_run_state(SMF_CTX(&state_obj));
-        if (err) {
-            LOG_ERR("State machine message processing error: %d", err);
-        }
+        module_template_run(chan);
     }
 }
 
@@ -484,3 +780,5 @@ K_THREAD_DEFINE(module_template_thread_id,
                 NULL, NULL, NULL,
                 CONFIG_APP_MODULE_TEMPLATE_THREAD_PRIORITY,
                 0, 0);
+
+#endif /* CONFIG_APP_SMF_EXECUTOR */
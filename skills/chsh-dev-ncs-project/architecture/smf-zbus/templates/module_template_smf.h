@@ -30,9 +30,16 @@ struct module_template_msg {
     enum module_template_msg_type type;
     uint32_t timestamp;
     int32_t value;
+#ifdef CONFIG_APP_ZBUS_TRACE
+    uint32_t trace_cycles;  /* Publish timestamp, set by zbus_trace_stamp() */
+#endif
 };
 
-/* Declare the channel (defined in .c file) */
+/*
+ * Declare the channel (defined in .c file). Every message is a status, so
+ * observers should use ZBUS_LATEST_CHAN_ADD_OBS() (or the lanes variant):
+ * a flapping module then queues one message per observer, not one per change.
+ */
 extern const struct zbus_channel MODULE_TEMPLATE_CHAN;
 
 #endif /* MODULE_TEMPLATE_H */
@@ -0,0 +1,69 @@
+#!/usr/bin/env bash
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+# Build and run the log benchmark on native_sim in text and dictionary mode.
+#
+# Usage: ./run.sh [baud]     (baud only scales the UART ceiling, default 115200)
+#
+
+set -euo pipefail
+
+HERE="$(cd "$(dirname "$0")" && pwd)"
+OVERLAY="$HERE/../../overlays/overlay-log-dictionary.conf"
+DICT_LOG="$HERE/../scripts/dict_log.py"
+OUT="${OUT:-$HERE/out}"
+BAUD="${1:-115200}"
+
+mkdir -p "$OUT"
+
+west build -b native_sim -p always -d "$OUT/build_text" "$HERE"
+west build -b native_sim -p always -d "$OUT/build_dict" "$HERE" -- \
+    -DEXTRA_CONF_FILE="$OVERLAY"
+
+# Runs until main() is done; -stop_at is only a safety net (simulated time)
+run() {
+    local build="$1" raw="$2" start end
+    start=$(date +%s%N)
+    "$build/zephyr/zephyr.exe" -stop_at=600 > "$raw"
+    end=$(date +%s%N)
+    echo $(( (end - start) / 1000000 ))
+}
+
+text_ms=$(run "$OUT/build_text" "$OUT/text.log")
+dict_ms=$(run "$OUT/build_dict" "$OUT/dict.bin")
+
+# Parser may complain about the simulator's trailing text; results come first
+python3 "$DICT_LOG" decode "$OUT/dict.bin" -d "$OUT/build_dict" \
+    > "$OUT/dict.log" 2>&1 || true
+
+report() {
+    local mode="$1" log="$2" raw="$3" ms="$4"
+    local msgs burst bytes
+
+    if ! grep -q "BENCH done" "$log"; then
+        echo "$mode: no results in $log" >&2
+        return 1
+    fi
+
+    msgs=$(grep -o "phase=throughput msgs=[0-9]*" "$log" | grep -o "[0-9]*$")
+    burst=$(grep -o "phase=burst msgs=[0-9]*" "$log" | grep -o "[0-9]*$")
+    bytes=$(stat -c %s "$raw")
+
+    echo "== $mode"
+    grep -o "BENCH phase=.*" "$log"
+    awk -v ms="$ms" -v n="$msgs" -v b="$burst" -v bytes="$bytes" -v baud="$BAUD" 'BEGIN {
+        # A fast host can finish below the 1 ms resolution
+        if (ms < 1) ms = 1
+        per_msg = bytes / (n + b)
+        printf "host_time_ms=%d msgs_per_s=%.0f ns_per_msg=%.0f\n",
+               ms, n / (ms / 1000), ms * 1e6 / n
+        printf "wire_bytes=%d bytes_per_msg=%.1f uart_ceiling_msgs_per_s@%d=%.0f\n",
+               bytes, per_msg, baud, baud / 10 / per_msg
+    }'
+}
+
+report text "$OUT/text.log" "$OUT/text.log" "$text_ms"
+report dictionary "$OUT/dict.log" "$OUT/dict.bin" "$dict_ms"
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file main.c
+ * @brief Text vs dictionary logging benchmark (native_sim)
+ *
+ * Two phases, each reported as a "BENCH key=value" line:
+ * - throughput: CONFIG_LOG_BENCHMARK_MSGS messages in batches, each drained
+ *   before the next so the log thread keeps up. run.sh times the whole run,
+ *   so host wall time per message is the full cost of producing, processing
+ *   and emitting one message.
+ * - burst: CONFIG_LOG_BENCHMARK_BURST_MSGS messages back-to-back from a
+ *   thread that outranks the log thread, then the dropped count.
+ *
+ * The log statements mimic the templates (integer args, a channel name).
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
+
+LOG_MODULE_REGISTER(log_benchmark, LOG_LEVEL_INF);
+
+static const char *const chan_names[] = {
+	"SENSOR_CHAN", "BUTTON_CHAN", "MODULE_TEMPLATE_CHAN",
+};
+
+/* Backend that prints nothing and counts the drops the core reports to every backend */
+static atomic_t dropped_count;
+
+static void counter_process(const struct log_backend *const backend,
+			    union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(msg);
+}
+
+static void counter_dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+	atomic_add(&dropped_count, cnt);
+}
+
+static void counter_panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api counter_api = {
+	.process = counter_process,
+	.dropped = counter_dropped,
+	.panic = counter_panic,
+};
+
+LOG_BACKEND_DEFINE(log_benchmark_drops, counter_api, true);
+
+static void log_one(uint32_t i)
+{
+	LOG_INF("Message %u on channel %s: temp=%d.%02d hum=%u%%",
+		i, chan_names[i % ARRAY_SIZE(chan_names)],
+		20 + (int)(i % 10), (int)(i % 100), 40 + i % 20);
+}
+
+static uint32_t drain(void)
+{
+	while (log_data_pending()) {
+		k_msleep(1);
+	}
+
+	/* The log thread reports drops after freeing the last message */
+	k_msleep(1);
+
+	/* Drops reported by the log thread since the last drain */
+	return (uint32_t)atomic_clear(&dropped_count);
+}
+
+int main(void)
+{
+	uint32_t dropped = 0;
+	uint32_t max_usage = 0;
+
+	printk("BENCH mode=%s buffer=%d\n",
+	       IS_ENABLED(CONFIG_LOG_BACKEND_UART_OUTPUT_DICTIONARY) ? "dictionary" : "text",
+	       CONFIG_LOG_BUFFER_SIZE);
+	drain();
+
+	for (uint32_t i = 0; i < CONFIG_LOG_BENCHMARK_MSGS; i++) {
+		log_one(i);
+		if ((i % CONFIG_LOG_BENCHMARK_BATCH) == CONFIG_LOG_BENCHMARK_BATCH - 1) {
+			dropped += drain();
+		}
+	}
+	dropped += drain();
+
+	printk("BENCH phase=throughput msgs=%d dropped=%u\n",
+	       CONFIG_LOG_BENCHMARK_MSGS, dropped);
+	drain();
+
+	/* Main (priority 0) outranks the log thread: nothing drains until the
+	 * loop is done, then the log thread reports the drops
+	 */
+	for (uint32_t i = 0; i < CONFIG_LOG_BENCHMARK_BURST_MSGS; i++) {
+		log_one(i);
+	}
+	(void)log_mem_get_max_usage(&max_usage);
+	dropped = drain();
+
+	printk("BENCH phase=burst msgs=%d dropped=%u buffer_max_usage=%u\n",
+	       CONFIG_LOG_BENCHMARK_BURST_MSGS, dropped, max_usage);
+	printk("BENCH done\n");
+
+	return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env bash
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+# Run the performance suite with twister and check the thresholds.
+#
+# Usage: ./run.sh [twister args]    e.g. ./run.sh -p native_sim
+#        UPDATE=1 ./run.sh           re-baseline thresholds.json
+#
+
+set -euo pipefail
+
+HERE="$(cd "$(dirname "$0")" && pwd)"
+CHECK="$HERE/../scripts/perf_check.py"
+OUT="${OUT:-$HERE/out}"
+
+if [ $# -eq 0 ]; then
+    set -- -p native_sim -p qemu_x86
+fi
+
+# One build/run at a time: parallel jobs share the CPU and skew the timings
+west twister -T "$HERE" --outdir "$OUT" -j 1 --inline-logs "$@"
+
+if [ -n "${UPDATE:-}" ]; then
+    python3 "$CHECK" "$OUT" -t "$HERE/thresholds.json" --update
+else
+    python3 "$CHECK" "$OUT" -t "$HERE/thresholds.json" -o "$OUT/perf_results.json"
+fi
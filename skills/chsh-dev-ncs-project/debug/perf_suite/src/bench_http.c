@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file bench_http.c
+ * @brief HTTP resource serving over loopback
+ *
+ * The two resource kinds of protocols/webserver/templates, served by the
+ * Zephyr HTTP server and fetched by main on a new connection per request:
+ * - http_static: gzipped page embedded as a .gz.inc file
+ * - http_dynamic: JSON status built by a dynamic resource callback
+ *
+ * Each sample covers connect, request, the full response and close.
+ * Uses the Zephyr 4.x dynamic resource API (request/response contexts).
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "perf.h"
+
+static uint16_t http_port = CONFIG_PERF_SUITE_HTTP_PORT;
+HTTP_SERVICE_DEFINE(perf_http, "127.0.0.1", &http_port, 1, 4, NULL);
+
+static const uint8_t index_html_gz[] = {
+#include "index.html.gz.inc"
+};
+
+static struct http_resource_detail_static index_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.content_encoding = "gzip",
+		.content_type = "text/html",
+	},
+	.static_data = index_html_gz,
+	.static_data_len = sizeof(index_html_gz),
+};
+
+HTTP_RESOURCE_DEFINE(index_resource, perf_http, "/", &index_detail);
+
+static int status_cb(struct http_client_ctx *client, enum http_data_status status,
+		     const struct http_request_ctx *request_ctx,
+		     struct http_response_ctx *response_ctx, void *user_data)
+{
+	static char json[64];
+	int len;
+
+	ARG_UNUSED(client);
+	ARG_UNUSED(request_ctx);
+	ARG_UNUSED(user_data);
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	len = snprintk(json, sizeof(json), "{\"uptime\":%u,\"temp\":25.5}", k_uptime_get_32());
+	response_ctx->body = (const uint8_t *)json;
+	response_ctx->body_len = len;
+	response_ctx->final_chunk = true;
+
+	return 0;
+}
+
+static uint8_t status_buf[512];
+
+static struct http_resource_detail_dynamic status_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.content_type = "application/json",
+	},
+	.cb = status_cb,
+	.data_buffer = status_buf,
+	.data_buffer_len = sizeof(status_buf),
+};
+
+HTTP_RESOURCE_DEFINE(status_resource, perf_http, "/api/status", &status_detail);
+
+/* Whole response, headers included */
+static char rx[4096];
+
+/* Value of a header in the received headers, NULL if absent */
+static const char *header_find(const char *hdr, size_t hdr_len, const char *name)
+{
+	size_t name_len = strlen(name);
+
+	for (size_t i = 0; i + name_len < hdr_len; i++) {
+		if ((i == 0 || hdr[i - 1] == '\n') && strncasecmp(&hdr[i], name, name_len) == 0) {
+			return &hdr[i + name_len];
+		}
+	}
+
+	return NULL;
+}
+
+/* True once the response in rx[0..len) is complete */
+static bool response_done(size_t len)
+{
+	const char *end = NULL;
+	const char *cl;
+	size_t hdr_len;
+
+	for (size_t i = 0; i + 4 <= len; i++) {
+		if (memcmp(&rx[i], "\r\n\r\n", 4) == 0) {
+			end = &rx[i + 4];
+			break;
+		}
+	}
+	if (end == NULL) {
+		return false;
+	}
+
+	hdr_len = end - rx;
+	cl = header_find(rx, hdr_len, "Content-Length:");
+	if (cl) {
+		return len >= hdr_len + strtoul(cl, NULL, 10);
+	}
+
+	/* Chunked: the zero-length last chunk */
+	return len >= hdr_len + 5 && memcmp(&rx[len - 5], "0\r\n\r\n", 5) == 0;
+}
+
+static int http_get(const char *path)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONFIG_PERF_SUITE_HTTP_PORT),
+	};
+	char req[96];
+	size_t len = 0;
+	ssize_t n;
+	int sock;
+	int err = 0;
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		err = -errno;
+		goto out;
+	}
+
+	n = snprintk(req, sizeof(req),
+		     "GET %s HTTP/1.1\r\nHost: 127.0.0.1\r\nAccept-Encoding: gzip\r\n\r\n", path);
+	if (zsock_send(sock, req, n, 0) != n) {
+		err = -EIO;
+		goto out;
+	}
+
+	while (!response_done(len)) {
+		if (len == sizeof(rx)) {
+			err = -ENOBUFS;
+			goto out;
+		}
+		n = zsock_recv(sock, &rx[len], sizeof(rx) - len, 0);
+		if (n <= 0) {
+			err = n ? -errno : -ECONNRESET;
+			goto out;
+		}
+		len += n;
+	}
+
+	if (strncmp(rx, "HTTP/1.1 200", 12) != 0) {
+		err = -EPROTO;
+	}
+
+out:
+	zsock_close(sock);
+
+	return err;
+}
+
+static int run(const char *metric, const char *path)
+{
+	struct perf_stat stat = {0};
+	uint32_t start;
+	int failed = 0;
+
+	for (uint32_t i = 0; i < CONFIG_PERF_SUITE_HTTP_REQUESTS; i++) {
+		start = perf_stamp();
+		if (http_get(path)) {
+			failed++;
+			continue;
+		}
+		perf_stat_add(&stat, perf_ns_since(start));
+	}
+
+	perf_report(metric, &stat);
+
+	return failed;
+}
+
+int bench_http_run(void)
+{
+	int failed = 0;
+	int err;
+
+	err = http_server_start();
+	if (err) {
+		printk("PERF http server start failed: %d\n", err);
+		return 1;
+	}
+
+	/* Let the server thread open its listening socket */
+	k_sleep(K_MSEC(100));
+
+	printk("PERF http static_bytes=%u\n", (uint32_t)sizeof(index_html_gz));
+
+	failed += run("http_static", "/");
+	failed += run("http_dynamic", "/api/status");
+
+	return failed;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file bench_queue.c
+ * @brief Queue hand-off cost for the simple multi-threaded template
+ *
+ * main sends CONFIG_PERF_SUITE_ITERATIONS messages of the
+ * module_template_simple.c message type to a receiving thread of higher
+ * priority, so every send wakes the receiver as in the template. The
+ * batch time per message covers send, context switch and receive:
+ * - queue_msgq: k_msgq copy in and out (what the template uses)
+ * - queue_fifo_slab: k_mem_slab block passed by pointer through a k_fifo
+ * - queue_ring_sem: ring buffer copy plus a counting semaphore
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include "perf.h"
+
+/* Same layout as struct module_message in module_template_simple.c */
+struct module_message {
+	int type;
+	void *data;
+	size_t data_len;
+	uint32_t timestamp;
+};
+
+/* Template queue depth */
+#define QUEUE_DEPTH 10
+
+struct fifo_item {
+	void *fifo_reserved;
+	struct module_message msg;
+};
+
+K_MSGQ_DEFINE(bench_msgq, sizeof(struct module_message), QUEUE_DEPTH, 4);
+
+static K_FIFO_DEFINE(bench_fifo);
+K_MEM_SLAB_DEFINE_STATIC(bench_slab, sizeof(struct fifo_item), QUEUE_DEPTH, 4);
+
+RING_BUF_DECLARE(bench_ring, QUEUE_DEPTH * sizeof(struct module_message));
+static K_SEM_DEFINE(ring_sem, 0, QUEUE_DEPTH);
+static struct k_spinlock ring_lock;
+
+/* Messages handled by the receivers; main waits for all of them */
+static atomic_t received;
+static K_SEM_DEFINE(all_received, 0, 1);
+static uint32_t expected;
+
+static void consume(const struct module_message *msg)
+{
+	ARG_UNUSED(msg);
+
+	if ((uint32_t)atomic_inc(&received) + 1 == expected) {
+		k_sem_give(&all_received);
+	}
+}
+
+static void msgq_thread(void)
+{
+	struct module_message msg;
+
+	while (true) {
+		if (k_msgq_get(&bench_msgq, &msg, K_FOREVER) == 0) {
+			consume(&msg);
+		}
+	}
+}
+
+static void fifo_thread(void)
+{
+	struct fifo_item *item;
+
+	while (true) {
+		item = k_fifo_get(&bench_fifo, K_FOREVER);
+		consume(&item->msg);
+		k_mem_slab_free(&bench_slab, item);
+	}
+}
+
+static void ring_thread(void)
+{
+	struct module_message msg;
+	k_spinlock_key_t key;
+	uint32_t len;
+
+	while (true) {
+		k_sem_take(&ring_sem, K_FOREVER);
+
+		key = k_spin_lock(&ring_lock);
+		len = ring_buf_get(&bench_ring, (uint8_t *)&msg, sizeof(msg));
+		k_spin_unlock(&ring_lock, key);
+
+		if (len == sizeof(msg)) {
+			consume(&msg);
+		}
+	}
+}
+
+K_THREAD_DEFINE(bench_msgq_tid, 1024, msgq_thread, NULL, NULL, NULL,
+		CONFIG_PERF_SUITE_MODULE_PRIORITY, 0, 0);
+K_THREAD_DEFINE(bench_fifo_tid, 1024, fifo_thread, NULL, NULL, NULL,
+		CONFIG_PERF_SUITE_MODULE_PRIORITY, 0, 0);
+K_THREAD_DEFINE(bench_ring_tid, 1024, ring_thread, NULL, NULL, NULL,
+		CONFIG_PERF_SUITE_MODULE_PRIORITY, 0, 0);
+
+static int send_msgq(const struct module_message *msg)
+{
+	return k_msgq_put(&bench_msgq, msg, K_SECONDS(1));
+}
+
+static int send_fifo(const struct module_message *msg)
+{
+	struct fifo_item *item;
+	int err;
+
+	err = k_mem_slab_alloc(&bench_slab, (void **)&item, K_SECONDS(1));
+	if (err) {
+		return err;
+	}
+
+	item->msg = *msg;
+	k_fifo_put(&bench_fifo, item);
+
+	return 0;
+}
+
+static int send_ring(const struct module_message *msg)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+	uint32_t len = ring_buf_put(&bench_ring, (const uint8_t *)msg, sizeof(*msg));
+
+	k_spin_unlock(&ring_lock, key);
+
+	if (len != sizeof(*msg)) {
+		return -ENOMEM;
+	}
+
+	k_sem_give(&ring_sem);
+
+	return 0;
+}
+
+static int run(const char *metric, int (*send)(const struct module_message *msg),
+	       uint32_t count)
+{
+	struct module_message msg = { .type = 3 /* MSG_TYPE_DATA */ };
+	uint32_t start;
+	uint32_t ns;
+	int failed = 0;
+
+	atomic_clear(&received);
+	expected = count;
+	k_sem_reset(&all_received);
+
+	start = perf_stamp();
+	for (uint32_t i = 0; i < count; i++) {
+		msg.timestamp = i;
+		if (send(&msg)) {
+			failed++;
+			expected--;
+		}
+	}
+
+	if (expected && k_sem_take(&all_received, K_SECONDS(5))) {
+		failed++;
+	}
+	ns = perf_ns_since(start);
+
+	if (metric) {
+		perf_report_batch(metric, count, ns);
+	}
+
+	return failed;
+}
+
+int bench_queue_run(void)
+{
+	int failed = 0;
+
+	/* Warm-up runs are not reported */
+	failed += run(NULL, send_msgq, CONFIG_PERF_SUITE_WARMUP);
+	failed += run("queue_msgq", send_msgq, CONFIG_PERF_SUITE_ITERATIONS);
+	failed += run(NULL, send_fifo, CONFIG_PERF_SUITE_WARMUP);
+	failed += run("queue_fifo_slab", send_fifo, CONFIG_PERF_SUITE_ITERATIONS);
+	failed += run(NULL, send_ring, CONFIG_PERF_SUITE_WARMUP);
+	failed += run("queue_ring_sem", send_ring, CONFIG_PERF_SUITE_ITERATIONS);
+
+	return failed;
+}
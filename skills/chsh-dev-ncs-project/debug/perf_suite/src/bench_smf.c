@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file bench_smf.c
+ * @brief SMF cost for the module_template_smf.c state tree
+ *
+ * Same tree as the template: INIT, RUNNING (parent, initial IDLE) with
+ * IDLE and ACTIVE as children, and ERROR. State actions only count, so
+ * the numbers are framework overhead:
+ * - smf_run: smf_run_state() in IDLE, handled without a transition
+ * - smf_sibling: IDLE <-> ACTIVE (exit one child, enter the other)
+ * - smf_cross: IDLE -> ERROR -> RUNNING, through the initial transition
+ *   back to IDLE (per transition)
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/smf.h>
+
+#include "perf.h"
+
+enum bench_state {
+	STATE_INIT,
+	STATE_RUNNING,
+	STATE_IDLE,
+	STATE_ACTIVE,
+	STATE_ERROR,
+};
+
+struct bench_obj {
+	struct smf_ctx ctx;
+	uint32_t actions;
+};
+
+static struct bench_obj obj;
+
+static void count_entry(void *o)
+{
+	((struct bench_obj *)o)->actions++;
+}
+
+static enum smf_state_result count_run(void *o)
+{
+	((struct bench_obj *)o)->actions++;
+
+	return SMF_EVENT_HANDLED;
+}
+
+static const struct smf_state states[] = {
+	[STATE_INIT] = SMF_CREATE_STATE(count_entry, count_run, NULL, NULL, NULL),
+	[STATE_RUNNING] = SMF_CREATE_STATE(count_entry, NULL, NULL, NULL,
+					   &states[STATE_IDLE]),
+	[STATE_IDLE] = SMF_CREATE_STATE(count_entry, count_run, count_entry,
+					&states[STATE_RUNNING], NULL),
+	[STATE_ACTIVE] = SMF_CREATE_STATE(count_entry, count_run, count_entry,
+					  &states[STATE_RUNNING], NULL),
+	[STATE_ERROR] = SMF_CREATE_STATE(count_entry, count_run, NULL, NULL, NULL),
+};
+
+static void bench_run(uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++) {
+		(void)smf_run_state(SMF_CTX(&obj));
+	}
+}
+
+static void bench_sibling(uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++) {
+		smf_set_state(SMF_CTX(&obj), &states[(i & 1) ? STATE_IDLE : STATE_ACTIVE]);
+	}
+}
+
+static void bench_cross(uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++) {
+		smf_set_state(SMF_CTX(&obj), &states[(i & 1) ? STATE_RUNNING : STATE_ERROR]);
+	}
+}
+
+static void run(const char *metric, void (*bench)(uint32_t count))
+{
+	uint32_t start;
+	uint32_t ns;
+
+	/* Every run starts in IDLE and ends there (even count) */
+	smf_set_initial(SMF_CTX(&obj), &states[STATE_RUNNING]);
+	bench(CONFIG_PERF_SUITE_WARMUP & ~1U);
+
+	start = perf_stamp();
+	bench(CONFIG_PERF_SUITE_ITERATIONS & ~1U);
+	ns = perf_ns_since(start);
+
+	perf_report_batch(metric, CONFIG_PERF_SUITE_ITERATIONS & ~1U, ns);
+}
+
+int bench_smf_run(void)
+{
+	run("smf_run", bench_run);
+	run("smf_sibling", bench_sibling);
+	run("smf_cross", bench_cross);
+
+	/* Keep the actions from being optimized out, and catch a broken tree */
+	return (obj.actions == 0) ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file bench_zbus.c
+ * @brief zbus publish-to-handler latency
+ *
+ * One channel per observer type, each with a single observer. main
+ * stamps a message, publishes it and waits until the handler has seen
+ * it, so every sample is one uncontended publish:
+ * - zbus_msg_sub: message subscriber, as in module_template_smf.c
+ * - zbus_sub: subscriber + zbus_chan_read(), as in the simple examples
+ * - zbus_listener: synchronous callback in the publisher's context
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "perf.h"
+
+/* Sized like a small sensor message */
+struct perf_msg {
+	uint32_t seq;
+	uint32_t stamp;
+	uint8_t payload[24];
+};
+
+ZBUS_CHAN_DEFINE(PERF_MSG_SUB_CHAN, struct perf_msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(PERF_SUB_CHAN, struct perf_msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(PERF_LISTENER_CHAN, struct perf_msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+
+static void listener_cb(const struct zbus_channel *chan);
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(perf_msg_sub);
+ZBUS_SUBSCRIBER_DEFINE(perf_sub, 4);
+ZBUS_LISTENER_DEFINE(perf_listener, listener_cb);
+
+ZBUS_CHAN_ADD_OBS(PERF_MSG_SUB_CHAN, perf_msg_sub, 0);
+ZBUS_CHAN_ADD_OBS(PERF_SUB_CHAN, perf_sub, 0);
+ZBUS_CHAN_ADD_OBS(PERF_LISTENER_CHAN, perf_listener, 0);
+
+/* Where handlers put their sample; a scratch stat during warm-up */
+static struct perf_stat *volatile sink;
+static K_SEM_DEFINE(handled, 0, 1);
+
+static void handled_at(uint32_t stamp)
+{
+	perf_stat_add(sink, perf_ns_since(stamp));
+	k_sem_give(&handled);
+}
+
+static void listener_cb(const struct zbus_channel *chan)
+{
+	const struct perf_msg *msg = zbus_chan_const_msg(chan);
+
+	handled_at(msg->stamp);
+}
+
+static void msg_sub_thread(void)
+{
+	const struct zbus_channel *chan;
+	struct perf_msg msg;
+
+	while (true) {
+		if (zbus_sub_wait_msg(&perf_msg_sub, &chan, &msg, K_FOREVER) == 0) {
+			handled_at(msg.stamp);
+		}
+	}
+}
+
+static void sub_thread(void)
+{
+	const struct zbus_channel *chan;
+	struct perf_msg msg;
+
+	while (true) {
+		if (zbus_sub_wait(&perf_sub, &chan, K_FOREVER) == 0 &&
+		    zbus_chan_read(chan, &msg, K_NO_WAIT) == 0) {
+			handled_at(msg.stamp);
+		}
+	}
+}
+
+K_THREAD_DEFINE(perf_msg_sub_tid, 1024, msg_sub_thread, NULL, NULL, NULL,
+		CONFIG_PERF_SUITE_MODULE_PRIORITY, 0, 0);
+K_THREAD_DEFINE(perf_sub_tid, 1024, sub_thread, NULL, NULL, NULL,
+		CONFIG_PERF_SUITE_MODULE_PRIORITY, 0, 0);
+
+static int run(const char *metric, const struct zbus_channel *chan)
+{
+	struct perf_stat warmup = {0};
+	struct perf_stat stat = {0};
+	struct perf_msg msg = {0};
+	int failed = 0;
+
+	for (uint32_t i = 0; i < CONFIG_PERF_SUITE_WARMUP + CONFIG_PERF_SUITE_ITERATIONS; i++) {
+		sink = (i < CONFIG_PERF_SUITE_WARMUP) ? &warmup : &stat;
+		msg.seq = i;
+		msg.stamp = perf_stamp();
+
+		if (zbus_chan_pub(chan, &msg, K_SECONDS(1)) ||
+		    k_sem_take(&handled, K_SECONDS(1))) {
+			failed++;
+		}
+	}
+
+	perf_report(metric, &stat);
+
+	return failed;
+}
+
+int bench_zbus_run(void)
+{
+	int failed = 0;
+
+	failed += run("zbus_msg_sub", &PERF_MSG_SUB_CHAN);
+	failed += run("zbus_sub", &PERF_SUB_CHAN);
+	failed += run("zbus_listener", &PERF_LISTENER_CHAN);
+
+	return failed;
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file main.c
+ * @brief Message path performance suite (native_sim, qemu_x86)
+ *
+ * Runs each benchmark once and prints "PERF key=value" lines, then
+ * "PERF done failed=<n>" for the twister console harness:
+ * - bench_zbus.c: publish-to-handler latency, message subscriber vs
+ *   subscriber + zbus_chan_read()
+ * - bench_queue.c: k_msgq (module_template_simple.c) vs k_fifo + slab
+ *   vs ring buffer + semaphore
+ * - bench_smf.c: run and transition cost of the module_template_smf.c
+ *   state tree
+ * - bench_http.c: static and dynamic resource serving over loopback
+ *   (perf.http scenario only)
+ */
+
+#include <zephyr/kernel.h>
+
+#include "perf.h"
+
+int main(void)
+{
+	int failed = 0;
+
+	printk("PERF suite board=%s iterations=%d\n", CONFIG_BOARD_TARGET,
+	       CONFIG_PERF_SUITE_ITERATIONS);
+
+	failed += bench_zbus_run();
+	failed += bench_queue_run();
+	failed += bench_smf_run();
+#ifdef CONFIG_PERF_SUITE_HTTP
+	failed += bench_http_run();
+#endif
+
+	printk("PERF done failed=%d\n", failed);
+
+	return 0;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+
+#include "perf.h"
+
+#ifdef CONFIG_NATIVE_LIBRARY
+#include "perf_clock_native.h"
+#endif
+
+uint32_t perf_stamp(void)
+{
+#ifdef CONFIG_NATIVE_LIBRARY
+	return (uint32_t)perf_native_host_ns();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+uint32_t perf_ns_since(uint32_t stamp)
+{
+#ifdef CONFIG_NATIVE_LIBRARY
+	return (uint32_t)perf_native_host_ns() - stamp;
+#else
+	return (uint32_t)MIN(k_cyc_to_ns_floor64(k_cycle_get_32() - stamp), UINT32_MAX);
+#endif
+}
+
+void perf_stat_add(struct perf_stat *s, uint32_t ns)
+{
+	s->n++;
+	s->sum_ns += ns;
+	s->max_ns = MAX(s->max_ns, ns);
+}
+
+void perf_report(const char *metric, const struct perf_stat *s)
+{
+	printk("PERF metric=%s n=%u avg_ns=%u max_ns=%u per_s=%u\n", metric, s->n,
+	       s->n ? (uint32_t)(s->sum_ns / s->n) : 0, s->max_ns,
+	       s->sum_ns ? (uint32_t)(((uint64_t)s->n * NSEC_PER_SEC) / s->sum_ns) : 0);
+}
+
+void perf_report_batch(const char *metric, uint32_t n, uint64_t total_ns)
+{
+	printk("PERF metric=%s n=%u avg_ns=%u per_s=%u\n", metric, n,
+	       n ? (uint32_t)(total_ns / n) : 0,
+	       total_ns ? (uint32_t)(((uint64_t)n * NSEC_PER_SEC) / total_ns) : 0);
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _PERF_H_
+#define _PERF_H_
+
+/**
+ * @file perf.h
+ * @brief Timing and result lines shared by the benchmarks
+ *
+ * Every result is one console line that ../scripts/perf_check.py parses:
+ *
+ *   PERF metric=<name> n=<samples> avg_ns=<avg> [max_ns=<max>] per_s=<rate>
+ *
+ * per_s is the back-to-back rate: samples per second of measured time.
+ */
+
+#include <zephyr/kernel.h>
+
+/** Accumulated per-sample timings */
+struct perf_stat {
+	uint32_t n;
+	uint64_t sum_ns;
+	uint32_t max_ns;
+};
+
+/**
+ * @brief Take a timestamp
+ *
+ * Host clock on native_sim (simulated time stands still while code runs),
+ * cycle counter elsewhere. Only differences are meaningful.
+ */
+uint32_t perf_stamp(void);
+
+/**
+ * @brief Nanoseconds since a perf_stamp(), valid up to ~4 s
+ */
+uint32_t perf_ns_since(uint32_t stamp);
+
+/** Add one sample */
+void perf_stat_add(struct perf_stat *s, uint32_t ns);
+
+/** Print average, maximum and rate of per-sample timings */
+void perf_report(const char *metric, const struct perf_stat *s);
+
+/** Print average and rate of a batch timed as a whole */
+void perf_report_batch(const char *metric, uint32_t n, uint64_t total_ns);
+
+/* Benchmarks, each returns the number of failed operations */
+int bench_zbus_run(void);
+int bench_queue_run(void);
+int bench_smf_run(void);
+int bench_http_run(void);
+
+#endif /* _PERF_H_ */
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file perf_clock_native.c
+ * @brief Host clock for native_sim
+ *
+ * Built into the native simulator runner (host libc), not into the
+ * Zephyr image.
+ */
+
+#include <time.h>
+
+#include "perf_clock_native.h"
+
+uint64_t perf_native_host_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _PERF_CLOCK_NATIVE_H_
+#define _PERF_CLOCK_NATIVE_H_
+
+/* Implemented in perf_clock_native.c against the host C library */
+
+#include <stdint.h>
+
+/** Host monotonic clock in nanoseconds */
+uint64_t perf_native_host_ns(void);
+
+#endif /* _PERF_CLOCK_NATIVE_H_ */
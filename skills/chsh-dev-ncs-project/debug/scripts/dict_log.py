@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Capture and decode dictionary-based (binary) Zephyr logs.
+
+Usage:
+    dict_log.py capture /dev/ttyACM0 -o uart.bin            # raw dump, Ctrl-C to stop
+    dict_log.py capture /dev/ttyACM0 -o uart.bin -t 30      # stop after 30 s
+    dict_log.py decode uart.bin -d build                    # decode a capture
+    dict_log.py decode uart.hex -d build --hex              # CONFIG_..._DICTIONARY_HEX
+
+The dictionary database (log_dictionary.json) is looked up in the build
+directory, including sysbuild layouts (build/<app>/zephyr/). It must come
+from the exact build that is running on the device; a mismatch decodes to
+garbage or fails. Decoding uses Zephyr's own parser from
+$ZEPHYR_BASE/scripts/logging/dictionary.
+"""
+
+import argparse
+import glob
+import os
+import subprocess
+import sys
+import time
+
+DB_NAME = "log_dictionary.json"
+
+
+def find_db(build_dir):
+    for pattern in (os.path.join(build_dir, "zephyr", DB_NAME),
+                    os.path.join(build_dir, "*", "zephyr", DB_NAME)):
+        found = sorted(glob.glob(pattern))
+        if found:
+            return found[0]
+    sys.exit(f"{DB_NAME} not found under {build_dir}; "
+             "was it built with overlay-log-dictionary.conf?")
+
+
+def find_parser():
+    zephyr_base = os.environ.get("ZEPHYR_BASE")
+    if not zephyr_base:
+        sys.exit("ZEPHYR_BASE is not set; source the NCS environment first")
+    parser = os.path.join(zephyr_base, "scripts", "logging", "dictionary",
+                          "log_parser.py")
+    if not os.path.isfile(parser):
+        sys.exit(f"Zephyr dictionary log parser not found: {parser}")
+    return parser
+
+
+def open_serial(port, baud):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("pyserial is required: pip install pyserial")
+    return serial.Serial(port, baud, timeout=0.2)
+
+
+def decode(db, path, hex_input):
+    cmd = [sys.executable, find_parser()]
+    if hex_input:
+        cmd.append("--hex")
+    cmd += [db, path]
+    return subprocess.call(cmd)
+
+
+def cmd_capture(args):
+    ser = open_serial(args.port, args.baud)
+    end = time.monotonic() + args.time if args.time else None
+    total = 0
+
+    with open(args.output, "wb") as out:
+        try:
+            while end is None or time.monotonic() < end:
+                chunk = ser.read(4096)
+                if chunk:
+                    out.write(chunk)
+                    total += len(chunk)
+        except KeyboardInterrupt:
+            pass
+
+    print(f"Captured {total} bytes to {args.output}", file=sys.stderr)
+    return 0
+
+
+def cmd_decode(args):
+    return decode(find_db(args.build_dir), args.input, args.hex)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = ap.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("capture", help="dump raw log bytes from a serial port")
+    p.add_argument("port")
+    p.add_argument("-b", "--baud", type=int, default=115200)
+    p.add_argument("-o", "--output", default="uart.bin")
+    p.add_argument("-t", "--time", type=float, default=0,
+                   help="capture duration in seconds (default: until Ctrl-C)")
+    p.set_defaults(func=cmd_capture)
+
+    p = sub.add_parser("decode", help="decode a captured log file")
+    p.add_argument("input")
+    p.add_argument("-d", "--build-dir", default="build")
+    p.add_argument("--hex", action="store_true",
+                   help="input is hex text (CONFIG_LOG_BACKEND_UART_OUTPUT_DICTIONARY_HEX)")
+    p.set_defaults(func=cmd_decode)
+
+    args = ap.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
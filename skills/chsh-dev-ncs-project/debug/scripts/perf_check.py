@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Collect perf_suite results into JSON and fail on threshold regressions.
+
+Usage:
+    perf_check.py twister-out -t thresholds.json -o results.json   # check
+    perf_check.py twister-out -t thresholds.json --update           # re-baseline
+    perf_check.py handler.log                                       # print only
+
+Inputs are console logs with "PERF" lines, or directories searched for
+twister's handler.log files. Results are keyed by board (the part of
+CONFIG_BOARD_TARGET before "/") and metric.
+
+Threshold file:
+    {"native_sim": {"zbus_msg_sub": {"avg_ns": 20000}, "http_static": {"per_s": 200}}}
+
+Keys ending in _ns are upper bounds, per_s is a lower bound. A metric with
+a threshold but no result is a failure too (a benchmark stopped running).
+--update rewrites the thresholds from the results plus --headroom percent,
+keeping the keys already present and adding avg_ns for new metrics.
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import sys
+
+SUITE_RE = re.compile(r"PERF suite board=(\S+)")
+METRIC_RE = re.compile(r"PERF metric=(\S+)((?:\s+\w+=\d+)+)")
+DONE_RE = re.compile(r"PERF done failed=(\d+)")
+
+
+def log_files(paths):
+    for path in paths:
+        if os.path.isdir(path):
+            yield from sorted(glob.glob(os.path.join(path, "**", "handler.log"), recursive=True))
+        else:
+            yield path
+
+
+def collect(paths):
+    """Return ({board: {metric: {key: value}}}, [errors])."""
+    results = {}
+    errors = []
+    for path in log_files(paths):
+        board = None
+        done = False
+        with open(path, encoding="utf-8", errors="replace") as f:
+            for line in f:
+                m = SUITE_RE.search(line)
+                if m:
+                    board = m.group(1).split("/")[0]
+                    continue
+                m = METRIC_RE.search(line)
+                if m and board:
+                    values = dict(kv.split("=") for kv in m.group(2).split())
+                    results.setdefault(board, {})[m.group(1)] = \
+                        {k: int(v) for k, v in values.items()}
+                    continue
+                m = DONE_RE.search(line)
+                if m and board:
+                    done = True
+                    if int(m.group(1)):
+                        errors.append(f"{path}: {m.group(1)} failed operations")
+        if board and not done:
+            errors.append(f"{path}: run did not finish")
+    return results, errors
+
+
+def check(results, thresholds):
+    """Print a table, return the number of regressions."""
+    failures = 0
+    print(f"{'board':<12} {'metric':<18} {'key':<7} {'result':>12} {'limit':>12}  status")
+    for board, metrics in sorted(thresholds.items()):
+        if board.startswith("_"):
+            continue
+        for metric, limits in sorted(metrics.items()):
+            measured = results.get(board, {}).get(metric)
+            for key, limit in sorted(limits.items()):
+                if measured is None or key not in measured:
+                    if board in results:
+                        print(f"{board:<12} {metric:<18} {key:<7} {'-':>12} {limit:>12}  MISSING")
+                        failures += 1
+                    continue
+                value = measured[key]
+                ok = value >= limit if key == "per_s" else value <= limit
+                margin = (value - limit) * 100 / limit if limit else 0
+                status = "ok" if ok else "REGRESSION"
+                print(f"{board:<12} {metric:<18} {key:<7} {value:>12} {limit:>12}  "
+                      f"{status} ({margin:+.0f}%)")
+                failures += not ok
+    for board, metrics in sorted(results.items()):
+        for metric in sorted(set(metrics) - set(thresholds.get(board, {}))):
+            print(f"# {board} {metric}: no threshold", file=sys.stderr)
+    return failures
+
+
+def update(results, thresholds, headroom):
+    scale = 1 + headroom / 100
+    for board, metrics in results.items():
+        limits = thresholds.setdefault(board, {})
+        for metric, values in metrics.items():
+            keys = limits.get(metric) or {"avg_ns": 0}
+            limits[metric] = {
+                key: int(values[key] / scale) if key == "per_s" else int(values[key] * scale)
+                for key in keys if key in values
+            }
+    return thresholds
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="+", help="twister output dirs or console logs")
+    parser.add_argument("-t", "--thresholds", help="threshold JSON to check against")
+    parser.add_argument("-o", "--output", help="write the results as JSON")
+    parser.add_argument("--update", action="store_true",
+                        help="rewrite the thresholds from these results")
+    parser.add_argument("--headroom", type=float, default=25,
+                        help="percent added to results by --update (default 25)")
+    args = parser.parse_args()
+
+    results, errors = collect(args.inputs)
+    if not results:
+        sys.exit("No PERF results found")
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+            f.write("\n")
+
+    for error in errors:
+        print(f"error: {error}", file=sys.stderr)
+
+    if not args.thresholds:
+        print(json.dumps(results, indent=2, sort_keys=True))
+        sys.exit(1 if errors else 0)
+
+    with open(args.thresholds, encoding="utf-8") as f:
+        thresholds = json.load(f)
+
+    if args.update:
+        with open(args.thresholds, "w", encoding="utf-8") as f:
+            json.dump(update(results, thresholds, args.headroom), f, indent=2, sort_keys=True)
+            f.write("\n")
+        print(f"Thresholds updated with {args.headroom:.0f}% headroom: {args.thresholds}")
+        sys.exit(1 if errors else 0)
+
+    failures = check(results, thresholds)
+    sys.exit(1 if failures or errors else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <dk_buttons_and_leds.h>
+
+#ifdef CONFIG_BASIC_APP_LED_PWM
+#include <zephyr/drivers/pwm.h>
+#endif
+
+#include "led_pattern.h"
+
+LOG_MODULE_REGISTER(led_pattern, LOG_LEVEL_INF);
+
+/* Per-LED engine state */
+struct led_engine {
+	struct k_timer timer;
+	struct k_work work;	/* Writes level to the LED in thread context */
+	struct led_pattern pattern;
+	uint16_t step;	/* Position within the pattern cycle */
+	uint8_t level;	/* Brightness of the current edge, in percent */
+};
+
+static struct led_engine leds[LED_PATTERN_LED_COUNT];
+static struct k_spinlock lock;
+
+#ifdef CONFIG_BASIC_APP_LED_PWM
+/* LEDs with a pwm-ledN alias are driven by PWM, the others by GPIO */
+static const struct pwm_dt_spec pwm_leds[LED_PATTERN_LED_COUNT] = {
+	PWM_DT_SPEC_GET_OR(DT_ALIAS(pwm_led0), {0}),
+	PWM_DT_SPEC_GET_OR(DT_ALIAS(pwm_led1), {0}),
+	PWM_DT_SPEC_GET_OR(DT_ALIAS(pwm_led2), {0}),
+	PWM_DT_SPEC_GET_OR(DT_ALIAS(pwm_led3), {0}),
+};
+
+#define BREATHE_STEP_MS CONFIG_BASIC_APP_LED_BREATHE_STEP_MS
+#endif
+
+static bool led_has_pwm(uint8_t led)
+{
+#ifdef CONFIG_BASIC_APP_LED_PWM
+	return pwm_leds[led].dev != NULL;
+#else
+	ARG_UNUSED(led);
+	return false;
+#endif
+}
+
+/* Set an LED to a brightness in percent (GPIO LEDs: on above 0) */
+static void led_write(uint8_t led, uint32_t level)
+{
+#ifdef CONFIG_BASIC_APP_LED_PWM
+	if (led_has_pwm(led)) {
+		(void)pwm_set_pulse_dt(&pwm_leds[led], pwm_leds[led].period * level / 100);
+		return;
+	}
+#endif
+	(void)dk_set_led(led, level > 0);
+}
+
+#ifdef CONFIG_BASIC_APP_LED_PWM
+/* Triangle ramp over up + down, squared so the fade looks linear */
+static uint32_t breathe_step(struct led_engine *e)
+{
+	uint16_t up = MAX(e->pattern.on_ms / BREATHE_STEP_MS, 1);
+	uint16_t down = MAX(e->pattern.off_ms / BREATHE_STEP_MS, 1);
+	uint32_t x = (e->step < up) ? (e->step * 100U) / up :
+		     ((up + down - e->step) * 100U) / down;
+
+	e->level = (x * x) / 100U;
+	e->step = (e->step + 1) % (up + down);
+
+	return BREATHE_STEP_MS;
+}
+#endif
+
+/*
+ * Compute the level of the current edge of the pattern and advance it.
+ * Returns the time until the next edge, 0 when the LED is static.
+ * Called with the lock held; the caller submits e->work to apply the level.
+ */
+static uint32_t led_step(struct led_engine *e, uint8_t led)
+{
+	const struct led_pattern *p = &e->pattern;
+	bool on;
+
+	switch (p->type) {
+	case LED_PATTERN_TYPE_ON:
+		e->level = 100;
+		return 0;
+
+	case LED_PATTERN_TYPE_BLINK:
+		on = (e->step == 0);
+		e->level = on ? 100 : 0;
+		e->step ^= 1;
+		return on ? p->on_ms : p->off_ms;
+
+	case LED_PATTERN_TYPE_BURST:
+		on = !(e->step & 1);
+		e->level = on ? 100 : 0;
+		e->step = (e->step + 1) % (2 * p->count);
+		if (on) {
+			return p->on_ms;
+		}
+		/* Last flash of the code is followed by the pause */
+		return (e->step == 0) ? p->pause_ms : p->off_ms;
+
+	case LED_PATTERN_TYPE_BREATHE:
+#ifdef CONFIG_BASIC_APP_LED_PWM
+		if (led_has_pwm(led)) {
+			return breathe_step(e);
+		}
+#endif
+		on = (e->step == 0);
+		e->level = on ? 100 : 0;
+		e->step ^= 1;
+		return on ? p->on_ms : p->off_ms;
+
+	case LED_PATTERN_TYPE_OFF:
+	default:
+		e->level = 0;
+		return 0;
+	}
+}
+
+/* Work handler (system workqueue): PWM drivers may sleep, so never write from the ISR */
+static void led_work_handler(struct k_work *work)
+{
+	struct led_engine *e = CONTAINER_OF(work, struct led_engine, work);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint8_t level = e->level;
+
+	k_spin_unlock(&lock, key);
+
+	/* A newer edge resubmits the work, so the last level always lands */
+	led_write(e - leds, level);
+}
+
+/* Timer callback (ISR context): one edge, then re-arm for the next */
+static void led_timer_handler(struct k_timer *timer)
+{
+	struct led_engine *e = CONTAINER_OF(timer, struct led_engine, timer);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t next_ms = led_step(e, e - leds);
+
+	if (next_ms) {
+		k_timer_start(timer, K_MSEC(next_ms), K_NO_WAIT);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	k_work_submit(&e->work);
+}
+
+static bool pattern_valid(const struct led_pattern *p)
+{
+	switch (p->type) {
+	case LED_PATTERN_TYPE_OFF:
+	case LED_PATTERN_TYPE_ON:
+		return true;
+	case LED_PATTERN_TYPE_BLINK:
+	case LED_PATTERN_TYPE_BREATHE:
+		return p->on_ms && p->off_ms;
+	case LED_PATTERN_TYPE_BURST:
+		return p->count && p->on_ms && p->off_ms && p->pause_ms;
+	default:
+		return false;
+	}
+}
+
+/* Field-wise: compound literals leave padding undefined */
+static bool pattern_equal(const struct led_pattern *a, const struct led_pattern *b)
+{
+	return a->type == b->type && a->on_ms == b->on_ms && a->off_ms == b->off_ms &&
+	       a->pause_ms == b->pause_ms && a->count == b->count;
+}
+
+/*******************************************************************************
+ * Public API
+ ******************************************************************************/
+
+int led_pattern_init(void)
+{
+	for (uint8_t i = 0; i < LED_PATTERN_LED_COUNT; i++) {
+		k_timer_init(&leds[i].timer, led_timer_handler, NULL);
+		k_work_init(&leds[i].work, led_work_handler);
+		leds[i].pattern = LED_PATTERN_OFF();
+
+#ifdef CONFIG_BASIC_APP_LED_PWM
+		if (led_has_pwm(i) && !pwm_is_ready_dt(&pwm_leds[i])) {
+			LOG_ERR("PWM for LED %u not ready", i);
+			return -ENODEV;
+		}
+#endif
+		led_write(i, 0);
+	}
+
+	return 0;
+}
+
+int led_pattern_set(uint8_t led, const struct led_pattern *pattern)
+{
+	struct led_engine *e;
+	k_spinlock_key_t key;
+	uint32_t next_ms;
+	bool changed;
+
+	if (led >= LED_PATTERN_LED_COUNT || pattern == NULL || !pattern_valid(pattern)) {
+		return -EINVAL;
+	}
+
+	e = &leds[led];
+	key = k_spin_lock(&lock);
+
+	changed = !pattern_equal(&e->pattern, pattern);
+	if (changed) {
+		k_timer_stop(&e->timer);
+		e->pattern = *pattern;
+		e->step = 0;
+
+		next_ms = led_step(e, led);
+		if (next_ms) {
+			k_timer_start(&e->timer, K_MSEC(next_ms), K_NO_WAIT);
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (changed) {
+		k_work_submit(&e->work);
+	}
+
+	return 0;
+}
+
+int led_pattern_get(uint8_t led, struct led_pattern *pattern)
+{
+	k_spinlock_key_t key;
+
+	if (led >= LED_PATTERN_LED_COUNT || pattern == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+	*pattern = leds[led].pattern;
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
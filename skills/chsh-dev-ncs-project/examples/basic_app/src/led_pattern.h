@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _LED_PATTERN_H_
+#define _LED_PATTERN_H_
+
+/**
+ * @file led_pattern.h
+ * @brief Timer-driven LED pattern engine
+ *
+ * Each LED runs a declarative pattern from its own k_timer. The timer
+ * callback advances the pattern, re-arms itself for the next edge and
+ * submits a work item that writes the LED (PWM drivers may sleep). A 1 Hz
+ * blink costs two timer interrupts and two work items per second; a steady
+ * LED costs nothing.
+ *
+ * @code
+ * led_pattern_set(DK_LED1, &LED_PATTERN_BLINK(500, 500));
+ * led_pattern_set(DK_LED2, &LED_PATTERN_BURST(3, 150, 150, 2000));
+ * @endcode
+ *
+ * All functions are thread-safe and may be called from ISRs.
+ */
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** LEDs handled by the engine (DK_LED1..DK_LED4) */
+#define LED_PATTERN_LED_COUNT 4
+
+enum led_pattern_type {
+	LED_PATTERN_TYPE_OFF,
+	LED_PATTERN_TYPE_ON,
+	LED_PATTERN_TYPE_BLINK,		/* on_ms on, off_ms off, forever */
+	LED_PATTERN_TYPE_BURST,		/* count flashes, then pause_ms dark */
+	LED_PATTERN_TYPE_BREATHE,	/* Ramp up over on_ms, down over off_ms */
+};
+
+/**
+ * @brief Pattern description
+ *
+ * Build with the LED_PATTERN_*() macros rather than by hand.
+ */
+struct led_pattern {
+	enum led_pattern_type type;
+	uint16_t on_ms;
+	uint16_t off_ms;
+	uint16_t pause_ms;
+	uint8_t count;
+};
+
+/** LED off */
+#define LED_PATTERN_OFF() ((struct led_pattern){ .type = LED_PATTERN_TYPE_OFF })
+
+/** LED steadily on */
+#define LED_PATTERN_ON() ((struct led_pattern){ .type = LED_PATTERN_TYPE_ON })
+
+/** Square wave: @p _on_ms on, @p _off_ms off */
+#define LED_PATTERN_BLINK(_on_ms, _off_ms)						\
+	((struct led_pattern){ .type = LED_PATTERN_TYPE_BLINK,				\
+			       .on_ms = (_on_ms), .off_ms = (_off_ms) })
+
+/** Blink code: @p _count flashes of @p _on_ms / @p _off_ms, then @p _pause_ms off */
+#define LED_PATTERN_BURST(_count, _on_ms, _off_ms, _pause_ms)				\
+	((struct led_pattern){ .type = LED_PATTERN_TYPE_BURST,				\
+			       .count = (_count), .on_ms = (_on_ms),			\
+			       .off_ms = (_off_ms), .pause_ms = (_pause_ms) })
+
+/**
+ * @brief Fade in and out over @p _period_ms
+ *
+ * Needs CONFIG_BASIC_APP_LED_PWM and a pwm-ledN alias for the LED; on a
+ * plain GPIO LED it falls back to a blink with the same period.
+ */
+#define LED_PATTERN_BREATHE(_period_ms)							\
+	((struct led_pattern){ .type = LED_PATTERN_TYPE_BREATHE,			\
+			       .on_ms = (_period_ms) / 2, .off_ms = (_period_ms) / 2 })
+
+/**
+ * @brief Initialize the engine
+ *
+ * Call after dk_leds_init(). All LEDs start with LED_PATTERN_OFF().
+ *
+ * @return 0 on success, negative errno on failure
+ */
+int led_pattern_init(void);
+
+/**
+ * @brief Start a pattern on an LED
+ *
+ * Replaces the running pattern immediately and starts the new one from
+ * its first edge. Setting the pattern that is already running does not
+ * restart it, so callers can re-apply their state freely.
+ *
+ * @param led LED index (DK_LED1..DK_LED4)
+ * @param pattern Pattern, copied by the engine
+ * @return 0 on success, -EINVAL for an invalid LED or pattern
+ */
+int led_pattern_set(uint8_t led, const struct led_pattern *pattern);
+
+/**
+ * @brief Get the pattern running on an LED
+ *
+ * @return 0 on success, -EINVAL for an invalid LED
+ */
+int led_pattern_get(uint8_t led, struct led_pattern *pattern);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LED_PATTERN_H_ */
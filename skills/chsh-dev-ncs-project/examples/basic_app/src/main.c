@@ -11,38 +11,68 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/shell/shell.h>
 #include <dk_buttons_and_leds.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "led_pattern.h"
 
 LOG_MODULE_REGISTER(basic_app, LOG_LEVEL_INF);
 
-/* Application state */
+/* Application state, changed from the button handler and the shell */
+static K_MUTEX_DEFINE(app_lock);
 static bool app_running = true;
 static uint32_t blink_interval_ms = CONFIG_BASIC_APP_LED_BLINK_INTERVAL_MS;
 
+/* Push the application state to the status LED. Call with app_lock held. */
+static void update_led(void)
+{
+	if (app_running) {
+		led_pattern_set(DK_LED1, &LED_PATTERN_BLINK(blink_interval_ms,
+							   blink_interval_ms));
+	} else {
+		led_pattern_set(DK_LED1, &LED_PATTERN_OFF());
+	}
+}
+
 /* Button callback */
 static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
 	if (has_changed & button_state & DK_BTN1_MSK) {
 		LOG_INF("Button 1 pressed");
+		k_mutex_lock(&app_lock, K_FOREVER);
 		app_running = !app_running;
+		update_led();
 		LOG_INF("Application %s", app_running ? "started" : "paused");
+		k_mutex_unlock(&app_lock);
 	}
 
 	if (has_changed & button_state & DK_BTN2_MSK) {
 		LOG_INF("Button 2 pressed");
 		/* Toggle between fast and slow blink */
+		k_mutex_lock(&app_lock, K_FOREVER);
 		blink_interval_ms = (blink_interval_ms == 1000) ? 250 : 1000;
+		update_led();
 		LOG_INF("Blink interval set to %d ms", blink_interval_ms);
+		k_mutex_unlock(&app_lock);
 	}
 }
 
 #if CONFIG_BASIC_APP_ENABLE_SHELL
+static void set_running(bool running)
+{
+	k_mutex_lock(&app_lock, K_FOREVER);
+	app_running = running;
+	update_led();
+	k_mutex_unlock(&app_lock);
+}
+
 /* Shell command to start application */
 static int cmd_start(const struct shell *sh, size_t argc, char **argv)
 {
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
 
-	app_running = true;
+	set_running(true);
 	shell_print(sh, "Application started");
 	return 0;
 }
@@ -53,7 +83,7 @@ static int cmd_stop(const struct shell *sh, size_t argc, char **argv)
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
 
-	app_running = false;
+	set_running(false);
 	shell_print(sh, "Application stopped");
 	return 0;
 }
@@ -61,19 +91,68 @@ static int cmd_stop(const struct shell *sh, size_t argc, char **argv)
 /* Shell command to set blink interval */
 static int cmd_interval(const struct shell *sh, size_t argc, char **argv)
 {
+	int interval;
+
 	if (argc < 2) {
 		shell_error(sh, "Usage: interval <ms>");
 		return -EINVAL;
 	}
 
-	blink_interval_ms = atoi(argv[1]);
-	if (blink_interval_ms < 100 || blink_interval_ms > 10000) {
+	interval = atoi(argv[1]);
+	if (interval < 100 || interval > 10000) {
 		shell_error(sh, "Interval must be between 100 and 10000 ms");
-		blink_interval_ms = CONFIG_BASIC_APP_LED_BLINK_INTERVAL_MS;
 		return -EINVAL;
 	}
 
-	shell_print(sh, "Blink interval set to %d ms", blink_interval_ms);
+	k_mutex_lock(&app_lock, K_FOREVER);
+	blink_interval_ms = interval;
+	update_led();
+	k_mutex_unlock(&app_lock);
+
+	shell_print(sh, "Blink interval set to %d ms", interval);
+	return 0;
+}
+
+/* Shell command to run a pattern on LED2 */
+static int cmd_pattern(const struct shell *sh, size_t argc, char **argv)
+{
+	struct led_pattern pattern;
+	unsigned long count = 3;
+	char *end;
+
+	if (argc < 2) {
+		shell_error(sh, "Usage: pattern <off|on|blink|breathe|burst> [count]");
+		return -EINVAL;
+	}
+
+	if (strcmp(argv[1], "off") == 0) {
+		pattern = LED_PATTERN_OFF();
+	} else if (strcmp(argv[1], "on") == 0) {
+		pattern = LED_PATTERN_ON();
+	} else if (strcmp(argv[1], "blink") == 0) {
+		pattern = LED_PATTERN_BLINK(100, 900);
+	} else if (strcmp(argv[1], "breathe") == 0) {
+		pattern = LED_PATTERN_BREATHE(3000);
+	} else if (strcmp(argv[1], "burst") == 0) {
+		if (argc > 2) {
+			count = strtoul(argv[2], &end, 10);
+			if (*end != '\0' || count < 1 || count > UINT8_MAX) {
+				shell_error(sh, "Count must be 1..%u", UINT8_MAX);
+				return -EINVAL;
+			}
+		}
+		pattern = LED_PATTERN_BURST(count, 150, 250, 2000);
+	} else {
+		shell_error(sh, "Unknown pattern: %s", argv[1]);
+		return -EINVAL;
+	}
+
+	if (led_pattern_set(DK_LED2, &pattern)) {
+		shell_error(sh, "Invalid pattern");
+		return -EINVAL;
+	}
+
+	shell_print(sh, "LED2 pattern: %s", argv[1]);
 	return 0;
 }
 
@@ -81,6 +160,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_app,
 	SHELL_CMD(start, NULL, "Start the application", cmd_start),
 	SHELL_CMD(stop, NULL, "Stop the application", cmd_stop),
 	SHELL_CMD(interval, NULL, "Set blink interval <ms>", cmd_interval),
+	SHELL_CMD(pattern, NULL, "Run a pattern on LED2 <off|on|blink|breathe|burst> [count]",
+		  cmd_pattern),
 	SHELL_SUBCMD_SET_END
 );
 
@@ -91,7 +172,6 @@ SHELL_CMD_REGISTER(app, &sub_app, "Application commands", NULL);
 int main(void)
 {
 	int ret;
-	bool led_state = false;
 
 	LOG_INF("=========================================");
 	LOG_INF("Basic NCS Application");
@@ -99,17 +179,23 @@ int main(void)
 	LOG_INF("Build time: %s %s", __DATE__, __TIME__);
 	LOG_INF("=========================================");
 
-	/* Initialize buttons */
-	ret = dk_buttons_init(button_handler);
+	/* Initialize LEDs */
+	ret = dk_leds_init();
 	if (ret) {
-		LOG_ERR("Failed to initialize buttons: %d", ret);
+		LOG_ERR("Failed to initialize LEDs: %d", ret);
 		return ret;
 	}
 
-	/* Initialize LEDs */
-	ret = dk_leds_init();
+	ret = led_pattern_init();
 	if (ret) {
-		LOG_ERR("Failed to initialize LEDs: %d", ret);
+		LOG_ERR("Failed to initialize LED patterns: %d", ret);
+		return ret;
+	}
+
+	/* Initialize buttons */
+	ret = dk_buttons_init(button_handler);
+	if (ret) {
+		LOG_ERR("Failed to initialize buttons: %d", ret);
 		return ret;
 	}
 
@@ -117,26 +203,15 @@ int main(void)
 	LOG_INF("Press Button 1 to pause/resume");
 	LOG_INF("Press Button 2 to toggle blink speed");
 #if CONFIG_BASIC_APP_ENABLE_SHELL
-	LOG_INF("Shell commands: app start, app stop, app interval <ms>");
+	LOG_INF("Shell commands: app start, app stop, app interval <ms>, app pattern <name>");
 #endif
 
-	/* Main application loop */
-	while (1) {
-		if (app_running) {
-			/* Toggle LED */
-			led_state = !led_state;
-			if (led_state) {
-				dk_set_led_on(DK_LED1);
-			} else {
-				dk_set_led_off(DK_LED1);
-			}
-		} else {
-			/* When paused, turn off LED */
-			dk_set_led_off(DK_LED1);
-		}
+	k_mutex_lock(&app_lock, K_FOREVER);
+	update_led();
+	k_mutex_unlock(&app_lock);
 
-		k_msleep(blink_interval_ms);
-	}
+	/* LEDs run from timers, buttons and shell from their own contexts */
+	k_sleep(K_FOREVER);
 
 	return 0;
 }
@@ -320,6 +320,11 @@ int control_handler(struct http_client_ctx *client, enum http_data_status status
  * 
  * Call this early in main() to set up all HTTP resources.
  * Typically called before starting Wi-Fi/network.
+ *
+ * In an SMF + zbus app with CONFIG_APP_BOOT_GRAPH, declare that order
+ * instead of relying on main(): call this from the INIT state of a module
+ * defined with BOOT_GRAPH_MODULE_DEFINE(webserver), and define the Wi-Fi
+ * module with BOOT_GRAPH_MODULE_DEFINE(wifi, webserver).
  */
 void http_resources_init(void)
 {